@@ -15,6 +15,9 @@
 #pragma once
 
 #include <any>
+#include <array>
+
+#include "portal/core/strings/string_id.h"
 
 namespace portal
 {
@@ -25,6 +28,15 @@ namespace ecs
     class Registry;
 }
 
+/**
+ * Time spent by a single ECS system during the frame's update.
+ */
+struct SystemTiming
+{
+    StringId name;
+    float time = 0.f;
+};
+
 /**
  * Performance statistics accumulated during a single frame.
  *
@@ -40,6 +52,15 @@ struct FrameStats
     int drawcall_count;
     float scene_update_time;
     float mesh_draw_time;
+    // Time spent syncing and culling the render scene, in milliseconds
+    float scene_extraction_time = 0.f;
+    int render_object_count = 0;
+    int visible_object_count = 0;
+
+    constexpr static size_t MAX_SYSTEM_TIMINGS = 32;
+    // Per system update times in milliseconds, filled by the system orchestrator in registration order
+    std::array<SystemTiming, MAX_SYSTEM_TIMINGS> system_timings = {};
+    size_t system_timing_count = 0;
 };
 
 
@@ -35,7 +35,7 @@ ProjectSettings ProjectSettings::create_settings(
     if (FileSystem::exists(mutable_settings_path))
     {
         auto user_settings = ProjectSettings(type, mutable_settings_path);
-        output.update(user_settings);
+        output.update(std::move(user_settings));
         output.settings_path = mutable_settings_path;
     }
 
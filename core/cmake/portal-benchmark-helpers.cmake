@@ -0,0 +1,104 @@
+#[=======================================================================[.rst:
+portal_add_benchmark_target
+---------------------------
+
+Creates a benchmark executable for a Portal Framework module.
+
+Benchmarks are plain executables built on top of ``portal/core/debug/benchmark.h``,
+they print a human readable summary to stderr and the full results as JSON to stdout
+(or to the file given as the first argument).
+
+Synopsis
+^^^^^^^^
+
+.. code-block:: cmake
+
+  portal_add_benchmark_target(<target_name>
+                              [SOURCES <source>...]
+                              [LIBRARIES <library>...])
+
+Arguments
+^^^^^^^^^
+
+``<target_name>``
+  Name of the module target to benchmark. The benchmark executable will
+  be named ``<target_name>-bench``.
+
+``SOURCES <source>...``
+  Optional. List of source files for the benchmark executable. If not provided,
+  the function automatically glob searches for files matching ``*bench.cpp``
+  in the current directory and subdirectories.
+
+``LIBRARIES <library>...``
+  Optional. Additional libraries to link against the benchmark executable beyond
+  the module target itself.
+
+Example Usage
+^^^^^^^^^^^^^
+
+.. code-block:: cmake
+
+  portal_add_benchmark_target(portal-serialization)
+
+Notes
+^^^^^
+
+- The ``PORTAL_BENCHMARK`` define is set on the benchmark executable
+- Benchmarks are not registered with CTest, run them manually on a Release build
+
+#]=======================================================================]
+function(portal_add_benchmark_target TARGET_NAME)
+    set(options "")
+    set(oneValueArgs "")
+    set(multiValueArgs SOURCES LIBRARIES)
+    cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    if(NOT ARG_SOURCES)
+        file(GLOB_RECURSE ARG_SOURCES "*bench.cpp")
+    endif()
+
+    set(BENCH_TARGET ${TARGET_NAME}-bench)
+    add_executable(${BENCH_TARGET} ${ARG_SOURCES})
+
+    message(STATUS "Adding benchmark target ${BENCH_TARGET}")
+    target_link_libraries(${BENCH_TARGET}
+            PRIVATE
+            ${TARGET_NAME}
+            ${ARG_LIBRARIES}
+    )
+
+    target_compile_definitions(${BENCH_TARGET} PRIVATE PORTAL_BENCHMARK)
+endfunction()
+
+#[=======================================================================[.rst:
+portal_build_benchmarks
+-----------------------
+
+Conditionally builds benchmarks from a subdirectory based on the ``PORTAL_BUILD_BENCHMARKS`` option.
+
+Synopsis
+^^^^^^^^
+
+.. code-block:: cmake
+
+  portal_build_benchmarks(<folder_name>)
+
+Example Usage
+^^^^^^^^^^^^^
+
+.. code-block:: cmake
+
+  # In serialization/CMakeLists.txt
+  portal_build_benchmarks(benchmarks)
+
+See Also
+^^^^^^^^
+
+- ``portal_add_benchmark_target``: Creates benchmark executables
+
+#]=======================================================================]
+function(portal_build_benchmarks FOLDER_NAME)
+    if (PORTAL_BUILD_BENCHMARKS)
+        add_subdirectory(${FOLDER_NAME})
+    endif ()
+endfunction()
@@ -0,0 +1,106 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <fmt/format.h>
+
+#if defined(PORTAL_PLATFORM_WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace portal::benchmark
+{
+size_t get_peak_rss()
+{
+#if defined(PORTAL_PLATFORM_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(PORTAL_PLATFORM_MACOS)
+    // macOS reports bytes
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+BenchmarkRunner::BenchmarkRunner(std::string suite_name, const size_t min_iterations, const std::chrono::milliseconds min_time)
+    : suite_name(std::move(suite_name)),
+      min_iterations(min_iterations == 0 ? 1 : min_iterations),
+      min_time(min_time)
+{}
+
+const BenchmarkResult& BenchmarkRunner::add_result(
+    const std::string_view name,
+    const size_t bytes_per_op,
+    const std::vector<double>& samples,
+    const AllocationStats& allocations
+)
+{
+    auto& result = results.emplace_back();
+    result.name = std::string(name);
+    result.iterations = samples.size();
+    result.bytes_per_op = bytes_per_op;
+
+    const auto iterations = static_cast<double>(samples.size());
+    result.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / iterations;
+    result.min_ns = *std::ranges::min_element(samples);
+    result.max_ns = *std::ranges::max_element(samples);
+    if (result.mean_ns > 0)
+        result.throughput_mb_s = (static_cast<double>(bytes_per_op) / (1024.0 * 1024.0)) / (result.mean_ns / 1e9);
+
+    result.allocations_per_op = static_cast<double>(allocations.count) / iterations;
+    result.allocated_bytes_per_op = static_cast<double>(allocations.bytes) / iterations;
+
+    fmt::print(
+        stderr,
+        "{:<48} {:>10.3f} ms {:>10.1f} MB/s {:>12.1f} allocs/op\n",
+        result.name,
+        result.mean_ns / 1e6,
+        result.throughput_mb_s,
+        result.allocations_per_op
+    );
+
+    return result;
+}
+
+void BenchmarkRunner::write_json(std::ostream& output) const
+{
+    output << fmt::format("{{\n  \"suite\": \"{}\",\n  \"peak_rss_bytes\": {},\n  \"results\": [\n", suite_name, get_peak_rss());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        output << fmt::format(
+            "    {{\"name\": \"{}\", \"iterations\": {}, \"bytes_per_op\": {}, \"mean_ns\": {:.1f}, \"min_ns\": {:.1f}, "
+            "\"max_ns\": {:.1f}, \"throughput_mb_s\": {:.2f}, \"allocations_per_op\": {:.2f}, \"allocated_bytes_per_op\": {:.1f}}}{}\n",
+            result.name,
+            result.iterations,
+            result.bytes_per_op,
+            result.mean_ns,
+            result.min_ns,
+            result.max_ns,
+            result.throughput_mb_s,
+            result.allocations_per_op,
+            result.allocated_bytes_per_op,
+            i + 1 < results.size() ? "," : ""
+        );
+    }
+    output << "  ]\n}\n";
+}
+} // portal
@@ -0,0 +1,215 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(PORTAL_PLATFORM_WINDOWS)
+#include <malloc.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace portal::benchmark
+{
+namespace details
+{
+    inline std::atomic<uint64_t> allocation_count = 0;
+    inline std::atomic<uint64_t> allocated_bytes = 0;
+}
+
+/**
+ * @brief Global allocation counters, only populated in executables that use `PORTAL_BENCHMARK_TRACK_ALLOCATIONS`.
+ */
+struct AllocationStats
+{
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+[[nodiscard]] inline AllocationStats get_allocation_stats()
+{
+    return {
+        details::allocation_count.load(std::memory_order_relaxed),
+        details::allocated_bytes.load(std::memory_order_relaxed)
+    };
+}
+
+/**
+ * @brief Returns the peak resident set size of the current process in bytes (0 if unavailable).
+ */
+[[nodiscard]] size_t get_peak_rss();
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(_MSC_VER)
+    const volatile auto* escape = reinterpret_cast<const volatile char*>(&value);
+    static_cast<void>(*escape);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/**
+ * @brief The measurements of a single benchmark case.
+ */
+struct BenchmarkResult
+{
+    std::string name;
+    size_t iterations = 0;
+    // Payload processed by a single operation, used to compute throughput
+    size_t bytes_per_op = 0;
+
+    double mean_ns = 0;
+    double min_ns = 0;
+    double max_ns = 0;
+    double throughput_mb_s = 0;
+
+    double allocations_per_op = 0;
+    double allocated_bytes_per_op = 0;
+};
+
+/**
+ * @brief Minimal benchmark runner that times a callable, counts its allocations and reports the results as JSON.
+ *
+ * Each case runs once as a warmup, and then repeatedly until both `min_iterations` and `min_time` are reached.
+ *
+ * @par Example:
+ * @code
+ * PORTAL_BENCHMARK_TRACK_ALLOCATIONS()
+ *
+ * int main()
+ * {
+ *     benchmark::BenchmarkRunner runner("my-suite");
+ *     runner.run("copy 1MB", 1024 * 1024, [&] { std::memcpy(dst, src, 1024 * 1024); });
+ *     runner.write_json(std::cout);
+ * }
+ * @endcode
+ */
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(
+        std::string suite_name,
+        size_t min_iterations = 5,
+        std::chrono::milliseconds min_time = std::chrono::milliseconds{250}
+    );
+
+    template <typename Func>
+    const BenchmarkResult& run(const std::string_view name, const size_t bytes_per_op, Func&& func)
+    {
+        // Warmup, also primes any lazily allocated caches so they don't count as per op allocations
+        func();
+
+        std::vector<double> samples;
+        AllocationStats allocations;
+        const auto start = Clock::now();
+        while (samples.size() < min_iterations || Clock::now() - start < min_time)
+        {
+            // Only the callable is measured, not the bookkeeping of the samples
+            const auto allocations_before = get_allocation_stats();
+            const auto iteration_start = Clock::now();
+            func();
+            const auto iteration_end = Clock::now();
+            const auto allocations_after = get_allocation_stats();
+
+            allocations.count += allocations_after.count - allocations_before.count;
+            allocations.bytes += allocations_after.bytes - allocations_before.bytes;
+            samples.push_back(std::chrono::duration<double, std::nano>(iteration_end - iteration_start).count());
+        }
+
+        return add_result(name, bytes_per_op, samples, allocations);
+    }
+
+    [[nodiscard]] const std::vector<BenchmarkResult>& get_results() const { return results; }
+
+    /**
+     * @brief Writes every result, together with the process peak RSS, as a JSON document.
+     */
+    void write_json(std::ostream& output) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const BenchmarkResult& add_result(
+        std::string_view name,
+        size_t bytes_per_op,
+        const std::vector<double>& samples,
+        const AllocationStats& allocations
+    );
+
+private:
+    std::string suite_name;
+    size_t min_iterations;
+    std::chrono::milliseconds min_time;
+    std::vector<BenchmarkResult> results;
+};
+} // portal
+
+#if defined(PORTAL_PLATFORM_WINDOWS)
+#define PORTAL_BENCHMARK_ALIGNED_ALLOC(alignment, size) _aligned_malloc(size, alignment)
+#define PORTAL_BENCHMARK_ALIGNED_FREE(ptr) _aligned_free(ptr)
+#else
+#define PORTAL_BENCHMARK_ALIGNED_ALLOC(alignment, size) std::aligned_alloc(alignment, ((size) + (alignment) - 1) / (alignment) * (alignment))
+#define PORTAL_BENCHMARK_ALIGNED_FREE(ptr) std::free(ptr)
+#endif
+
+/**
+ * @brief Replaces the global allocation functions with counting ones, use exactly once in a benchmark executable.
+ */
+#define PORTAL_BENCHMARK_TRACK_ALLOCATIONS()                                                                   \
+    namespace portal::benchmark::details                                                                       \
+    {                                                                                                          \
+        static void* tracked_alloc(const size_t size)                                                          \
+        {                                                                                                      \
+            allocation_count.fetch_add(1, std::memory_order_relaxed);                                          \
+            allocated_bytes.fetch_add(size, std::memory_order_relaxed);                                        \
+            if (auto* ptr = std::malloc(size == 0 ? 1 : size))                                                 \
+                return ptr;                                                                                    \
+            throw std::bad_alloc();                                                                            \
+        }                                                                                                      \
+        static void* tracked_aligned_alloc(const size_t size, const std::align_val_t alignment)                \
+        {                                                                                                      \
+            allocation_count.fetch_add(1, std::memory_order_relaxed);                                          \
+            allocated_bytes.fetch_add(size, std::memory_order_relaxed);                                        \
+            if (auto* ptr = PORTAL_BENCHMARK_ALIGNED_ALLOC(static_cast<size_t>(alignment), size == 0 ? 1 : size)) \
+                return ptr;                                                                                    \
+            throw std::bad_alloc();                                                                            \
+        }                                                                                                      \
+    }                                                                                                          \
+    void* operator new(const size_t size) { return portal::benchmark::details::tracked_alloc(size); }         \
+    void* operator new[](const size_t size) { return portal::benchmark::details::tracked_alloc(size); }       \
+    void* operator new(const size_t size, const std::align_val_t alignment)                                    \
+    {                                                                                                          \
+        return portal::benchmark::details::tracked_aligned_alloc(size, alignment);                             \
+    }                                                                                                          \
+    void* operator new[](const size_t size, const std::align_val_t alignment)                                  \
+    {                                                                                                          \
+        return portal::benchmark::details::tracked_aligned_alloc(size, alignment);                             \
+    }                                                                                                          \
+    void operator delete(void* ptr) noexcept { std::free(ptr); }                                               \
+    void operator delete[](void* ptr) noexcept { std::free(ptr); }                                             \
+    void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }                                       \
+    void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }                                     \
+    void operator delete(void* ptr, std::align_val_t) noexcept { PORTAL_BENCHMARK_ALIGNED_FREE(ptr); }         \
+    void operator delete[](void* ptr, std::align_val_t) noexcept { PORTAL_BENCHMARK_ALIGNED_FREE(ptr); }       \
+    void operator delete(void* ptr, size_t, std::align_val_t) noexcept { PORTAL_BENCHMARK_ALIGNED_FREE(ptr); } \
+    void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { PORTAL_BENCHMARK_ALIGNED_FREE(ptr); }
@@ -0,0 +1,83 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "file_watcher.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "portal/core/debug/profile.h"
+
+namespace portal
+{
+namespace
+{
+    /**
+     * The change a burst of events amounts to, from whether the file existed before its first event and whether it
+     * exists after its last one. A file that was created and removed within the burst was never there.
+     */
+    std::optional<FileChangeType> coalesce(const FileChangeType first, const FileChangeType last)
+    {
+        const bool existed_before = first != FileChangeType::Added;
+        const bool exists_after = last != FileChangeType::Removed;
+
+        if (!existed_before && !exists_after)
+            return std::nullopt;
+        if (!exists_after)
+            return FileChangeType::Removed;
+        if (!existed_before)
+            return FileChangeType::Added;
+        return FileChangeType::Modified;
+    }
+}
+
+std::vector<FileChange> FileWatcher::poll()
+{
+    PORTAL_PROF_ZONE();
+
+    read_events();
+    if (pending.empty())
+        return {};
+
+    return take_settled(Clock::now());
+}
+
+bool FileWatcher::consume_overflow()
+{
+    return std::exchange(overflowed, false);
+}
+
+void FileWatcher::record(const std::filesystem::path& path, const FileChangeType type, const Clock::time_point time)
+{
+    const auto [it, inserted] = pending.try_emplace(path.generic_string(), PendingChange{type, type, time});
+    if (inserted)
+        return;
+
+    it->second.last = type;
+    it->second.last_event = time;
+}
+
+std::vector<FileChange> FileWatcher::take_settled(const Clock::time_point now)
+{
+    std::vector<FileChange> changes;
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        const auto& [path, change] = *it;
+        if (now - change.last_event < settle_time)
+        {
+            ++it;
+            continue;
+        }
+
+        if (const auto type = coalesce(change.first, change.last))
+            changes.push_back({path, *type});
+        it = pending.erase(it);
+    }
+
+    std::ranges::sort(changes, {}, &FileChange::path);
+    return changes;
+}
+} // portal
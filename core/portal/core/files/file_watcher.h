@@ -0,0 +1,111 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace portal
+{
+enum class FileChangeType : uint8_t
+{
+    Added,
+    Modified,
+    Removed
+};
+
+struct FileChange
+{
+    // Relative to the watched directory
+    std::filesystem::path path;
+    FileChangeType type;
+};
+
+/**
+ * @brief Watches a directory tree for file changes.
+ *
+ * Saving a file usually produces a burst of events (an editor might write a temporary file, remove the original and
+ * rename the temporary over it), the watcher coalesces the events of each file and only reports it once no event was
+ * seen for it for the settle time, as a single change describing the difference between before and after the burst.
+ *
+ * The watcher has no thread of its own, events are collected by calling `poll`, which never blocks.
+ *
+ * Only implemented on Linux (inotify), on other platforms `start` fails and nothing is reported.
+ */
+class FileWatcher
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    constexpr static auto DEFAULT_SETTLE_TIME = std::chrono::milliseconds(100);
+
+    explicit FileWatcher(std::filesystem::path root, Clock::duration settle_time = DEFAULT_SETTLE_TIME);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Starts watching the root directory and all of its subdirectories.
+     *
+     * @return false if the directory cannot be watched
+     */
+    bool start();
+    void stop();
+
+    [[nodiscard]] bool is_watching() const;
+
+    /**
+     * @brief Collects the pending events and returns the changes that settled, sorted by path.
+     */
+    std::vector<FileChange> poll();
+
+    /**
+     * @brief Returns true once after the watcher missed events (its event queue overflowed or a directory was moved out
+     * of the tree), in which case the watched directory should be scanned again.
+     */
+    bool consume_overflow();
+
+    /**
+     * @brief Records a single event of a file, called by the platform backend.
+     */
+    void record(const std::filesystem::path& path, FileChangeType type, Clock::time_point time);
+
+    /**
+     * @brief Returns the coalesced changes of the files that had no events since `now - settle_time`.
+     */
+    std::vector<FileChange> take_settled(Clock::time_point now);
+
+    [[nodiscard]] const std::filesystem::path& get_root() const { return root; }
+
+private:
+    struct NativeWatcher;
+
+    struct PendingChange
+    {
+        FileChangeType first;
+        FileChangeType last;
+        Clock::time_point last_event;
+    };
+
+    /**
+     * @brief Reads every event the platform queued since the last call, without blocking.
+     */
+    void read_events();
+
+    std::filesystem::path root;
+    Clock::duration settle_time;
+    std::unique_ptr<NativeWatcher> native;
+
+    // Keyed by the generic path string
+    std::unordered_map<std::string, PendingChange> pending;
+    bool overflowed = false;
+};
+} // portal
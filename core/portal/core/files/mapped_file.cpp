@@ -0,0 +1,40 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "mapped_file.h"
+
+#include <utility>
+
+namespace portal
+{
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    data(std::exchange(other.data, nullptr)),
+    size(std::exchange(other.size, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    unmap();
+    data = std::exchange(other.data, nullptr);
+    size = std::exchange(other.size, 0);
+    return *this;
+}
+
+Buffer MappedFile::get_buffer(const size_t offset, const size_t length) const
+{
+    if (offset > size || length > size - offset)
+        return {};
+
+    return Buffer{static_cast<const std::byte*>(data) + offset, length};
+}
+} // portal
@@ -0,0 +1,59 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <filesystem>
+
+#include "portal/core/buffer.h"
+
+namespace portal
+{
+/**
+ * @brief A whole file mapped read only into memory.
+ *
+ * Pages are read from disk by the OS the first time they are touched, so opening a large file is as cheap as opening
+ * a small one, and untouched parts of the file are never read. Buffers returned by the mapping point straight into it,
+ * they must not outlive it.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Maps a file.
+     *
+     * @return The mapping, invalid if the file cannot be opened or is empty
+     */
+    static MappedFile open(const std::filesystem::path& path);
+
+    [[nodiscard]] bool is_valid() const { return data != nullptr; }
+    [[nodiscard]] size_t get_size() const { return size; }
+
+    /**
+     * @brief Returns a non owning buffer of the whole file.
+     */
+    [[nodiscard]] Buffer get_buffer() const { return Buffer{data, size}; }
+
+    /**
+     * @brief Returns a non owning buffer of a part of the file, or an empty buffer if the range is out of the file.
+     */
+    [[nodiscard]] Buffer get_buffer(size_t offset, size_t length) const;
+
+private:
+    void unmap();
+
+    const void* data = nullptr;
+    size_t size = 0;
+};
+} // portal
@@ -7,7 +7,7 @@
 
 #include <map>
 #include <memory_resource>
-#include <stdexcept>
+#include <mutex>
 
 #include "portal/core/log.h"
 
@@ -17,22 +17,23 @@ std::string_view StringRegistry::store(uint64_t id, const std::string_view strin
 {
     auto& entries = get_entries();
 
-    const auto it = entries.find(id);
-    if (it != entries.end())
-        return it->second;
-
-    // Saves a copy of the string in memory
-    const auto& [added_it, success] = entries.emplace(id, std::pmr::string(string, get_allocator()));
-
-    if (!success)
-        throw std::runtime_error("Failed to store string in StringIdPool");
+    {
+        std::shared_lock guard(get_mutex());
+        const auto it = entries.find(id);
+        if (it != entries.end())
+            return it->second;
+    }
 
+    std::unique_lock guard(get_mutex());
+    // Saves a copy of the string in memory, unless another thread stored it since the lookup
+    const auto& [added_it, _] = entries.try_emplace(id, string, get_allocator());
     return std::string_view(added_it->second);
 }
 
 std::string_view StringRegistry::find(const uint64_t id)
 {
     auto& entries = get_entries();
+    std::shared_lock guard(get_mutex());
     const auto it = entries.find(id);
     if (it != entries.end())
         return it->second;
@@ -41,6 +42,7 @@ std::string_view StringRegistry::find(const uint64_t id)
 
 void StringRegistry::debug_print()
 {
+    std::shared_lock guard(get_mutex());
     for (auto& [id, string] : get_entries())
     {
         LOG_DEBUG_TAG("String Registry", "0x{:x} = \"{}\"", id, string);
@@ -60,4 +62,10 @@ std::pmr::unordered_map<uint64_t, std::pmr::string>& StringRegistry::get_entries
     static std::pmr::unordered_map<uint64_t, std::pmr::string> entries{get_allocator()};
     return entries;
 }
+
+std::shared_mutex& StringRegistry::get_mutex()
+{
+    static std::shared_mutex mutex;
+    return mutex;
+}
 } // portal
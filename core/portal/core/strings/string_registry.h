@@ -6,6 +6,7 @@
 #pragma once
 
 #include <memory_resource>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -40,13 +41,10 @@ constexpr auto INVALID_STRING_VIEW = std::string_view("Invalid");
  * monotonic buffer avoids allocation fragmentation and deallocation overhead.
  *
  * Thread Safety:
- * NOT thread-safe. String registration (store()) and lookup (find()) are not
- * protected by locks. However, this is typically acceptable because:
- * - Most string registration happens during initialization (single-threaded)
- * - Compile-time STRING_ID() macros don't use the registry at all
- * - Runtime StringId construction is usually at load time, not hot paths
- *
- * If concurrent access is required, external synchronization must be used.
+ * Thread-safe. Lookups (find(), and store() of a string that is already registered)
+ * take a shared lock, only registering a new string takes an exclusive lock. Runtime
+ * StringIds are created from jobs (e.g. parsing resource metadata in parallel), while
+ * compile-time STRING_ID() macros don't use the registry at all.
  *
  * Usage:
  * You rarely call StringRegistry methods directly - StringId constructors handle
@@ -90,5 +88,6 @@ public:
 private:
     static std::pmr::memory_resource* get_allocator();
     static std::pmr::unordered_map<uint64_t, std::pmr::string>& get_entries();
+    static std::shared_mutex& get_mutex();
 };
 } // portal
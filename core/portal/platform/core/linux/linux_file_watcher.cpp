@@ -0,0 +1,167 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "portal/core/files/file_watcher.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "portal/core/log.h"
+
+namespace portal
+{
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+struct FileWatcher::NativeWatcher
+{
+    int fd = -1;
+    // Watch descriptor to the watched directory, relative to the root
+    std::unordered_map<int, std::filesystem::path> directories;
+
+    bool add_watch(const std::filesystem::path& root, const std::filesystem::path& relative_path)
+    {
+        const auto path = (root / relative_path).lexically_normal();
+        const int wd = inotify_add_watch(fd, path.c_str(), WATCH_MASK);
+        if (wd < 0)
+        {
+            LOG_WARN_TAG("Filesystem", "Failed to watch {}: {}", path.generic_string(), std::strerror(errno));
+            return false;
+        }
+
+        directories[wd] = relative_path;
+        return true;
+    }
+};
+
+FileWatcher::FileWatcher(std::filesystem::path root, const Clock::duration settle_time) : root(std::move(root)), settle_time(settle_time) {}
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+bool FileWatcher::start()
+{
+    if (native)
+        return true;
+
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to initialize inotify: {}", std::strerror(errno));
+        return false;
+    }
+
+    native = std::make_unique<NativeWatcher>();
+    native->fd = fd;
+    if (!native->add_watch(root, {}))
+    {
+        stop();
+        return false;
+    }
+
+    // inotify is not recursive, every directory in the tree has a watch of its own
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+    {
+        if (it->is_directory())
+            native->add_watch(root, it->path().lexically_relative(root));
+    }
+
+    LOG_DEBUG_TAG("Filesystem", "Watching {} directories in {}", native->directories.size(), root.generic_string());
+    return true;
+}
+
+void FileWatcher::stop()
+{
+    if (!native)
+        return;
+
+    close(native->fd);
+    native.reset();
+    pending.clear();
+}
+
+bool FileWatcher::is_watching() const
+{
+    return native != nullptr;
+}
+
+void FileWatcher::read_events()
+{
+    if (!native)
+        return;
+
+    const auto now = Clock::now();
+    alignas(inotify_event) std::array<char, 16 * 1024> buffer;
+    while (true)
+    {
+        const auto length = read(native->fd, buffer.data(), buffer.size());
+        if (length <= 0)
+        {
+            if (length < 0 && errno != EAGAIN && errno != EINTR)
+                LOG_ERROR_TAG("Filesystem", "Failed to read file events: {}", std::strerror(errno));
+            return;
+        }
+
+        for (auto* data = buffer.data(); data < buffer.data() + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(data);
+            data += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                overflowed = true;
+                continue;
+            }
+
+            if (event->mask & IN_IGNORED)
+            {
+                native->directories.erase(event->wd);
+                continue;
+            }
+
+            const auto directory = native->directories.find(event->wd);
+            if (directory == native->directories.end() || event->len == 0)
+                continue;
+
+            const auto path = directory->second / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    // Files created before the watch was added have no events, they are reported here instead
+                    native->add_watch(root, path);
+                    std::error_code error;
+                    for (auto it = std::filesystem::recursive_directory_iterator(root / path, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+                    {
+                        const auto relative_path = it->path().lexically_relative(root);
+                        if (it->is_directory())
+                            native->add_watch(root, relative_path);
+                        else if (it->is_regular_file())
+                            record(relative_path, FileChangeType::Added, now);
+                    }
+                }
+                else if (event->mask & IN_MOVED_FROM)
+                {
+                    // The files of a directory moved out of the tree get no events of their own
+                    overflowed = true;
+                }
+                continue;
+            }
+
+            if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                record(path, FileChangeType::Added, now);
+            else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                record(path, FileChangeType::Removed, now);
+            else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+                record(path, FileChangeType::Modified, now);
+        }
+    }
+}
+} // portal
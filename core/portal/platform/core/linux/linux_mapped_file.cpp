@@ -0,0 +1,62 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "portal/core/files/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "portal/core/log.h"
+
+namespace portal
+{
+MappedFile MappedFile::open(const std::filesystem::path& path)
+{
+    MappedFile file;
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to open {}: {}", path.generic_string(), std::strerror(errno));
+        return file;
+    }
+
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        close(fd);
+        return file;
+    }
+
+    const auto size = static_cast<size_t>(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to map {}: {}", path.generic_string(), std::strerror(errno));
+        return file;
+    }
+
+    file.data = data;
+    file.size = size;
+    return file;
+}
+
+void MappedFile::unmap()
+{
+    if (!data)
+        return;
+
+    munmap(const_cast<void*>(data), size);
+    data = nullptr;
+    size = 0;
+}
+} // portal
@@ -0,0 +1,38 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "portal/core/files/file_watcher.h"
+
+#include "portal/core/log.h"
+
+namespace portal
+{
+// TODO: implement with FSEvents
+struct FileWatcher::NativeWatcher
+{
+};
+
+FileWatcher::FileWatcher(std::filesystem::path root, const Clock::duration settle_time) : root(std::move(root)), settle_time(settle_time) {}
+
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::start()
+{
+    LOG_WARN_TAG("Filesystem", "Watching {} is not supported on macOS", root.generic_string());
+    return false;
+}
+
+void FileWatcher::stop()
+{
+    pending.clear();
+}
+
+bool FileWatcher::is_watching() const
+{
+    return false;
+}
+
+void FileWatcher::read_events() {}
+} // portal
@@ -0,0 +1,71 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "portal/core/files/mapped_file.h"
+
+#include <Windows.h>
+
+#include "portal/core/log.h"
+
+namespace portal
+{
+MappedFile MappedFile::open(const std::filesystem::path& path)
+{
+    MappedFile file;
+
+    const HANDLE file_handle = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to open {}: {}", path.generic_string(), GetLastError());
+        return file;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file_handle);
+        return file;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file_handle);
+    if (!mapping)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to map {}: {}", path.generic_string(), GetLastError());
+        return file;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    // The view keeps its own reference to the mapping
+    CloseHandle(mapping);
+    if (!data)
+    {
+        LOG_ERROR_TAG("Filesystem", "Failed to map {}: {}", path.generic_string(), GetLastError());
+        return file;
+    }
+
+    file.data = data;
+    file.size = static_cast<size_t>(file_size.QuadPart);
+    return file;
+}
+
+void MappedFile::unmap()
+{
+    if (!data)
+        return;
+
+    UnmapViewOfFile(data);
+    data = nullptr;
+    size = 0;
+}
+} // portal
@@ -0,0 +1,75 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/core/files/file_watcher.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("File watcher coalescing", "[file_watcher]")
+{
+    portal::FileWatcher watcher("root", 100ms);
+    const auto start = portal::FileWatcher::Clock::now();
+
+    SECTION("Changes are reported once they settle")
+    {
+        watcher.record("a.png", portal::FileChangeType::Modified, start);
+        watcher.record("a.png", portal::FileChangeType::Modified, start + 50ms);
+
+        REQUIRE(watcher.take_settled(start + 100ms).empty());
+
+        const auto changes = watcher.take_settled(start + 150ms);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].path == "a.png");
+        REQUIRE(changes[0].type == portal::FileChangeType::Modified);
+
+        REQUIRE(watcher.take_settled(start + 1s).empty());
+    }
+
+    SECTION("Replacing a file is a modification")
+    {
+        watcher.record("a.png", portal::FileChangeType::Removed, start);
+        watcher.record("a.png", portal::FileChangeType::Added, start);
+        watcher.record("a.png", portal::FileChangeType::Modified, start);
+
+        const auto changes = watcher.take_settled(start + 100ms);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].type == portal::FileChangeType::Modified);
+    }
+
+    SECTION("A created file is added, even if it was written to")
+    {
+        watcher.record("a.png", portal::FileChangeType::Added, start);
+        watcher.record("a.png", portal::FileChangeType::Modified, start);
+
+        const auto changes = watcher.take_settled(start + 100ms);
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes[0].type == portal::FileChangeType::Added);
+    }
+
+    SECTION("A temporary file is not reported")
+    {
+        watcher.record("a.png.tmp", portal::FileChangeType::Added, start);
+        watcher.record("a.png.tmp", portal::FileChangeType::Modified, start);
+        watcher.record("a.png.tmp", portal::FileChangeType::Removed, start);
+
+        REQUIRE(watcher.take_settled(start + 100ms).empty());
+    }
+
+    SECTION("Removed files are reported")
+    {
+        watcher.record("b.png", portal::FileChangeType::Modified, start);
+        watcher.record("b.png", portal::FileChangeType::Removed, start);
+        watcher.record("a.png", portal::FileChangeType::Removed, start);
+
+        const auto changes = watcher.take_settled(start + 100ms);
+        REQUIRE(changes.size() == 2);
+        REQUIRE(changes[0].path == "a.png");
+        REQUIRE(changes[0].type == portal::FileChangeType::Removed);
+        REQUIRE(changes[1].path == "b.png");
+        REQUIRE(changes[1].type == portal::FileChangeType::Removed);
+    }
+}
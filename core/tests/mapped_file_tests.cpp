@@ -0,0 +1,57 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <cstring>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/core/files/mapped_file.h"
+
+TEST_CASE("Mapped file", "[mapped_file]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "portal_mapped_file_test.bin";
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output << "hello mapped file";
+    }
+
+    SECTION("The mapping holds the file content")
+    {
+        const auto file = portal::MappedFile::open(path);
+        REQUIRE(file.is_valid());
+        REQUIRE(file.get_size() == 17);
+        REQUIRE(std::memcmp(file.get_buffer().data, "hello mapped file", 17) == 0);
+
+        const auto part = file.get_buffer(6, 6);
+        REQUIRE(part.size == 6);
+        REQUIRE(std::memcmp(part.data, "mapped", 6) == 0);
+        REQUIRE_FALSE(part.is_allocated());
+    }
+
+    SECTION("Ranges out of the file are empty")
+    {
+        const auto file = portal::MappedFile::open(path);
+        REQUIRE_FALSE(file.get_buffer(12, 6));
+        REQUIRE_FALSE(file.get_buffer(18, 0));
+        REQUIRE(file.get_buffer(17, 0).size == 0);
+    }
+
+    SECTION("Moving a mapping transfers it")
+    {
+        auto file = portal::MappedFile::open(path);
+        const auto moved = std::move(file);
+        REQUIRE_FALSE(file.is_valid());
+        REQUIRE(moved.is_valid());
+        REQUIRE(moved.get_size() == 17);
+    }
+
+    SECTION("Missing files cannot be mapped")
+    {
+        REQUIRE_FALSE(portal::MappedFile::open(path.parent_path() / "portal_mapped_file_missing.bin").is_valid());
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,90 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/core/glm.h"
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/culling/bounding_volume_hierarchy.h"
+#include "portal/engine/renderer/culling/frustum.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t INSTANCE_COUNT = 128'000;
+constexpr float WORLD_SIZE = 1000.f;
+
+std::vector<renderer::BoundingBox> make_boxes(std::mt19937& random)
+{
+    std::uniform_real_distribution position(-WORLD_SIZE / 2.f, WORLD_SIZE / 2.f);
+    std::uniform_real_distribution size(0.5f, 4.f);
+
+    std::vector<renderer::BoundingBox> boxes;
+    boxes.reserve(INSTANCE_COUNT);
+    for (size_t i = 0; i < INSTANCE_COUNT; ++i)
+        boxes.push_back({{position(random), position(random) / 10.f, position(random)}, glm::vec3{size(random)}});
+    return boxes;
+}
+}
+
+void run_culling_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    // Fixed seed, so every run culls the same scene
+    std::mt19937 random(42);
+    auto boxes = make_boxes(random);
+
+    // A camera in the middle of the scene looking along one axis, roughly a sixth of the boxes are visible
+    const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, WORLD_SIZE / 2.f);
+    const auto view = glm::lookAt(glm::vec3{0.f, 10.f, 0.f}, glm::vec3{0.f, 10.f, 1.f}, glm::vec3{0.f, 1.f, 0.f});
+    const renderer::Frustum frustum(projection * view);
+
+    const auto name = fmt::format("culling_{}k", INSTANCE_COUNT / 1000);
+    renderer::BoundingVolumeHierarchy bvh;
+
+    runner.run(fmt::format("{}/build", name), 0, [&] { bvh.build(boxes); });
+
+    // Moves every box slightly, the refit cost does not depend on how far they move
+    runner.run(
+        fmt::format("{}/refit", name),
+        0,
+        [&]
+        {
+            for (auto& box : boxes)
+                box.center.y += 0.01f;
+            bvh.refit(boxes);
+        }
+    );
+
+    std::vector<uint32_t> visible;
+    visible.reserve(INSTANCE_COUNT);
+
+    runner.run(fmt::format("{}/cull_serial", name), 0, [&] { bvh.cull(frustum, visible); });
+
+    jobs::Scheduler scheduler(0);
+    runner.run(fmt::format("{}/cull_parallel", name), 0, [&] { bvh.cull(frustum, scheduler, visible); });
+
+    // Baseline, every box tested against the frustum
+    runner.run(
+        fmt::format("{}/brute_force", name),
+        0,
+        [&]
+        {
+            visible.clear();
+            for (uint32_t i = 0; i < boxes.size(); ++i)
+            {
+                if (frustum.test(boxes[i]) != renderer::Visibility::Outside)
+                    visible.push_back(i);
+            }
+        }
+    );
+}
+} // portal
@@ -0,0 +1,111 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/core/debug/benchmark.h"
+#include "portal/engine/renderer/draw_list.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t DRAW_COUNT = 100'000;
+constexpr uint16_t PIPELINE_COUNT = 8;
+constexpr uint16_t MATERIAL_COUNT = 256;
+constexpr uint16_t INDEX_BUFFER_COUNT = 1024;
+
+std::vector<uint64_t> make_keys(std::mt19937& random)
+{
+    std::vector<uint64_t> keys;
+    keys.reserve(DRAW_COUNT);
+    for (size_t i = 0; i < DRAW_COUNT; ++i)
+    {
+        keys.push_back(
+            renderer::DrawKey::make(
+                static_cast<uint16_t>(random() % PIPELINE_COUNT),
+                static_cast<uint16_t>(random() % MATERIAL_COUNT),
+                static_cast<uint16_t>(random() % INDEX_BUFFER_COUNT),
+                static_cast<uint16_t>(random())
+            )
+        );
+    }
+    return keys;
+}
+}
+
+void run_draw_list_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    // Fixed seed, so every run sorts the same draws
+    std::mt19937 random(42);
+    const auto keys = make_keys(random);
+
+    const auto name = fmt::format("draw_list_{}k", DRAW_COUNT / 1000);
+
+    renderer::DrawList draw_list;
+    draw_list.reserve(DRAW_COUNT);
+    runner.run(
+        fmt::format("{}/build", name),
+        0,
+        [&]
+        {
+            draw_list.clear();
+            for (uint32_t i = 0; i < keys.size(); ++i)
+                draw_list.add(keys[i], i);
+            draw_list.build();
+        }
+    );
+
+    std::vector<uint64_t> sorted_keys;
+    std::vector<uint32_t> objects(DRAW_COUNT);
+    std::vector<uint64_t> key_scratch;
+    std::vector<uint32_t> object_scratch;
+    runner.run(
+        fmt::format("{}/radix_sort", name),
+        0,
+        [&]
+        {
+            sorted_keys = keys;
+            for (uint32_t i = 0; i < objects.size(); ++i)
+                objects[i] = i;
+            renderer::radix_sort(sorted_keys, objects, key_scratch, object_scratch);
+        }
+    );
+
+    // Baseline, a comparison sort of (key, object) pairs
+    std::vector<std::pair<uint64_t, uint32_t>> pairs;
+    runner.run(
+        fmt::format("{}/std_sort", name),
+        0,
+        [&]
+        {
+            pairs.clear();
+            for (uint32_t i = 0; i < keys.size(); ++i)
+                pairs.emplace_back(keys[i], i);
+            std::ranges::sort(pairs);
+        }
+    );
+
+    // Baseline, the per material hash map of index vectors the renderer used to build every frame
+    runner.run(
+        fmt::format("{}/material_hash_map", name),
+        0,
+        [&]
+        {
+            std::unordered_map<uint16_t, std::vector<uint32_t>> by_material;
+            by_material.reserve(MATERIAL_COUNT);
+            for (uint32_t i = 0; i < keys.size(); ++i)
+                by_material[renderer::DrawKey::get_material(keys[i])].push_back(i);
+        }
+    );
+}
+} // portal
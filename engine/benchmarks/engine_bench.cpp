@@ -0,0 +1,44 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <fstream>
+#include <iostream>
+
+#include "engine_benchmarks.h"
+
+PORTAL_BENCHMARK_TRACK_ALLOCATIONS()
+
+using namespace portal;
+
+/**
+ * Usage: portal-engine-bench [output.json]
+ *
+ * Prints a summary to stderr and the results as JSON to stdout, or to `output.json` if given.
+ */
+int main(const int argc, char** argv)
+{
+    benchmark::BenchmarkRunner runner("portal-engine");
+
+    run_transform_hierarchy_benchmarks(runner);
+    run_name_index_benchmarks(runner);
+    run_culling_benchmarks(runner);
+    run_draw_list_benchmarks(runner);
+    run_light_cluster_benchmarks(runner);
+    run_prefab_benchmarks(runner);
+    run_shader_compile_benchmarks(runner);
+    run_resource_database_benchmarks(runner);
+
+    if (argc > 1)
+    {
+        std::ofstream output(argv[1]);
+        runner.write_json(output);
+    }
+    else
+    {
+        runner.write_json(std::cout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include "portal/core/debug/benchmark.h"
+
+namespace portal
+{
+void run_transform_hierarchy_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_name_index_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_culling_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_draw_list_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_light_cluster_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_prefab_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_shader_compile_benchmarks(benchmark::BenchmarkRunner& runner);
+void run_resource_database_benchmarks(benchmark::BenchmarkRunner& runner);
+} // portal
@@ -0,0 +1,72 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "portal/core/glm.h"
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/lighting/light_clusters.h"
+
+namespace portal
+{
+namespace
+{
+constexpr float NEAR_DEPTH = 0.1f;
+constexpr float FAR_DEPTH = 1000.f;
+
+std::vector<renderer::LightBounds> make_lights(std::mt19937& random, const size_t count)
+{
+    // Lights spread in front of the camera, most of them close enough to touch several clusters
+    std::uniform_real_distribution<float> lateral(-100.f, 100.f);
+    std::uniform_real_distribution<float> depth(1.f, 200.f);
+    std::uniform_real_distribution<float> radius(1.f, 15.f);
+
+    std::vector<renderer::LightBounds> lights;
+    lights.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        lights.push_back({{lateral(random), lateral(random), -depth(random)}, radius(random)});
+    return lights;
+}
+}
+
+void run_light_cluster_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, NEAR_DEPTH, FAR_DEPTH);
+
+    jobs::Scheduler scheduler(0);
+
+    runner.run(
+        "light_clusters/configure",
+        0,
+        [&]
+        {
+            // A fresh grid, so the bounds are recomputed every iteration
+            renderer::LightClusterGrid grid;
+            grid.configure(projection, NEAR_DEPTH, FAR_DEPTH);
+        }
+    );
+
+    for (const size_t light_count : {1024uz, 4096uz})
+    {
+        // Fixed seed, so every run bins the same lights
+        std::mt19937 random(42);
+        const auto lights = make_lights(random, light_count);
+
+        renderer::LightClusterGrid grid;
+        grid.configure(projection, NEAR_DEPTH, FAR_DEPTH);
+
+        const auto name = fmt::format("light_clusters_{}", light_count);
+        runner.run(fmt::format("{}/assign_serial", name), 0, [&] { grid.assign(lights); });
+        runner.run(fmt::format("{}/assign_parallel", name), 0, [&] { grid.assign(lights, scheduler); });
+    }
+}
+} // portal
@@ -0,0 +1,106 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/engine/components/base.h"
+#include "portal/engine/ecs/registry.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t ENTITY_COUNT = 100'000;
+constexpr size_t LOOKUP_COUNT = 10'000;
+
+// Names are registered once up front, so the string registry is not part of the measurements
+std::vector<StringId> make_names()
+{
+    std::vector<StringId> names;
+    names.reserve(ENTITY_COUNT);
+    for (size_t i = 0; i < ENTITY_COUNT; ++i)
+    {
+        const auto name = fmt::format("entity_{}", i);
+        names.push_back(STRING_ID(name));
+    }
+    return names;
+}
+}
+
+void run_name_index_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    const auto names = make_names();
+    const auto name = fmt::format("name_index_{}k", ENTITY_COUNT / 1000);
+
+    runner.run(
+        fmt::format("{}/create_named", name),
+        0,
+        [&]
+        {
+            ModuleStack stack;
+            auto& registry = stack.add_module<ecs::Registry>();
+            for (const auto& entity_name : names)
+                benchmark::do_not_optimize(registry.create_entity(entity_name));
+        }
+    );
+
+    ModuleStack stack;
+    auto& registry = stack.add_module<ecs::Registry>();
+    for (const auto& entity_name : names)
+        registry.create_entity(entity_name);
+
+    // Fixed seed, so every run looks up the same entities
+    std::mt19937 random(42);
+
+    runner.run(
+        fmt::format("{}/find_by_name_{}k", name, LOOKUP_COUNT / 1000),
+        0,
+        [&]
+        {
+            for (size_t i = 0; i < LOOKUP_COUNT; ++i)
+                benchmark::do_not_optimize(registry.find_by_name(names[random() % names.size()]));
+        }
+    );
+
+    runner.run(
+        fmt::format("{}/find_or_create_existing_{}k", name, LOOKUP_COUNT / 1000),
+        0,
+        [&]
+        {
+            for (size_t i = 0; i < LOOKUP_COUNT; ++i)
+                benchmark::do_not_optimize(registry.find_or_create(names[random() % names.size()]));
+        }
+    );
+
+    runner.run(
+        fmt::format("{}/rename_1k", name),
+        0,
+        [&]
+        {
+            auto& raw_registry = registry.get_raw_registry();
+            for (size_t i = 0; i < 1'000; ++i)
+            {
+                const auto first = registry.find_by_name(names[random() % names.size()]);
+                const auto second = registry.find_by_name(names[random() % names.size()]);
+                if (!first || !second || *first == *second)
+                    continue;
+
+                // Swap the two names, so the set of names stays the same between iterations
+                const auto first_name = first->get_component<NameComponent>().name;
+                const auto second_name = second->get_component<NameComponent>().name;
+                raw_registry.replace<NameComponent>(first->get_id(), second_name);
+                raw_registry.replace<NameComponent>(second->get_id(), first_name);
+            }
+        }
+    );
+}
+} // portal
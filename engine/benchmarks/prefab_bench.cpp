@@ -0,0 +1,96 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/glm.h"
+#include "portal/core/debug/benchmark.h"
+#include "portal/engine/components/relationship.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/prefab.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/systems/transform_hierarchy_system.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t INSTANCE_COUNT = 10'000;
+
+// A prop with two attached parts, every node has a transform
+ecs::Prefab make_prop()
+{
+    ecs::Prefab prop;
+    prop.set_component(ecs::Prefab::ROOT, TransformComponent{});
+    for (const float offset : {1.f, 2.f})
+    {
+        const auto part = prop.add_node(ecs::Prefab::ROOT);
+        prop.set_component(part, TransformComponent{glm::vec3{0.f, offset, 0.f}});
+    }
+    return prop;
+}
+
+std::vector<glm::mat4> make_transforms()
+{
+    std::vector<glm::mat4> transforms;
+    transforms.reserve(INSTANCE_COUNT);
+    for (size_t i = 0; i < INSTANCE_COUNT; ++i)
+        transforms.push_back(glm::translate(glm::mat4(1.f), glm::vec3{static_cast<float>(i % 100), 0.f, static_cast<float>(i / 100)}));
+    return transforms;
+}
+}
+
+void run_prefab_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    ModuleStack stack;
+    auto& registry = stack.add_module<ecs::Registry>();
+
+    TransformHierarchySystem transform_system;
+    transform_system.register_to(registry);
+
+    const auto prop = make_prop();
+    const auto transforms = make_transforms();
+    const auto name = fmt::format("prefab_{}k_instances", INSTANCE_COUNT / 1000);
+
+    // Both cases clear the registry first, so they spawn into the same (empty but allocated) storage
+    runner.run(
+        fmt::format("{}/spawn_bulk", name),
+        0,
+        [&]
+        {
+            registry.clear();
+            registry.spawn_bulk(prop, INSTANCE_COUNT, transforms);
+        }
+    );
+
+    // Baseline, the entity by entity construction scenes used before
+    runner.run(
+        fmt::format("{}/create_entity", name),
+        0,
+        [&]
+        {
+            registry.clear();
+            for (const auto& transform : transforms)
+            {
+                auto root = registry.create_child_entity(null_entity);
+                root.add_component<TransformComponent>(transform);
+                for (const float offset : {1.f, 2.f})
+                {
+                    auto part = registry.create_child_entity(root);
+                    part.add_component<TransformComponent>(glm::vec3{0.f, offset, 0.f});
+                }
+            }
+        }
+    );
+
+    registry.clear();
+    transform_system.unregister_from(registry);
+}
+} // portal
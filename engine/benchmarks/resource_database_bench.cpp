@@ -0,0 +1,118 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/resources/cook/pack_builder.h"
+#include "portal/engine/resources/database/folder_resource_database.h"
+#include "portal/engine/resources/database/pack_resource_database.h"
+#include "portal/engine/resources/source/resource_source.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t RESOURCE_COUNT = 2'000;
+constexpr size_t RESOURCES_PER_FOLDER = 100;
+constexpr size_t RESOURCE_SIZE = 4 * 1024;
+
+std::string make_resource_id(const size_t i)
+{
+    return fmt::format("bench/shaders/{}/shader_{}", i / RESOURCES_PER_FOLDER, i);
+}
+
+// Shaders have no metadata to enrich, the folder database is opened without decoding any of the files
+void make_folder_database(const std::filesystem::path& root_path)
+{
+    std::filesystem::remove_all(root_path);
+    std::filesystem::create_directories(root_path);
+
+    {
+        std::ofstream output(root_path / fmt::format("root{}", FolderResourceDatabase::DATABASE_METADATA_EXTENSION));
+        output << fmt::format(
+            R"({{"dirty": 0, "ignored_extensions": [], "ignored_files": [], "name": "bench", "resource_count": {}, "version": 1}})",
+            RESOURCE_COUNT
+        );
+    }
+
+    for (size_t i = 0; i < RESOURCE_COUNT; ++i)
+    {
+        const auto path = root_path / fmt::format("shaders/{}/shader_{}.slang", i / RESOURCES_PER_FOLDER, i);
+        std::filesystem::create_directories(path.parent_path());
+
+        std::ofstream output(path, std::ios::binary);
+        const auto line = fmt::format("float4 value_{} = float4({}, 0.5, 0.25, 1.0);\n", i, i);
+        for (size_t written = 0; written < RESOURCE_SIZE; written += line.size())
+            output << line;
+    }
+}
+}
+
+void run_resource_database_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    const auto root_path = std::filesystem::temp_directory_path() / "portal_resource_database_bench";
+    const auto pack_path = root_path.parent_path() / "portal_resource_database_bench.ppak";
+    const auto stored_pack_path = root_path.parent_path() / "portal_resource_database_bench_stored.ppak";
+
+    // The first open writes the metadata of every resource and the index, every open after it reads the index
+    make_folder_database(root_path);
+    {
+        jobs::Scheduler scheduler(-1);
+        resources::PackBuilder builder(scheduler);
+        const auto database = FolderResourceDatabase::open(root_path);
+        builder.build(*database, pack_path);
+        builder.build(*database, stored_pack_path, {.compress = false});
+    }
+
+    std::vector<StringId> resource_ids;
+    resource_ids.reserve(RESOURCE_COUNT);
+    for (size_t i = 0; i < RESOURCE_COUNT; ++i)
+        resource_ids.push_back(STRING_ID(make_resource_id(i)));
+
+    const auto name = fmt::format("resource_database_{}k", RESOURCE_COUNT / 1000);
+
+    // Databases are kept open until the case is done, so closing them is not measured. The files were just written, so
+    // every case reads them from the page cache, cold opens are not measured here
+    std::vector<std::unique_ptr<ResourceDatabase>> opened;
+    runner.run(fmt::format("{}/open_folder_warm", name), 0, [&] { opened.push_back(FolderResourceDatabase::open(root_path)); });
+    opened.clear();
+    runner.run(fmt::format("{}/open_pack_warm", name), 0, [&] { opened.push_back(PackResourceDatabase::open(pack_path)); });
+    opened.clear();
+
+    const auto read_all = [&resource_ids](ResourceDatabase& database)
+    {
+        for (const auto& resource_id : resource_ids)
+        {
+            const auto meta = database.find(resource_id);
+            const auto source = database.create_source(resource_id, meta.value());
+            benchmark::do_not_optimize(source->load());
+        }
+    };
+
+    {
+        const auto folder = FolderResourceDatabase::open(root_path);
+        runner.run(fmt::format("{}/read_folder", name), RESOURCE_COUNT * RESOURCE_SIZE, [&] { read_all(*folder); });
+
+        // Stored data is handed out straight from the mapping
+        const auto stored_pack = PackResourceDatabase::open(stored_pack_path);
+        runner.run(fmt::format("{}/read_pack_stored", name), RESOURCE_COUNT * RESOURCE_SIZE, [&] { read_all(*stored_pack); });
+
+        const auto pack = PackResourceDatabase::open(pack_path);
+        runner.run(fmt::format("{}/read_pack_compressed", name), RESOURCE_COUNT * RESOURCE_SIZE, [&] { read_all(*pack); });
+    }
+
+    std::filesystem::remove_all(root_path);
+    std::filesystem::remove(pack_path);
+    std::filesystem::remove(stored_pack_path);
+}
+} // portal
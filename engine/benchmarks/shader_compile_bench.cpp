@@ -0,0 +1,99 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <filesystem>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/shaders/shader_compile_service.h"
+
+namespace portal
+{
+namespace
+{
+// Self contained, so the benchmark does not depend on the engine resources being next to the binary
+constexpr std::string_view SHADER_SOURCE = R"(
+RWStructuredBuffer<float> output;
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    float value = float(id.x);
+#if USE_SQUARE
+    value = value * value;
+#endif
+#if USE_OFFSET
+    value += OFFSET;
+#endif
+    output[id.x] = value;
+}
+)";
+
+std::vector<renderer::ShaderCompiler::CompileRequest> make_requests()
+{
+    std::vector<renderer::ShaderCompiler::CompileRequest> requests;
+    for (const auto* use_square : {"0", "1"})
+    {
+        for (const auto* use_offset : {"0", "1"})
+        {
+            for (const auto* offset : {"1.0", "2.0"})
+            {
+                requests.push_back(
+                    {
+                        .name = STRING_ID("bench_compute"),
+                        .shader_path = std::filesystem::temp_directory_path() / "bench_compute.slang",
+                        .shader_data = Buffer{SHADER_SOURCE.data(), SHADER_SOURCE.size()},
+                        .defines = {{"USE_SQUARE", use_square}, {"USE_OFFSET", use_offset}, {"OFFSET", offset}},
+                    }
+                );
+            }
+        }
+    }
+    return requests;
+}
+}
+
+void run_shader_compile_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    const auto requests = make_requests();
+    const auto name = fmt::format("shader_compile_{}_permutations", requests.size());
+
+    // Baseline, every compile creates its own compiler and Slang global session
+    runner.run(
+        fmt::format("{}/fresh_compiler", name),
+        0,
+        [&]
+        {
+            for (const auto& request : requests)
+            {
+                renderer::ShaderCompiler compiler;
+                benchmark::do_not_optimize(compiler.compile(request));
+            }
+        }
+    );
+
+    // Services live across iterations, so their compilers are created once, in the warm up iteration
+    for (const int32_t workers : {0, -1})
+    {
+        jobs::Scheduler scheduler(workers);
+        renderer::ShaderCompileService service(scheduler);
+
+        runner.run(
+            fmt::format("{}/service_{}", name, workers == 0 ? "main_thread" : "all_workers"),
+            0,
+            [&]
+            {
+                benchmark::do_not_optimize(service.compile_all(requests));
+            }
+        );
+    }
+}
+} // portal
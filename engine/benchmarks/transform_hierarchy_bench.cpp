@@ -0,0 +1,198 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "engine_benchmarks.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/glm.h"
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/components/relationship.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/systems/transform_engine.h"
+#include "portal/engine/systems/transform_hierarchy_system.h"
+
+namespace portal
+{
+namespace
+{
+constexpr size_t ENTITY_COUNT = 100'000;
+constexpr size_t ROOT_COUNT = 1'000;
+constexpr size_t CHILDREN_PER_NODE = 4;
+
+// A forest of 4-ary trees, the first `ROOT_COUNT` entities are the roots and every other entity is attached breadth first
+std::vector<Entity> make_hierarchy(ecs::Registry& registry)
+{
+    std::vector<Entity> entities;
+    entities.reserve(ENTITY_COUNT);
+    for (size_t i = 0; i < ENTITY_COUNT; ++i)
+    {
+        const auto parent = i < ROOT_COUNT ? null_entity : entities[(i - ROOT_COUNT) / CHILDREN_PER_NODE];
+        auto entity = registry.create_child_entity(parent, INVALID_STRING_ID);
+        entity.add_component<TransformComponent>(glm::vec3{static_cast<float>(i % 100), 1.f, 0.f});
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+void move_entities(ecs::Registry& registry, const std::vector<Entity>& entities, std::mt19937& random, const size_t count)
+{
+    auto& raw_registry = registry.get_raw_registry();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto entity = entities[random() % entities.size()];
+        raw_registry.patch<TransformComponent>(
+            entity.get_id(),
+            [](TransformComponent& transform)
+            {
+                transform.set_translation(transform.get_translation() + glm::vec3{0.f, 0.01f, 0.f});
+            }
+        );
+    }
+}
+
+/**
+ * The per frame cost before the system became incremental: every transform sorted by a depth found by walking the
+ * parent chain, then every world matrix recomputed.
+ */
+void full_rebuild(ecs::Registry& registry, std::vector<entt::entity>& order)
+{
+    auto& raw_registry = registry.get_raw_registry();
+
+    auto get_depth = [&raw_registry](const entt::entity entity)
+    {
+        int depth = 0;
+        auto parent = raw_registry.get<RelationshipComponent>(entity).parent;
+        while (parent != null_entity)
+        {
+            parent = parent.get_component<RelationshipComponent>().parent;
+            ++depth;
+        }
+        return depth;
+    };
+
+    std::ranges::sort(
+        order,
+        [&get_depth](const entt::entity lhs, const entt::entity rhs)
+        {
+            const int left_depth = get_depth(lhs);
+            const int right_depth = get_depth(rhs);
+            if (left_depth != right_depth)
+                return left_depth < right_depth;
+            return lhs < rhs;
+        }
+    );
+
+    for (const auto entity : order)
+    {
+        const auto& relationship = raw_registry.get<RelationshipComponent>(entity);
+        auto parent_matrix = glm::mat4(1.0f);
+        if (relationship.parent != null_entity)
+            parent_matrix = relationship.parent.get_component<TransformComponent>().get_world_matrix();
+        raw_registry.get<TransformComponent>(entity).calculate_world_matrix(parent_matrix);
+    }
+}
+}
+
+void run_transform_hierarchy_benchmarks(benchmark::BenchmarkRunner& runner)
+{
+    ModuleStack stack;
+    auto& registry = stack.add_module<ecs::Registry>();
+
+    TransformHierarchySystem transform_system;
+    transform_system.register_to(registry);
+
+    const auto entities = make_hierarchy(registry);
+    transform_system.execute(registry);
+
+    // Fixed seed, so every run moves the same entities
+    std::mt19937 random(42);
+    const auto name = fmt::format("transform_hierarchy_{}k", ENTITY_COUNT / 1000);
+
+    runner.run(
+        fmt::format("{}/move_1pct", name),
+        0,
+        [&]
+        {
+            move_entities(registry, entities, random, ENTITY_COUNT / 100);
+            transform_system.execute(registry);
+        }
+    );
+
+    runner.run(
+        fmt::format("{}/move_all", name),
+        0,
+        [&]
+        {
+            move_entities(registry, entities, random, ENTITY_COUNT);
+            transform_system.execute(registry);
+        }
+    );
+
+    runner.run(
+        fmt::format("{}/reparent_100", name),
+        0,
+        [&]
+        {
+            // Roots have no ancestors, so moving an entity under a root never creates a cycle
+            for (size_t i = 0; i < 100; ++i)
+            {
+                const auto entity = entities[ROOT_COUNT + random() % (ENTITY_COUNT - ROOT_COUNT)];
+                entity.set_parent(entities[random() % ROOT_COUNT]);
+            }
+            transform_system.execute(registry);
+        }
+    );
+
+    std::vector<entt::entity> order;
+    order.reserve(entities.size());
+    for (const auto entity : entities)
+        order.push_back(entity.get_id());
+    // Shuffled once, matching a storage that was reordered by unrelated insertions and removals
+    std::ranges::shuffle(order, random);
+
+    runner.run(
+        fmt::format("{}/full_rebuild_sorted", name),
+        0,
+        [&]
+        {
+            move_entities(registry, entities, random, ENTITY_COUNT / 100);
+            full_rebuild(registry, order);
+            registry.get_raw_registry().clear<TransformDirtyTag>();
+        }
+    );
+
+    // The layout is built on the first update (the warmup), the hierarchy does not change after this point
+    jobs::Scheduler scheduler(0);
+    TransformEngine transform_engine;
+
+    runner.run(
+        fmt::format("{}/parallel_move_1pct", name),
+        0,
+        [&]
+        {
+            move_entities(registry, entities, random, ENTITY_COUNT / 100);
+            transform_engine.update(registry, scheduler);
+        }
+    );
+
+    runner.run(
+        fmt::format("{}/parallel_move_all", name),
+        0,
+        [&]
+        {
+            move_entities(registry, entities, random, ENTITY_COUNT);
+            transform_engine.update(registry, scheduler);
+        }
+    );
+}
+} // portal
@@ -11,6 +11,7 @@
 
 namespace portal
 {
+// Modify existing components through `patch_component`, the scene rendering system only refreshes its render objects on updates
 struct StaticMeshComponent
 {
     ResourceReference<MeshGeometry> mesh;
@@ -7,6 +7,7 @@
 #include <entt/entt.hpp>
 #include <glaze/reflection/get_name.hpp>
 
+#include "portal/engine/ecs/change_tracker.h"
 #include "portal/engine/ecs/entity.h"
 #include "portal/engine/ecs/registry.h"
 #include "portal/engine/resources/resource_registry.h"
@@ -49,6 +50,18 @@ namespace details
     };
 }
 
+/**
+ * @brief The id a component type is registered and serialized under.
+ *
+ * Created once when the component is registered, so serialization jobs only read it and never touch the string registry.
+ */
+template <typename T>
+const StringId& get_component_type_id()
+{
+    static const auto type_id = STRING_ID(glz::type_name<T>);
+    return type_id;
+}
+
 template <typename T>
 static void archive_component(Entity entity, ArchiveObject& archive, [[maybe_unused]] ecs::Registry& ecs_reg)
 {
@@ -134,7 +147,7 @@ static bool serialize_component(
     if (!entity.has_component<T>())
         return false;
 
-    serializer.add_value(STRING_ID(glz::type_name<T>));
+    serializer.add_value(get_component_type_id<T>());
     if constexpr (std::is_empty_v<T>)
     {
         // Tag components have no data to serialize, just mark presence
@@ -294,6 +307,21 @@ static void print(Entity entity)
     }
 }
 
+template <typename T>
+static void connect_change_tracker(entt::registry& raw_registry, ChangeTracker& tracker)
+{
+    raw_registry.on_construct<T>().template connect<&ChangeTracker::on_change>(&tracker);
+    raw_registry.on_update<T>().template connect<&ChangeTracker::on_change>(&tracker);
+    raw_registry.on_destroy<T>().template connect<&ChangeTracker::on_change>(&tracker);
+}
+
+template <typename T>
+static void disconnect_change_tracker(entt::registry& raw_registry, ChangeTracker& tracker)
+{
+    raw_registry.on_construct<T>().disconnect(&tracker);
+    raw_registry.on_update<T>().disconnect(&tracker);
+    raw_registry.on_destroy<T>().disconnect(&tracker);
+}
 
 template <typename T>
 void register_component()
@@ -301,15 +329,18 @@ void register_component()
     using namespace entt::literals;
     LOG_DEBUG_TAG("ECS", "Registering component {}", glz::type_name<T>);
 
+    const auto& type_id = get_component_type_id<T>();
     entt::meta_factory<T>()
-        .type(static_cast<entt::id_type>(STRING_ID(glz::type_name<T>).id), STRING_ID(glz::type_name<T>).string.data())
+        .type(static_cast<entt::id_type>(type_id.id), type_id.string.data())
         .template func<&archive_component<T>>(static_cast<entt::id_type>(STRING_ID("archive").id))
         .template func<&dearchive_component<T>>(static_cast<entt::id_type>(STRING_ID("dearchive").id))
         .template func<&serialize_component<T>>(static_cast<entt::id_type>(STRING_ID("serialize").id))
         .template func<&deserialize_component<T>>(static_cast<entt::id_type>(STRING_ID("deserialize").id))
         .template func<&post_serialization_pass<T>>(static_cast<entt::id_type>(STRING_ID("post_serialization").id))
         .template func<&print<T>>(static_cast<entt::id_type>(STRING_ID("print").id))
-        .template func<&find_dependencies<T>>(static_cast<entt::id_type>(STRING_ID("find_dependencies").id));
+        .template func<&find_dependencies<T>>(static_cast<entt::id_type>(STRING_ID("find_dependencies").id))
+        .template func<&connect_change_tracker<T>>(static_cast<entt::id_type>(STRING_ID("connect_change_tracker").id))
+        .template func<&disconnect_change_tracker<T>>(static_cast<entt::id_type>(STRING_ID("disconnect_change_tracker").id));
 }
 
 #define REGISTER_COMPONENT(ComponentType) \
@@ -21,6 +21,9 @@ struct RelationshipComponent
     // Parent
     Entity parent = null_entity;
 
+    // Distance from the hierarchy root, kept up to date by `Entity::set_parent` and `Entity::remove_child`
+    uint32_t depth = 0;
+
     void archive(ArchiveObject& archive) const;
     static RelationshipComponent dearchive(ArchiveObject& archive, Entity entity, ecs::Registry& ecs_reg);
 
@@ -13,6 +13,13 @@ namespace portal
 {
 struct TransformDirtyTag {};
 
+/**
+ * @brief Added by the transform hierarchy system to every entity whose world matrix was recomputed.
+ *
+ * Consumers that cache world matrices (such as the scene rendering system) refresh the tagged entities and clear the tag.
+ */
+struct WorldTransformChangedTag {};
+
 class TransformComponent
 {
 public:
@@ -0,0 +1,106 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "change_tracker.h"
+
+#include <entt/meta/resolve.hpp>
+
+#include "registry.h"
+#include "portal/core/debug/assert.h"
+#include "portal/engine/components/base.h"
+
+namespace portal::ecs
+{
+ChangeTracker::~ChangeTracker()
+{
+    detach();
+}
+
+void ChangeTracker::attach(Registry& ecs_registry)
+{
+    PORTAL_ASSERT(registry == nullptr, "Change tracker is already attached to a registry");
+    registry = &ecs_registry;
+
+    auto& raw_registry = ecs_registry.get_raw_registry();
+
+    // Names are not registered as a regular component, but renames still need to be tracked
+    raw_registry.on_construct<NameComponent>().connect<&ChangeTracker::on_name_change>(this);
+    raw_registry.on_update<NameComponent>().connect<&ChangeTracker::on_name_change>(this);
+    raw_registry.on_destroy<NameComponent>().connect<&ChangeTracker::on_name_change>(this);
+
+    for (auto&& [id, type] : entt::resolve())
+    {
+        type.invoke(
+            static_cast<entt::id_type>(STRING_ID("connect_change_tracker").id),
+            {},
+            entt::forward_as_meta(raw_registry),
+            entt::forward_as_meta(*this)
+        );
+    }
+}
+
+void ChangeTracker::detach()
+{
+    if (registry == nullptr)
+        return;
+
+    auto& raw_registry = registry->get_raw_registry();
+
+    raw_registry.on_construct<NameComponent>().disconnect(this);
+    raw_registry.on_update<NameComponent>().disconnect(this);
+    raw_registry.on_destroy<NameComponent>().disconnect(this);
+
+    for (auto&& [id, type] : entt::resolve())
+    {
+        type.invoke(
+            static_cast<entt::id_type>(STRING_ID("disconnect_change_tracker").id),
+            {},
+            entt::forward_as_meta(raw_registry),
+            entt::forward_as_meta(*this)
+        );
+    }
+
+    registry = nullptr;
+    clear();
+}
+
+std::vector<ChangeTracker::DirtyEntity> ChangeTracker::consume()
+{
+    std::lock_guard guard(lock);
+    std::vector<DirtyEntity> result;
+    result.reserve(dirty.size());
+    for (const auto& [entity, name] : dirty)
+    {
+        // Entities that are still alive are reported under their current name
+        auto& raw_registry = registry->get_raw_registry();
+        const auto* current = raw_registry.valid(entity) ? raw_registry.try_get<NameComponent>(entity) : nullptr;
+        result.emplace_back(entity, current ? current->name : name);
+    }
+
+    dirty.clear();
+    return result;
+}
+
+void ChangeTracker::clear()
+{
+    std::lock_guard guard(lock);
+    dirty.clear();
+}
+
+void ChangeTracker::on_change(entt::registry&, const entt::entity entity)
+{
+    std::lock_guard guard(lock);
+    dirty.try_emplace(entity, INVALID_STRING_ID);
+}
+
+void ChangeTracker::on_name_change(entt::registry& raw_registry, const entt::entity entity)
+{
+    // Keep the latest known name, on destruction the name component is still alive when the signal fires
+    const auto name = raw_registry.get<NameComponent>(entity).name;
+
+    std::lock_guard guard(lock);
+    dirty[entity] = name;
+}
+} // portal
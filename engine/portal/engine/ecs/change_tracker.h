@@ -0,0 +1,106 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entity/registry.hpp>
+
+#include "portal/core/strings/string_id.h"
+
+namespace portal::ecs
+{
+class Registry;
+
+/**
+ * @brief Records which entities were touched since the last time the changes were consumed.
+ *
+ * The tracker listens to EnTT's storage signals (construct, update and destroy) of every registered component type
+ * (see `register_component`) and of `NameComponent`. Only modifications that go through EnTT are observed, meaning
+ * `add_component`, `patch_component`, `remove_component` and entity destruction. Writing to a component through a
+ * reference returned by `get_component` is invisible to the tracker.
+ *
+ * The name of each dirty entity is captured while it is still alive, so destroyed entities can still be identified
+ * once their components are gone.
+ *
+ * The same listener is connected to every component type, so systems writing different components call it from
+ * different threads when the orchestrator runs them concurrently. Recording a change is therefore done under a lock,
+ * and only the `NameComponent` listener reads the name of the entity (systems writing names conflict with each other),
+ * the names of entities that are still alive are read when the changes are consumed.
+ *
+ * @par Example:
+ * @code
+ * ChangeTracker tracker;
+ * tracker.attach(registry);
+ *
+ * entity.patch_component<TransformComponent>([](auto& t) { t.set_translation({0, 1, 0}); });
+ *
+ * for (auto& [entity, name] : tracker.consume())
+ * {
+ *     // entity is either alive and modified, or was destroyed (check with registry.valid)
+ * }
+ * @endcode
+ */
+class ChangeTracker
+{
+public:
+    struct DirtyEntity
+    {
+        entt::entity entity;
+        StringId name;
+    };
+
+    ChangeTracker() = default;
+    ~ChangeTracker();
+
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+    ChangeTracker(ChangeTracker&&) = delete;
+    ChangeTracker& operator=(ChangeTracker&&) = delete;
+
+    /**
+     * @brief Connects the tracker to the storage signals of every registered component.
+     *
+     * @param ecs_registry The registry to track
+     */
+    void attach(Registry& ecs_registry);
+
+    /**
+     * @brief Disconnects the tracker from the registry it is attached to and drops any recorded changes.
+     */
+    void detach();
+
+    [[nodiscard]] bool is_attached() const { return registry != nullptr; }
+
+    /** @brief Number of entities touched since the last `consume` or `clear` */
+    [[nodiscard]] size_t dirty_count() const
+    {
+        std::lock_guard guard(lock);
+        return dirty.size();
+    }
+
+    /**
+     * @brief Returns every entity touched since the last call and resets the tracker.
+     */
+    [[nodiscard]] std::vector<DirtyEntity> consume();
+
+    /**
+     * @brief Drops every recorded change, used after bulk operations (e.g. loading a scene) that should not be tracked.
+     */
+    void clear();
+
+    void on_change(entt::registry& raw_registry, entt::entity entity);
+    void on_name_change(entt::registry& raw_registry, entt::entity entity);
+
+private:
+    Registry* registry = nullptr;
+
+    mutable std::mutex lock;
+    std::unordered_map<entt::entity, StringId> dirty;
+};
+} // portal
@@ -10,6 +10,23 @@
 
 namespace portal
 {
+namespace
+{
+    // Re-derives the cached depth of `root` from its parent, and of every entity below it
+    void update_subtree_depth(Entity root)
+    {
+        auto& root_rel = root.get_component<RelationshipComponent>();
+        root_rel.depth = root_rel.parent ? root_rel.parent.get_component<RelationshipComponent>().depth + 1 : 0;
+
+        // Parents are visited before their children
+        for (auto descendant : root.descendants())
+        {
+            auto& relationship = descendant.get_component<RelationshipComponent>();
+            relationship.depth = relationship.parent.get_component<RelationshipComponent>().depth + 1;
+        }
+    }
+}
+
 Entity::Entity(const entt::entity entity, entt::registry& reg) : handle(reg, entity) {}
 
 Entity::Entity(const entt::handle handle) : handle(handle) {}
@@ -52,6 +69,11 @@ void Entity::set_parent(const Entity parent) const
         relationship.prev = null_entity;
         relationship.next = null_entity;
     }
+
+    update_subtree_depth(*this);
+
+    // Notify listeners (e.g. change tracking) that the hierarchy changed
+    handle.patch<RelationshipComponent>();
 }
 
 bool Entity::remove_child(Entity child)
@@ -81,6 +103,9 @@ bool Entity::remove_child(Entity child)
     child_rel.parent = null_entity;
 
     parent_rel.children -= 1;
+
+    update_subtree_depth(child);
+    child.handle.patch<RelationshipComponent>();
     return true;
 }
 
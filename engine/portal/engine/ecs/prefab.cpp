@@ -0,0 +1,41 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "prefab.h"
+
+namespace portal::ecs
+{
+Prefab::Prefab()
+{
+    nodes.emplace_back();
+}
+
+uint32_t Prefab::add_node(const uint32_t parent)
+{
+    PORTAL_ASSERT(parent < nodes.size(), "Prefab nodes must be added after their parent");
+
+    const auto node = static_cast<uint32_t>(nodes.size());
+    auto& parent_links = nodes[parent];
+
+    NodeLinks links{.parent = parent, .depth = parent_links.depth + 1};
+    if (parent_links.first_child == NO_NODE)
+    {
+        parent_links.first_child = node;
+    }
+    else
+    {
+        // Children are appended in order, the last child is the one without a next sibling
+        auto last_child = parent_links.first_child;
+        while (nodes[last_child].next != NO_NODE)
+            last_child = nodes[last_child].next;
+        nodes[last_child].next = node;
+        links.prev = last_child;
+    }
+    parent_links.children += 1;
+
+    nodes.push_back(links);
+    return node;
+}
+} // portal
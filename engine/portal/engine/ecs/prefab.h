@@ -0,0 +1,127 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <entt/entity/registry.hpp>
+
+#include "portal/core/debug/assert.h"
+
+namespace portal
+{
+struct RelationshipComponent;
+}
+
+namespace portal::ecs
+{
+/**
+ * @brief Shared template of an entity hierarchy, instanced many times at once by `Registry::spawn_bulk`.
+ *
+ * A prefab is a list of nodes, node 0 being the root. Every other node has a parent that was added before it, so
+ * nodes are always ordered parents first. Each node holds the component values its instances are created with.
+ *
+ * The hierarchy links (parent, first child, siblings and depth) are precomputed as node indices when nodes are added,
+ * spawning only offsets them by the first entity of each instance. `RelationshipComponent` is therefore owned by the
+ * prefab and cannot be set as a component.
+ *
+ * @par Example:
+ * @code
+ * ecs::Prefab tree;
+ * tree.set_component(Prefab::ROOT, TransformComponent{});
+ * const auto leaves = tree.add_node(Prefab::ROOT);
+ * tree.set_component(leaves, TransformComponent{glm::vec3{0.f, 2.f, 0.f}});
+ * tree.set_component(leaves, StaticMeshComponent{...});
+ *
+ * const auto entities = registry.spawn_bulk(tree, transforms.size(), transforms);
+ * @endcode
+ */
+class Prefab
+{
+public:
+    constexpr static uint32_t ROOT = 0;
+    constexpr static uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Node links, as node indices (`NO_NODE` when there is none).
+     */
+    struct NodeLinks
+    {
+        uint32_t parent = NO_NODE;
+        uint32_t first_child = NO_NODE;
+        uint32_t prev = NO_NODE;
+        uint32_t next = NO_NODE;
+        uint32_t children = 0;
+        uint32_t depth = 0;
+    };
+
+    /**
+     * @brief Type erased component value of a node.
+     */
+    struct ComponentTemplate
+    {
+        uint32_t node;
+        entt::id_type type;
+        // Reserves room for `count` more components in the storage of the component type
+        std::function<void(entt::registry&, size_t)> reserve;
+        // Copies the value to every entity of the span at once
+        std::function<void(entt::registry&, std::span<const entt::entity>)> insert;
+    };
+
+    Prefab();
+
+    /**
+     * @brief Adds a node as the last child of `parent`.
+     *
+     * @return The index of the new node
+     */
+    uint32_t add_node(uint32_t parent = ROOT);
+
+    /**
+     * @brief Sets the value `component` is created with on every instance of `node`, replacing the previous one.
+     */
+    template <typename C>
+    void set_component(const uint32_t node, C component)
+    {
+        static_assert(!std::same_as<C, RelationshipComponent>, "The prefab hierarchy is defined by its nodes");
+        static_assert(std::is_copy_constructible_v<C>, "Prefab components are copied to every instance");
+        PORTAL_ASSERT(node < nodes.size(), "Invalid prefab node");
+
+        const auto type = entt::type_hash<C>::value();
+        std::erase_if(components, [node, type](const auto& value) { return value.node == node && value.type == type; });
+
+        components.push_back(
+            {
+                .node = node,
+                .type = type,
+                .reserve = [](entt::registry& registry, const size_t count)
+                {
+                    auto& storage = registry.storage<C>();
+                    storage.reserve(storage.size() + count);
+                },
+                .insert = [value = std::move(component)](entt::registry& registry, const std::span<const entt::entity> entities)
+                {
+                    if constexpr (std::is_empty_v<C>)
+                        registry.insert<C>(entities.begin(), entities.end());
+                    else
+                        registry.insert<C>(entities.begin(), entities.end(), value);
+                }
+            }
+        );
+    }
+
+    [[nodiscard]] size_t get_node_count() const { return nodes.size(); }
+    [[nodiscard]] std::span<const NodeLinks> get_nodes() const { return nodes; }
+    [[nodiscard]] std::span<const ComponentTemplate> get_components() const { return components; }
+
+private:
+    std::vector<NodeLinks> nodes;
+    std::vector<ComponentTemplate> components;
+};
+} // portal
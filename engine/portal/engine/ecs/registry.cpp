@@ -5,11 +5,16 @@
 
 #include "registry.h"
 
+#include <algorithm>
+
+#include <llvm/ADT/DenseMap.h>
+
 #include "portal/application/modules/module_stack.h"
 #include "portal/core/debug/profile.h"
 #include "portal/engine/components/base.h"
 #include "portal/engine/components/relationship.h"
 #include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/prefab.h"
 
 namespace portal::ecs
 {
@@ -17,6 +22,11 @@ static auto logger = Log::get_logger("ECS Registry");
 
 Registry::Registry(ModuleStack& stack) : TaggedModule(stack, STRING_ID("ECS Registry")), registry(), env_entity(registry.create())
 {
+    registry.on_construct<NameComponent>().connect<&Registry::on_name_constructed>(this);
+    registry.on_update<NameComponent>().connect<&Registry::on_name_updated>(this);
+    registry.on_destroy<NameComponent>().connect<&Registry::on_name_destroyed>(this);
+    registry.ctx().emplace<SpawnBatch>();
+
     // Entity that holds global values
     registry.emplace<NameComponent>(env_entity, STRING_ID(ENV_ENTITY_ID));
     registry.emplace<RelationshipComponent>(env_entity);
@@ -44,12 +54,76 @@ Entity Registry::find_or_create(const StringId& entity_name)
 
 std::optional<Entity> Registry::find_by_name(const StringId& entity_name)
 {
-    for (auto&& [entity, tag] : view_raw<NameComponent>().each())
-    {
-        if (tag.name == entity_name)
-            return entity_from_id(entity);
-    }
-    return std::nullopt;
+    const auto entities = find_all_by_name(entity_name);
+    if (entities.empty())
+        return std::nullopt;
+    return entity_from_id(entities.front());
+}
+
+std::span<const entt::entity> Registry::find_all_by_name(const StringId& entity_name) const
+{
+    // The invalid id is the empty key of the index, unnamed entities are never indexed
+    if (entity_name == INVALID_STRING_ID)
+        return {};
+
+    const auto it = name_index.find(entity_name);
+    if (it == name_index.end())
+        return {};
+    return {it->second.data(), it->second.size()};
+}
+
+void Registry::on_name_constructed(entt::registry& raw_registry, const entt::entity entity)
+{
+    std::lock_guard guard(name_index_lock);
+    add_to_name_index(raw_registry.get<NameComponent>(entity).name, entity);
+}
+
+void Registry::on_name_updated(entt::registry& raw_registry, const entt::entity entity)
+{
+    std::lock_guard guard(name_index_lock);
+    remove_from_name_index(entity);
+    add_to_name_index(raw_registry.get<NameComponent>(entity).name, entity);
+}
+
+void Registry::on_name_destroyed(entt::registry&, const entt::entity entity)
+{
+    std::lock_guard guard(name_index_lock);
+    remove_from_name_index(entity);
+}
+
+void Registry::add_to_name_index(const StringId& name, const entt::entity entity)
+{
+    if (name == INVALID_STRING_ID)
+        return;
+
+    auto& entities = name_index[name];
+    if (!entities.empty() && duplicate_name_policy == DuplicateNamePolicy::Warn)
+        LOGGER_WARN("Entity name {} is not unique, {} entities share it", name, entities.size() + 1);
+    entities.push_back(entity);
+
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= indexed_names.size())
+        indexed_names.resize(index + 1, INVALID_STRING_ID);
+    indexed_names[index] = name;
+}
+
+void Registry::remove_from_name_index(const entt::entity entity)
+{
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= indexed_names.size() || indexed_names[index] == INVALID_STRING_ID)
+        return;
+
+    const auto it = name_index.find(indexed_names[index]);
+    indexed_names[index] = INVALID_STRING_ID;
+    if (it == name_index.end())
+        return;
+
+    auto& entities = it->second;
+    // Erase rather than swap with the last element, duplicates stay in naming order
+    if (const auto position = std::ranges::find(entities, entity); position != entities.end())
+        entities.erase(position);
+    if (entities.empty())
+        name_index.erase(it);
 }
 
 Entity Registry::get_env_entity() const
@@ -61,11 +135,8 @@ Entity Registry::find_or_create_child(Entity parent, const StringId& entity_name
 {
     PORTAL_PROF_ZONE();
 
-    for (auto&& [entity, tag] : view_raw<NameComponent>().each())
-    {
-        if (tag.name == entity_name)
-            return entity_from_id(entity);
-    }
+    if (const auto entity = find_by_name(entity_name); entity.has_value())
+        return entity.value();
 
     return create_child_entity(parent, entity_name);
 }
@@ -89,6 +160,88 @@ Entity Registry::create_child_entity(Entity parent, const StringId& entity_name)
     return child;
 }
 
+std::vector<entt::entity> Registry::spawn_bulk(const Prefab& prefab, const size_t count, const std::span<const glm::mat4> transforms)
+{
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(transforms.empty() || transforms.size() == count, "Expected a root transform for every instance");
+
+    const auto nodes = prefab.get_nodes();
+    std::vector<entt::entity> entities(nodes.size() * count);
+    if (entities.empty())
+        return entities;
+
+    auto& batch = registry.ctx().emplace<SpawnBatch>();
+    batch.active = true;
+
+    registry.create(entities.begin(), entities.end());
+
+    // Every instance links the same node indices, offset to its own entities
+    const auto link = [&](const uint32_t node, const size_t instance)
+    {
+        return node == Prefab::NO_NODE ? null_entity : Entity{entities[node * count + instance], registry};
+    };
+
+    std::vector<RelationshipComponent> relationships;
+    relationships.reserve(entities.size());
+    for (uint32_t node = 0; node < nodes.size(); ++node)
+    {
+        const auto& links = nodes[node];
+        for (size_t instance = 0; instance < count; ++instance)
+        {
+            relationships.push_back(
+                {
+                    .children = links.children,
+                    .first = link(links.first_child, instance),
+                    .prev = link(links.prev, instance),
+                    .next = link(links.next, instance),
+                    .parent = link(links.parent, instance),
+                    .depth = links.depth
+                }
+            );
+        }
+    }
+    registry.storage<RelationshipComponent>().reserve(registry.storage<RelationshipComponent>().size() + entities.size());
+    registry.insert<RelationshipComponent>(entities.begin(), entities.end(), relationships.begin());
+
+    // Reserve each storage once for all the nodes using it, then fill every node's instances with one insert
+    llvm::DenseMap<entt::id_type, size_t> reservations;
+    for (const auto& component : prefab.get_components())
+        reservations[component.type] += count;
+
+    for (const auto& component : prefab.get_components())
+    {
+        if (const auto it = reservations.find(component.type); it != reservations.end())
+        {
+            component.reserve(registry, it->second);
+            reservations.erase(it);
+        }
+        component.insert(registry, std::span(entities).subspan(component.node * count, count));
+    }
+
+    if (!transforms.empty())
+    {
+        const auto roots = std::span(entities).first(count);
+        if (registry.all_of<TransformComponent>(roots.front()))
+        {
+            // Written in place, the spawn notification marks the new transforms dirty
+            for (size_t instance = 0; instance < count; ++instance)
+                registry.get<TransformComponent>(roots[instance]).set_matrix(transforms[instance]);
+        }
+        else
+        {
+            std::vector<TransformComponent> root_transforms;
+            root_transforms.reserve(count);
+            for (const auto& transform : transforms)
+                root_transforms.emplace_back(transform);
+            registry.insert<TransformComponent>(roots.begin(), roots.end(), root_transforms.begin());
+        }
+    }
+
+    batch.active = false;
+    batch.on_spawned.publish(registry, std::span<const entt::entity>{entities});
+    return entities;
+}
+
 void Registry::destroy_entity(const Entity entity, const bool exclude_children)
 {
     PORTAL_PROF_ZONE();
@@ -123,5 +276,7 @@ void Registry::clear()
     }
 
     registry.clear();
+    name_index.clear();
+    std::ranges::fill(indexed_names, INVALID_STRING_ID);
 }
 } // portal
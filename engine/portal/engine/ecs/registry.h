@@ -4,15 +4,48 @@
 //
 
 #pragma once
+#include <mutex>
+#include <span>
+#include <vector>
+
 #include <entt/entity/registry.hpp>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
 
 #include "entity.h"
 #include "system_base.h"
+#include "portal/core/glm.h"
 #include "portal/application/modules/module.h"
 #include "portal/engine/components/base.h"
 
 namespace portal::ecs
 {
+class Prefab;
+
+/**
+ * @brief Lives in the context of the EnTT registry, announces entities spawned by `Registry::spawn_bulk`.
+ *
+ * While `active` the components of a bulk spawn are being inserted. Systems implementing `on_entities_spawned` skip
+ * their per entity construct callbacks during that time, and get every spawned entity in one `on_spawned` call
+ * once the spawn is complete.
+ */
+struct SpawnBatch
+{
+    bool active = false;
+    entt::sigh<void(entt::registry&, std::span<const entt::entity>)> on_spawned;
+};
+
+/**
+ * @brief How the registry reacts to several entities sharing a name.
+ *
+ * Duplicates are always indexed, `find_by_name` returns the entity that was named first.
+ */
+enum class DuplicateNamePolicy
+{
+    Allow,
+    Warn
+};
+
 /**
  * @brief Central registry for all entity and component operations in the Portal ECS.
  *
@@ -105,13 +138,25 @@ public:
     /**
      * @brief Find an entity by name.
      *
-     * Searches for an entity with the specified name in the registry.
+     * Looks the name up in the name index, which is kept in sync with `NameComponent` through EnTT's construct, update
+     * and destroy signals. Renaming must therefore go through `patch_component`/`replace`, not a direct write.
+     * If several entities share the name, the one that was named first is returned.
      *
      * @param entity_name The name for the entity.
-     * @reaturn The entity if found, std::nullopt otherwise
+     * @return The entity if found, std::nullopt otherwise
      */
     std::optional<Entity> find_by_name(const StringId& entity_name);
 
+    /**
+     * @brief Returns every entity with the given name, in the order they were named.
+     *
+     * @note The span is invalidated by any change to the names in the registry.
+     */
+    [[nodiscard]] std::span<const entt::entity> find_all_by_name(const StringId& entity_name) const;
+
+    void set_duplicate_name_policy(const DuplicateNamePolicy policy) { duplicate_name_policy = policy; }
+    [[nodiscard]] DuplicateNamePolicy get_duplicate_name_policy() const { return duplicate_name_policy; }
+
     /**
      * @brief Creates a new top-level entity.
      *
@@ -173,6 +218,28 @@ public:
      */
     Entity create_child_entity(Entity parent, const StringId& entity_name = INVALID_STRING_ID);
 
+    /**
+     * @brief Creates `count` instances of a prefab at once.
+     *
+     * Entities are created in one batch, every component storage is reserved once and filled with a single insert per
+     * prefab node, and the hierarchy is linked from the node indices precomputed by the prefab. Construct signals still
+     * fire per entity, except for systems implementing `on_entities_spawned` which are notified once for the whole
+     * spawn (see `SpawnBatch`).
+     *
+     * @param prefab The template to instance
+     * @param count Number of instances
+     * @param transforms Optional local matrix of the root of every instance, either empty or `count` matrices
+     * @return The spawned entities, node major: node `n` of instance `i` is at `n * count + i`, so the first `count`
+     *         entities are the roots
+     *
+     * @par Example:
+     * @code
+     * const auto entities = registry.spawn_bulk(prefab, transforms.size(), transforms);
+     * const auto roots = std::span(entities).first(transforms.size());
+     * @endcode
+     */
+    std::vector<entt::entity> spawn_bulk(const Prefab& prefab, size_t count, std::span<const glm::mat4> transforms = {});
+
     /**
      * @brief Returns the special environment entity.
      *
@@ -433,8 +500,23 @@ private:
         return registry.view<T...>();
     }
 
+    void on_name_constructed(entt::registry& raw_registry, entt::entity entity);
+    void on_name_updated(entt::registry& raw_registry, entt::entity entity);
+    void on_name_destroyed(entt::registry& raw_registry, entt::entity entity);
+
+    void add_to_name_index(const StringId& name, entt::entity entity);
+    void remove_from_name_index(entt::entity entity);
+
 private:
     entt::registry registry;
     entt::entity env_entity;
+
+    DuplicateNamePolicy duplicate_name_policy = DuplicateNamePolicy::Allow;
+    // Guards the index in the `NameComponent` listeners, which run on the threads of the systems writing names
+    std::mutex name_index_lock;
+    // Entities by name, in the order they were named
+    llvm::DenseMap<StringId, llvm::SmallVector<entt::entity, 1>> name_index;
+    // The name each entity is indexed under (by `entt::to_entity`), `on_update` fires after the old name is gone
+    std::vector<StringId> indexed_names;
 };
 } // portal
@@ -105,6 +105,31 @@ public:
         group(registry);
     }
 
+    /**
+     * @brief Disconnects the component lifecycle callbacks installed by `register_to`.
+     *
+     * @param registry The registry the system was registered to
+     */
+    void unregister_from(Registry& registry) override
+    {
+        unregister_component_callbacks(registry);
+    }
+
+    /**
+     * @brief Returns the components this system reads and writes.
+     *
+     * `Owns<T>` components are written and `Views<T>` components are read, extended by `Derived::declare_access`
+     * when the system implements it (see `DeclaresAccess`).
+     */
+    static ComponentAccess get_component_access()
+    {
+        ComponentAccess access;
+        (declare_component<Components>(access), ...);
+        if constexpr (ecs::DeclaresAccess<Derived>)
+            Derived::declare_access(access);
+        return access;
+    }
+
     /**
      * @brief Internal execution dispatcher (called by system orchestrator).
      *
@@ -264,12 +289,28 @@ private:
         }
     };
 
+    template <typename C>
+    static void declare_component(ComponentAccess& access)
+    {
+        if constexpr (ComponentOwned<C>)
+            access.write<typename C::comp>();
+        else
+            access.read<typename C::comp>();
+    }
+
     Derived& derived() { return static_cast<Derived&>(*this); }
     const Derived& derived() const { return static_cast<const Derived&>(*this); }
 
     template <typename Component>
     void on_construct(entt::registry& registry, const entt::entity entity_raw)
     {
+        if constexpr (ecs::OnEntitiesSpawned<Derived>)
+        {
+            // Handled once for the whole spawn by `on_entities_spawned`
+            if (const auto* batch = registry.ctx().find<SpawnBatch>(); batch && batch->active)
+                return;
+        }
+
         auto entity = Entity(entity_raw, registry);
         auto& component = entity.get_component<Component>();
         derived().on_component_added(entity, component);
@@ -311,9 +352,51 @@ private:
         }
     }
 
+    void on_spawned(entt::registry& registry, const std::span<const entt::entity> entities)
+    {
+        derived().on_entities_spawned(registry, entities);
+    }
+
     void register_component_callbacks(Registry& registry)
     {
         (register_component_callbacks_single<typename Components::comp>(registry), ...);
+
+        if constexpr (ecs::OnEntitiesSpawned<Derived>)
+        {
+            auto& batch = registry.get_raw_registry().ctx().emplace<SpawnBatch>();
+            entt::sink{batch.on_spawned}.template connect<&System::on_spawned>(this);
+        }
+    }
+
+    template <typename Component>
+    void unregister_component_callbacks_single(Registry& registry)
+    {
+        auto& raw_registry = registry.get_raw_registry();
+        if constexpr (ecs::OnComponentAdded<Derived, Component>)
+        {
+            raw_registry.on_construct<Component>().template disconnect<&System::on_construct<Component>>(this);
+        }
+
+        if constexpr (ecs::OnComponentRemoved<Derived, Component>)
+        {
+            raw_registry.on_destroy<Component>().template disconnect<&System::on_destroy<Component>>(this);
+        }
+
+        if constexpr (ecs::OnComponentChanged<Derived, Component>)
+        {
+            raw_registry.on_update<Component>().template disconnect<&System::on_update<Component>>(this);
+        }
+    }
+
+    void unregister_component_callbacks(Registry& registry)
+    {
+        (unregister_component_callbacks_single<typename Components::comp>(registry), ...);
+
+        if constexpr (ecs::OnEntitiesSpawned<Derived>)
+        {
+            auto& batch = registry.get_raw_registry().ctx().emplace<SpawnBatch>();
+            entt::sink{batch.on_spawned}.template disconnect<&System::on_spawned>(this);
+        }
     }
 
 protected:
@@ -4,6 +4,9 @@
 //
 
 #pragma once
+#include <algorithm>
+#include <span>
+
 #include "entity.h"
 #include "portal/core/type_traits.h"
 #include "portal/core/jobs/job.h"
@@ -79,6 +82,87 @@ concept OnComponentChanged = requires(System& system, Entity entity, Component&
     { system.on_component_changed(entity, component) } -> std::same_as<void>;
 };
 
+/**
+ * @brief Concept for systems that handle the entities of a bulk spawn at once.
+ *
+ * Systems satisfying this concept skip their `on_component_added` callbacks while `Registry::spawn_bulk` runs, and
+ * are given every spawned entity in a single call instead, whatever components the entities have.
+ *
+ * @tparam System The system type
+ */
+template <typename System>
+concept OnEntitiesSpawned = requires(System& system, entt::registry& registry, std::span<const entt::entity> entities) {
+    { system.on_entities_spawned(registry, entities) } -> std::same_as<void>;
+};
+
+/**
+ * @brief The components a system reads and writes, used by the orchestrator to decide which systems may run concurrently.
+ *
+ * Two systems conflict when one of them writes a component the other one reads or writes.
+ */
+struct ComponentAccess
+{
+    llvm::SmallVector<entt::id_type, 8> reads;
+    llvm::SmallVector<entt::id_type, 8> writes;
+
+    template <typename T>
+    void read()
+    {
+        const auto id = entt::type_hash<std::remove_const_t<T>>::value();
+        if (!contains(reads, id) && !contains(writes, id))
+            reads.push_back(id);
+    }
+
+    template <typename T>
+    void write()
+    {
+        const auto id = entt::type_hash<std::remove_const_t<T>>::value();
+        if (contains(writes, id))
+            return;
+        // A write supersedes a read of the same component
+        if (const auto it = std::ranges::find(reads, id); it != reads.end())
+            reads.erase(it);
+        writes.push_back(id);
+    }
+
+    [[nodiscard]] bool conflicts_with(const ComponentAccess& other) const
+    {
+        const auto touches = [](const ComponentAccess& access, const entt::id_type id)
+        {
+            return contains(access.reads, id) || contains(access.writes, id);
+        };
+
+        return std::ranges::any_of(writes, [&](const auto id) { return touches(other, id); }) ||
+            std::ranges::any_of(other.writes, [&](const auto id) { return touches(*this, id); });
+    }
+
+private:
+    static bool contains(const llvm::SmallVector<entt::id_type, 8>& ids, const entt::id_type id)
+    {
+        return std::ranges::find(ids, id) != ids.end();
+    }
+};
+
+/**
+ * @brief Concept for systems that access components outside of their `Owns`/`Views` list, or write viewed components.
+ *
+ * `Owns<T>` components are treated as written and `Views<T>` components as read, systems that go beyond that
+ * must declare it so the orchestrator does not run them concurrently with conflicting systems.
+ *
+ * @par Example:
+ * @code
+ * static void declare_access(ComponentAccess& access)
+ * {
+ *     access.write<TransformComponent>();
+ *     access.read<MainCameraTag>();
+ * }
+ * @endcode
+ */
+template <typename System>
+concept DeclaresAccess = requires(ComponentAccess& access) {
+    { System::declare_access(access) } -> std::same_as<void>;
+};
+
 /**
  * @brief Concept for systems with sequential execute(Registry&).
  * @tparam System The system type
@@ -266,6 +350,11 @@ public:
     virtual void connect(Registry& registry, entt::dispatcher& dispatcher) = 0;
     virtual void disconnect(Registry& registry, entt::dispatcher& dispatcher) = 0;
 
+    /**
+     * @brief Removes the component callbacks the system installed when it was registered to the registry.
+     */
+    virtual void unregister_from(Registry& registry) = 0;
+
     /**
      * @brief Changes the system's execution policy at runtime.
      *
@@ -391,7 +391,7 @@ void WindowTitlebar::draw_menubar(EditorContext& editor_context, FrameContext& f
                 if (imgui::begin_menu_with_image(icons.get_descriptor(EditorIcon::History), "Snapshot History"))
                 {
                     auto current_snapshot = editor_context.snapshot_manager.get_current_snapshot_index();
-                    for (auto [index, title, timestamp] : editor_context.snapshot_manager.list_snapshots())
+                    for (auto [index, title, timestamp, keyframe, size, raw_size, capture_time] : editor_context.snapshot_manager.list_snapshots())
                     {
                         if (index == current_snapshot)
                             ImGuiFonts::push_font(STRING_ID("Bold"));
@@ -402,6 +402,15 @@ void WindowTitlebar::draw_menubar(EditorContext& editor_context, FrameContext& f
                         {
                             editor_context.snapshot_manager.revert_snapshot(index);
                         }
+                        imgui::set_tooltip(
+                            fmt::format(
+                                "{}: {:.1f} KiB ({:.1f} KiB raw), captured in {:.2f} ms",
+                                keyframe ? "Keyframe" : "Delta",
+                                static_cast<float>(size) / 1024.f,
+                                static_cast<float>(raw_size) / 1024.f,
+                                static_cast<float>(capture_time.count()) / 1000.f
+                            ).c_str()
+                        );
 
                         if (index == current_snapshot)
                             ImGuiFonts::pop_font();
@@ -393,9 +393,10 @@ struct ComponentEditorFunctions<StaticMeshComponent>
         {
             for (auto& id : entities)
             {
+                // Patched so the scene rendering system picks up the change
                 auto entity = context.ecs_registry.find_by_name(id);
-                auto& mesh = entity->get_component<StaticMeshComponent>();
-                mesh.visible = first_component.visible;
+                const bool visible = first_component.visible;
+                entity->patch_component<StaticMeshComponent>([visible](StaticMeshComponent& comp) { comp.visible = visible; });
             }
         }
         ImGui::PopItemFlag();
@@ -23,12 +23,14 @@ void StatisticsPanel::on_gui_render(EditorContext& editor_context, FrameContext&
     static std::array<float, history_size> frame_time_history_ms = {};
     static std::array<float, history_size> draw_time_history_ms = {};
     static std::array<float, history_size> update_time_history_ms = {};
+    static std::array<float, history_size> extraction_time_history_ms = {};
     static int history_index = 0;
 
     fps_history[history_index] = 1000.f / frame_context.stats.frame_time;
     frame_time_history_ms[history_index] = frame_context.stats.frame_time;
     draw_time_history_ms[history_index] = frame_context.stats.mesh_draw_time;
     update_time_history_ms[history_index] = frame_context.stats.scene_update_time;
+    extraction_time_history_ms[history_index] = frame_context.stats.scene_extraction_time;
 
     history_index = (history_index + 1) % history_size;
 
@@ -64,14 +66,26 @@ void StatisticsPanel::on_gui_render(EditorContext& editor_context, FrameContext&
 
                 ImGui::Text("Draw Time: %.3f ms", avg(draw_time_history_ms));
                 ImGui::Text("Update Time %.3f ms", avg(update_time_history_ms));
+                ImGui::Text("Extraction Time %.3f ms", avg(extraction_time_history_ms));
 
                 ImGui::Separator();
                 ImGui::Text("Triangles %i", frame_context.stats.triangle_count);
                 ImGui::Text("Draws %i", frame_context.stats.drawcall_count);
+                ImGui::Text("Objects %i (%i visible)", frame_context.stats.render_object_count, frame_context.stats.visible_object_count);
 
                 ImGui::EndTabItem();
             }
 
+            if (ImGui::BeginTabItem("Systems"))
+            {
+                for (size_t i = 0; i < frame_context.stats.system_timing_count; ++i)
+                {
+                    const auto& [name, time] = frame_context.stats.system_timings[i];
+                    ImGui::Text("%.*s: %.3f ms", static_cast<int>(name.string.size()), name.string.data(), time);
+                }
+                ImGui::EndTabItem();
+            }
+
             if (ImGui::BeginTabItem("Memory"))
             {
                 ImGui::Text("Not Implemented");
@@ -5,54 +5,154 @@
 
 #include "snapshot_manager.h"
 
-#include <spdlog/fmt/bin_to_hex.h>
+#include <algorithm>
+#include <optional>
+#include <ranges>
 
+#include "portal/core/buffer_stream.h"
+#include "portal/engine/components/relationship.h"
 #include "portal/engine/resources/resource_registry.h"
+#include "portal/engine/resources/loader/scene_loader.h"
+#include "portal/engine/scene/scene.h"
+#include "portal/serialization/serialize/binary_serialization.h"
 #include "portal/third_party/imgui/ImGuiNotify.h"
 
 namespace portal
 {
-SnapshotManager::SnapshotManager(ResourceRegistry& registry) : registry(registry) {}
+namespace
+{
+    /**
+     * @brief Returns the depth of `entity` under `scene_entity`, or nullopt if the entity is not part of the scene.
+     */
+    std::optional<size_t> get_scene_depth(const Entity entity, const Entity scene_entity)
+    {
+        size_t depth = 0;
+        const auto* relationship = entity.try_get_component<RelationshipComponent>();
+        while (relationship != nullptr && relationship->parent != null_entity)
+        {
+            ++depth;
+            if (relationship->parent == scene_entity)
+                return depth;
+            relationship = relationship->parent.try_get_component<RelationshipComponent>();
+        }
+        return std::nullopt;
+    }
+}
+
+SnapshotManager::SnapshotManager(ResourceRegistry& registry, const CompressionParams& compression, const size_t keyframe_interval)
+    : registry(registry),
+      compression(compression),
+      keyframe_interval(keyframe_interval)
+{
+    PORTAL_ASSERT(
+        keyframe_interval > 0 && keyframe_interval <= MAX_SNAPSHOTS,
+        "Keyframe interval must be between 1 and {}",
+        MAX_SNAPSHOTS
+    );
+    change_tracker.attach(registry.get_ecs_registry());
+}
 
 void SnapshotManager::set_scene_id(const StringId& new_scene_id)
 {
+    if (scene_id == new_scene_id)
+        return;
+
     scene_id = new_scene_id;
+
+    // Changes made while loading the scene are not part of any snapshot, the next snapshot is a keyframe
+    change_tracker.clear();
+    in_flight_changes.clear();
+    head_sequence = 0;
 }
 
 void SnapshotManager::prepare_snapshot(const StringId& title)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-    auto data = registry.snapshot(scene_id);
-    auto end = std::chrono::high_resolution_clock::now();
-    LOG_TRACE("Snapshot {} took {} ms", title.string.data(), std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // A snapshot that was prepared but never committed already consumed some changes, carry them over
+    auto changes = change_tracker.consume();
+    changes.insert(changes.end(), in_flight_changes.begin(), in_flight_changes.end());
+
+    const bool keyframe = needs_keyframe(current_snapshot);
+    const auto raw_data = keyframe ? registry.snapshot(scene_id) : capture_delta(changes);
+    auto data = raw_data ? compress(raw_data, compression, &registry.get_scheduler()) : Buffer{};
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    const auto capture_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    LOG_TRACE(
+        "{} snapshot {} took {:.3f} ms ({} bytes, {} compressed)",
+        keyframe ? "Keyframe" : "Delta",
+        title.string.data(),
+        static_cast<float>(capture_time.count()) / 1000.f,
+        raw_data.size,
+        data.size
+    );
 
     in_flight_snapshot.title = title;
     in_flight_snapshot.data = std::move(data);
+    in_flight_snapshot.keyframe = keyframe;
+    in_flight_snapshot.parent_sequence = keyframe ? 0 : head_sequence;
+    in_flight_snapshot.raw_size = raw_data.size;
+    in_flight_snapshot.capture_time = capture_time;
+    in_flight_changes = std::move(changes);
 }
 
 void SnapshotManager::commit_snapshot()
 {
     PORTAL_ASSERT(in_flight_snapshot.data != nullptr, "No snapshot to commit");
     in_flight_snapshot.timestamp = std::chrono::system_clock::now();
+    in_flight_snapshot.sequence = next_sequence++;
+    head_sequence = in_flight_snapshot.sequence;
+
     snapshots[current_snapshot] = std::move(in_flight_snapshot);
     current_snapshot = get_next_snapshot_index();
 
     in_flight_snapshot.title = INVALID_STRING_ID;
     in_flight_snapshot.data = nullptr;
+    in_flight_changes.clear();
+
+    drop_broken_snapshots();
 }
 
 void SnapshotManager::revert_snapshot(const size_t snapshot_index)
 {
-    auto& [_, title, data] = snapshots[snapshot_index];
+    const auto& snapshot = snapshots[snapshot_index];
 
-    if (data == nullptr)
+    if (snapshot.data == nullptr)
     {
         ImGui::InsertNotification({ImGuiToastType::Warning, 3000, "No snapshot to revert"});
         return;
     }
 
-    registry.load_snapshot(scene_id, data);
-    ImGui::InsertNotification({ImGuiToastType::Info, 3000, "Reverted %s", title.string.data()});
+    const auto chain = resolve_chain(snapshot.sequence);
+    if (chain.empty())
+    {
+        LOG_ERROR("Failed to resolve the delta chain of snapshot {}", snapshot.title.string.data());
+        ImGui::InsertNotification({ImGuiToastType::Error, 3000, "Failed to revert %s", snapshot.title.string.data()});
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    auto& scheduler = registry.get_scheduler();
+    registry.load_snapshot(scene_id, decompress(snapshots[chain.front()].data, &scheduler));
+    for (size_t i = 1; i < chain.size(); ++i)
+        apply_delta(decompress(snapshots[chain[i]].data, &scheduler));
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    LOG_TRACE(
+        "Reverted {} (keyframe + {} deltas) in {} ms",
+        snapshot.title.string.data(),
+        chain.size() - 1,
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+    );
+
+    // Restoring touches every entity in the chain, none of it is a user change
+    change_tracker.clear();
+    in_flight_changes.clear();
+    head_sequence = snapshot.sequence;
+
+    ImGui::InsertNotification({ImGuiToastType::Info, 3000, "Reverted %s", snapshot.title.string.data()});
     current_snapshot = snapshot_index;
 }
 
@@ -77,6 +177,14 @@ bool SnapshotManager::can_redo() const
     return snapshots[get_next_snapshot_index()].data != nullptr;
 }
 
+size_t SnapshotManager::get_memory_usage() const
+{
+    size_t total = 0;
+    for (const auto& snapshot : snapshots)
+        total += snapshot.data.size;
+    return total;
+}
+
 size_t SnapshotManager::get_next_snapshot_index() const
 {
     return (current_snapshot + 1) % MAX_SNAPSHOTS;
@@ -86,4 +194,148 @@ size_t SnapshotManager::get_previous_snapshot_index() const
 {
     return (current_snapshot - 1) % MAX_SNAPSHOTS;
 }
+
+std::vector<size_t> SnapshotManager::resolve_chain(size_t sequence, const size_t excluded_slot) const
+{
+    std::vector<size_t> chain;
+    while (chain.size() < MAX_SNAPSHOTS)
+    {
+        const auto it = std::ranges::find_if(
+            snapshots,
+            [sequence](const SnapshotData& snapshot) { return snapshot.data != nullptr && snapshot.sequence == sequence; }
+        );
+        if (it == snapshots.end())
+            return {};
+
+        const auto slot = static_cast<size_t>(std::distance(snapshots.begin(), it));
+        if (slot == excluded_slot)
+            return {};
+
+        chain.push_back(slot);
+        if (it->keyframe)
+        {
+            std::ranges::reverse(chain);
+            return chain;
+        }
+
+        sequence = it->parent_sequence;
+    }
+
+    return {};
+}
+
+bool SnapshotManager::needs_keyframe(const size_t slot) const
+{
+    if (head_sequence == 0)
+        return true;
+
+    // The delta would be written over a link in its own chain, or the chain got too long
+    const auto chain = resolve_chain(head_sequence, slot);
+    return chain.empty() || chain.size() >= keyframe_interval;
+}
+
+Buffer SnapshotManager::capture_delta(std::vector<ecs::ChangeTracker::DirtyEntity>& changes) const
+{
+    auto scene = registry.get<Scene>(scene_id);
+    if (!scene.is_valid())
+        return {};
+
+    auto& ecs_registry = registry.get_ecs_registry();
+    auto& raw_registry = ecs_registry.get_raw_registry();
+    const auto scene_entity = scene->get_scene_entity();
+
+    // Newer changes come first, keep them when an entity shows up more than once
+    std::ranges::stable_sort(changes, {}, &ecs::ChangeTracker::DirtyEntity::entity);
+    const auto [first, last] = std::ranges::unique(changes, {}, &ecs::ChangeTracker::DirtyEntity::entity);
+    changes.erase(first, last);
+
+    std::vector<StringId> removed;
+    std::vector<std::pair<size_t, Entity>> changed;
+    for (const auto& [raw_entity, name] : changes)
+    {
+        if (!raw_registry.valid(raw_entity))
+        {
+            if (name != INVALID_STRING_ID)
+                removed.push_back(name);
+            continue;
+        }
+
+        const auto entity = ecs_registry.entity_from_id(raw_entity);
+        if (const auto depth = get_scene_depth(entity, scene_entity); depth.has_value())
+            changed.emplace_back(depth.value(), entity);
+    }
+
+    // Parents are resolved by name on load, so they must be written before their children
+    std::ranges::stable_sort(changed, {}, &std::pair<size_t, Entity>::first);
+
+    Buffer buffer;
+    BufferStreamWriter stream(buffer);
+    BinarySerializer serializer(stream);
+
+    serializer.add_value(removed.size());
+    for (const auto& name : removed)
+        serializer.add_value(name);
+
+    serializer.add_value(changed.size());
+    for (const auto& entity : changed | std::views::values)
+        resources::SceneLoader::serialize_entity(entity, serializer, ecs_registry);
+
+    stream.flush();
+    return stream.get_buffer();
+}
+
+void SnapshotManager::apply_delta(const Buffer& delta) const
+{
+    auto scene = registry.get<Scene>(scene_id);
+    if (!scene.is_valid() || delta == nullptr)
+    {
+        LOG_ERROR("Failed to apply snapshot delta to scene {}", scene_id);
+        return;
+    }
+
+    auto& ecs_registry = registry.get_ecs_registry();
+    const auto scene_entity = scene->get_scene_entity();
+
+    BufferStreamReader stream(delta);
+    BinaryDeserializer deserializer(stream);
+
+    // Removals are applied first, so an entity that was destroyed and recreated under the same name ends up alive
+    size_t removed_count;
+    deserializer.get_value(removed_count);
+    for (size_t i = 0; i < removed_count; ++i)
+    {
+        StringId name;
+        deserializer.get_value(name);
+
+        const auto entity = ecs_registry.find_by_name(name);
+        if (entity.has_value() && get_scene_depth(*entity, scene_entity).has_value())
+            ecs_registry.destroy_entity(*entity, true);
+    }
+
+    size_t changed_count;
+    deserializer.get_value(changed_count);
+
+    std::vector<Entity> entities;
+    entities.reserve(changed_count);
+    for (size_t i = 0; i < changed_count; ++i)
+        entities.push_back(resources::SceneLoader::deserialize_entity(deserializer, ecs_registry, true));
+
+    for (const auto entity : entities)
+        resources::SceneLoader::post_serialize_entity(entity, registry);
+}
+
+void SnapshotManager::drop_broken_snapshots()
+{
+    for (auto& snapshot : snapshots)
+    {
+        if (snapshot.data == nullptr || snapshot.keyframe)
+            continue;
+
+        if (resolve_chain(snapshot.sequence).empty())
+        {
+            LOG_TRACE("Dropping snapshot {}, its delta chain was overwritten", snapshot.title.string.data());
+            snapshot.data = nullptr;
+        }
+    }
+}
 } // portal
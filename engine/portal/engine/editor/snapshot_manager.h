@@ -5,17 +5,31 @@
 
 #pragma once
 #include <array>
+#include <chrono>
 #include <vector>
 
 #include "portal/core/buffer.h"
 #include "portal/core/strings/string_id.h"
+#include "portal/engine/ecs/change_tracker.h"
+#include "portal/serialization/compression/block_compression.h"
 
 namespace portal
 {
 class ResourceRegistry;
 
 constexpr auto MAX_SNAPSHOTS = 16;
+constexpr auto SNAPSHOT_KEYFRAME_INTERVAL = 8;
 
+/**
+ * @brief Keeps a ring of scene snapshots used for undo / redo in the editor.
+ *
+ * Only every `keyframe_interval`-th snapshot holds a full dump of the scene (a keyframe), every other snapshot is a
+ * delta that holds just the entities touched since the snapshot before it. Touched entities are collected through an
+ * `ecs::ChangeTracker`, so taking a delta costs the size of the edit rather than the size of the scene.
+ *
+ * Restoring a delta loads its keyframe and then applies every delta in the chain up to the requested snapshot.
+ * Snapshots whose chain was broken (e.g. their keyframe was overwritten by the ring) are dropped.
+ */
 class SnapshotManager
 {
 public:
@@ -24,6 +38,14 @@ public:
         std::chrono::system_clock::time_point timestamp;
         StringId title;
         Buffer data;
+
+        bool keyframe = false;
+        // Monotonic id of the snapshot, deltas reference their parent through it
+        size_t sequence = 0;
+        size_t parent_sequence = 0;
+
+        size_t raw_size = 0;
+        std::chrono::microseconds capture_time{};
     };
 
     struct SnapshotView
@@ -31,9 +53,19 @@ public:
         size_t index;
         StringId title;
         std::chrono::system_clock::time_point timestamp;
+        bool keyframe;
+        // Size of the snapshot in memory (compressed)
+        size_t size;
+        // Size of the snapshot before compression
+        size_t raw_size;
+        std::chrono::microseconds capture_time;
     };
 
-    explicit SnapshotManager(ResourceRegistry& registry);
+    explicit SnapshotManager(
+        ResourceRegistry& registry,
+        const CompressionParams& compression = {},
+        size_t keyframe_interval = SNAPSHOT_KEYFRAME_INTERVAL
+    );
 
     void set_scene_id(const StringId& new_scene_id);
     void prepare_snapshot(const StringId& title);
@@ -48,14 +80,30 @@ public:
 
     [[nodiscard]] size_t get_current_snapshot_index() const { return current_snapshot; }
 
+    /**
+     * @brief Total amount of memory held by all stored snapshots.
+     */
+    [[nodiscard]] size_t get_memory_usage() const;
+
     [[nodiscard]] std::vector<SnapshotView> list_snapshots() const
     {
         std::vector<SnapshotView> result;
         for (size_t i = 0; i < snapshots.size(); ++i)
         {
-            if (snapshots[i].data != nullptr)
+            const auto& snapshot = snapshots[i];
+            if (snapshot.data != nullptr)
             {
-                result.push_back(SnapshotView{i, snapshots[i].title, snapshots[i].timestamp});
+                result.push_back(
+                    SnapshotView{
+                        i,
+                        snapshot.title,
+                        snapshot.timestamp,
+                        snapshot.keyframe,
+                        snapshot.data.size,
+                        snapshot.raw_size,
+                        snapshot.capture_time
+                    }
+                );
             }
         }
         return result;
@@ -65,9 +113,35 @@ private:
     [[nodiscard]] size_t get_next_snapshot_index() const;
     [[nodiscard]] size_t get_previous_snapshot_index() const;
 
+    /**
+     * @brief Resolves the slots that need to be applied (keyframe first) to restore the snapshot with `sequence`.
+     *
+     * @param sequence The sequence of the snapshot to restore
+     * @param excluded_slot A slot that must not be part of the chain (e.g. because it's about to be overwritten)
+     * @return The chain of slot indices, empty if the chain is broken
+     */
+    [[nodiscard]] std::vector<size_t> resolve_chain(size_t sequence, size_t excluded_slot = MAX_SNAPSHOTS) const;
+    [[nodiscard]] bool needs_keyframe(size_t slot) const;
+
+    [[nodiscard]] Buffer capture_delta(std::vector<ecs::ChangeTracker::DirtyEntity>& changes) const;
+    void apply_delta(const Buffer& delta) const;
+
+    void drop_broken_snapshots();
+
 private:
     StringId scene_id;
     ResourceRegistry& registry;
+    // Snapshots are kept block compressed in memory, LZ4 by default
+    CompressionParams compression;
+    size_t keyframe_interval;
+
+    ecs::ChangeTracker change_tracker;
+    // Changes consumed by a prepared snapshot that was not committed yet
+    std::vector<ecs::ChangeTracker::DirtyEntity> in_flight_changes;
+
+    // Sequence of the snapshot that matches the current scene state (0 if there is none)
+    size_t head_sequence = 0;
+    size_t next_sequence = 1;
 
     SnapshotData in_flight_snapshot;
     std::array<SnapshotData, MAX_SNAPSHOTS> snapshots;
@@ -32,7 +32,7 @@ Engine::Engine(const Reference<Project>& project, const ApplicationProperties& p
 
     modules.add_module<SchedulerModule>(settings.get_setting<int32_t>("application.scheduler-threads", 0));
     auto& registry = modules.add_module<ecs::Registry>();
-    auto& system_orchestrator = modules.add_module<SystemOrchestrator>();
+    auto& system_orchestrator = modules.add_module<SystemOrchestrator>(settings);
 
     // Creating vulkan context
     const WindowProperties window_properties{
@@ -94,7 +94,11 @@ void Engine::prepare()
     const auto scene_id = project->get_starting_scene();
     if (scene_id != INVALID_STRING_ID)
     {
-        auto scene_reference = engine_context->get_resource_registry().immediate_load<Scene>(scene_id);
+        // Loading the scene and everything it references up front reads all of it in parallel
+        LoadTimeline timeline;
+        auto scene_reference = engine_context->get_resource_registry().immediate_load_with_dependencies<Scene>(scene_id, &timeline);
+        timeline.log();
+
         scene_reference->set_viewport_bounds({0, 0, swapchain->get_width(), swapchain->get_height()});
         engine_context->get_system_orchestrator().set_active_scene(scene_reference);
     }
@@ -30,4 +30,10 @@ ResourcesModule::ResourcesModule(ModuleStack& stack, Project& project, renderer:
         context
     );
 }
+
+void ResourcesModule::end_frame(FrameContext&)
+{
+    registry->update_sources();
+    registry->update_residency();
+}
 } // portal
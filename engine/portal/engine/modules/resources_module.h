@@ -22,8 +22,10 @@ class ReferenceManager;
  * - ReferenceManager for tracking resource references
  * - ResourceRegistry for storing and accessing loaded resources
  *
+ * At the end of every frame the registry reloads resources whose files changed on disk, and evicts resources to keep each
+ * resource type within its memory budget.
  */
-class ResourcesModule final: public Module<SchedulerModule, ecs::Registry>
+class ResourcesModule final: public TaggedModule<Tag<ModuleTags::FrameLifecycle>, SchedulerModule, ecs::Registry>
 {
 public:
     /**
@@ -39,6 +41,8 @@ public:
      */
     [[nodiscard]] ResourceRegistry& get_registry() const { return *registry; }
 
+    void end_frame(FrameContext& frame) override;
+
 private:
     std::unique_ptr<ReferenceManager> reference_manager;
     std::unique_ptr<ResourceRegistry> registry;
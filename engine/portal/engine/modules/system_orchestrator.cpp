@@ -5,6 +5,14 @@
 
 #include "system_orchestrator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <span>
+#include <utility>
+
+#include <fmt/format.h>
+
 #include "portal/engine/scene/scene.h"
 #include "portal/engine/systems/base_camera_system.h"
 #include "portal/engine/systems/base_player_input_system.h"
@@ -13,19 +21,226 @@
 
 namespace portal
 {
-SystemOrchestrator::SystemOrchestrator(ModuleStack& stack)
+SystemOrchestrator::SystemOrchestrator(ModuleStack& stack, ProjectSettings& settings)
     : TaggedModule(stack, STRING_ID("System Orchestrator")),
-      player_input_system(std::make_unique<BasePlayerInputSystem>(get_dependency<InputManager>())),
-      camera_system(std::make_unique<BaseCameraSystem>()),
-      transform_system(std::make_unique<TransformHierarchySystem>()),
-      scene_rendering_system(std::make_unique<SceneRenderingSystem>())
+      settings(settings)
+{
+    system_order = settings.get_setting<std::vector<std::string>>("systems.order", {});
+
+    const bool parallel_transforms = settings.get_setting<bool>("application.parallel-transforms", false);
+
+    register_system<BasePlayerInputSystem>({}, get_dependency<InputManager>());
+    register_system<BaseCameraSystem>({});
+    register_system<TransformHierarchySystem>(
+        {},
+        parallel_transforms ? ecs::ExecutionPolicy::Parallel : ecs::ExecutionPolicy::Sequential
+    );
+    // Renders with the final world matrices of this frame
+    register_system<SceneRenderingSystem>({TransformHierarchySystem::get_name()}, get_dependency<SchedulerModule>().get_scheduler());
+}
+
+SystemOrchestrator::~SystemOrchestrator()
+{
+    auto& registry = get_dependency<ecs::Registry>();
+    for (const auto& node : nodes)
+        node.system->unregister_from(registry);
+}
+
+void SystemOrchestrator::add_node(SystemNode&& node)
 {
+    PORTAL_ASSERT(!has_system(node.name), "System {} is already registered", node.name);
+
+    const auto prefix = fmt::format("systems.{}", node.name.string);
+    node.settings.enabled = settings.get_setting<bool>(fmt::format("{}.enabled", prefix), true);
+    node.settings.interval = std::max(settings.get_setting<uint32_t>(fmt::format("{}.interval", prefix), 1u), 1u);
+    node.settings.budget = settings.get_setting<float>(fmt::format("{}.budget", prefix), 0.f);
+
+    if (connected_dispatcher)
+        node.system->connect(get_dependency<ecs::Registry>(), *connected_dispatcher);
+
+    node.registration = next_registration++;
+    nodes.push_back(std::move(node));
+    build_schedule();
+}
+
+bool SystemOrchestrator::unregister_system(const StringId name)
+{
+    const auto it = std::ranges::find(nodes, name, &SystemNode::name);
+    if (it == nodes.end())
+    {
+        LOG_WARN_TAG("ECS", "Cannot unregister system {}, it is not registered", name);
+        return false;
+    }
+
     auto& registry = get_dependency<ecs::Registry>();
+    if (connected_dispatcher)
+        it->system->disconnect(registry, *connected_dispatcher);
+    it->system->unregister_from(registry);
 
-    player_input_system->register_to(registry);
-    camera_system->register_to(registry);
-    transform_system->register_to(registry);
-    scene_rendering_system->register_to(registry);
+    nodes.erase(it);
+    build_schedule();
+    return true;
+}
+
+bool SystemOrchestrator::has_system(const StringId name) const
+{
+    return find_node(name) != nullptr;
+}
+
+const SystemSettings* SystemOrchestrator::get_system_settings(const StringId name) const
+{
+    const auto* node = find_node(name);
+    return node ? &node->settings : nullptr;
+}
+
+void SystemOrchestrator::set_system_settings(const StringId name, const SystemSettings& system_settings)
+{
+    auto* node = find_node(name);
+    if (!node)
+    {
+        LOG_WARN_TAG("ECS", "Cannot change settings of system {}, it is not registered", name);
+        return;
+    }
+
+    node->settings = system_settings;
+    node->settings.interval = std::max(node->settings.interval, 1u);
+    node->frames_until_run = 0;
+}
+
+void SystemOrchestrator::set_system_enabled(const StringId name, const bool enabled)
+{
+    if (const auto* system_settings = get_system_settings(name))
+    {
+        auto new_settings = *system_settings;
+        new_settings.enabled = enabled;
+        set_system_settings(name, new_settings);
+    }
+    else
+    {
+        LOG_WARN_TAG("ECS", "Cannot change settings of system {}, it is not registered", name);
+    }
+}
+
+SystemOrchestrator::SystemNode* SystemOrchestrator::find_node(const StringId name)
+{
+    const auto it = std::ranges::find(nodes, name, &SystemNode::name);
+    return it == nodes.end() ? nullptr : &*it;
+}
+
+const SystemOrchestrator::SystemNode* SystemOrchestrator::find_node(const StringId name) const
+{
+    const auto it = std::ranges::find(nodes, name, &SystemNode::name);
+    return it == nodes.end() ? nullptr : &*it;
+}
+
+void SystemOrchestrator::sort_nodes()
+{
+    // Systems listed in `systems.order` come first in the listed order, the rest keep their registration order after them
+    std::vector<std::pair<size_t, uint64_t>> ranks;
+    ranks.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        const auto it = std::ranges::find(system_order, node.name.string);
+        ranks.emplace_back(static_cast<size_t>(std::distance(system_order.begin(), it)), node.registration);
+    }
+
+    // `run_after` is a hard edge, the order only decides between systems that are free to run
+    std::vector<size_t> remaining_dependencies(nodes.size(), 0);
+    std::vector<llvm::SmallVector<size_t, 4>> dependents(nodes.size());
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        for (const auto& name : nodes[index].run_after)
+        {
+            // Systems that are not registered yet are ordered once they are
+            const auto it = std::ranges::find(nodes, name, &SystemNode::name);
+            if (it == nodes.end())
+                continue;
+
+            const auto dependency = static_cast<size_t>(std::distance(nodes.begin(), it));
+            dependents[dependency].push_back(index);
+            ++remaining_dependencies[index];
+
+            if (ranks[dependency].first < system_order.size() && ranks[index].first < ranks[dependency].first)
+            {
+                LOG_WARN_TAG(
+                    "ECS",
+                    "systems.order lists {} before {}, but it runs after it, ignoring the configured order",
+                    nodes[index].name,
+                    name
+                );
+            }
+        }
+    }
+
+    std::vector<size_t> order;
+    order.reserve(nodes.size());
+    std::vector<size_t> ready;
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        if (remaining_dependencies[index] == 0)
+            ready.push_back(index);
+    }
+
+    while (!ready.empty())
+    {
+        const auto next = std::ranges::min_element(ready, {}, [&ranks](const size_t index) { return ranks[index]; });
+        const auto index = *next;
+        ready.erase(next);
+        order.push_back(index);
+
+        for (const auto dependent : dependents[index])
+        {
+            if (--remaining_dependencies[dependent] == 0)
+                ready.push_back(dependent);
+        }
+    }
+
+    if (order.size() != nodes.size())
+    {
+        LOG_ERROR_TAG("ECS", "Systems have cyclic run_after dependencies, the systems in the cycle run in the configured order");
+        std::vector<size_t> cyclic;
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (remaining_dependencies[index] > 0)
+                cyclic.push_back(index);
+        }
+        std::ranges::sort(cyclic, {}, [&ranks](const size_t index) { return ranks[index]; });
+        order.insert(order.end(), cyclic.begin(), cyclic.end());
+    }
+
+    // Nodes are kept in execution order, which is also the order the timings are reported in
+    std::vector<SystemNode> sorted;
+    sorted.reserve(nodes.size());
+    for (const auto index : order)
+        sorted.push_back(std::move(nodes[index]));
+    nodes = std::move(sorted);
+}
+
+void SystemOrchestrator::build_schedule()
+{
+    sort_nodes();
+
+    std::vector<size_t> node_waves(nodes.size(), 0);
+    waves.clear();
+
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        const auto& node = nodes[index];
+        for (size_t previous = 0; previous < index; ++previous)
+        {
+            const auto& other = nodes[previous];
+            const bool ordered = std::ranges::find(node.run_after, other.name) != node.run_after.end();
+            if (ordered || node.access.conflicts_with(other.access))
+                node_waves[index] = std::max(node_waves[index], node_waves[previous] + 1);
+        }
+
+        if (node_waves[index] >= waves.size())
+            waves.resize(node_waves[index] + 1);
+        waves[node_waves[index]].push_back(index);
+    }
+
+    should_run.resize(nodes.size());
+    LOG_DEBUG_TAG("ECS", "Scheduled {} systems in {} waves", nodes.size(), waves.size());
 }
 
 void SystemOrchestrator::clean()
@@ -37,20 +252,19 @@ void SystemOrchestrator::connect(entt::dispatcher& dispatcher)
 {
     auto& registry = get_dependency<ecs::Registry>();
 
-    player_input_system->connect(registry, dispatcher);
-    camera_system->connect(registry, dispatcher);
-    transform_system->connect(registry, dispatcher);
-    scene_rendering_system->connect(registry, dispatcher);
+    for (const auto& node : nodes)
+        node.system->connect(registry, dispatcher);
+    connected_dispatcher = &dispatcher;
 }
 
 void SystemOrchestrator::disconnect(entt::dispatcher& dispatcher)
 {
     auto& registry = get_dependency<ecs::Registry>();
 
-    player_input_system->disconnect(registry, dispatcher);
-    camera_system->disconnect(registry, dispatcher);
-    transform_system->disconnect(registry, dispatcher);
-    scene_rendering_system->disconnect(registry, dispatcher);
+    for (const auto& node : nodes)
+        node.system->disconnect(registry, dispatcher);
+    if (connected_dispatcher == &dispatcher)
+        connected_dispatcher = nullptr;
 }
 
 void SystemOrchestrator::set_active_scene(const ResourceReference<Scene>& scene)
@@ -69,9 +283,74 @@ void SystemOrchestrator::update(FrameContext& frame)
     auto& scheduler = get_dependency<SchedulerModule>().get_scheduler();
 
     PORTAL_ASSERT(frame.ecs_registry != nullptr, "Invalid registry, cannot run systems");
-    player_input_system->_execute(frame, *frame.ecs_registry, scheduler, nullptr);
-    camera_system->_execute(frame, *frame.ecs_registry, scheduler, nullptr);
-    transform_system->_execute(frame, *frame.ecs_registry, scheduler, nullptr);
-    scene_rendering_system->_execute(frame, *frame.ecs_registry, scheduler, nullptr);
+    frame.stats.system_timing_count = std::min(nodes.size(), FrameStats::MAX_SYSTEM_TIMINGS);
+
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        auto& node = nodes[index];
+        should_run[index] = node.settings.enabled && node.frames_until_run == 0;
+        if (node.settings.enabled && node.frames_until_run > 0)
+            --node.frames_until_run;
+
+        if (!should_run[index] && index < FrameStats::MAX_SYSTEM_TIMINGS)
+            frame.stats.system_timings[index] = {node.name, 0.f};
+    }
+
+    llvm::SmallVector<size_t, 4> running;
+    llvm::SmallVector<Job<>> jobs;
+    for (const auto& wave : waves)
+    {
+        running.clear();
+        for (const auto index : wave)
+        {
+            if (should_run[index])
+                running.push_back(index);
+        }
+
+        // No point paying for a job when nothing runs next to it
+        if (running.size() == 1)
+        {
+            run_system(running.front(), frame, scheduler);
+            continue;
+        }
+
+        jobs.clear();
+        for (const auto index : running)
+            jobs.push_back(run_system_job(*this, index, frame, scheduler));
+        if (!jobs.empty())
+            scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+    }
+}
+
+void SystemOrchestrator::run_system(const size_t index, FrameContext& frame, jobs::Scheduler& scheduler)
+{
+    auto& node = nodes[index];
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Parallel systems dispatch their own jobs, the system is only done once those finish
+    jobs::Counter counter{};
+    node.execute(*node.system, frame, *frame.ecs_registry, scheduler, &counter);
+    scheduler.wait_for_counter(counter);
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    const float elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.f;
+    if (index < FrameStats::MAX_SYSTEM_TIMINGS)
+        frame.stats.system_timings[index] = {node.name, elapsed};
+
+    uint32_t interval = node.settings.interval;
+    if (node.settings.budget > 0.f)
+    {
+        // Spread the cost of the system so its average per frame time stays under the budget
+        const auto budget_interval = static_cast<uint32_t>(std::ceil(elapsed / node.settings.budget));
+        interval = std::max(interval, std::min(budget_interval, SystemSettings::MAX_BUDGET_INTERVAL));
+    }
+    node.frames_until_run = interval - 1;
+}
+
+Job<> SystemOrchestrator::run_system_job(SystemOrchestrator& orchestrator, const size_t index, FrameContext& frame, jobs::Scheduler& scheduler)
+{
+    PORTAL_PROF_ZONE();
+    orchestrator.run_system(index, frame, scheduler);
+    co_return;
 }
 } // portal
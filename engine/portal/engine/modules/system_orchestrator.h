@@ -6,8 +6,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
+#include <llvm/ADT/SmallVector.h>
 
 #include "scheduler_module.h"
+#include "portal/application/settings.h"
 #include "portal/application/modules/module.h"
 #include "portal/input/input_manager.h"
 #include "portal/engine/ecs/registry.h"
@@ -19,19 +23,95 @@
 
 namespace portal
 {
+/**
+ * @brief Scheduling controls of a single system, adjustable at runtime.
+ */
+struct SystemSettings
+{
+    bool enabled = true;
+    // Run once every `interval` frames
+    uint32_t interval = 1;
+    // Average time in milliseconds the system may take per frame, a system that runs longer is spread over more
+    // frames (up to `MAX_BUDGET_INTERVAL`). 0 disables the budget
+    float budget = 0.f;
 
-// TODO: support dependencies between systems and parallel system execution
-// TODO: support dynamic system declaration
-// TODO: support creating system stack from file
+    constexpr static uint32_t MAX_BUDGET_INTERVAL = 16;
+};
+
+/**
+ * @brief Owns the ECS systems and runs them every frame.
+ *
+ * Systems are scheduled from the components they read and write (see `ecs::ComponentAccess`), plus an optional
+ * explicit ordering. A system depends on every earlier system it conflicts with or is explicitly ordered after, and the
+ * systems are grouped into waves where each wave only depends on the waves before it. The systems of a wave run
+ * concurrently as jobs, so a system must not touch components it does not declare, or create component storages while
+ * running (storages of declared components are created on registration).
+ *
+ * Systems are registered at runtime with `register_system`. Systems always run after the systems in their `run_after`,
+ * other conflicting systems run in registration order, unless overridden by `systems.order` (a list of system names)
+ * in the project settings. The settings of each system are loaded from `systems.<name>` (`enabled`, `interval` and
+ * `budget`).
+ *
+ * Systems are stored type erased and called through a trampoline, the per entity work stays in the CRTP `ecs::System`.
+ * Throttled systems still receive the delta time of the frame they run in.
+ *
+ * The time spent in each system is reported in `FrameStats::system_timings`.
+ */
 class SystemOrchestrator final : public TaggedModule<Tag<ModuleTags::Update, ModuleTags::FrameLifecycle>, ecs::Registry, SchedulerModule, InputManager>
 {
 public:
-    explicit SystemOrchestrator(ModuleStack& stack);
+    explicit SystemOrchestrator(ModuleStack& stack, ProjectSettings& settings);
+    ~SystemOrchestrator() override;
+
     void clean();
 
     void connect(entt::dispatcher& dispatcher);
     void disconnect(entt::dispatcher& dispatcher);
 
+    /**
+     * @brief Creates a system, registers it to the registry and adds it to the schedule.
+     *
+     * Must not be called while the systems are running (from within a system).
+     *
+     * @param run_after Systems that must finish before this one, even if they do not conflict
+     * @param args Arguments forwarded to the system constructor
+     * @return The registered system
+     */
+    template <typename T, typename... Args> requires std::derived_from<T, ecs::SystemBase>
+    T& register_system(std::initializer_list<StringId> run_after, Args&&... args)
+    {
+        auto system = std::make_unique<T>(std::forward<Args>(args)...);
+        auto& system_ref = *system;
+        system_ref.register_to(get_dependency<ecs::Registry>());
+
+        add_node(
+            SystemNode{
+                .name = T::get_name(),
+                .system = std::move(system),
+                .execute = &execute_trampoline<T>,
+                .access = T::get_component_access(),
+                .run_after = run_after,
+            }
+        );
+        return system_ref;
+    }
+
+    /**
+     * @brief Removes a system from the schedule and destroys it.
+     *
+     * @return false if no system with this name is registered
+     */
+    bool unregister_system(StringId name);
+
+    [[nodiscard]] bool has_system(StringId name) const;
+
+    /**
+     * @brief Returns the settings of a system, or nullptr if it is not registered.
+     */
+    [[nodiscard]] const SystemSettings* get_system_settings(StringId name) const;
+    void set_system_settings(StringId name, const SystemSettings& system_settings);
+    void set_system_enabled(StringId name, bool enabled);
+
     void set_active_scene(const ResourceReference<Scene>& scene);
     [[nodiscard]] ResourceReference<Scene> get_active_scene() const { return active_scene; }
 
@@ -39,11 +119,57 @@ public:
     void update(FrameContext& frame) override;
 
 private:
+    using ExecuteTrampoline = void (*)(ecs::SystemBase&, FrameContext&, ecs::Registry&, jobs::Scheduler&, jobs::Counter*);
+
+    struct SystemNode
+    {
+        StringId name;
+        std::unique_ptr<ecs::SystemBase> system;
+        ExecuteTrampoline execute;
+        ecs::ComponentAccess access;
+        llvm::SmallVector<StringId, 2> run_after;
+
+        SystemSettings settings{};
+        uint32_t frames_until_run = 0;
+        // Breaks ties between systems that are not in `systems.order`
+        uint64_t registration = 0;
+    };
+
+    template <typename T>
+    static void execute_trampoline(
+        ecs::SystemBase& system,
+        FrameContext& frame,
+        ecs::Registry& registry,
+        jobs::Scheduler& scheduler,
+        jobs::Counter* counter
+    )
+    {
+        static_cast<T&>(system)._execute(frame, registry, scheduler, counter);
+    }
+
+    void add_node(SystemNode&& node);
+    [[nodiscard]] SystemNode* find_node(StringId name);
+    [[nodiscard]] const SystemNode* find_node(StringId name) const;
+
+    // Orders the nodes by their `run_after` constraints, then by `systems.order` and registration order
+    void sort_nodes();
+    void build_schedule();
+    void run_system(size_t index, FrameContext& frame, jobs::Scheduler& scheduler);
+    static Job<> run_system_job(SystemOrchestrator& orchestrator, size_t index, FrameContext& frame, jobs::Scheduler& scheduler);
+
+private:
+    ProjectSettings& settings;
     ResourceReference<Scene> active_scene;
+    entt::dispatcher* connected_dispatcher = nullptr;
+
+    // Names from `systems.order`, conflicting systems run in this order
+    std::vector<std::string> system_order;
+    uint64_t next_registration = 0;
 
-    std::unique_ptr<BasePlayerInputSystem> player_input_system;
-    std::unique_ptr<BaseCameraSystem> camera_system;
-    std::unique_ptr<TransformHierarchySystem> transform_system;
-    std::unique_ptr<SceneRenderingSystem> scene_rendering_system;
+    std::vector<SystemNode> nodes;
+    // Indices into `nodes`, the systems of a wave may run concurrently
+    std::vector<llvm::SmallVector<size_t, 4>> waves;
+    // Scratch, the nodes that run this frame
+    std::vector<uint8_t> should_run;
 };
 } // portal
@@ -54,8 +54,8 @@ public:
     [[nodiscard]] static std::filesystem::path get_engine_resource_directory();
     [[nodiscard]] static std::filesystem::path get_engine_config_directory();
 
-    [[nodiscard]] ResourceDatabase& get_resource_database() { return resource_database; }
-    [[nodiscard]] const ResourceDatabase& get_resource_database() const { return resource_database; }
+    [[nodiscard]] ResourceDatabaseFacade& get_resource_database() { return resource_database; }
+    [[nodiscard]] const ResourceDatabaseFacade& get_resource_database() const { return resource_database; }
 
 private:
     Project(ProjectType type, ProjectProperties project_properties, std::filesystem::path working_directory, ProjectSettings&& settings);
@@ -0,0 +1,230 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "bounding_volume_hierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <ranges>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/debug/assert.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/jobs/scheduler.h"
+
+namespace portal::renderer
+{
+void BoundingVolumeHierarchy::build(const std::span<const BoundingBox> boxes)
+{
+    PORTAL_PROF_ZONE();
+
+    nodes.clear();
+    items.resize(boxes.size());
+    std::iota(items.begin(), items.end(), 0u);
+    item_boxes.assign(boxes.begin(), boxes.end());
+
+    if (boxes.empty())
+        return;
+
+    // A binary tree with up to LEAF_SIZE items per leaf
+    nodes.reserve(2 * (boxes.size() / LEAF_SIZE + 1));
+    build_node(0, static_cast<uint32_t>(boxes.size()));
+
+    for (size_t i = 0; i < items.size(); ++i)
+        item_boxes[i] = boxes[items[i]];
+}
+
+uint32_t BoundingVolumeHierarchy::build_node(const uint32_t begin, const uint32_t end)
+{
+    const auto index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({});
+
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    glm::vec3 centroid_min = min;
+    glm::vec3 centroid_max = max;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const auto& box = item_boxes[items[i]];
+        min = glm::min(min, box.center - box.extents);
+        max = glm::max(max, box.center + box.extents);
+        centroid_min = glm::min(centroid_min, box.center);
+        centroid_max = glm::max(centroid_max, box.center);
+    }
+
+    uint32_t right = 0;
+    if (end - begin > LEAF_SIZE)
+    {
+        const auto centroid_size = centroid_max - centroid_min;
+        int axis = 0;
+        if (centroid_size.y > centroid_size[axis])
+            axis = 1;
+        if (centroid_size.z > centroid_size[axis])
+            axis = 2;
+
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(
+            items.begin() + begin,
+            items.begin() + middle,
+            items.begin() + end,
+            [this, axis](const uint32_t lhs, const uint32_t rhs)
+            {
+                return item_boxes[lhs].center[axis] < item_boxes[rhs].center[axis];
+            }
+        );
+
+        build_node(begin, middle);
+        right = build_node(middle, end);
+    }
+
+    // `nodes` may have grown, don't keep a reference across the recursion
+    nodes[index] = Node{min, begin, max, end - begin, right};
+    return index;
+}
+
+void BoundingVolumeHierarchy::refit(const std::span<const BoundingBox> boxes)
+{
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(boxes.size() == items.size(), "Refit requires the same boxes the tree was built with");
+
+    for (size_t i = 0; i < items.size(); ++i)
+        item_boxes[i] = boxes[items[i]];
+
+    // Children always come after their parent
+    for (auto& node : std::ranges::reverse_view(nodes))
+    {
+        if (node.right == 0)
+        {
+            node.min = glm::vec3{std::numeric_limits<float>::max()};
+            node.max = glm::vec3{std::numeric_limits<float>::lowest()};
+            for (uint32_t i = node.item_begin; i < node.item_begin + node.item_count; ++i)
+            {
+                node.min = glm::min(node.min, item_boxes[i].center - item_boxes[i].extents);
+                node.max = glm::max(node.max, item_boxes[i].center + item_boxes[i].extents);
+            }
+        }
+        else
+        {
+            const auto& left = *(&node + 1);
+            const auto& right = nodes[node.right];
+            node.min = glm::min(left.min, right.min);
+            node.max = glm::max(left.max, right.max);
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const
+{
+    PORTAL_PROF_ZONE();
+
+    visible.clear();
+    if (!nodes.empty())
+        cull_subtree(frustum, 0, visible);
+}
+
+void BoundingVolumeHierarchy::cull(const Frustum& frustum, jobs::Scheduler& scheduler, std::vector<uint32_t>& visible)
+{
+    PORTAL_PROF_ZONE();
+
+    visible.clear();
+    if (nodes.empty())
+        return;
+
+    // Expand the top of the tree breadth first until there are enough independent subtrees. Only intersecting nodes
+    // are expanded (and not tested again), nodes inside or outside the frustum stay task roots that their job tests again
+    task_roots.clear();
+    task_roots.push_back(0);
+    size_t expanded = 0;
+    while (task_roots.size() - expanded < TASK_COUNT && expanded < task_roots.size())
+    {
+        const auto& node = nodes[task_roots[expanded]];
+        if (node.right == 0)
+        {
+            ++expanded;
+            continue;
+        }
+
+        const auto visibility = frustum.test((node.min + node.max) * 0.5f, (node.max - node.min) * 0.5f);
+        if (visibility != Visibility::Intersecting)
+        {
+            ++expanded;
+            continue;
+        }
+
+        // Replace the node by its children, keeping the tree order so the output order does not depend on the split
+        const auto left_index = task_roots[expanded] + 1;
+        const auto right_index = node.right;
+        task_roots[expanded] = left_index;
+        task_roots.insert(task_roots.begin() + static_cast<std::ptrdiff_t>(expanded) + 1, right_index);
+    }
+
+    task_visible.resize(task_roots.size());
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(task_roots.size());
+    for (size_t i = 0; i < task_roots.size(); ++i)
+    {
+        task_visible[i].clear();
+        jobs.push_back(cull_subtree_job(*this, frustum, task_roots[i], task_visible[i]));
+    }
+    scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+
+    for (const auto& task_result : task_visible)
+        visible.insert(visible.end(), task_result.begin(), task_result.end());
+}
+
+void BoundingVolumeHierarchy::cull_subtree(const Frustum& frustum, const uint32_t root, std::vector<uint32_t>& visible) const
+{
+    llvm::SmallVector<uint32_t, 64> pending;
+    pending.push_back(root);
+    while (!pending.empty())
+    {
+        const auto& node = nodes[pending.pop_back_val()];
+
+        const auto visibility = frustum.test((node.min + node.max) * 0.5f, (node.max - node.min) * 0.5f);
+        if (visibility == Visibility::Outside)
+            continue;
+
+        if (visibility == Visibility::Inside)
+        {
+            emit_items(node, visible);
+            continue;
+        }
+
+        if (node.right != 0)
+        {
+            // Right first, so the left subtree is popped (and emitted) first
+            pending.push_back(node.right);
+            pending.push_back(static_cast<uint32_t>(&node - nodes.data()) + 1);
+            continue;
+        }
+
+        for (uint32_t i = node.item_begin; i < node.item_begin + node.item_count; ++i)
+        {
+            if (frustum.test(item_boxes[i]) != Visibility::Outside)
+                visible.push_back(items[i]);
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::emit_items(const Node& node, std::vector<uint32_t>& visible) const
+{
+    const auto begin = items.begin() + node.item_begin;
+    visible.insert(visible.end(), begin, begin + node.item_count);
+}
+
+Job<> BoundingVolumeHierarchy::cull_subtree_job(
+    const BoundingVolumeHierarchy& bvh,
+    const Frustum& frustum,
+    const uint32_t root,
+    std::vector<uint32_t>& visible
+)
+{
+    PORTAL_PROF_ZONE();
+    bvh.cull_subtree(frustum, root, visible);
+    co_return;
+}
+} // portal
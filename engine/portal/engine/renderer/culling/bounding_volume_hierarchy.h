@@ -0,0 +1,103 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "portal/core/jobs/job.h"
+#include "portal/engine/renderer/culling/frustum.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+}
+
+namespace portal::renderer
+{
+/**
+ * @brief Bounding volume hierarchy over a set of boxes, used to frustum cull the scene on the CPU.
+ *
+ * Nodes are stored in depth first order, so every subtree covers a contiguous range of items and the left child of a
+ * node directly follows it. `build` splits the boxes at the median of the longest centroid axis, `refit` only
+ * recomputes the node bounds for boxes that moved and is much cheaper, but the tree quality degrades when boxes move
+ * far from where they were when the tree was built.
+ *
+ * Culling skips whole subtrees outside the frustum and emits subtrees fully inside it without testing their boxes.
+ * The parallel overload splits the top of the tree into independent subtrees that are culled as jobs.
+ *
+ * @par Example:
+ * @code
+ * bvh.build(boxes);
+ * std::vector<uint32_t> visible;
+ * bvh.cull(Frustum(view_projection), scheduler, visible);
+ * @endcode
+ */
+class BoundingVolumeHierarchy
+{
+public:
+    /** @brief Maximum number of boxes in a leaf */
+    constexpr static uint32_t LEAF_SIZE = 4;
+    /** @brief Number of subtrees the parallel cull aims for */
+    constexpr static size_t TASK_COUNT = 64;
+
+    /**
+     * @brief Builds the tree over `boxes`, item `i` of the tree is `boxes[i]`.
+     */
+    void build(std::span<const BoundingBox> boxes);
+
+    /**
+     * @brief Updates the bounds of the tree without changing its structure.
+     *
+     * @param boxes The new boxes, must have the same count (and meaning) as the ones the tree was built with
+     */
+    void refit(std::span<const BoundingBox> boxes);
+
+    /**
+     * @brief Writes the indices of the boxes that are at least partially inside the frustum to `visible`.
+     */
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+    /**
+     * @brief Parallel version of `cull`, the result is the same (including the order).
+     */
+    void cull(const Frustum& frustum, jobs::Scheduler& scheduler, std::vector<uint32_t>& visible);
+
+    [[nodiscard]] size_t size() const { return items.size(); }
+    [[nodiscard]] size_t get_node_count() const { return nodes.size(); }
+
+private:
+    struct Node
+    {
+        glm::vec3 min;
+        uint32_t item_begin;
+        glm::vec3 max;
+        uint32_t item_count;
+        // Index of the right child, 0 for leaves (the root is never a right child)
+        uint32_t right;
+    };
+
+    uint32_t build_node(uint32_t begin, uint32_t end);
+    void cull_subtree(const Frustum& frustum, uint32_t root, std::vector<uint32_t>& visible) const;
+    void emit_items(const Node& node, std::vector<uint32_t>& visible) const;
+
+    static Job<> cull_subtree_job(const BoundingVolumeHierarchy& bvh, const Frustum& frustum, uint32_t root, std::vector<uint32_t>& visible);
+
+private:
+    std::vector<Node> nodes;
+    // Box indices in tree order
+    std::vector<uint32_t> items;
+    // Boxes in tree order, so leaves read them sequentially
+    std::vector<BoundingBox> item_boxes;
+
+    // Scratch for the parallel cull
+    std::vector<uint32_t> task_roots;
+    std::vector<std::vector<uint32_t>> task_visible;
+};
+} // portal
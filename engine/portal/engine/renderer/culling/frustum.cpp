@@ -0,0 +1,113 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "frustum.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PORTAL_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#else
+#define PORTAL_FRUSTUM_SSE 0
+#endif
+
+namespace portal::renderer
+{
+BoundingBox BoundingBox::from_transformed(const glm::mat4& matrix, const glm::vec3& center, const glm::vec3& extents)
+{
+    // The extents of the transformed box are the extents projected on the absolute basis (Arvo)
+    const glm::vec3 world_center = glm::vec3(matrix * glm::vec4(center, 1.f));
+    const glm::vec3 world_extents =
+        glm::abs(glm::vec3(matrix[0])) * extents.x +
+        glm::abs(glm::vec3(matrix[1])) * extents.y +
+        glm::abs(glm::vec3(matrix[2])) * extents.z;
+    return {world_center, world_extents};
+}
+
+Frustum::Frustum(const glm::mat4& view_projection)
+{
+    const auto row = [&view_projection](const int index)
+    {
+        return glm::vec4(view_projection[0][index], view_projection[1][index], view_projection[2][index], view_projection[3][index]);
+    };
+
+    const std::array<glm::vec4, PLANE_COUNT> planes{
+        row(3) + row(0), // left
+        row(3) - row(0), // right
+        row(3) + row(1), // bottom
+        row(3) - row(1), // top
+        row(2),          // near, depth is [0, 1]
+        row(3) - row(2), // far
+    };
+
+    for (size_t i = 0; i < PLANE_COUNT; ++i)
+    {
+        const auto plane = planes[i] / glm::length(glm::vec3(planes[i]));
+        normal_x[i] = plane.x;
+        normal_y[i] = plane.y;
+        normal_z[i] = plane.z;
+        distance[i] = plane.w;
+    }
+
+    for (size_t i = PLANE_COUNT; i < PADDED_PLANE_COUNT; ++i)
+        distance[i] = std::numeric_limits<float>::max();
+}
+
+Visibility Frustum::test(const glm::vec3& center, const glm::vec3& extents) const
+{
+#if PORTAL_FRUSTUM_SSE
+    const __m128 center_x = _mm_set1_ps(center.x);
+    const __m128 center_y = _mm_set1_ps(center.y);
+    const __m128 center_z = _mm_set1_ps(center.z);
+    const __m128 extents_x = _mm_set1_ps(extents.x);
+    const __m128 extents_y = _mm_set1_ps(extents.y);
+    const __m128 extents_z = _mm_set1_ps(extents.z);
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+
+    int outside = 0;
+    int intersecting = 0;
+    for (size_t i = 0; i < PADDED_PLANE_COUNT; i += 4)
+    {
+        const __m128 plane_x = _mm_load_ps(normal_x + i);
+        const __m128 plane_y = _mm_load_ps(normal_y + i);
+        const __m128 plane_z = _mm_load_ps(normal_z + i);
+
+        // Signed distance of the center, and the projected radius of the box on the plane normal
+        __m128 signed_distance = _mm_add_ps(_mm_mul_ps(plane_x, center_x), _mm_load_ps(distance + i));
+        signed_distance = _mm_add_ps(signed_distance, _mm_mul_ps(plane_y, center_y));
+        signed_distance = _mm_add_ps(signed_distance, _mm_mul_ps(plane_z, center_z));
+
+        __m128 radius = _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_x), extents_x);
+        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_y), extents_y));
+        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(sign_mask, plane_z), extents_z));
+
+        outside |= _mm_movemask_ps(_mm_cmplt_ps(signed_distance, _mm_xor_ps(radius, sign_mask)));
+        intersecting |= _mm_movemask_ps(_mm_cmplt_ps(signed_distance, radius));
+    }
+#else
+    bool outside = false;
+    bool intersecting = false;
+    for (size_t i = 0; i < PLANE_COUNT; ++i)
+    {
+        const float signed_distance = normal_x[i] * center.x + normal_y[i] * center.y + normal_z[i] * center.z + distance[i];
+        const float radius = std::abs(normal_x[i]) * extents.x + std::abs(normal_y[i]) * extents.y + std::abs(normal_z[i]) * extents.z;
+        outside |= signed_distance < -radius;
+        intersecting |= signed_distance < radius;
+    }
+#endif
+
+    if (outside)
+        return Visibility::Outside;
+    return intersecting ? Visibility::Intersecting : Visibility::Inside;
+}
+
+glm::vec4 Frustum::get_plane(const size_t index) const
+{
+    return {normal_x[index], normal_y[index], normal_z[index], distance[index]};
+}
+} // portal
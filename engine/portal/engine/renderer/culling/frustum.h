@@ -0,0 +1,67 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include "portal/core/glm.h"
+
+namespace portal::renderer
+{
+/**
+ * @brief Axis aligned bounding box, stored as center and half extents.
+ */
+struct BoundingBox
+{
+    glm::vec3 center{};
+    glm::vec3 extents{};
+
+    /**
+     * @brief Returns the bounding box of the local box (`center`, `extents`) after it is transformed by `matrix`.
+     */
+    [[nodiscard]] static BoundingBox from_transformed(const glm::mat4& matrix, const glm::vec3& center, const glm::vec3& extents);
+};
+
+/**
+ * @brief Result of testing a bounding volume against a frustum.
+ */
+enum class Visibility
+{
+    Outside,
+    Intersecting,
+    Inside
+};
+
+/**
+ * @brief View frustum as six inward facing planes, extracted from a view projection matrix with [0, 1] depth.
+ *
+ * The planes are stored as a structure of arrays padded to eight planes, so a bounding box is tested against four
+ * planes at a time with SSE where available.
+ */
+class Frustum
+{
+public:
+    constexpr static size_t PLANE_COUNT = 6;
+
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& view_projection);
+
+    [[nodiscard]] Visibility test(const glm::vec3& center, const glm::vec3& extents) const;
+    [[nodiscard]] Visibility test(const BoundingBox& box) const { return test(box.center, box.extents); }
+
+    /**
+     * @brief Returns plane `index` as (normal, distance), points inside the frustum have a positive signed distance.
+     */
+    [[nodiscard]] glm::vec4 get_plane(size_t index) const;
+
+private:
+    // Padding planes always pass
+    constexpr static size_t PADDED_PLANE_COUNT = 8;
+
+    alignas(16) float normal_x[PADDED_PLANE_COUNT] = {};
+    alignas(16) float normal_y[PADDED_PLANE_COUNT] = {};
+    alignas(16) float normal_z[PADDED_PLANE_COUNT] = {};
+    alignas(16) float distance[PADDED_PLANE_COUNT] = {};
+};
+} // portal
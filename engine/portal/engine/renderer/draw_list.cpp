@@ -0,0 +1,141 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "draw_list.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+#include "portal/core/debug/assert.h"
+#include "portal/core/debug/profile.h"
+
+namespace portal::renderer
+{
+uint16_t DrawKey::quantize_depth(const float depth, const float min_depth, const float max_depth)
+{
+    if (!(max_depth > min_depth))
+        return 0;
+
+    const float normalized = std::clamp((depth - min_depth) / (max_depth - min_depth), 0.f, 1.f);
+    return static_cast<uint16_t>(normalized * static_cast<float>(std::numeric_limits<uint16_t>::max()));
+}
+
+void radix_sort(const std::span<uint64_t> keys, const std::span<uint32_t> values, std::vector<uint64_t>& key_scratch, std::vector<uint32_t>& value_scratch)
+{
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(keys.size() == values.size(), "Radix sort requires a value per key");
+
+    constexpr size_t DIGIT_BITS = 8;
+    constexpr size_t DIGIT_COUNT = sizeof(uint64_t) * 8 / DIGIT_BITS;
+    constexpr size_t BUCKET_COUNT = 1 << DIGIT_BITS;
+
+    const size_t count = keys.size();
+    if (count < 2)
+        return;
+
+    key_scratch.resize(count);
+    value_scratch.resize(count);
+
+    // All the histograms are built in a single read of the keys
+    std::array<std::array<uint32_t, BUCKET_COUNT>, DIGIT_COUNT> histograms{};
+    for (const auto key : keys)
+    {
+        for (size_t digit = 0; digit < DIGIT_COUNT; ++digit)
+            ++histograms[digit][(key >> (digit * DIGIT_BITS)) & (BUCKET_COUNT - 1)];
+    }
+
+    uint64_t* source_keys = keys.data();
+    uint32_t* source_values = values.data();
+    uint64_t* target_keys = key_scratch.data();
+    uint32_t* target_values = value_scratch.data();
+
+    for (size_t digit = 0; digit < DIGIT_COUNT; ++digit)
+    {
+        const size_t shift = digit * DIGIT_BITS;
+        auto& histogram = histograms[digit];
+
+        // Every key has the same digit, the pass would not move anything
+        if (histogram[(source_keys[0] >> shift) & (BUCKET_COUNT - 1)] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& bucket : histogram)
+            offset += std::exchange(bucket, offset);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto position = histogram[(source_keys[i] >> shift) & (BUCKET_COUNT - 1)]++;
+            target_keys[position] = source_keys[i];
+            target_values[position] = source_values[i];
+        }
+
+        std::swap(source_keys, target_keys);
+        std::swap(source_values, target_values);
+    }
+
+    if (source_keys != keys.data())
+    {
+        std::copy_n(source_keys, count, keys.data());
+        std::copy_n(source_values, count, values.data());
+    }
+}
+
+void DrawList::clear()
+{
+    keys.clear();
+    objects.clear();
+    commands.clear();
+}
+
+void DrawList::reserve(const size_t count)
+{
+    keys.reserve(count);
+    objects.reserve(count);
+    commands.reserve(count);
+}
+
+void DrawList::add(const uint64_t key, const uint32_t object)
+{
+    keys.push_back(key);
+    objects.push_back(object);
+}
+
+void DrawList::build()
+{
+    PORTAL_PROF_ZONE();
+
+    radix_sort(keys, objects, key_scratch, object_scratch);
+
+    commands.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const auto key = keys[i];
+        DrawStateChanges changes = DrawStateBits::None;
+        if (i == 0)
+        {
+            changes = FlagTraits<DrawStateBits>::all_flags;
+        }
+        else
+        {
+            const auto previous = keys[i - 1];
+            const auto pipeline = DrawKey::get_pipeline(key);
+            const auto material = DrawKey::get_material(key);
+            const auto index_buffer = DrawKey::get_index_buffer(key);
+
+            // Binding a pipeline invalidates the material bindings
+            if (pipeline != DrawKey::get_pipeline(previous) || pipeline == DrawKey::OVERFLOW_ID)
+                changes |= DrawStateBits::Pipeline | DrawStateBits::Material;
+            if (material != DrawKey::get_material(previous) || material == DrawKey::OVERFLOW_ID)
+                changes |= DrawStateBits::Material;
+            if (index_buffer != DrawKey::get_index_buffer(previous) || index_buffer == DrawKey::OVERFLOW_ID)
+                changes |= DrawStateBits::IndexBuffer;
+        }
+
+        commands[i] = {objects[i], changes};
+    }
+}
+} // portal
@@ -0,0 +1,140 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "portal/core/flags.h"
+
+namespace portal::renderer
+{
+/**
+ * @brief The state a draw command has to bind before it is drawn.
+ */
+enum class DrawStateBits : uint8_t
+{
+    None        = 0b00000000,
+    Pipeline    = 0b00000001,
+    Material    = 0b00000010,
+    IndexBuffer = 0b00000100,
+};
+
+using DrawStateChanges = Flags<DrawStateBits>;
+} // portal
+
+template <>
+struct portal::FlagTraits<portal::renderer::DrawStateBits>
+{
+    static constexpr bool is_bitmask = true;
+    static constexpr Flags<renderer::DrawStateBits> all_flags = renderer::DrawStateBits::Pipeline | renderer::DrawStateBits::Material |
+        renderer::DrawStateBits::IndexBuffer;
+};
+
+namespace portal::renderer
+{
+/**
+ * @brief 64 bit draw sort key, from the most to the least significant 16 bits: pipeline, material, index buffer and depth.
+ *
+ * Sorting by the key groups draws by the most expensive state change first, and draws that share all their state
+ * front to back.
+ */
+struct DrawKey
+{
+    /** @brief State id used for state that did not fit in 16 bits, it never batches and is always rebound */
+    constexpr static uint16_t OVERFLOW_ID = 0xFFFF;
+
+    [[nodiscard]] static constexpr uint64_t make(const uint16_t pipeline, const uint16_t material, const uint16_t index_buffer, const uint16_t depth)
+    {
+        return static_cast<uint64_t>(pipeline) << 48 | static_cast<uint64_t>(material) << 32 | static_cast<uint64_t>(index_buffer) << 16 | depth;
+    }
+
+    [[nodiscard]] static constexpr uint16_t get_pipeline(const uint64_t key) { return static_cast<uint16_t>(key >> 48); }
+    [[nodiscard]] static constexpr uint16_t get_material(const uint64_t key) { return static_cast<uint16_t>(key >> 32); }
+    [[nodiscard]] static constexpr uint16_t get_index_buffer(const uint64_t key) { return static_cast<uint16_t>(key >> 16); }
+    [[nodiscard]] static constexpr uint16_t get_depth(const uint64_t key) { return static_cast<uint16_t>(key); }
+
+    /**
+     * @brief Maps `depth` in [`min_depth`, `max_depth`] to the 16 bit depth of a key, values outside the range are clamped.
+     */
+    [[nodiscard]] static uint16_t quantize_depth(float depth, float min_depth, float max_depth);
+};
+
+/**
+ * @brief A single draw in the command stream, with the state that changed since the previous command.
+ */
+struct DrawCommand
+{
+    uint32_t object;
+    DrawStateChanges changes;
+};
+
+/**
+ * @brief Stable LSD radix sort of `keys`, moving `values` along with them.
+ *
+ * Sorts 8 bits per pass, passes over digits shared by every key are skipped, so keys that only differ in a few bytes
+ * sort in a few passes.
+ *
+ * @param keys The keys to sort
+ * @param values The values attached to the keys, must have the same size as `keys`
+ * @param key_scratch Scratch buffer, resized to the number of keys
+ * @param value_scratch Scratch buffer, resized to the number of keys
+ */
+void radix_sort(std::span<uint64_t> keys, std::span<uint32_t> values, std::vector<uint64_t>& key_scratch, std::vector<uint32_t>& value_scratch);
+
+/**
+ * @brief Per frame list of draws, sorted by `DrawKey` and turned into a stream of draw commands.
+ *
+ * The list does not know anything about the GPU, objects are indices the recorder resolves (for example into a
+ * `RenderScene`). A command only carries the state bits that differ from the previous command, so the recorder binds
+ * each pipeline, material and index buffer once per batch.
+ *
+ * @par Example:
+ * @code
+ * draw_list.clear();
+ * for (const auto object : visible_objects)
+ *     draw_list.add(DrawKey::make(pipeline, material, index_buffer, depth), object);
+ * draw_list.build();
+ *
+ * for (const auto& [object, changes] : draw_list.get_commands())
+ * {
+ *     if (changes & DrawStateBits::Pipeline)
+ *         bind_pipeline(object);
+ *     draw(object);
+ * }
+ * @endcode
+ */
+class DrawList
+{
+public:
+    void clear();
+    void reserve(size_t count);
+
+    void add(uint64_t key, uint32_t object);
+
+    /**
+     * @brief Sorts the draws by key and builds the command stream.
+     */
+    void build();
+
+    [[nodiscard]] size_t size() const { return keys.size(); }
+    [[nodiscard]] bool empty() const { return keys.empty(); }
+
+    /** @brief The sorted keys, valid after `build` */
+    [[nodiscard]] std::span<const uint64_t> get_keys() const { return keys; }
+    /** @brief The draw commands in submission order, valid after `build` */
+    [[nodiscard]] std::span<const DrawCommand> get_commands() const { return commands; }
+
+private:
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> objects;
+    std::vector<DrawCommand> commands;
+
+    std::vector<uint64_t> key_scratch;
+    std::vector<uint32_t> object_scratch;
+};
+} // portal
@@ -228,6 +228,9 @@ struct TextureProperties
     std::optional<SamplerProperties> sampler_prop = std::nullopt;
 
     bool generate_mipmaps = true;
+    // When not zero, the image data already holds this many mips, tightly packed starting from the full resolution one,
+    // and no mips are generated
+    uint32_t precomputed_mips = 0;
     bool storage = false;
     bool store_locally = false;
 };
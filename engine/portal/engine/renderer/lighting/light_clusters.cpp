@@ -0,0 +1,202 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <glm/gtc/constants.hpp>
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/debug/assert.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/jobs/scheduler.h"
+
+namespace portal::renderer
+{
+namespace
+{
+    bool sphere_intersects_box(const LightBounds& sphere, const BoundingBox& box)
+    {
+        const glm::vec3 distance = glm::max(glm::abs(sphere.center - box.center) - box.extents, glm::vec3{0.f});
+        return glm::dot(distance, distance) <= sphere.radius * sphere.radius;
+    }
+}
+
+LightBounds LightBounds::from_cone(const glm::vec3& apex, const glm::vec3& direction, const float range, const float half_angle)
+{
+    // Wide cones are bound by the sphere around their base, narrow ones by the sphere through the apex and the base rim
+    const float cos_angle = std::cos(half_angle);
+    if (half_angle > glm::quarter_pi<float>())
+        return {apex + direction * (range * cos_angle), range * std::sin(half_angle)};
+
+    const float radius = range / (2.f * cos_angle);
+    return {apex + direction * radius, radius};
+}
+
+void LightClusterGrid::configure(const glm::mat4& new_projection, const float new_near_depth, const float new_far_depth, const glm::uvec3& new_dimensions)
+{
+    if (new_projection == projection && new_near_depth == near_depth && new_far_depth == far_depth && new_dimensions == dimensions)
+        return;
+
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(new_near_depth > 0.f && new_far_depth > new_near_depth, "Invalid cluster depth range");
+    PORTAL_ASSERT(new_dimensions.x > 0 && new_dimensions.y > 0 && new_dimensions.z > 0, "Invalid cluster grid dimensions");
+
+    projection = new_projection;
+    near_depth = new_near_depth;
+    far_depth = new_far_depth;
+    dimensions = new_dimensions;
+
+    // Exponential slices keep the clusters roughly cubic along the view direction
+    slice_depths.resize(dimensions.z + 1);
+    for (uint32_t slice = 0; slice <= dimensions.z; ++slice)
+        slice_depths[slice] = near_depth * std::pow(far_depth / near_depth, static_cast<float>(slice) / static_cast<float>(dimensions.z));
+
+    // Direction of the ray through every tile corner, scaled so it reaches the depth `d` at `ray * d`
+    const auto inverse_projection = glm::inverse(projection);
+    std::vector<glm::vec3> corner_rays((dimensions.x + 1) * (dimensions.y + 1));
+    for (uint32_t y = 0; y <= dimensions.y; ++y)
+    {
+        for (uint32_t x = 0; x <= dimensions.x; ++x)
+        {
+            const glm::vec2 ndc{
+                -1.f + 2.f * static_cast<float>(x) / static_cast<float>(dimensions.x),
+                -1.f + 2.f * static_cast<float>(y) / static_cast<float>(dimensions.y)
+            };
+            const glm::vec4 point = inverse_projection * glm::vec4(ndc, 0.5f, 1.f);
+            const glm::vec3 view_point = glm::vec3(point) / point.w;
+            corner_rays[x + y * (dimensions.x + 1)] = view_point / -view_point.z;
+        }
+    }
+
+    cluster_bounds.resize(static_cast<size_t>(dimensions.x) * dimensions.y * dimensions.z);
+    for (uint32_t slice = 0; slice < dimensions.z; ++slice)
+    {
+        const std::array depths{slice_depths[slice], slice_depths[slice + 1]};
+        for (uint32_t y = 0; y < dimensions.y; ++y)
+        {
+            for (uint32_t x = 0; x < dimensions.x; ++x)
+            {
+                glm::vec3 min{std::numeric_limits<float>::max()};
+                glm::vec3 max{std::numeric_limits<float>::lowest()};
+                for (uint32_t corner = 0; corner < 4; ++corner)
+                {
+                    const uint32_t corner_x = x + (corner & 1);
+                    const uint32_t corner_y = y + (corner >> 1);
+                    for (const auto depth : depths)
+                    {
+                        const auto point = corner_rays[corner_x + corner_y * (dimensions.x + 1)] * depth;
+                        min = glm::min(min, point);
+                        max = glm::max(max, point);
+                    }
+                }
+                cluster_bounds[get_cluster_index(x, y, slice)] = {(min + max) * 0.5f, (max - min) * 0.5f};
+            }
+        }
+    }
+
+    clusters.assign(cluster_bounds.size(), {});
+    light_indices.clear();
+}
+
+void LightClusterGrid::assign(const std::span<const LightBounds> lights)
+{
+    PORTAL_PROF_ZONE();
+
+    slice_indices.resize(dimensions.z);
+    for (uint32_t slice = 0; slice < dimensions.z; ++slice)
+        assign_slice(lights, slice, slice_indices[slice]);
+    pack_slices();
+}
+
+void LightClusterGrid::assign(const std::span<const LightBounds> lights, jobs::Scheduler& scheduler)
+{
+    PORTAL_PROF_ZONE();
+
+    slice_indices.resize(dimensions.z);
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(dimensions.z);
+    for (uint32_t slice = 0; slice < dimensions.z; ++slice)
+        jobs.push_back(assign_slice_job(*this, lights, slice, slice_indices[slice]));
+    scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+
+    pack_slices();
+}
+
+uint32_t LightClusterGrid::get_slice(const float depth) const
+{
+    if (depth <= near_depth)
+        return 0;
+
+    const float slice = std::log(depth / near_depth) / std::log(far_depth / near_depth) * static_cast<float>(dimensions.z);
+    return std::min(static_cast<uint32_t>(slice), dimensions.z - 1);
+}
+
+void LightClusterGrid::assign_slice(const std::span<const LightBounds> lights, const uint32_t slice, std::vector<uint32_t>& indices)
+{
+    indices.clear();
+
+    // Only the lights reaching the depth range of the slice are tested against its clusters
+    llvm::SmallVector<uint32_t, 64> candidates;
+    const float slice_near = slice_depths[slice];
+    const float slice_far = slice_depths[slice + 1];
+    for (uint32_t light = 0; light < lights.size(); ++light)
+    {
+        const float depth = -lights[light].center.z;
+        if (depth + lights[light].radius >= slice_near && depth - lights[light].radius <= slice_far)
+            candidates.push_back(light);
+    }
+
+    const uint32_t first_cluster = get_cluster_index(0, 0, slice);
+    const uint32_t slice_cluster_count = dimensions.x * dimensions.y;
+    for (uint32_t cluster = first_cluster; cluster < first_cluster + slice_cluster_count; ++cluster)
+    {
+        const auto offset = static_cast<uint32_t>(indices.size());
+        for (const auto light : candidates)
+        {
+            if (sphere_intersects_box(lights[light], cluster_bounds[cluster]))
+                indices.push_back(light);
+        }
+        clusters[cluster] = {offset, static_cast<uint32_t>(indices.size()) - offset};
+    }
+}
+
+void LightClusterGrid::pack_slices()
+{
+    size_t total = 0;
+    for (const auto& indices : slice_indices)
+        total += indices.size();
+
+    light_indices.clear();
+    light_indices.reserve(total);
+
+    const uint32_t slice_cluster_count = dimensions.x * dimensions.y;
+    for (uint32_t slice = 0; slice < dimensions.z; ++slice)
+    {
+        const auto base = static_cast<uint32_t>(light_indices.size());
+        const uint32_t first_cluster = get_cluster_index(0, 0, slice);
+        for (uint32_t cluster = first_cluster; cluster < first_cluster + slice_cluster_count; ++cluster)
+            clusters[cluster].offset += base;
+
+        light_indices.insert(light_indices.end(), slice_indices[slice].begin(), slice_indices[slice].end());
+    }
+}
+
+Job<> LightClusterGrid::assign_slice_job(
+    LightClusterGrid& grid,
+    const std::span<const LightBounds> lights,
+    const uint32_t slice,
+    std::vector<uint32_t>& indices
+)
+{
+    PORTAL_PROF_ZONE();
+    grid.assign_slice(lights, slice, indices);
+    co_return;
+}
+} // portal
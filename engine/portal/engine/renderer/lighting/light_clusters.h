@@ -0,0 +1,140 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "portal/core/glm.h"
+#include "portal/core/jobs/job.h"
+#include "portal/engine/renderer/culling/frustum.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+}
+
+namespace portal::renderer
+{
+/**
+ * @brief View space bounding sphere of a light, the camera looks down -z.
+ */
+struct LightBounds
+{
+    glm::vec3 center{};
+    float radius = 0.f;
+
+    /**
+     * @brief Returns the bounding sphere of a spot light cone.
+     *
+     * @param apex The position of the light
+     * @param direction The normalized direction of the cone
+     * @param range The length of the cone
+     * @param half_angle Half of the cone opening angle, in radians
+     */
+    [[nodiscard]] static LightBounds from_cone(const glm::vec3& apex, const glm::vec3& direction, float range, float half_angle);
+};
+
+/**
+ * @brief Offset and count of a cluster's lights in `LightClusterGrid::get_light_indices`.
+ */
+struct LightCluster
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+/**
+ * @brief Bins lights into view space clusters (froxels), so shading only considers the lights that can reach a pixel.
+ *
+ * The view frustum is split into a grid of screen tiles and exponentially distributed depth slices. Every cluster
+ * lists the indices of the lights whose bounding sphere overlaps the cluster's view space bounding box, the lists of
+ * all clusters are packed in a single index array.
+ *
+ * Cluster `(x, y, slice)` is stored at `x + y * tiles_x + slice * tiles_x * tiles_y`, tiles are laid out in the NDC of
+ * the projection the grid was configured with.
+ *
+ * @par Example:
+ * @code
+ * grid.configure(projection, near_depth, far_depth);
+ * grid.assign(lights, scheduler);
+ *
+ * const auto& cluster = grid.get_clusters()[grid.get_cluster_index(x, y, grid.get_slice(depth))];
+ * for (const auto light : grid.get_light_indices().subspan(cluster.offset, cluster.count))
+ *     shade(light);
+ * @endcode
+ */
+class LightClusterGrid
+{
+public:
+    constexpr static uint32_t DEFAULT_TILES_X = 16;
+    constexpr static uint32_t DEFAULT_TILES_Y = 9;
+    constexpr static uint32_t DEFAULT_SLICES = 24;
+
+    /**
+     * @brief Computes the cluster bounds, does nothing when the arguments did not change since the last call.
+     *
+     * @param projection The camera projection, depth in [0, 1] (either direction)
+     * @param near_depth The distance of the near plane
+     * @param far_depth The distance of the far plane
+     * @param dimensions Number of tiles along x and y, and number of depth slices
+     */
+    void configure(const glm::mat4& projection, float near_depth, float far_depth, const glm::uvec3& dimensions = {DEFAULT_TILES_X, DEFAULT_TILES_Y, DEFAULT_SLICES});
+
+    /**
+     * @brief Assigns `lights` to the clusters, light `i` is referenced by index `i`.
+     */
+    void assign(std::span<const LightBounds> lights);
+
+    /**
+     * @brief Parallel version of `assign`, every depth slice is binned by its own job, the result is the same.
+     */
+    void assign(std::span<const LightBounds> lights, jobs::Scheduler& scheduler);
+
+    /**
+     * @brief Returns the depth slice containing the view space `depth` (a positive distance), clamped to the grid.
+     */
+    [[nodiscard]] uint32_t get_slice(float depth) const;
+
+    [[nodiscard]] uint32_t get_cluster_index(const uint32_t x, const uint32_t y, const uint32_t slice) const
+    {
+        return x + y * dimensions.x + slice * dimensions.x * dimensions.y;
+    }
+
+    [[nodiscard]] const glm::uvec3& get_dimensions() const { return dimensions; }
+    [[nodiscard]] size_t get_cluster_count() const { return clusters.size(); }
+
+    [[nodiscard]] std::span<const LightCluster> get_clusters() const { return clusters; }
+    [[nodiscard]] std::span<const uint32_t> get_light_indices() const { return light_indices; }
+    /** @brief The view space bounding box of every cluster */
+    [[nodiscard]] std::span<const BoundingBox> get_cluster_bounds() const { return cluster_bounds; }
+
+private:
+    void assign_slice(std::span<const LightBounds> lights, uint32_t slice, std::vector<uint32_t>& indices);
+    void pack_slices();
+
+    static Job<> assign_slice_job(LightClusterGrid& grid, std::span<const LightBounds> lights, uint32_t slice, std::vector<uint32_t>& indices);
+
+private:
+    glm::mat4 projection{0.f};
+    float near_depth = 0.f;
+    float far_depth = 0.f;
+    glm::uvec3 dimensions{0};
+
+    std::vector<BoundingBox> cluster_bounds;
+    // Depth of the slice boundaries, `dimensions.z + 1` entries
+    std::vector<float> slice_depths;
+
+    std::vector<LightCluster> clusters;
+    std::vector<uint32_t> light_indices;
+
+    // Per slice scratch, cluster offsets are relative to their slice until packed
+    std::vector<std::vector<uint32_t>> slice_indices;
+};
+} // portal
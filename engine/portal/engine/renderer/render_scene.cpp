@@ -0,0 +1,181 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "render_scene.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <utility>
+
+#include "portal/core/debug/profile.h"
+#include "portal/engine/renderer/draw_list.h"
+#include "portal/engine/renderer/material/material.h"
+#include "portal/engine/renderer/vulkan/vulkan_material.h"
+#include "portal/engine/renderer/vulkan/vulkan_pipeline.h"
+
+namespace portal::renderer
+{
+namespace
+{
+    template <typename T>
+    void apply_order(std::vector<T>& values, const std::span<const uint32_t> order)
+    {
+        std::vector<T> ordered;
+        ordered.reserve(order.size());
+        for (const auto index : order)
+            ordered.push_back(std::move(values[index]));
+        values = std::move(ordered);
+    }
+}
+
+void RenderScene::add(
+    const entt::entity owner,
+    const RenderDraw& draw,
+    const Reference<Material>& material,
+    const std::shared_ptr<vulkan::AllocatedBuffer>& index_buffer,
+    const glm::mat4& transform,
+    const BoundingBox& local_bounds
+)
+{
+    owner_objects[entt::to_integral(owner)].push_back(static_cast<uint32_t>(draws.size()));
+
+    draws.push_back(draw);
+    materials.push_back(material);
+    transforms.push_back(transform);
+    world_bounds.push_back(BoundingBox::from_transformed(transform, local_bounds.center, local_bounds.extents));
+    this->local_bounds.push_back(local_bounds);
+    owners.push_back(owner);
+    index_buffers.push_back(index_buffer);
+    state_keys.push_back(0);
+
+    structure_changed = true;
+}
+
+void RenderScene::remove(const entt::entity owner)
+{
+    const auto it = owner_objects.find(entt::to_integral(owner));
+    if (it == owner_objects.end())
+        return;
+
+    // Dead objects are dropped by the next commit
+    for (const auto index : it->second)
+        owners[index] = entt::null;
+    owner_objects.erase(it);
+
+    structure_changed = true;
+}
+
+void RenderScene::set_transform(const entt::entity owner, const glm::mat4& transform)
+{
+    const auto it = owner_objects.find(entt::to_integral(owner));
+    if (it == owner_objects.end())
+        return;
+
+    for (const auto index : it->second)
+    {
+        transforms[index] = transform;
+        world_bounds[index] = BoundingBox::from_transformed(transform, local_bounds[index].center, local_bounds[index].extents);
+    }
+    bounds_changed = true;
+}
+
+bool RenderScene::contains(const entt::entity owner) const
+{
+    return owner_objects.contains(entt::to_integral(owner));
+}
+
+bool RenderScene::commit()
+{
+    if (!structure_changed)
+        return false;
+
+    PORTAL_PROF_ZONE();
+
+    std::vector<uint32_t> order;
+    order.reserve(draws.size());
+    for (uint32_t index = 0; index < draws.size(); ++index)
+    {
+        if (owners[index] != entt::null)
+            order.push_back(index);
+    }
+
+    // Objects sharing state end up next to each other, the renderer binds it once
+    assign_state_keys(order);
+    std::ranges::stable_sort(order, std::less{}, [this](const uint32_t index) { return state_keys[index]; });
+
+    apply_order(draws, order);
+    apply_order(materials, order);
+    apply_order(transforms, order);
+    apply_order(world_bounds, order);
+    apply_order(local_bounds, order);
+    apply_order(owners, order);
+    apply_order(index_buffers, order);
+    apply_order(state_keys, order);
+
+    rebuild_owner_index();
+
+    ++structure_version;
+    structure_changed = false;
+    bounds_changed = true;
+    return true;
+}
+
+bool RenderScene::consume_bounds_changed()
+{
+    return std::exchange(bounds_changed, false);
+}
+
+void RenderScene::clear()
+{
+    draws.clear();
+    materials.clear();
+    transforms.clear();
+    world_bounds.clear();
+    local_bounds.clear();
+    owners.clear();
+    index_buffers.clear();
+    state_keys.clear();
+    owner_objects.clear();
+
+    ++structure_version;
+    structure_changed = false;
+    bounds_changed = true;
+}
+
+void RenderScene::assign_state_keys(const std::span<const uint32_t> objects)
+{
+    // Ids are assigned in first seen order, state past the 16 bit range shares the overflow id and is always rebound
+    llvm::DenseMap<uint64_t, uint16_t> pipeline_ids;
+    llvm::DenseMap<uint64_t, uint16_t> material_ids;
+    llvm::DenseMap<uint64_t, uint16_t> index_buffer_ids;
+    const auto get_id = [](llvm::DenseMap<uint64_t, uint16_t>& ids, const uint64_t state)
+    {
+        const auto [it, inserted] = ids.try_emplace(state, static_cast<uint16_t>(std::min<size_t>(ids.size(), DrawKey::OVERFLOW_ID)));
+        return it->second;
+    };
+
+    for (const auto index : objects)
+    {
+        const auto& material = materials[index];
+        const auto vulkan_material = reference_cast<vulkan::VulkanMaterial>(material);
+        const auto* pipeline = vulkan_material ? vulkan_material->get_pipeline().get() : nullptr;
+
+        state_keys[index] = DrawKey::make(
+            get_id(pipeline_ids, reinterpret_cast<uintptr_t>(pipeline)),
+            get_id(material_ids, reinterpret_cast<uintptr_t>(material.get())),
+            get_id(index_buffer_ids, std::bit_cast<uint64_t>(static_cast<VkBuffer>(draws[index].index_buffer))),
+            0
+        );
+    }
+}
+
+void RenderScene::rebuild_owner_index()
+{
+    owner_objects.clear();
+    for (uint32_t index = 0; index < owners.size(); ++index)
+        owner_objects[entt::to_integral(owners[index])].push_back(index);
+}
+} // portal
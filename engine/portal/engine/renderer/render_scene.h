@@ -0,0 +1,133 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/engine/reference.h"
+#include "portal/engine/renderer/culling/frustum.h"
+#include "portal/engine/renderer/vulkan/allocated_buffer.h"
+
+namespace portal::renderer
+{
+class Material;
+
+/**
+ * @brief Everything needed to record the draw call of a render object, without any reference counting.
+ */
+struct RenderDraw
+{
+    uint32_t index_count = 0;
+    uint32_t first_index = 0;
+    vk::Buffer index_buffer = nullptr;
+    vk::DeviceAddress vertex_buffer_address = 0;
+};
+
+/**
+ * @brief Retained list of the objects to render, kept in sync with the scene instead of being rebuilt every frame.
+ *
+ * Every object is a submesh owned by an entity. The objects are stored as a structure of arrays (draws, materials,
+ * transforms and world bounds) sorted by pipeline, material and index buffer, so objects that share state are next to
+ * each other. Each object also has a state key, a `DrawKey` without depth made of compact per scene state ids.
+ *
+ * Adding or removing objects only marks the structure as changed, the arrays are compacted and re-sorted once by
+ * `commit`. Object indices are stable between two structural commits, `get_structure_version` changes whenever they
+ * are invalidated. Transforms are patched in place.
+ *
+ * @par Example:
+ * @code
+ * scene.remove(entity);
+ * scene.add(entity, draw, material, index_buffer, world_matrix, local_bounds);
+ * scene.commit();
+ *
+ * for (const auto index : visible_objects)
+ *     record(scene.get_draws()[index], scene.get_transforms()[index]);
+ * @endcode
+ */
+class RenderScene
+{
+public:
+    /**
+     * @brief Adds an object owned by `owner`, an entity may own any number of objects.
+     *
+     * @param owner The entity the object belongs to
+     * @param draw The draw call of the object
+     * @param material The material the object is drawn with
+     * @param index_buffer The index buffer referenced by `draw`, kept alive as long as the object exists
+     * @param transform The world matrix of the object
+     * @param local_bounds The bounds of the object in its local space
+     */
+    void add(
+        entt::entity owner,
+        const RenderDraw& draw,
+        const Reference<Material>& material,
+        const std::shared_ptr<vulkan::AllocatedBuffer>& index_buffer,
+        const glm::mat4& transform,
+        const BoundingBox& local_bounds
+    );
+
+    /**
+     * @brief Removes every object owned by `owner`.
+     */
+    void remove(entt::entity owner);
+
+    /**
+     * @brief Updates the world matrix (and bounds) of every object owned by `owner`.
+     */
+    void set_transform(entt::entity owner, const glm::mat4& transform);
+
+    [[nodiscard]] bool contains(entt::entity owner) const;
+
+    /**
+     * @brief Applies the pending additions and removals, compacting and re-sorting the objects.
+     *
+     * @return True if the structure changed, invalidating object indices
+     */
+    bool commit();
+
+    /**
+     * @brief Resets the bounds changed flag, returns whether any bounds changed since the last call.
+     */
+    bool consume_bounds_changed();
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return draws.size(); }
+    [[nodiscard]] uint64_t get_structure_version() const { return structure_version; }
+
+    [[nodiscard]] std::span<const RenderDraw> get_draws() const { return draws; }
+    [[nodiscard]] std::span<const Reference<Material>> get_materials() const { return materials; }
+    [[nodiscard]] std::span<const glm::mat4> get_transforms() const { return transforms; }
+    [[nodiscard]] std::span<const BoundingBox> get_world_bounds() const { return world_bounds; }
+    [[nodiscard]] std::span<const uint64_t> get_state_keys() const { return state_keys; }
+
+private:
+    void rebuild_owner_index();
+    void assign_state_keys(std::span<const uint32_t> objects);
+
+private:
+    // One entry per object
+    std::vector<RenderDraw> draws;
+    std::vector<Reference<Material>> materials;
+    std::vector<glm::mat4> transforms;
+    std::vector<BoundingBox> world_bounds;
+    std::vector<BoundingBox> local_bounds;
+    std::vector<entt::entity> owners;
+    std::vector<std::shared_ptr<vulkan::AllocatedBuffer>> index_buffers;
+    std::vector<uint64_t> state_keys;
+
+    llvm::DenseMap<entt::id_type, llvm::SmallVector<uint32_t, 2>> owner_objects;
+
+    uint64_t structure_version = 0;
+    bool structure_changed = false;
+    bool bounds_changed = false;
+};
+} // portal
@@ -20,6 +20,7 @@
 #include "vk_mem_alloc.h"
 #include "portal/engine/renderer/descriptor_layout_builder.h"
 
+#include <array>
 #include <imgui.h>
 #include <ranges>
 
@@ -157,15 +158,14 @@ void Renderer::draw_geometry(FrameContext& frame, const vk::CommandBuffer& comma
     //begin clock
     auto start = std::chrono::system_clock::now();
 
-    std::unordered_map<StringId, std::vector<uint32_t>> render_by_material;
-    render_by_material.reserve(rendering_context->render_objects.size());
-
-    for (uint32_t i = 0; i < rendering_context->render_objects.size(); i++)
-    {
-        const auto& object = rendering_context->render_objects[i];
-        if (object.is_visible(rendering_context->scene_data.camera.view_proj))
-            render_by_material[object.material->get_id()].push_back(i);
-    }
+    // The draw list is already culled and sorted by the scene rendering system
+    static const RenderScene empty_scene;
+    static const DrawList empty_draw_list;
+    const auto& render_scene = rendering_context->render_scene ? *rendering_context->render_scene : empty_scene;
+    const auto& draw_list = rendering_context->draw_list ? *rendering_context->draw_list : empty_draw_list;
+    const auto draws = render_scene.get_draws();
+    const auto materials = render_scene.get_materials();
+    const auto transforms = render_scene.get_transforms();
 
     {
         auto info = reference_cast<vulkan::VulkanRenderTarget>(current_render_target)->make_rendering_info();
@@ -174,65 +174,64 @@ void Renderer::draw_geometry(FrameContext& frame, const vk::CommandBuffer& comma
         scene_data_uniform_buffer->get(frame.frame_index)->set_data_typed<vulkan::GPUSceneData>(rendering_context->scene_data);
         scene_lights_uniform_buffer->get(frame.frame_index)->set_data_typed<vulkan::GPUSceneLights>(rendering_context->scene_lights);
 
-        Reference<vulkan::VulkanPipeline> last_pipeline = nullptr;
-        Reference<vulkan::VulkanMaterial> last_material = nullptr;
-        // MaterialPipeline* real_p = nullptr;
-        std::shared_ptr<vulkan::AllocatedBuffer> last_index_buffer = nullptr;
+        Reference<vulkan::VulkanPipeline> pipeline = nullptr;
+        Reference<vulkan::VulkanMaterial> material = nullptr;
 
-        auto draw_object = [&](const RenderObject& object)
+        for (const auto& [object, changes] : draw_list.get_commands())
         {
             // TracyVkZone(tracy_context, *current_rendering_context->command_buffer, "Draw object");
-            auto material = reference_cast<vulkan::VulkanMaterial>(object.material);
-            auto pipeline = material->get_pipeline();
-            if (material != last_material)
+            const auto& draw = draws[object];
+
+            if (changes & DrawStateBits::Material)
+                material = reference_cast<vulkan::VulkanMaterial>(materials[object]);
+
+            if (changes & DrawStateBits::Pipeline)
             {
-                last_material = material;
-                //rebind pipeline and descriptors if the material changed
-                if (pipeline != last_pipeline)
-                {
-                    last_pipeline = pipeline;
-
-                    descriptor_set_manager->invalidate_and_update(frame.frame_index);
-
-                    const auto descriptor_sets =
-                        std::ranges::to<std::vector>(
-                            descriptor_set_manager->get_descriptor_sets(frame.frame_index) | std::views::transform(
-                                [](const auto& set) { return *set; }
-                            )
-                        );
-
-                    command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->get_vulkan_pipeline());
-                    command_buffer.bindDescriptorSets(
-                        vk::PipelineBindPoint::eGraphics,
-                        pipeline->get_vulkan_pipeline_layout(),
-                        0,
-                        descriptor_sets,
-                        {}
-                    );
+                pipeline = material->get_pipeline();
 
-                    command_buffer.setViewport(
-                        0,
-                        vk::Viewport(
-                            0.0f,
-                            0.0f,
-                            static_cast<float>(viewport_bounds.z),
-                            static_cast<float>(viewport_bounds.w),
-                            0.0f,
-                            1.0f
-                        )
-                    );
-                    command_buffer.setScissor(
-                        0,
-                        vk::Rect2D(
-                            vk::Offset2D(0, 0),
-                            {
-                                viewport_bounds.z,
-                                viewport_bounds.w,
-                            }
+                descriptor_set_manager->invalidate_and_update(frame.frame_index);
+
+                const auto descriptor_sets =
+                    std::ranges::to<std::vector>(
+                        descriptor_set_manager->get_descriptor_sets(frame.frame_index) | std::views::transform(
+                            [](const auto& set) { return *set; }
                         )
                     );
-                }
 
+                command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->get_vulkan_pipeline());
+                command_buffer.bindDescriptorSets(
+                    vk::PipelineBindPoint::eGraphics,
+                    pipeline->get_vulkan_pipeline_layout(),
+                    0,
+                    descriptor_sets,
+                    {}
+                );
+
+                command_buffer.setViewport(
+                    0,
+                    vk::Viewport(
+                        0.0f,
+                        0.0f,
+                        static_cast<float>(viewport_bounds.z),
+                        static_cast<float>(viewport_bounds.w),
+                        0.0f,
+                        1.0f
+                    )
+                );
+                command_buffer.setScissor(
+                    0,
+                    vk::Rect2D(
+                        vk::Offset2D(0, 0),
+                        {
+                            viewport_bounds.z,
+                            viewport_bounds.w,
+                        }
+                    )
+                );
+            }
+
+            if (changes & DrawStateBits::Material)
+            {
                 const auto descriptor_set = material->get_descriptor_set(frame.frame_index);
                 const std::vector descriptor_set_array{
                     descriptor_set
@@ -247,16 +246,12 @@ void Renderer::draw_geometry(FrameContext& frame, const vk::CommandBuffer& comma
                 );
             }
 
-            //rebind index buffer if needed
-            if (object.index_buffer != last_index_buffer)
-            {
-                last_index_buffer = object.index_buffer;
-                command_buffer.bindIndexBuffer(object.index_buffer->get_handle(), 0, vk::IndexType::eUint32);
-            }
+            if (changes & DrawStateBits::IndexBuffer)
+                command_buffer.bindIndexBuffer(draw.index_buffer, 0, vk::IndexType::eUint32);
 
             vulkan::GPUDrawPushConstants push_constants{
-                object.transform,
-                object.vertex_buffer_address,
+                transforms[object],
+                draw.vertex_buffer_address,
             };
             command_buffer.pushConstants<vulkan::GPUDrawPushConstants>(
                 pipeline->get_vulkan_pipeline_layout(),
@@ -265,19 +260,11 @@ void Renderer::draw_geometry(FrameContext& frame, const vk::CommandBuffer& comma
                 {push_constants}
             );
 
-            command_buffer.drawIndexed(object.index_count, 1, object.first_index, 0, 0);
+            command_buffer.drawIndexed(draw.index_count, 1, draw.first_index, 0, 0);
 
             //add counters for triangles and draws
             frame.stats.drawcall_count++;
-            frame.stats.triangle_count += static_cast<uint32_t>(object.index_count / 3);
-        };
-
-        for (const auto& indexes : render_by_material | std::views::values)
-        {
-            for (const auto& index : indexes)
-            {
-                draw_object(rendering_context->render_objects[index]);
-            }
+            frame.stats.triangle_count += static_cast<uint32_t>(draw.index_count / 3);
         }
 
         command_buffer.endRendering();
@@ -324,18 +311,18 @@ void Renderer::init_global_descriptors(ResourceRegistry& resource_registry)
     auto frames_in_flight = settings.get_setting<size_t>("application.frames_in_flight", 3);
 
     auto shader = resource_registry.immediate_load<Shader>(STRING_ID("engine/shaders/pbr_static"));
-    const auto hash = shader->compile_with_permutations(
-        {},
-        {
-            {
+    const std::array permutations{
+        ShaderPermutation{
+            .static_constants = {
                 {"has_normal_texture", "bool", "true"},
                 {"has_tangent_texture", "bool", "true"},
                 {"has_metallic_texture", "bool", "true"},
                 {"has_roughness_texture", "bool", "true"},
             }
         }
-    );
-    const auto variant = shader->get_shader(hash).lock();
+    };
+    const auto hashes = shader->compile_permutations(permutations);
+    const auto variant = shader->get_shader(hashes.front()).lock();
 
     const DescriptorSetManagerProperties manager_props{
         .shader = variant,
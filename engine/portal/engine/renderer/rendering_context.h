@@ -10,6 +10,9 @@
 #include "portal/engine/renderer/deletion_queue.h"
 #include "portal/engine/renderer/descriptor_allocator.h"
 #include "portal/engine/renderer/rendering_types.h"
+#include "portal/engine/renderer/draw_list.h"
+#include "portal/engine/renderer/render_scene.h"
+#include "portal/engine/renderer/lighting/light_clusters.h"
 #include "portal/engine/resources/resources/mesh_geometry.h"
 
 namespace portal::renderer {
@@ -20,59 +23,6 @@ namespace portal::renderer
 {
 class Material;
 
-struct RenderObject
-{
-    uint32_t index_count = 0;
-    uint32_t first_index = 0;
-    std::shared_ptr<vulkan::AllocatedBuffer> index_buffer = nullptr;
-
-    Reference<Material> material = nullptr;
-    portal::resources::Bounds bounds{};
-
-    glm::mat4 transform = glm::mat4(1.0f);
-    vk::DeviceAddress vertex_buffer_address = 0;
-
-    [[nodiscard]] bool is_visible(const glm::mat4& view_projection) const
-    {
-        constexpr std::array clip_space_corners{
-            glm::vec3{1, 1, 1},
-            glm::vec3{1, 1, -1},
-            glm::vec3{1, -1, 1},
-            glm::vec3{1, -1, -1},
-            glm::vec3{-1, 1, 1},
-            glm::vec3{-1, 1, -1},
-            glm::vec3{-1, -1, 1},
-            glm::vec3{-1, -1, -1},
-        };
-
-        glm::mat4 matrix = view_projection * transform;
-
-        glm::vec3 min = {1.5, 1.5, 1.5};
-        glm::vec3 max = {-1.5, -1.5, -1.5};
-
-        for (int c = 0; c < 8; c++)
-        {
-            // project each corner into clip space
-            glm::vec4 v = matrix * glm::vec4(bounds.origin + (clip_space_corners[c] * bounds.extents), 1.f);
-
-            // perspective correction
-            v.x = v.x / v.w;
-            v.y = v.y / v.w;
-            v.z = v.z / v.w;
-
-            min = glm::min(glm::vec3{v.x, v.y, v.z}, min);
-            max = glm::max(glm::vec3{v.x, v.y, v.z}, max);
-        }
-
-        // check the clip space box is within the view
-        if (min.z > 1.f || max.z < 0.f || min.x > 1.f || max.x < -1.f || min.y > 1.f || max.y < -1.f)
-        {
-            return false;
-        }
-        return true;
-    }
-};
-
 /**
  * @struct FrameResources
  * @brief Per-frame resources for N-frames-in-flight rendering
@@ -134,6 +84,12 @@ struct FrameRenderingContext
     vk::CommandBuffer global_command_buffer = nullptr;
 
     vulkan::DescriptorAllocator* frame_descriptors = nullptr;
-    llvm::SmallVector<RenderObject> render_objects;
+
+    // Retained scene owned by the scene rendering system, the draw list references its objects in submission order
+    const RenderScene* render_scene = nullptr;
+    const DrawList* draw_list = nullptr;
+
+    // Point and spot lights binned into view space clusters, point lights are indexed first, then spot lights
+    const LightClusterGrid* light_clusters = nullptr;
 };
 } // portal
@@ -5,10 +5,12 @@
 
 #include "shader.h"
 
+#include <algorithm>
 #include <ranges>
 #include <nlohmann/detail/input/parser.hpp>
 
 #include "portal/core/reflection/property_concepts.h"
+#include "portal/engine/renderer/shaders/shader_compile_service.h"
 #include "portal/engine/renderer/shaders/shader_compiler.h"
 #include "portal/serialization/serialize.h"
 
@@ -19,11 +21,26 @@ static auto logger = Log::get_logger("Shader");
 Shader::Shader(const StringId& id) : Resource(id)
 {}
 
-void Shader::load_source(Buffer&& new_source, const std::filesystem::path& shader_path, const std::filesystem::path& engine_path)
+void Shader::load_source(
+    Buffer&& new_source,
+    const std::filesystem::path& shader_path,
+    const std::filesystem::path& engine_path,
+    std::shared_ptr<ShaderCompileService> service
+)
 {
     source_path = shader_path;
     engine_shader_path = engine_path;
     source = std::move(new_source);
+    compile_service = std::move(service);
+}
+
+uint64_t Shader::load_compiled(CompiledShader&& compiled)
+{
+    const auto permutations_hash = calculate_permutations_hash({}, {});
+
+    std::lock_guard lock(shader_cache_lock);
+    shaders[permutations_hash] = std::move(compiled);
+    return permutations_hash;
 }
 
 uint64_t Shader::compile_with_permutations(
@@ -34,23 +51,97 @@ uint64_t Shader::compile_with_permutations(
     const auto permutations_hash = calculate_permutations_hash(permutations, static_constants);
 
     std::lock_guard lock(shader_cache_lock);
-    if (!shaders.contains(permutations_hash))
+    if (shaders.contains(permutations_hash))
+        return permutations_hash;
+
+    if (!source)
+    {
+        LOGGER_ERROR("Cannot compile shader variant: {} [{}], the shader has no source", id, permutations_hash);
+        return permutations_hash;
+    }
+
+    const ShaderCompiler::CompileRequest request{
+        .name = id,
+        .shader_path = source_path,
+        .engine_shader_path = engine_shader_path,
+        .shader_data = source,
+        .defines = permutations,
+        .static_constants = static_constants
+    };
+
+    LOGGER_DEBUG("Compiling shader variant: {} [{}]", id, permutations_hash);
+    if (compile_service)
+    {
+        shaders[permutations_hash] = compile_service->compile_immediate(request);
+    }
+    else
     {
-        LOGGER_DEBUG("Compiling shader variant: {} [{}]", id, permutations_hash);
         ShaderCompiler compiler;
-        shaders[permutations_hash] = compiler.compile({
-            .name = id,
-            .shader_path = source_path,
-            .engine_shader_path = engine_shader_path,
-            .shader_data = source,
-            .defines = permutations,
-            .static_constants = static_constants
-        });
+        shaders[permutations_hash] = compiler.compile(request);
     }
 
     return permutations_hash;
 }
 
+std::vector<uint64_t> Shader::compile_permutations(const std::span<const ShaderPermutation> permutations)
+{
+    std::vector<uint64_t> hashes;
+    hashes.reserve(permutations.size());
+
+    if (!compile_service)
+    {
+        for (const auto& [defines, static_constants] : permutations)
+            hashes.push_back(compile_with_permutations(defines, static_constants));
+        return hashes;
+    }
+
+    std::vector<uint64_t> pending_hashes;
+    std::vector<ShaderCompiler::CompileRequest> requests;
+    {
+        std::lock_guard lock(shader_cache_lock);
+        for (const auto& [defines, static_constants] : permutations)
+        {
+            const auto hash = calculate_permutations_hash(defines, static_constants);
+            hashes.push_back(hash);
+            if (shaders.contains(hash) || std::ranges::contains(pending_hashes, hash))
+                continue;
+
+            pending_hashes.push_back(hash);
+            requests.push_back(
+                {
+                    .name = id,
+                    .shader_path = source_path,
+                    .engine_shader_path = engine_shader_path,
+                    .shader_data = source,
+                    .defines = defines,
+                    .static_constants = static_constants
+                }
+            );
+        }
+    }
+
+    if (requests.empty())
+        return hashes;
+
+    if (!source)
+    {
+        LOGGER_ERROR("Cannot compile {} variants of shader: {}, the shader has no source", requests.size(), id);
+        return hashes;
+    }
+
+    // The lock is not held while compiling, waiting for the jobs may run other jobs on this thread that use this shader
+    LOGGER_DEBUG("Compiling {} shader variants: {}", requests.size(), id);
+    auto compiled = compile_service->compile_all(requests);
+
+    std::lock_guard lock(shader_cache_lock);
+    for (size_t i = 0; i < pending_hashes.size(); ++i)
+    {
+        if (!shaders.contains(pending_hashes[i]))
+            shaders[pending_hashes[i]] = std::move(compiled[i]);
+    }
+    return hashes;
+}
+
 
 uint64_t Shader::calculate_permutations_hash(
     const std::vector<ShaderDefine>& permutations,
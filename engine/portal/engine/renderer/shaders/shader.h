@@ -6,6 +6,8 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <span>
 
 #include "portal/core/buffer.h"
 #include "portal/core/reflection/property_concepts.h"
@@ -24,6 +26,7 @@ class Serializer;
 namespace portal::renderer
 {
 struct CompiledShader;
+class ShaderCompileService;
 
 namespace vulkan
 {
@@ -72,8 +75,26 @@ public:
      * @brief Loads shader source code
      * @param new_source Shader source buffer
      * @param shader_path Source file path
+     * @param engine_path Engine shader folder, searched for imported modules
+     * @param compile_service Service compiling (and caching) the variants, may be null to compile without one
      */
-    void load_source(Buffer&& new_source, const std::filesystem::path& shader_path, const std::filesystem::path& engine_path);
+    void load_source(
+        Buffer&& new_source,
+        const std::filesystem::path& shader_path,
+        const std::filesystem::path& engine_path,
+        std::shared_ptr<ShaderCompileService> compile_service = nullptr
+    );
+
+    /**
+     * @brief Loads an already compiled variant, without any source
+     *
+     * The variant is registered as the permutation without defines, shaders loaded this way cannot compile other
+     * permutations.
+     *
+     * @param compiled Compiled bytecode and reflection
+     * @return Hash to retrieve the variant
+     */
+    uint64_t load_compiled(CompiledShader&& compiled);
 
     /**
      * @brief Compiles shader with given defines and specialization constants
@@ -86,6 +107,17 @@ public:
         const std::vector<ShaderStaticConstants>& static_constants = {}
     );
 
+    /**
+     * @brief Compiles several permutations in parallel
+     *
+     * Permutations that are already compiled are skipped. Without a compile service the permutations are compiled one
+     * after the other.
+     *
+     * @param permutations The permutations to compile
+     * @return Hashes to retrieve the compiled variants, in the order of the permutations
+     */
+    std::vector<uint64_t> compile_permutations(std::span<const ShaderPermutation> permutations);
+
     /**
      * @brief Gets compiled shader variant
      * @param shader_hash Permutation hash
@@ -109,6 +141,7 @@ protected:
     std::filesystem::path source_path;
     std::filesystem::path engine_shader_path;
     Buffer source;
+    std::shared_ptr<ShaderCompileService> compile_service;
     SpinLock shader_cache_lock;
     std::unordered_map<uint64_t, CompiledShader> shaders;
 };
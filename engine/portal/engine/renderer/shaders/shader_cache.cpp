@@ -0,0 +1,631 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "shader_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+#include <unordered_set>
+
+#include "slang.h"
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/files/file_system.h"
+#include "portal/core/strings/hash.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+namespace portal::renderer
+{
+static auto logger = Log::get_logger("Shader");
+
+namespace
+{
+    uint64_t combine(uint64_t seed, const uint64_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4);
+        return seed;
+    }
+
+    uint64_t hash_buffer(const Buffer& buffer)
+    {
+        if (!buffer)
+            return 0;
+        return hash::rapidhash(buffer.as<const char*>(), buffer.size);
+    }
+
+    std::string_view trim(std::string_view line)
+    {
+        const auto begin = line.find_first_not_of(" \t");
+        if (begin == std::string_view::npos)
+            return {};
+        const auto end = line.find_last_not_of(" \t\r");
+        return line.substr(begin, end - begin + 1);
+    }
+
+    /**
+     * Extracts the file a source line imports, if any, supporting `import module.name;`, `import "file.slang";`,
+     * `__include module;` and `#include "file"`.
+     */
+    std::optional<std::filesystem::path> parse_dependency(std::string_view line)
+    {
+        line = trim(line);
+
+        std::string_view rest;
+        bool is_module = false;
+        for (const std::string_view directive : {"import", "__include", "#include"})
+        {
+            if (!line.starts_with(directive) || line.size() <= directive.size())
+                continue;
+
+            if (const auto separator = line[directive.size()]; separator == ' ' || separator == '\t' || separator == '"')
+            {
+                rest = trim(line.substr(directive.size()));
+                is_module = directive != "#include";
+                break;
+            }
+        }
+
+        if (rest.empty())
+            return std::nullopt;
+
+        if (rest.front() == '"')
+        {
+            const auto end = rest.find('"', 1);
+            if (end == std::string_view::npos)
+                return std::nullopt;
+            return std::filesystem::path(rest.substr(1, end - 1));
+        }
+
+        if (!is_module)
+            return std::nullopt;
+
+        const auto end = rest.find(';');
+        std::string module_name{trim(rest.substr(0, end))};
+        if (module_name.empty())
+            return std::nullopt;
+        std::ranges::replace(module_name, '.', '/');
+        return std::filesystem::path(module_name + ".slang");
+    }
+
+    std::optional<std::filesystem::path> resolve_dependency(
+        const std::filesystem::path& dependency,
+        const std::filesystem::path& importer_directory,
+        const ShaderCompiler::CompileRequest& request
+    )
+    {
+        for (const auto& directory : {importer_directory, request.shader_path.parent_path(), request.engine_shader_path})
+        {
+            auto candidate = (directory / dependency).lexically_normal();
+            if (FileSystem::stat_file(candidate).is_file)
+                return candidate;
+        }
+        return std::nullopt;
+    }
+
+    uint64_t hash_dependencies(
+        const std::string_view source,
+        const std::filesystem::path& directory,
+        const ShaderCompiler::CompileRequest& request,
+        std::unordered_set<std::string>& visited,
+        uint64_t hash
+    )
+    {
+        size_t position = 0;
+        while (position < source.size())
+        {
+            auto end = source.find('\n', position);
+            if (end == std::string_view::npos)
+                end = source.size();
+            const auto line = source.substr(position, end - position);
+            position = end + 1;
+
+            const auto dependency = parse_dependency(line);
+            if (!dependency)
+                continue;
+
+            const auto resolved = resolve_dependency(dependency.value(), directory, request);
+            if (!resolved)
+            {
+                // The compiler either finds it somewhere we did not look, or fails on it, the name is the best we can do
+                hash = combine(hash, hash::rapidhash(dependency->generic_string()));
+                continue;
+            }
+
+            if (!visited.insert(resolved->generic_string()).second)
+                continue;
+
+            const auto content = FileSystem::read_file_binary(resolved.value());
+            hash = combine(hash, hash::rapidhash(resolved->filename().generic_string()));
+            hash = combine(hash, hash_buffer(content));
+            hash = hash_dependencies(
+                std::string_view{content.as<const char*>(), content.size},
+                resolved->parent_path(),
+                request,
+                visited,
+                hash
+            );
+        }
+        return hash;
+    }
+
+    void write_string_id(Serializer& serializer, const StringId& id)
+    {
+        serializer.add_value(id.id);
+        serializer.add_value(std::string(id.string));
+    }
+
+    StringId read_string_id(Deserializer& deserializer)
+    {
+        StringId::HashType id = 0;
+        std::string string;
+        deserializer.get_value(id);
+        deserializer.get_value(string);
+        return StringId{id, string};
+    }
+
+    void write_property(Serializer& serializer, const reflection::Property& property)
+    {
+        serializer.add_value(property.type);
+        serializer.add_value(property.container_type);
+        serializer.add_value(property.elements_number);
+        // Reflected properties only hold their type name as a value
+        serializer.add_value(property.value ? std::string(property.value.as<const char*>(), property.value.size) : std::string{});
+    }
+
+    reflection::Property read_property(Deserializer& deserializer)
+    {
+        reflection::Property property;
+        std::string value;
+        deserializer.get_value(property.type);
+        deserializer.get_value(property.container_type);
+        deserializer.get_value(property.elements_number);
+        deserializer.get_value(value);
+        if (!value.empty())
+            property.value = Buffer::copy(value.data(), value.size());
+        return property;
+    }
+
+    void write_buffer_descriptor(Serializer& serializer, const shader_reflection::BufferDescriptor& buffer)
+    {
+        serializer.add_value(buffer.type);
+        serializer.add_value(buffer.stage);
+        serializer.add_value(buffer.size);
+        serializer.add_value(buffer.offset);
+        serializer.add_value(buffer.range);
+        serializer.add_value(buffer.binding_point);
+        write_string_id(serializer, buffer.name);
+
+        serializer.add_value(buffer.uniforms.size());
+        for (const auto& uniform : buffer.uniforms | std::views::values)
+        {
+            write_string_id(serializer, uniform.name);
+            write_property(serializer, uniform.property);
+            serializer.add_value(uniform.size);
+            serializer.add_value(uniform.offset);
+        }
+
+        serializer.add_value(buffer.struct_types.size());
+        for (const auto& reflected : buffer.struct_types | std::views::values)
+        {
+            write_string_id(serializer, reflected.name);
+            serializer.add_value(reflected.stride);
+            serializer.add_value(reflected.fields.size());
+            for (const auto& field : reflected.fields)
+            {
+                write_string_id(serializer, field.name);
+                write_property(serializer, field.property);
+                serializer.add_value(field.size);
+                serializer.add_value(field.offset);
+            }
+        }
+    }
+
+    shader_reflection::BufferDescriptor read_buffer_descriptor(Deserializer& deserializer)
+    {
+        shader_reflection::BufferDescriptor buffer{};
+        deserializer.get_value(buffer.type);
+        deserializer.get_value(buffer.stage);
+        deserializer.get_value(buffer.size);
+        deserializer.get_value(buffer.offset);
+        deserializer.get_value(buffer.range);
+        deserializer.get_value(buffer.binding_point);
+        buffer.name = read_string_id(deserializer);
+
+        size_t uniform_count = 0;
+        deserializer.get_value(uniform_count);
+        for (size_t i = 0; i < uniform_count; ++i)
+        {
+            shader_reflection::Uniform uniform;
+            uniform.name = read_string_id(deserializer);
+            uniform.property = read_property(deserializer);
+            deserializer.get_value(uniform.size);
+            deserializer.get_value(uniform.offset);
+            buffer.uniforms[uniform.name] = std::move(uniform);
+        }
+
+        size_t struct_count = 0;
+        deserializer.get_value(struct_count);
+        for (size_t i = 0; i < struct_count; ++i)
+        {
+            shader_reflection::ReflectedStruct reflected;
+            reflected.name = read_string_id(deserializer);
+            deserializer.get_value(reflected.stride);
+
+            size_t field_count = 0;
+            deserializer.get_value(field_count);
+            reflected.fields.resize(field_count);
+            for (auto& field : reflected.fields)
+            {
+                field.name = read_string_id(deserializer);
+                field.property = read_property(deserializer);
+                deserializer.get_value(field.size);
+                deserializer.get_value(field.offset);
+            }
+            buffer.struct_types[reflected.name] = std::move(reflected);
+        }
+        return buffer;
+    }
+
+    void write_image_descriptor(Serializer& serializer, const shader_reflection::ImageSamplerDescriptor& image)
+    {
+        serializer.add_value(image.type);
+        serializer.add_value(image.stage);
+        serializer.add_value(image.binding_point);
+        serializer.add_value(image.descriptor_set);
+        serializer.add_value(image.dimensions);
+        serializer.add_value(image.array_size);
+        write_string_id(serializer, image.name);
+    }
+
+    shader_reflection::ImageSamplerDescriptor read_image_descriptor(Deserializer& deserializer)
+    {
+        shader_reflection::ImageSamplerDescriptor image;
+        deserializer.get_value(image.type);
+        deserializer.get_value(image.stage);
+        deserializer.get_value(image.binding_point);
+        deserializer.get_value(image.descriptor_set);
+        deserializer.get_value(image.dimensions);
+        deserializer.get_value(image.array_size);
+        image.name = read_string_id(deserializer);
+        return image;
+    }
+
+    template <typename T, typename F>
+    void write_descriptor_map(Serializer& serializer, const std::unordered_map<size_t, T>& descriptors, F&& write)
+    {
+        serializer.add_value(descriptors.size());
+        for (const auto& [binding, descriptor] : descriptors)
+        {
+            serializer.add_value(binding);
+            write(serializer, descriptor);
+        }
+    }
+
+    template <typename T, typename F>
+    void read_descriptor_map(Deserializer& deserializer, std::unordered_map<size_t, T>& descriptors, F&& read)
+    {
+        size_t count = 0;
+        deserializer.get_value(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t binding = 0;
+            deserializer.get_value(binding);
+            descriptors[binding] = read(deserializer);
+        }
+    }
+
+    void write_reflection(Serializer& serializer, const ShaderReflection& reflection)
+    {
+        serializer.add_value(reflection.descriptor_sets.size());
+        for (const auto& set : reflection.descriptor_sets)
+        {
+            write_descriptor_map(serializer, set.uniform_buffers, write_buffer_descriptor);
+            write_descriptor_map(serializer, set.storage_buffers, write_buffer_descriptor);
+            write_descriptor_map(serializer, set.image_samplers, write_image_descriptor);
+            write_descriptor_map(serializer, set.storage_images, write_image_descriptor);
+            write_descriptor_map(serializer, set.images, write_image_descriptor);
+            write_descriptor_map(serializer, set.samplers, write_image_descriptor);
+        }
+
+        serializer.add_value(reflection.resources.size());
+        for (const auto& resource : reflection.resources | std::views::values)
+        {
+            write_string_id(serializer, resource.name);
+            serializer.add_value(resource.type);
+            serializer.add_value(resource.set);
+            serializer.add_value(resource.binding_index);
+            serializer.add_value(resource.count);
+        }
+
+        serializer.add_value(reflection.push_constants.size());
+        for (const auto& [stage, offset, size] : reflection.push_constants)
+        {
+            serializer.add_value(stage);
+            serializer.add_value(offset);
+            serializer.add_value(size);
+        }
+
+        serializer.add_value(reflection.stages.size());
+        for (const auto& [stage, entry_point] : reflection.stages)
+        {
+            serializer.add_value(stage);
+            serializer.add_value(entry_point);
+        }
+    }
+
+    void read_reflection(Deserializer& deserializer, ShaderReflection& reflection)
+    {
+        size_t set_count = 0;
+        deserializer.get_value(set_count);
+        reflection.descriptor_sets.resize(set_count);
+        for (auto& set : reflection.descriptor_sets)
+        {
+            read_descriptor_map(deserializer, set.uniform_buffers, read_buffer_descriptor);
+            read_descriptor_map(deserializer, set.storage_buffers, read_buffer_descriptor);
+            read_descriptor_map(deserializer, set.image_samplers, read_image_descriptor);
+            read_descriptor_map(deserializer, set.storage_images, read_image_descriptor);
+            read_descriptor_map(deserializer, set.images, read_image_descriptor);
+            read_descriptor_map(deserializer, set.samplers, read_image_descriptor);
+        }
+
+        size_t resource_count = 0;
+        deserializer.get_value(resource_count);
+        for (size_t i = 0; i < resource_count; ++i)
+        {
+            shader_reflection::ShaderResourceDeclaration resource;
+            resource.name = read_string_id(deserializer);
+            deserializer.get_value(resource.type);
+            deserializer.get_value(resource.set);
+            deserializer.get_value(resource.binding_index);
+            deserializer.get_value(resource.count);
+            reflection.resources[resource.name] = resource;
+        }
+
+        size_t push_constant_count = 0;
+        deserializer.get_value(push_constant_count);
+        reflection.push_constants.resize(push_constant_count);
+        for (auto& [stage, offset, size] : reflection.push_constants)
+        {
+            deserializer.get_value(stage);
+            deserializer.get_value(offset);
+            deserializer.get_value(size);
+        }
+
+        size_t stage_count = 0;
+        deserializer.get_value(stage_count);
+        reflection.stages.resize(stage_count);
+        for (auto& [stage, entry_point] : reflection.stages)
+        {
+            deserializer.get_value(stage);
+            deserializer.get_value(entry_point);
+        }
+    }
+
+    uint64_t hash_payload(const Buffer& code, const Buffer& reflection)
+    {
+        return combine(hash_buffer(code), hash_buffer(reflection));
+    }
+}
+
+bool ShaderCacheHeader::is_valid() const
+{
+    return magic == MAGIC && version == VERSION;
+}
+
+ShaderCache::ShaderCache(std::filesystem::path directory, const size_t max_size) : directory(std::move(directory)), max_size(max_size)
+{
+    std::error_code error;
+    std::filesystem::create_directories(this->directory, error);
+    if (error)
+    {
+        LOGGER_WARN("Failed to create shader cache directory {}: {}", this->directory.generic_string(), error.message());
+        return;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(this->directory, error))
+    {
+        if (entry.is_regular_file(error) && entry.path().extension() == ENTRY_EXTENSION)
+            current_size += entry.file_size(error);
+    }
+}
+
+std::optional<CompiledShader> ShaderCache::load(const uint64_t key)
+{
+    PORTAL_PROF_ZONE();
+
+    const auto path = get_entry_path(key);
+    std::lock_guard lock(mutex);
+    if (!FileSystem::stat_file(path).is_file)
+        return std::nullopt;
+
+    auto compiled = read_entry(FileSystem::read_file_binary(path), key);
+    if (!compiled)
+    {
+        LOGGER_WARN("Discarding invalid shader cache entry {}", path.generic_string());
+        current_size -= std::min(current_size, static_cast<size_t>(FileSystem::stat_file(path).size));
+        FileSystem::remove(path);
+        return std::nullopt;
+    }
+
+    // Used entries are the last ones to be evicted
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return compiled;
+}
+
+void ShaderCache::store(const uint64_t key, const CompiledShader& compiled)
+{
+    PORTAL_PROF_ZONE();
+
+    if (!compiled.code)
+        return;
+
+    const auto path = get_entry_path(key);
+    const auto temporary_path = std::filesystem::path(path).concat(".tmp");
+
+    std::lock_guard lock(mutex);
+    {
+        std::ofstream output(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            LOGGER_WARN("Failed to open {} for writing", temporary_path.generic_string());
+            return;
+        }
+
+        write_entry(output, key, compiled);
+        if (!output)
+        {
+            LOGGER_WARN("Failed to write shader cache entry {}", temporary_path.generic_string());
+            output.close();
+            FileSystem::remove(temporary_path);
+            return;
+        }
+    }
+
+    const auto previous_size = FileSystem::stat_file(path).size;
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        LOGGER_WARN("Failed to move shader cache entry to {}: {}", path.generic_string(), error.message());
+        FileSystem::remove(temporary_path);
+        return;
+    }
+
+    current_size -= std::min(current_size, static_cast<size_t>(previous_size));
+    current_size += FileSystem::stat_file(path).size;
+    if (current_size > max_size)
+        trim_locked();
+}
+
+void ShaderCache::trim()
+{
+    std::lock_guard lock(mutex);
+    trim_locked();
+}
+
+void ShaderCache::trim_locked()
+{
+    PORTAL_PROF_ZONE();
+
+    struct Entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type last_write_time;
+        size_t size;
+    };
+
+    std::vector<Entry> entries;
+    size_t total_size = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (!entry.is_regular_file(error) || entry.path().extension() != ENTRY_EXTENSION)
+            continue;
+
+        const auto size = static_cast<size_t>(entry.file_size(error));
+        entries.push_back({entry.path(), entry.last_write_time(error), size});
+        total_size += size;
+    }
+
+    std::ranges::sort(entries, {}, &Entry::last_write_time);
+    for (const auto& entry : entries)
+    {
+        if (total_size <= max_size)
+            break;
+
+        LOGGER_TRACE("Evicting shader cache entry {}", entry.path.filename().generic_string());
+        FileSystem::remove(entry.path);
+        total_size -= entry.size;
+    }
+    current_size = total_size;
+}
+
+uint64_t ShaderCache::calculate_key(const ShaderCompiler::CompileRequest& request)
+{
+    PORTAL_PROF_ZONE();
+
+    uint64_t hash = ShaderCacheHeader::VERSION;
+    hash = combine(hash, hash::rapidhash(spGetBuildTagString()));
+    hash = combine(hash, hash_buffer(request.shader_data));
+
+    std::unordered_set<std::string> visited;
+    hash = hash_dependencies(
+        std::string_view{request.shader_data.as<const char*>(), request.shader_data.size},
+        request.shader_path.parent_path(),
+        request,
+        visited,
+        hash
+    );
+
+    for (const auto& [name, value] : request.defines)
+    {
+        hash = combine(hash, hash::rapidhash(name));
+        hash = combine(hash, hash::rapidhash(value));
+    }
+    for (const auto& [name, type, value] : request.static_constants)
+    {
+        hash = combine(hash, hash::rapidhash(name));
+        hash = combine(hash, hash::rapidhash(type));
+        hash = combine(hash, hash::rapidhash(value));
+    }
+    return hash;
+}
+
+void ShaderCache::write_entry(std::ostream& output, const uint64_t key, const CompiledShader& compiled)
+{
+    Buffer buffer;
+    BufferStreamWriter stream(buffer);
+    BinarySerializer serializer(stream);
+    write_reflection(serializer, compiled.reflection);
+    stream.flush();
+    const auto reflection = stream.get_buffer();
+
+    const ShaderCacheHeader header{
+        .key = key,
+        .code_size = compiled.code.size,
+        .payload_hash = hash_payload(compiled.code, reflection)
+    };
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(compiled.code.as<const char*>(), static_cast<std::streamsize>(compiled.code.size));
+    output.write(reflection.as<const char*>(), static_cast<std::streamsize>(reflection.size));
+}
+
+std::optional<CompiledShader> ShaderCache::read_entry(const Buffer& data, const std::optional<uint64_t> key)
+{
+    if (!data || data.size < sizeof(ShaderCacheHeader))
+        return std::nullopt;
+
+    ShaderCacheHeader header;
+    std::memcpy(&header, data.data, sizeof(header));
+    if (!header.is_valid() || header.code_size == 0 || header.code_size > data.size - sizeof(header))
+        return std::nullopt;
+
+    // A renamed or copied entry would otherwise be served for a different shader
+    if (key.has_value() && header.key != *key)
+        return std::nullopt;
+
+    const Buffer code{data, sizeof(header), header.code_size};
+    const Buffer reflection{data, sizeof(header) + header.code_size, data.size - sizeof(header) - header.code_size};
+    if (hash_payload(code, reflection) != header.payload_hash)
+        return std::nullopt;
+
+    CompiledShader compiled{.code = Buffer::copy(code)};
+    BufferStreamReader stream(reflection);
+    BinaryDeserializer deserializer(stream);
+    read_reflection(deserializer, compiled.reflection);
+    return compiled;
+}
+
+std::filesystem::path ShaderCache::get_entry_path(const uint64_t key) const
+{
+    return directory / fmt::format("{:016x}{}", key, ENTRY_EXTENSION);
+}
+} // portal
@@ -0,0 +1,127 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+
+#include "portal/engine/renderer/shaders/shader_compiler.h"
+
+namespace portal::renderer
+{
+/**
+ * @brief Header at the start of every shader cache entry.
+ *
+ * The SPIR-V code follows the header as is, followed by the binary serialized reflection. The payload hash covers both,
+ * so a truncated or corrupted entry is treated as a miss instead of being handed to Vulkan.
+ */
+struct ShaderCacheHeader
+{
+    constexpr static std::array MAGIC = {'P', 'S', 'H', 'C'};
+    constexpr static uint32_t VERSION = 1;
+
+    std::array<char, 4> magic = MAGIC;
+    uint32_t version = VERSION;
+    uint64_t key = 0;
+    uint64_t code_size = 0;
+    uint64_t payload_hash = 0;
+
+    [[nodiscard]] bool is_valid() const;
+};
+
+static_assert(std::is_trivially_copyable_v<ShaderCacheHeader>);
+static_assert(sizeof(ShaderCacheHeader) == 32, "The shader cache header is written as is, it must not have padding");
+
+/**
+ * @brief Persistent, content addressed cache of compiled shader variants.
+ *
+ * Every compiled variant is stored as a single file named after its key, holding the SPIR-V code and the reflection
+ * needed to build the Vulkan variant, so a cache hit never touches Slang. The key covers everything that affects the
+ * compilation output: the shader source, the source of every module it imports (transitively), the permutation defines
+ * and static constants, and the Slang build the variant was compiled with.
+ *
+ * Entries are written to a temporary file and renamed into place, so a crash mid write never leaves a partial entry. The
+ * cache is bounded by size, when it grows past its limit the least recently used entries are removed (loading an entry
+ * refreshes its write time).
+ *
+ * The cache is thread safe, different shaders may load and store variants concurrently.
+ *
+ * @par Example:
+ * @code
+ * ShaderCache cache(FileSystem::get_cache_dir("portal") / "shaders");
+ * const auto key = ShaderCache::calculate_key(request);
+ * auto compiled = cache.load(key);
+ * if (!compiled)
+ * {
+ *     compiled = compiler.compile(request);
+ *     cache.store(key, compiled.value());
+ * }
+ * @endcode
+ */
+class ShaderCache
+{
+public:
+    constexpr static size_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+    constexpr static auto ENTRY_EXTENSION = ".pshc";
+
+    explicit ShaderCache(std::filesystem::path directory, size_t max_size = DEFAULT_MAX_SIZE);
+
+    /**
+     * @brief Loads a compiled variant from the cache.
+     *
+     * @return The compiled variant, or nullopt on a miss or if the entry is invalid
+     */
+    [[nodiscard]] std::optional<CompiledShader> load(uint64_t key);
+
+    /**
+     * @brief Stores a compiled variant, evicting the least recently used entries if the cache grows past its limit.
+     */
+    void store(uint64_t key, const CompiledShader& compiled);
+
+    /**
+     * @brief Removes the least recently used entries until the cache is under its size limit.
+     */
+    void trim();
+
+    [[nodiscard]] const std::filesystem::path& get_directory() const { return directory; }
+    [[nodiscard]] size_t get_size() const { return current_size; }
+
+    /**
+     * @brief Calculates the cache key of a compile request.
+     *
+     * Imported modules (`import name;`) and included files (`#include "name"`) are resolved the way the compiler resolves
+     * them, relative to the importing file, the shader folder and then the engine shader folder. A module that cannot be
+     * found is hashed by name only, the compilation will fail on it anyway.
+     */
+    [[nodiscard]] static uint64_t calculate_key(const ShaderCompiler::CompileRequest& request);
+
+    /**
+     * @brief Serializes a compiled variant to the cache entry format.
+     */
+    static void write_entry(std::ostream& output, uint64_t key, const CompiledShader& compiled);
+
+    /**
+     * @brief Reads a cache entry.
+     *
+     * @param key The key the entry is expected to be written with, an entry of another key is rejected. Entries that are
+     * not looked up by key (e.g. precompiled shaders) pass nullopt.
+     * @return The compiled variant with its own copy of the code, or nullopt if `data` is not a valid cache entry of `key`
+     */
+    [[nodiscard]] static std::optional<CompiledShader> read_entry(const Buffer& data, std::optional<uint64_t> key);
+
+private:
+    [[nodiscard]] std::filesystem::path get_entry_path(uint64_t key) const;
+    void trim_locked();
+
+private:
+    std::filesystem::path directory;
+    size_t max_size;
+    size_t current_size = 0;
+    std::mutex mutex;
+};
+} // portal
@@ -0,0 +1,136 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "shader_compile_service.h"
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/shaders/shader_cache.h"
+
+namespace portal::renderer
+{
+static auto logger = Log::get_logger("Shader");
+
+ShaderCompileService::ShaderCompileService(jobs::Scheduler& scheduler, std::shared_ptr<ShaderCache> cache) :
+    scheduler(scheduler),
+    cache(std::move(cache))
+{}
+
+Job<CompiledShader> ShaderCompileService::compile(const ShaderCompiler::CompileRequest request)
+{
+    PORTAL_PROF_ZONE();
+
+    // The cache key covers the source, its imports and the permutation, so it identifies identical requests as well
+    const auto key = ShaderCache::calculate_key(request);
+
+    std::shared_ptr<InFlightCompile> compile;
+    bool is_owner = false;
+    {
+        std::lock_guard lock(in_flight_lock);
+        auto& entry = in_flight[key];
+        if (!entry)
+        {
+            entry = std::make_shared<InFlightCompile>();
+            is_owner = true;
+        }
+        compile = entry;
+    }
+
+    if (!is_owner)
+    {
+        LOGGER_TRACE("Waiting for in flight compile of shader: {}", request.name);
+        while (!compile->done.test(std::memory_order_acquire))
+            co_await SuspendJob();
+        co_return compile->result.clone();
+    }
+
+    auto compiled = compile_with_cache(request, key);
+    compile->result = compiled.clone();
+    {
+        std::lock_guard lock(in_flight_lock);
+        in_flight.erase(key);
+    }
+    compile->done.test_and_set(std::memory_order_release);
+
+    co_return compiled;
+}
+
+CompiledShader ShaderCompileService::compile_immediate(const ShaderCompiler::CompileRequest& request)
+{
+    PORTAL_PROF_ZONE();
+    return compile_with_cache(request, cache ? ShaderCache::calculate_key(request) : 0);
+}
+
+std::vector<CompiledShader> ShaderCompileService::compile_all(const std::span<const ShaderCompiler::CompileRequest> requests)
+{
+    PORTAL_PROF_ZONE();
+
+    std::vector<CompiledShader> results(requests.size());
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i)
+        jobs.push_back(compile_into(requests[i], results[i]));
+    scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+
+    return results;
+}
+
+size_t ShaderCompileService::get_compiler_count() const
+{
+    std::lock_guard lock(compilers_lock);
+    return compilers.size();
+}
+
+Job<> ShaderCompileService::compile_into(const ShaderCompiler::CompileRequest request, CompiledShader& output)
+{
+    PORTAL_PROF_ZONE();
+    auto job = compile(request);
+    co_await job;
+
+    // Results are moved out of the job, copying them would leave the output pointing to the job's buffers
+    if (auto result = job.result(); result.has_value())
+        output = std::move(result.value());
+    co_return;
+}
+
+CompiledShader ShaderCompileService::compile_with_cache(const ShaderCompiler::CompileRequest& request, const uint64_t key)
+{
+    if (cache)
+    {
+        if (auto cached = cache->load(key); cached.has_value())
+        {
+            LOGGER_DEBUG("Loaded shader variant from cache: {}", request.name);
+            return std::move(cached.value());
+        }
+    }
+
+    // A compile never suspends, so the thread's compiler cannot be picked up by another job halfway through
+    auto compiled = get_thread_compiler().compile(request);
+    if (cache && compiled.code)
+        cache->store(key, compiled);
+    return compiled;
+}
+
+ShaderCompiler& ShaderCompileService::get_thread_compiler()
+{
+    const auto thread_id = std::this_thread::get_id();
+    {
+        std::lock_guard lock(compilers_lock);
+        if (const auto it = compilers.find(thread_id); it != compilers.end())
+            return *it->second;
+    }
+
+    // Creating the global session is slow, other threads should not wait on it. Only this thread inserts its own
+    // compiler, so it cannot be inserted twice.
+    LOGGER_TRACE("Creating shader compiler for worker {}", jobs::Scheduler::get_tls_worker_id());
+    auto compiler = std::make_unique<ShaderCompiler>();
+
+    std::lock_guard lock(compilers_lock);
+    return *compilers.emplace(thread_id, std::move(compiler)).first->second;
+}
+} // portal
@@ -0,0 +1,100 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <thread>
+#include <unordered_map>
+
+#include "portal/core/concurrency/spin_lock.h"
+#include "portal/core/jobs/job.h"
+#include "portal/engine/renderer/shaders/shader_compiler.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+}
+
+namespace portal::renderer
+{
+class ShaderCache;
+
+/**
+ * @brief Compiles shader variants in jobs, with a pool of Slang compilers shared by every shader.
+ *
+ * Creating a Slang global session loads the Slang core module, which costs far more than compiling a typical variant.
+ * The service keeps one compiler (and global session) per thread that compiles through it, reused for every compile on
+ * that thread, instead of creating one per compile. Global sessions are not thread safe, so a compiler is never shared
+ * between threads.
+ *
+ * Compiles run as jobs on the scheduler, so the permutations of a material compile in parallel. Identical requests that
+ * are in flight at the same time are compiled once, later requests wait for the first one and get a copy of its result.
+ * When the service has a `ShaderCache`, it is checked before compiling and updated after.
+ *
+ * @par Example:
+ * @code
+ * ShaderCompileService service(scheduler, cache);
+ * const auto variants = service.compile_all(requests);
+ * @endcode
+ */
+class ShaderCompileService
+{
+public:
+    explicit ShaderCompileService(jobs::Scheduler& scheduler, std::shared_ptr<ShaderCache> cache = nullptr);
+
+    /**
+     * @brief Creates a job compiling a single variant.
+     *
+     * The source buffer of the request is not copied, it must outlive the job.
+     */
+    Job<CompiledShader> compile(ShaderCompiler::CompileRequest request);
+
+    /**
+     * @brief Compiles a single variant on the calling thread, without dispatching a job.
+     */
+    CompiledShader compile_immediate(const ShaderCompiler::CompileRequest& request);
+
+    /**
+     * @brief Compiles all requests in parallel and waits for them.
+     *
+     * @return The compiled variants, in the order of the requests
+     */
+    std::vector<CompiledShader> compile_all(std::span<const ShaderCompiler::CompileRequest> requests);
+
+    [[nodiscard]] jobs::Scheduler& get_scheduler() const { return scheduler; }
+    [[nodiscard]] const std::shared_ptr<ShaderCache>& get_cache() const { return cache; }
+
+    /**
+     * @brief Returns the number of compilers (and Slang global sessions) created so far.
+     */
+    [[nodiscard]] size_t get_compiler_count() const;
+
+private:
+    struct InFlightCompile
+    {
+        std::atomic_flag done;
+        CompiledShader result;
+    };
+
+    Job<> compile_into(ShaderCompiler::CompileRequest request, CompiledShader& output);
+    CompiledShader compile_with_cache(const ShaderCompiler::CompileRequest& request, uint64_t key);
+    ShaderCompiler& get_thread_compiler();
+
+private:
+    jobs::Scheduler& scheduler;
+    std::shared_ptr<ShaderCache> cache;
+
+    mutable SpinLock compilers_lock;
+    std::unordered_map<std::thread::id, std::unique_ptr<ShaderCompiler>> compilers;
+
+    SpinLock in_flight_lock;
+    std::unordered_map<uint64_t, std::shared_ptr<InFlightCompile>> in_flight;
+};
+} // portal
@@ -5,6 +5,8 @@
 
 #include "shader_compiler.h"
 
+#include <ranges>
+
 #include "shader_types.h"
 #include "portal/core/strings/string_utils.h"
 
@@ -194,6 +196,34 @@ reflection::PropertyType to_property_type(slang::TypeLayoutReflection* type_layo
     return reflection::PropertyType::invalid;
 }
 
+CompiledShader CompiledShader::clone() const
+{
+    auto clone_property = [](reflection::Property& property)
+    {
+        if (property.value)
+            property.value = Buffer::copy(property.value);
+    };
+
+    CompiledShader cloned{.code = code ? Buffer::copy(code) : Buffer{}, .reflection = reflection};
+    for (auto& set : cloned.reflection.descriptor_sets)
+    {
+        for (auto* buffers : {&set.uniform_buffers, &set.storage_buffers})
+        {
+            for (auto& buffer : *buffers | std::views::values)
+            {
+                for (auto& uniform : buffer.uniforms | std::views::values)
+                    clone_property(uniform.property);
+                for (auto& reflected : buffer.struct_types | std::views::values)
+                {
+                    for (auto& field : reflected.fields)
+                        clone_property(field.property);
+                }
+            }
+        }
+    }
+    return cloned;
+}
+
 ShaderCompiler::ShaderCompiler() : current_stage(ShaderStage::All)
 {
     slang::createGlobalSession(global_session.writeRef());
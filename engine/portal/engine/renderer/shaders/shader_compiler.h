@@ -20,6 +20,13 @@ struct CompiledShader
 {
     Buffer code = nullptr;
     ShaderReflection reflection{};
+
+    /**
+     * @brief Deep copies the variant
+     *
+     * Copying a `CompiledShader` shares the code and reflected type names with the original, the clone owns its own.
+     */
+    [[nodiscard]] CompiledShader clone() const;
 };
 
 /**
@@ -37,6 +37,16 @@ struct ShaderStaticConstants
     std::string value;  // Slang expression: "true", "false", etc.
 };
 
+/**
+ * @struct ShaderPermutation
+ * @brief A set of defines and specialization constants a shader variant is compiled with
+ */
+struct ShaderPermutation
+{
+    std::vector<ShaderDefine> defines;
+    std::vector<ShaderStaticConstants> static_constants;
+};
+
 /**
  * @enum ShaderStage
  * @brief Shader pipeline stages
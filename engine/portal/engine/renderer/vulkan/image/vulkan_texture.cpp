@@ -96,7 +96,12 @@ VulkanTexture::VulkanTexture(
     }
     else
     {
-        const auto size = renderer::utils::get_image_memory_size(properties.format, properties.width, properties.height, properties.depth);
+        size_t size = 0;
+        for (uint32_t mip = 0; mip < std::max(properties.precomputed_mips, 1u); ++mip)
+        {
+            const auto mip_size = get_mip_size(mip);
+            size += renderer::utils::get_image_memory_size(properties.format, mip_size.x, mip_size.y, mip_size.z);
+        }
         image_data = Buffer::allocate(size);
         image_data.zero_initialize();
     }
@@ -162,12 +167,14 @@ glm::uvec3 VulkanTexture::get_size() const
 
 uint32_t VulkanTexture::get_mip_level_count() const
 {
+    if (properties.precomputed_mips > 0)
+        return properties.precomputed_mips;
     return static_cast<uint32_t>(renderer::utils::calculate_mip_count(properties.width, properties.height, properties.depth));
 }
 
 glm::uvec3 VulkanTexture::get_mip_size(const uint32_t mip) const
 {
-    return {properties.width >> mip, properties.height >> mip, properties.depth >> mip};
+    return glm::max(glm::uvec3(properties.width >> mip, properties.height >> mip, properties.depth >> mip), glm::uvec3(1));
 }
 
 Reference<Image> VulkanTexture::get_image() const
@@ -200,12 +207,27 @@ bool VulkanTexture::loaded() const
     return image != nullptr;
 }
 
+ResourceMemoryUsage VulkanTexture::get_memory_usage() const
+{
+    ResourceMemoryUsage usage{.cpu_bytes = image_data.size};
+    if (!image)
+        return usage;
+
+    const auto layer_count = get_array_layer_count();
+    for (uint32_t mip = 0; mip < get_allocated_mip_count(); ++mip)
+    {
+        const auto mip_size = get_mip_size(mip);
+        usage.gpu_bytes += renderer::utils::get_image_memory_size(properties.format, mip_size.x, mip_size.y, mip_size.z) * layer_count;
+    }
+    return usage;
+}
+
 void VulkanTexture::recreate()
 {
     if (image != nullptr)
         image.reset();
 
-    const auto mip_count = properties.generate_mipmaps ? get_mip_level_count() : 1;
+    const auto mip_count = get_allocated_mip_count();
     const auto layer_count = get_array_layer_count();
 
     image::Properties image_prop{
@@ -290,6 +312,8 @@ void VulkanTexture::set_data(const Buffer& data)
     auto staging_buffer = AllocatedBuffer::create_staging_buffer(device, data.size, data.data);
 
     const uint32_t layer_count = get_array_layer_count();
+    // Precomputed mips are all copied from the data, otherwise only the first mip is and the rest are generated
+    const uint32_t copied_mips = std::max(properties.precomputed_mips, 1u);
 
     device.immediate_submit(
         [&](const vk::raii::CommandBuffer& command_buffer)
@@ -300,7 +324,7 @@ void VulkanTexture::set_data(const Buffer& data)
                 .aspectMask = vk::ImageAspectFlagBits::eColor,
                 // Start at the first mip level
                 .baseMipLevel = 0,
-                .levelCount = 1,
+                .levelCount = copied_mips,
                 .baseArrayLayer = 0,
                 .layerCount = layer_count
             };
@@ -318,31 +342,38 @@ void VulkanTexture::set_data(const Buffer& data)
                 vk::PipelineStageFlagBits2::eTransfer
             );
 
-            vk::BufferImageCopy copy_region{
-                .bufferOffset = 0,
-                .imageSubresource = {
-                    .aspectMask = vk::ImageAspectFlagBits::eColor,
-                    .mipLevel = 0,
-                    .baseArrayLayer = 0,
-                    .layerCount = layer_count
-                },
-                .imageExtent = {
-                    static_cast<uint32_t>(properties.width),
-                    static_cast<uint32_t>(properties.height),
-                    static_cast<uint32_t>(properties.depth)
-                }
-            };
+            // Mips are tightly packed one after the other in the data, with all the layers of a mip together
+            std::vector<vk::BufferImageCopy> copy_regions;
+            copy_regions.reserve(copied_mips);
+            vk::DeviceSize offset = 0;
+            for (uint32_t mip = 0; mip < copied_mips; ++mip)
+            {
+                const auto mip_size = get_mip_size(mip);
+                copy_regions.push_back(
+                    {
+                        .bufferOffset = offset,
+                        .imageSubresource = {
+                            .aspectMask = vk::ImageAspectFlagBits::eColor,
+                            .mipLevel = mip,
+                            .baseArrayLayer = 0,
+                            .layerCount = layer_count
+                        },
+                        .imageExtent = {mip_size.x, mip_size.y, mip_size.z}
+                    }
+                );
+                offset += renderer::utils::get_image_memory_size(properties.format, mip_size.x, mip_size.y, mip_size.z) * layer_count;
+            }
+            PORTAL_ASSERT(offset <= data.size, "Texture data is smaller than its mips");
 
             // Copy mip levels from staging buffer
             command_buffer.copyBufferToImage(
                 staging_buffer.get_handle(),
                 info.image.get_handle(),
                 vk::ImageLayout::eTransferDstOptimal,
-                {copy_region}
+                copy_regions
             );
 
-            const size_t mip_count = properties.generate_mipmaps ? get_mip_level_count() : 1;
-            if (mip_count > 1)
+            if (get_allocated_mip_count() > copied_mips)
             {
                 // There are mips to generate, move to get ready to transfer
                 portal::renderer::vulkan::transition_image_layout(
@@ -375,8 +406,7 @@ void VulkanTexture::set_data(const Buffer& data)
         }
     );
 
-    const size_t mip_count = properties.generate_mipmaps ? get_mip_level_count() : 1;
-    if (mip_count > 1 && properties.generate_mipmaps)
+    if (get_allocated_mip_count() > copied_mips)
         generate_mipmaps();
 }
 
@@ -495,6 +525,13 @@ void VulkanTexture::generate_mipmaps() const
     );
 }
 
+uint32_t VulkanTexture::get_allocated_mip_count() const
+{
+    if (properties.precomputed_mips > 0)
+        return properties.precomputed_mips;
+    return properties.generate_mipmaps ? get_mip_level_count() : 1;
+}
+
 uint32_t VulkanTexture::get_array_layer_count() const
 {
     if (properties.type == TextureType::TextureCube)
@@ -103,12 +103,17 @@ public:
     /** @brief Checks if texture data is loaded */
     bool loaded() const override;
 
+    /** @brief CPU copy of the data, and the image with all of its mips and layers on the GPU */
+    [[nodiscard]] ResourceMemoryUsage get_memory_usage() const override;
+
 private:
     void recreate();
 
     void set_data(const Buffer& data);
     void generate_mipmaps() const;
 
+    /** @brief Mips allocated in the image, either precomputed in the data or generated on upload */
+    uint32_t get_allocated_mip_count() const;
     uint32_t get_array_layer_count() const;
 
 private:
@@ -0,0 +1,206 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "asset_cooker.h"
+
+#include <cstring>
+#include <fstream>
+#include <ranges>
+#include <unordered_set>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "cooked_resource.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/core/strings/hash.h"
+#include "portal/engine/resources/database/folder_resource_database.h"
+
+namespace portal::resources
+{
+static auto logger = Log::get_logger("Resources");
+
+namespace
+{
+    void collect_resources(ResourceDatabase& database, const DatabaseEntry& entry, std::vector<SourceMetadata>& output)
+    {
+        if (entry.children.empty())
+        {
+            if (auto meta = database.find(entry.name); meta.has_value())
+                output.push_back(std::move(meta.value()));
+            return;
+        }
+
+        for (const auto& child : entry.children | std::views::values)
+            collect_resources(database, *child, output);
+    }
+
+    /**
+     * Writes a file next to its destination and renames it over the destination, so a cooked file is never seen
+     * half written, even if cooking is interrupted.
+     */
+    template <typename F>
+    bool write_atomically(const std::filesystem::path& path, F&& write)
+    {
+        const auto temporary_path = std::filesystem::path(path).concat(".tmp");
+        {
+            std::ofstream output(temporary_path, std::ios::binary | std::ios::trunc);
+            if (!output.is_open())
+            {
+                LOGGER_ERROR("Failed to open {} for writing", temporary_path.generic_string());
+                return false;
+            }
+
+            write(output);
+            if (!output)
+            {
+                LOGGER_ERROR("Failed to write {}", temporary_path.generic_string());
+                output.close();
+                FileSystem::remove(temporary_path);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary_path, path, error);
+        if (error)
+        {
+            LOGGER_ERROR("Failed to move cooked resource to {}: {}", path.generic_string(), error.message());
+            FileSystem::remove(temporary_path);
+            return false;
+        }
+        return true;
+    }
+}
+
+AssetCooker::AssetCooker(jobs::Scheduler& scheduler) : scheduler(scheduler) {}
+
+CookReport AssetCooker::cook(ResourceDatabase& database, const bool force)
+{
+    PORTAL_PROF_ZONE();
+
+    std::vector<SourceMetadata> resources;
+    collect_resources(database, database.get_structure(), resources);
+
+    // Several resources can share a source (e.g. a gltf texture and the image it points to), each source is cooked once
+    std::unordered_set<StringId> sources;
+    std::erase_if(resources, [&sources](const SourceMetadata& meta) { return !can_cook(meta) || !sources.insert(meta.source).second; });
+
+    std::vector<CookResult> results(resources.size(), CookResult::Failed);
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+        jobs.push_back(cook_job(database.get_root_path(), resources[i], force, results[i]));
+    scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+
+    CookReport report;
+    for (const auto result : results)
+    {
+        switch (result)
+        {
+        case CookResult::Cooked:
+            report.cooked++;
+            break;
+        case CookResult::UpToDate:
+            report.up_to_date++;
+            break;
+        case CookResult::Failed:
+            report.failed++;
+            break;
+        }
+    }
+
+    LOGGER_INFO(
+        "Cooked database {}: {} cooked, {} up to date, {} failed",
+        database.get_name(),
+        report.cooked,
+        report.up_to_date,
+        report.failed
+    );
+    return report;
+}
+
+bool AssetCooker::can_cook(const SourceMetadata& meta)
+{
+    return (meta.type == ResourceType::Texture && meta.format == SourceFormat::Image) ||
+        (meta.type == ResourceType::Mesh && meta.format == SourceFormat::Obj);
+}
+
+Job<> AssetCooker::cook_job(const std::filesystem::path& root_path, const SourceMetadata& meta, const bool force, CookResult& result)
+{
+    PORTAL_PROF_ZONE();
+    result = cook_resource(root_path, meta, force);
+    co_return;
+}
+
+AssetCooker::CookResult AssetCooker::cook_resource(const std::filesystem::path& root_path, const SourceMetadata& meta, const bool force)
+{
+    const auto source_path = root_path / meta.source.string;
+    const auto cooked_path = FolderResourceDatabase::get_cooked_path(source_path);
+
+    const auto stat = FileSystem::stat_file(source_path);
+    if (!stat.is_file)
+    {
+        LOGGER_ERROR("Failed to cook {}, missing source: {}", meta.resource_id, source_path.generic_string());
+        return CookResult::Failed;
+    }
+
+    std::optional<CookedHeader> existing;
+    if (!force)
+        existing = read_cooked_header(cooked_path);
+    if (existing && existing->type == meta.type && existing->matches(stat))
+        return CookResult::UpToDate;
+
+    const auto source = FileSystem::read_file_binary(source_path);
+    const CookedHeader header{
+        .type = meta.type,
+        .source_size = stat.size,
+        .source_write_time = stat.last_write_time,
+        .source_hash = hash::rapidhash(source.as<const char*>(), source.size),
+    };
+
+    if (existing && existing->type == meta.type && existing->source_hash == header.source_hash)
+    {
+        // The source was touched but its content did not change, only the header needs to match the new stat
+        auto cooked = FileSystem::read_file_binary(cooked_path);
+        std::memcpy(cooked.data_ptr(), &header, sizeof(header));
+        const bool written = write_atomically(
+            cooked_path,
+            [&cooked](std::ostream& output) { output.write(cooked.as<const char*>(), static_cast<std::streamsize>(cooked.size)); }
+        );
+        return written ? CookResult::UpToDate : CookResult::Failed;
+    }
+
+    LOGGER_DEBUG("Cooking {}", meta.resource_id);
+    bool written = false;
+    try
+    {
+        if (meta.type == ResourceType::Texture)
+        {
+            const auto texture = cook_texture(source);
+            if (!texture)
+            {
+                LOGGER_ERROR("Failed to cook texture {}", meta.resource_id);
+                return CookResult::Failed;
+            }
+
+            written = write_atomically(cooked_path, [&](std::ostream& output) { write_cooked_texture(output, header, texture.value()); });
+        }
+        else
+        {
+            const auto mesh = parse_obj(std::string_view{source.as<const char*>(), source.size});
+            written = write_atomically(cooked_path, [&](std::ostream& output) { write_cooked_mesh(output, header, mesh); });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOGGER_ERROR("Failed to cook {}: {}", meta.resource_id, e.what());
+        return CookResult::Failed;
+    }
+
+    return written ? CookResult::Cooked : CookResult::Failed;
+}
+} // portal
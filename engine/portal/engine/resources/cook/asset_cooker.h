@@ -0,0 +1,81 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <filesystem>
+
+#include "portal/core/jobs/job.h"
+#include "portal/engine/resources/database/resource_database.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+}
+
+namespace portal::resources
+{
+/**
+ * @brief Summary of a cook, per resource outcome.
+ */
+struct CookReport
+{
+    size_t cooked = 0;
+    size_t up_to_date = 0;
+    size_t failed = 0;
+};
+
+/**
+ * @brief Cooks the resources of a folder database into engine native binary files.
+ *
+ * Image textures are decoded and get their whole mip chain generated on the CPU, OBJ meshes are parsed and get their
+ * tangents calculated. The result is written next to the source as `{source}.pcooked`, which the database prefers over
+ * the source while the source is not modified, so the loaders only copy the cooked data to the GPU.
+ *
+ * Cooking is incremental, a resource is only cooked again when its source content hash changes. Every resource is
+ * cooked in its own job.
+ *
+ * @par Example:
+ * @code
+ * resources::AssetCooker cooker(scheduler);
+ * const auto report = cooker.cook(database);
+ * @endcode
+ */
+class AssetCooker
+{
+public:
+    explicit AssetCooker(jobs::Scheduler& scheduler);
+
+    /**
+     * @brief Cooks every cookable resource of the database.
+     *
+     * @param database A database with files under its root path, such as `FolderResourceDatabase`
+     * @param force Cook resources even when their cooked file is up to date
+     */
+    CookReport cook(ResourceDatabase& database, bool force = false);
+
+    /**
+     * @brief Checks if the cooker has a cooked format for the resource.
+     */
+    [[nodiscard]] static bool can_cook(const SourceMetadata& meta);
+
+private:
+    enum class CookResult
+    {
+        Cooked,
+        UpToDate,
+        Failed
+    };
+
+    static Job<> cook_job(const std::filesystem::path& root_path, const SourceMetadata& meta, bool force, CookResult& result);
+    static CookResult cook_resource(const std::filesystem::path& root_path, const SourceMetadata& meta, bool force);
+
+private:
+    jobs::Scheduler& scheduler;
+};
+} // portal
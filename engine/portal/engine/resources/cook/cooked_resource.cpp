@@ -0,0 +1,299 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "cooked_resource.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <stb_image.h>
+
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/engine/renderer/image/image.h"
+
+namespace portal::resources
+{
+static auto logger = Log::get_logger("Resources");
+
+namespace
+{
+    struct CookedTextureInfo
+    {
+        renderer::ImageFormat format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t mip_count;
+    };
+
+    struct CookedMeshInfo
+    {
+        uint64_t vertex_count;
+        uint64_t index_count;
+        uint64_t submesh_count;
+    };
+
+    template <typename T>
+    void write_raw(std::ostream& output, const T& value)
+    {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void write_raw(std::ostream& output, const std::vector<T>& values)
+    {
+        output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    bool read_raw(const Buffer& data, size_t& offset, T& value)
+    {
+        if (data.size - offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, static_cast<const uint8_t*>(data.data) + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool read_raw(const Buffer& data, size_t& offset, std::vector<T>& values, const uint64_t count)
+    {
+        if ((data.size - offset) / sizeof(T) < count)
+            return false;
+
+        values.resize(count);
+        std::memcpy(values.data(), static_cast<const uint8_t*>(data.data) + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    void downsample(const T* source, T* destination, const uint32_t source_width, const uint32_t source_height)
+    {
+        constexpr size_t channels = 4;
+        const uint32_t width = std::max(1u, source_width / 2);
+        const uint32_t height = std::max(1u, source_height / 2);
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            // Odd and 1 pixel wide sources clamp to their last row or column
+            const uint32_t y0 = std::min(y * 2, source_height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, source_height - 1);
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, source_width - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, source_width - 1);
+
+                for (size_t channel = 0; channel < channels; ++channel)
+                {
+                    const float sum = static_cast<float>(source[(y0 * source_width + x0) * channels + channel]) +
+                        static_cast<float>(source[(y0 * source_width + x1) * channels + channel]) +
+                        static_cast<float>(source[(y1 * source_width + x0) * channels + channel]) +
+                        static_cast<float>(source[(y1 * source_width + x1) * channels + channel]);
+
+                    if constexpr (std::is_integral_v<T>)
+                        destination[(y * width + x) * channels + channel] = static_cast<T>((sum + 2.f) / 4.f);
+                    else
+                        destination[(y * width + x) * channels + channel] = sum / 4.f;
+                }
+            }
+        }
+    }
+}
+
+bool CookedHeader::is_valid() const
+{
+    return magic == MAGIC && version == VERSION;
+}
+
+bool CookedHeader::matches(const FileStat& stat) const
+{
+    return is_valid() && source_size == stat.size && source_write_time == stat.last_write_time;
+}
+
+std::optional<CookedHeader> read_cooked_header(const Buffer& data)
+{
+    CookedHeader header;
+    size_t offset = 0;
+    if (!data || !read_raw(data, offset, header) || !header.is_valid())
+        return std::nullopt;
+
+    return header;
+}
+
+std::optional<CookedHeader> read_cooked_header(const std::filesystem::path& path)
+{
+    if (FileSystem::stat_file(path).size < sizeof(CookedHeader))
+        return std::nullopt;
+
+    return read_cooked_header(FileSystem::read_chunk(path, 0, sizeof(CookedHeader)));
+}
+
+uint32_t get_full_mip_count(const uint32_t width, const uint32_t height)
+{
+    return static_cast<uint32_t>(std::bit_width(std::max({width, height, 1u})));
+}
+
+size_t get_mip_chain_size(const renderer::ImageFormat format, const uint32_t width, const uint32_t height, const uint32_t mip_count)
+{
+    size_t size = 0;
+    for (uint32_t mip = 0; mip < mip_count; ++mip)
+        size += renderer::utils::get_image_memory_size(format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+    return size;
+}
+
+Buffer generate_mip_chain(
+    const renderer::ImageFormat format,
+    const Buffer& pixels,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t mip_count
+)
+{
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(
+        format == renderer::ImageFormat::RGBA8_UNorm || format == renderer::ImageFormat::RGBA32_Float,
+        "Unsupported mip generation format"
+    );
+    PORTAL_ASSERT(pixels.size == renderer::utils::get_image_memory_size(format, width, height), "Invalid image size");
+
+    auto chain = Buffer::allocate(get_mip_chain_size(format, width, height, mip_count));
+    std::memcpy(chain.data_ptr(), pixels.data, pixels.size);
+
+    auto* base = static_cast<uint8_t*>(chain.data_ptr());
+    size_t source_offset = 0;
+    size_t destination_offset = pixels.size;
+    for (uint32_t mip = 1; mip < mip_count; ++mip)
+    {
+        const uint32_t source_width = std::max(1u, width >> (mip - 1));
+        const uint32_t source_height = std::max(1u, height >> (mip - 1));
+
+        if (format == renderer::ImageFormat::RGBA8_UNorm)
+            downsample(base + source_offset, base + destination_offset, source_width, source_height);
+        else
+            downsample(
+                reinterpret_cast<const float*>(base + source_offset),
+                reinterpret_cast<float*>(base + destination_offset),
+                source_width,
+                source_height
+            );
+
+        source_offset = destination_offset;
+        destination_offset += renderer::utils::get_image_memory_size(format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+    }
+
+    return chain;
+}
+
+std::optional<CookedTexture> cook_texture(const Buffer& image_file)
+{
+    PORTAL_PROF_ZONE();
+
+    int width, height, n_channels;
+    void* image_data = nullptr;
+    renderer::ImageFormat format;
+
+    if (stbi_is_hdr_from_memory(image_file.as<const stbi_uc*>(), static_cast<int>(image_file.size)))
+    {
+        image_data = stbi_loadf_from_memory(image_file.as<const stbi_uc*>(), static_cast<int>(image_file.size), &width, &height, &n_channels, STBI_rgb_alpha);
+        format = renderer::ImageFormat::RGBA32_Float;
+    }
+    else
+    {
+        image_data = stbi_load_from_memory(image_file.as<const stbi_uc*>(), static_cast<int>(image_file.size), &width, &height, &n_channels, STBI_rgb_alpha);
+        format = renderer::ImageFormat::RGBA8_UNorm;
+    }
+
+    if (!image_data)
+    {
+        LOGGER_ERROR("Failed to decode image: {}", stbi_failure_reason());
+        return std::nullopt;
+    }
+
+    CookedTexture texture{
+        .format = format,
+        .width = static_cast<uint32_t>(width),
+        .height = static_cast<uint32_t>(height),
+        .mip_count = get_full_mip_count(static_cast<uint32_t>(width), static_cast<uint32_t>(height)),
+    };
+
+    const Buffer pixels{image_data, renderer::utils::get_image_memory_size(format, texture.width, texture.height)};
+    texture.data = generate_mip_chain(format, pixels, texture.width, texture.height, texture.mip_count);
+
+    stbi_image_free(image_data);
+    return texture;
+}
+
+void write_cooked_texture(std::ostream& output, const CookedHeader& header, const CookedTexture& texture)
+{
+    PORTAL_ASSERT(header.type == ResourceType::Texture, "Invalid cooked texture header");
+    PORTAL_ASSERT(texture.data.size == get_mip_chain_size(texture.format, texture.width, texture.height, texture.mip_count), "Invalid mip chain");
+
+    write_raw(output, header);
+    write_raw(output, CookedTextureInfo{texture.format, texture.width, texture.height, texture.mip_count});
+    output.write(texture.data.as<const char*>(), static_cast<std::streamsize>(texture.data.size));
+}
+
+void write_cooked_mesh(std::ostream& output, const CookedHeader& header, const MeshData& mesh)
+{
+    PORTAL_ASSERT(header.type == ResourceType::Mesh, "Invalid cooked mesh header");
+
+    write_raw(output, header);
+    write_raw(output, CookedMeshInfo{mesh.vertices.size(), mesh.indices.size(), mesh.submeshes.size()});
+    write_raw(output, mesh.vertices);
+    write_raw(output, mesh.indices);
+    write_raw(output, mesh.submeshes);
+}
+
+std::optional<CookedTexture> read_cooked_texture(const Buffer& data)
+{
+    const auto header = read_cooked_header(data);
+    if (!header || header->type != ResourceType::Texture)
+        return std::nullopt;
+
+    size_t offset = sizeof(CookedHeader);
+    CookedTextureInfo info{};
+    if (!read_raw(data, offset, info))
+        return std::nullopt;
+
+    const auto size = get_mip_chain_size(info.format, info.width, info.height, info.mip_count);
+    if (data.size - offset < size)
+    {
+        LOGGER_ERROR("Cooked texture is truncated, expected {} bytes of mips, found {}", size, data.size - offset);
+        return std::nullopt;
+    }
+
+    return CookedTexture{
+        .format = info.format,
+        .width = info.width,
+        .height = info.height,
+        .mip_count = info.mip_count,
+        .data = Buffer{data, offset, size}
+    };
+}
+
+std::optional<MeshData> read_cooked_mesh(const Buffer& data)
+{
+    const auto header = read_cooked_header(data);
+    if (!header || header->type != ResourceType::Mesh)
+        return std::nullopt;
+
+    size_t offset = sizeof(CookedHeader);
+    CookedMeshInfo info{};
+    MeshData mesh;
+    if (!read_raw(data, offset, info) ||
+        !read_raw(data, offset, mesh.vertices, info.vertex_count) ||
+        !read_raw(data, offset, mesh.indices, info.index_count) ||
+        !read_raw(data, offset, mesh.submeshes, info.submesh_count))
+    {
+        LOGGER_ERROR("Cooked mesh is truncated");
+        return std::nullopt;
+    }
+
+    return mesh;
+}
+} // portal
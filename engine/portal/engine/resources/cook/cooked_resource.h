@@ -0,0 +1,124 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <ostream>
+
+#include "portal/core/buffer.h"
+#include "portal/core/files/file_system.h"
+#include "portal/engine/renderer/image/image_types.h"
+#include "portal/engine/resources/resource_types.h"
+#include "portal/engine/resources/loader/mesh_loader.h"
+
+namespace portal::resources
+{
+/**
+ * @brief Header at the start of every cooked resource file.
+ *
+ * Records the source file the resource was cooked from, so a stale cooked file is detected by comparing the header with
+ * the source file stat, without decoding either of them. The content hash lets the cooker skip sources that were touched
+ * but not changed.
+ */
+struct CookedHeader
+{
+    constexpr static std::array MAGIC = {'P', 'C', 'K', 'D'};
+    constexpr static uint32_t VERSION = 1;
+
+    std::array<char, 4> magic = MAGIC;
+    uint32_t version = VERSION;
+    ResourceType type = ResourceType::Unknown;
+    uint16_t reserved_0 = 0;
+    uint32_t reserved_1 = 0;
+    uint64_t source_size = 0;
+    uint64_t source_write_time = 0;
+    uint64_t source_hash = 0;
+
+    /**
+     * @brief Checks the magic and version of the header.
+     */
+    [[nodiscard]] bool is_valid() const;
+
+    /**
+     * @brief Checks if the header was cooked from a source with the given stat.
+     */
+    [[nodiscard]] bool matches(const FileStat& stat) const;
+};
+
+static_assert(std::is_trivially_copyable_v<CookedHeader>);
+static_assert(sizeof(CookedHeader) == 40, "The cooked header is written as is, it must not have padding");
+
+/**
+ * @brief A decoded texture with its whole mip chain.
+ *
+ * Mips are tightly packed one after the other, starting with the full resolution mip. Every mip is half the size of the
+ * previous one, rounded down and clamped to 1.
+ */
+struct CookedTexture
+{
+    renderer::ImageFormat format = renderer::ImageFormat::RGBA8_UNorm;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mip_count = 0;
+    Buffer data;
+};
+
+/**
+ * @brief Reads the header of a cooked resource.
+ *
+ * @return The header, or nullopt if `data` is not a cooked resource of a supported version
+ */
+std::optional<CookedHeader> read_cooked_header(const Buffer& data);
+
+/**
+ * @brief Reads the header of a cooked resource file, without reading the rest of the file.
+ */
+std::optional<CookedHeader> read_cooked_header(const std::filesystem::path& path);
+
+/**
+ * @brief Returns the number of mips in a full mip chain, down to 1x1.
+ */
+uint32_t get_full_mip_count(uint32_t width, uint32_t height);
+
+/**
+ * @brief Returns the size in bytes of a tightly packed mip chain.
+ */
+size_t get_mip_chain_size(renderer::ImageFormat format, uint32_t width, uint32_t height, uint32_t mip_count);
+
+/**
+ * @brief Generates a mip chain from a full resolution image using a 2x2 box filter.
+ *
+ * Only `RGBA8_UNorm` and `RGBA32_Float` images are supported, as those are the formats images are decoded to.
+ *
+ * @return A buffer holding all the mips, with `pixels` copied as the first mip
+ */
+Buffer generate_mip_chain(renderer::ImageFormat format, const Buffer& pixels, uint32_t width, uint32_t height, uint32_t mip_count);
+
+/**
+ * @brief Decodes an image file (PNG, JPEG, HDR...) and generates its mip chain.
+ */
+std::optional<CookedTexture> cook_texture(const Buffer& image_file);
+
+void write_cooked_texture(std::ostream& output, const CookedHeader& header, const CookedTexture& texture);
+void write_cooked_mesh(std::ostream& output, const CookedHeader& header, const MeshData& mesh);
+
+/**
+ * @brief Reads a cooked texture.
+ *
+ * The returned texture data does not own its memory, it points into `data`.
+ *
+ * @return The texture, or nullopt if `data` is not a cooked texture
+ */
+std::optional<CookedTexture> read_cooked_texture(const Buffer& data);
+
+/**
+ * @brief Reads a cooked mesh.
+ *
+ * @return The mesh, or nullopt if `data` is not a cooked mesh
+ */
+std::optional<MeshData> read_cooked_mesh(const Buffer& data);
+} // portal
@@ -0,0 +1,281 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "pack_builder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <unordered_map>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/files/file_system.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/core/strings/hash.h"
+#include "portal/engine/resources/database/pack_resource_database.h"
+#include "portal/engine/resources/source/resource_source.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+namespace portal::resources
+{
+static auto logger = Log::get_logger("Resources");
+
+namespace
+{
+    // Blocks start aligned, so data read through the mapping can be used in place
+    constexpr uint64_t BLOCK_ALIGNMENT = 16;
+    // Blocks are read and compressed in batches, a pack is never held in memory as a whole
+    constexpr size_t BLOCK_BATCH_SIZE = 64;
+
+    void collect_resources(ResourceDatabase& database, const DatabaseEntry& entry, std::vector<SourceMetadata>& output)
+    {
+        if (entry.children.empty())
+        {
+            if (auto meta = database.find(entry.name); meta.has_value())
+                output.push_back(std::move(meta.value()));
+            return;
+        }
+
+        for (const auto& child : entry.children | std::views::values)
+            collect_resources(database, *child, output);
+    }
+
+    void pad(std::ostream& output, uint64_t& position)
+    {
+        constexpr std::array<char, BLOCK_ALIGNMENT> zeros{};
+        const auto padding = (BLOCK_ALIGNMENT - position % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT;
+        output.write(zeros.data(), static_cast<std::streamsize>(padding));
+        position += padding;
+    }
+
+    void append(std::vector<char>& output, const void* data, const size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        output.insert(output.end(), bytes, bytes + size);
+    }
+}
+
+PackBuilder::PackBuilder(jobs::Scheduler& scheduler) : scheduler(scheduler) {}
+
+PackReport PackBuilder::build(ResourceDatabase& database, const std::filesystem::path& output_path, const PackParams& params)
+{
+    PORTAL_PROF_ZONE();
+
+    std::vector<SourceMetadata> resources;
+    collect_resources(database, database.get_structure(), resources);
+
+    // Several resources can share a source (e.g. a gltf texture and the image it points to), each source is packed once.
+    // Resources inside of a composite are loaded through it and have no data of their own.
+    std::vector<Block> blocks;
+    std::unordered_map<StringId, size_t> source_blocks;
+    std::vector<size_t> resource_blocks(resources.size(), std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        const auto& meta = resources[i];
+        if (meta.source.string.starts_with("composite://"))
+            continue;
+
+        const auto [it, inserted] = source_blocks.try_emplace(meta.source, blocks.size());
+        if (inserted)
+            blocks.push_back(Block{.meta = meta});
+        resource_blocks[i] = it->second;
+    }
+
+    PackReport report;
+    const auto temporary_path = std::filesystem::path(output_path).concat(".tmp");
+    {
+        std::ofstream output(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            LOGGER_ERROR("Failed to open {} for writing", temporary_path.generic_string());
+            return PackReport{.failed = resources.size()};
+        }
+
+        // The header is written last, once the offsets are known
+        PackHeader header;
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t position = sizeof(header);
+
+        for (size_t batch = 0; batch < blocks.size(); batch += BLOCK_BATCH_SIZE)
+        {
+            const auto batch_blocks = std::span(blocks).subspan(batch, std::min(BLOCK_BATCH_SIZE, blocks.size() - batch));
+
+            llvm::SmallVector<Job<>> jobs;
+            jobs.reserve(batch_blocks.size());
+            for (auto& block : batch_blocks)
+                jobs.push_back(read_job(database, params, block));
+            scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+
+            for (auto& block : batch_blocks)
+            {
+                if (block.failed)
+                    continue;
+
+                pad(output, position);
+                block.offset = position;
+                output.write(block.data.as<const char*>(), static_cast<std::streamsize>(block.data.size));
+                position += block.data.size;
+
+                report.blocks++;
+                report.raw_bytes += block.raw_size;
+                report.stored_bytes += block.data.size;
+                block.data = Buffer{};
+            }
+        }
+
+        std::vector<PackEntry> entries;
+        std::vector<const SourceMetadata*> entry_metadata;
+        entries.reserve(resources.size());
+        for (size_t i = 0; i < resources.size(); ++i)
+        {
+            const auto& meta = resources[i];
+            PackEntry entry{.resource_id = meta.resource_id.id};
+
+            if (resource_blocks[i] != std::numeric_limits<size_t>::max())
+            {
+                const auto& block = blocks[resource_blocks[i]];
+                if (block.failed)
+                {
+                    report.failed++;
+                    continue;
+                }
+
+                entry.data_offset = block.offset;
+                entry.stored_size = block.stored_size;
+                entry.raw_size = block.raw_size;
+            }
+            else
+            {
+                entry.composite_id = meta.full_source_path.id;
+            }
+
+            entries.push_back(entry);
+            entry_metadata.push_back(&meta);
+        }
+
+        // Lookups binary search the table
+        std::vector<size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::sort(order, {}, [&entries](const size_t i) { return entries[i].resource_id; });
+
+        const auto name = database.get_name().string;
+        std::vector<char> strings;
+        append(strings, name.data(), name.size());
+        std::vector<char> metadata;
+        std::vector<PackEntry> table;
+        table.reserve(entries.size());
+        for (const auto i : order)
+        {
+            auto entry = entries[i];
+            const auto& meta = *entry_metadata[i];
+
+            entry.string_offset = static_cast<uint32_t>(strings.size());
+            entry.string_size = static_cast<uint32_t>(meta.resource_id.string.size());
+            append(strings, meta.resource_id.string.data(), meta.resource_id.string.size());
+
+            Buffer buffer;
+            BufferStreamWriter stream(buffer);
+            {
+                // Composites with many children do not fit in the default 16 bit element count
+                BinarySerializer serializer(stream, BinarySerializationParams{.large_element_size = true});
+                meta.serialize(serializer);
+            }
+            stream.flush();
+            const auto blob = stream.get_buffer();
+
+            entry.metadata_offset = static_cast<uint32_t>(metadata.size());
+            entry.metadata_size = static_cast<uint32_t>(blob.size);
+            append(metadata, blob.data, blob.size);
+
+            table.push_back(entry);
+            report.resources++;
+        }
+
+        // The table is read in place from the mapping
+        pad(output, position);
+        header.entry_count = table.size();
+        header.table_offset = position;
+        header.strings_offset = header.table_offset + table.size() * sizeof(PackEntry);
+        header.metadata_offset = header.strings_offset + strings.size();
+        header.name_offset = 0;
+        header.name_size = static_cast<uint32_t>(name.size());
+
+        std::vector<char> index;
+        index.reserve(metadata.size() + strings.size() + table.size() * sizeof(PackEntry));
+        append(index, table.data(), table.size() * sizeof(PackEntry));
+        append(index, strings.data(), strings.size());
+        append(index, metadata.data(), metadata.size());
+        header.index_hash = hash::rapidhash(index.data(), index.size());
+
+        output.write(index.data(), static_cast<std::streamsize>(index.size()));
+        output.seekp(0);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!output.good())
+        {
+            LOGGER_ERROR("Failed to write {}", temporary_path.generic_string());
+            output.close();
+            FileSystem::remove(temporary_path);
+            return PackReport{.failed = resources.size()};
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, output_path, error);
+    if (error)
+    {
+        LOGGER_ERROR("Failed to move resource pack to {}: {}", output_path.generic_string(), error.message());
+        FileSystem::remove(temporary_path);
+        return PackReport{.failed = resources.size()};
+    }
+
+    LOGGER_INFO(
+        "Packed database {} into {}: {} resources, {} blocks, {} bytes ({} raw), {} failed",
+        database.get_name(),
+        output_path.generic_string(),
+        report.resources,
+        report.blocks,
+        report.stored_bytes,
+        report.raw_bytes,
+        report.failed
+    );
+    return report;
+}
+
+Job<> PackBuilder::read_job(ResourceDatabase& database, const PackParams& params, Block& block)
+{
+    PORTAL_PROF_ZONE();
+
+    const auto source = database.create_source(block.meta.resource_id, block.meta);
+    auto data = source ? source->load() : Buffer{};
+    if (!data)
+    {
+        LOGGER_ERROR("Failed to read {} for packing", block.meta.resource_id);
+        block.failed = true;
+        co_return;
+    }
+
+    // Sources may hand out views into memory they own, the block outlives the source
+    if (!data.is_allocated())
+        data = Buffer::copy(data);
+
+    block.raw_size = data.size;
+    if (params.compress)
+    {
+        auto compressed = compress(data, params.compression);
+        if (compressed.size < data.size)
+            data = std::move(compressed);
+    }
+    block.stored_size = data.size;
+    block.data = std::move(data);
+    co_return;
+}
+} // portal
@@ -0,0 +1,84 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <filesystem>
+
+#include "portal/core/jobs/job.h"
+#include "portal/engine/resources/database/resource_database.h"
+#include "portal/serialization/compression/block_compression.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+}
+
+namespace portal::resources
+{
+struct PackParams
+{
+    // Compress the data of every resource, data that does not get smaller is stored as is
+    bool compress = true;
+    CompressionParams compression{.algorithm = CompressionAlgorithm::Zstd, .level = 3};
+};
+
+/**
+ * @brief Summary of a pack build.
+ */
+struct PackReport
+{
+    size_t resources = 0;
+    // Resources sharing a source share a block
+    size_t blocks = 0;
+    size_t raw_bytes = 0;
+    size_t stored_bytes = 0;
+    size_t failed = 0;
+};
+
+/**
+ * @brief Packs the resources of a database into a single file, opened with `PackResourceDatabase`.
+ *
+ * The data of every resource is read through the database, so cooked resources are packed in their cooked form, and
+ * is compressed in its own job. The pack is written next to the output path and renamed over it when it is complete.
+ *
+ * @par Example:
+ * @code
+ * resources::PackBuilder builder(scheduler);
+ * const auto report = builder.build(database, "game.ppak");
+ * @endcode
+ */
+class PackBuilder
+{
+public:
+    explicit PackBuilder(jobs::Scheduler& scheduler);
+
+    /**
+     * @brief Packs every resource of the database.
+     *
+     * @return The report, with every resource counted as failed if the pack could not be written
+     */
+    PackReport build(ResourceDatabase& database, const std::filesystem::path& output_path, const PackParams& params = {});
+
+private:
+    struct Block
+    {
+        SourceMetadata meta;
+        Buffer data;
+        uint64_t raw_size = 0;
+        uint64_t stored_size = 0;
+        uint64_t offset = 0;
+        bool failed = false;
+    };
+
+    static Job<> read_job(ResourceDatabase& database, const PackParams& params, Block& block);
+
+private:
+    jobs::Scheduler& scheduler;
+};
+} // portal
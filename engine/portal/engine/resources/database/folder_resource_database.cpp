@@ -5,11 +5,20 @@
 
 #include "folder_resource_database.h"
 
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/debug/profile.h"
 #include "portal/core/files/file_system.h"
 #include "portal/engine/project/project.h"
+#include "portal/engine/resources/cook/cooked_resource.h"
+#include "portal/engine/resources/database/pack_resource_database.h"
 #include "portal/engine/resources/loader/loader_factory.h"
 #include "portal/engine/resources/source/file_source.h"
 #include "portal/serialization/archive/json_archive.h"
@@ -50,6 +59,75 @@ DatabaseMetadata DatabaseMetadata::dearchive(ArchiveObject& archive)
     return metadata;
 }
 
+/**
+ * Dumps the archive to `path`, unless the file already holds the same content, so untouched metadata keeps its write
+ * time and is not seen as modified by version control.
+ *
+ * @return true if the file was written
+ */
+static bool dump_if_changed(JsonArchive& archive, const std::filesystem::path& path, std::string existing)
+{
+    std::ostringstream output;
+    archive.dump(output);
+
+    // Archives are dumped in text mode, which adds carriage returns on some platforms
+    std::erase(existing, '\r');
+    if (existing == output.view())
+        return false;
+
+    archive.dump(path);
+    return true;
+}
+
+static bool dump_if_changed(JsonArchive& archive, const std::filesystem::path& path)
+{
+    return dump_if_changed(archive, path, FileSystem::exists(path) ? FileSystem::read_file_string(path) : std::string{});
+}
+
+struct ParsedMetadata
+{
+    SourceMetadata meta;
+    FileStat stat{};
+    // The file could not be read or parsed, `meta` is empty
+    bool corrupt = false;
+};
+
+/**
+ * Parses a single metadata file. Files are parsed on plain threads, so a file that fails to parse is reported as corrupt
+ * instead of throwing.
+ */
+static ParsedMetadata parse_metadata(const std::filesystem::path& path, const FileStat& stat)
+{
+    PORTAL_PROF_ZONE();
+
+    try
+    {
+        auto content = FileSystem::read_file_string(path);
+        std::istringstream input(content);
+
+        JsonArchive archiver;
+        archiver.read(input);
+
+        // TODO: Add serialization checks
+        ParsedMetadata parsed{SourceMetadata::dearchive(archiver), stat};
+
+        // TODO: update to new version if necessary
+        parsed.meta.archive(archiver);
+        if (dump_if_changed(archiver, path, std::move(content)))
+        {
+            LOGGER_DEBUG("Updated metadata: {}", path.generic_string());
+            parsed.stat = FileSystem::stat_file(path);
+        }
+
+        return parsed;
+    }
+    catch (const std::exception& e)
+    {
+        LOGGER_WARN("Corrupt metadata: {} ({})", path.generic_string(), e.what());
+        return ParsedMetadata{.stat = stat, .corrupt = true};
+    }
+}
+
 std::filesystem::path validate_and_create_path(const Project& project, const std::filesystem::path& database_path)
 {
     std::filesystem::path output;
@@ -108,26 +186,48 @@ std::filesystem::path validate_and_create_meta_path(const std::filesystem::path&
 std::unique_ptr<FolderResourceDatabase> FolderResourceDatabase::create(const Project& project, const std::filesystem::path& database_path)
 {
     const auto root_path = validate_and_create_path(project, database_path);
+    // Watching is meant for editing resources while the project runs, runtime projects opt in
+    const auto watch = project.get_settings().get_setting<bool>("resources.hot_reload", project.get_type() == ProjectType::Editor);
+    return open(root_path, watch);
+}
+
+std::unique_ptr<FolderResourceDatabase> FolderResourceDatabase::open(const std::filesystem::path& root_path, const bool watch)
+{
     const auto meta_path = validate_and_create_meta_path(root_path);
     const auto metadata = load_meta(meta_path);
-    return std::unique_ptr<FolderResourceDatabase>(new FolderResourceDatabase(root_path, meta_path, metadata));
+    return std::unique_ptr<FolderResourceDatabase>(new FolderResourceDatabase(root_path, meta_path, metadata, watch));
 }
 
 FolderResourceDatabase::FolderResourceDatabase(
     std::filesystem::path root_path,
     std::filesystem::path meta_path,
-    DatabaseMetadata metadata
+    DatabaseMetadata metadata,
+    const bool watch
 )
     : root_path(std::move(root_path)),
       meta_path(std::move(meta_path)),
+      index_path(std::filesystem::path(this->meta_path).replace_extension(DATABASE_INDEX_EXTENSION)),
       metadata(metadata),
+      index(MetadataIndex::load(index_path)),
       structure(metadata.name)
 {
     LOGGER_INFO("Loaded folder database {}, version: {}", metadata.name, metadata.version);
 
-    populate();
-    const auto validate_result = validate();
-    mend(validate_result);
+    const auto scan_result = scan();
+    populate(scan_result);
+    const auto validate_result = validate(scan_result);
+    mend(validate_result, scan_result);
+    index.save(index_path);
+
+    if (watch)
+    {
+        watcher = std::make_unique<FileWatcher>(this->root_path);
+        if (!watcher->start())
+        {
+            LOGGER_WARN("Changes to {} will not be picked up until it is opened again", metadata.name);
+            watcher.reset();
+        }
+    }
 }
 
 FolderResourceDatabase::~FolderResourceDatabase()
@@ -136,12 +236,15 @@ FolderResourceDatabase::~FolderResourceDatabase()
 
     if (validate() != DatabaseErrorBit::Success)
         LOGGER_ERROR("Folder database destructed in invalid state");
+
+    index.save(index_path);
 }
 
 std::expected<SourceMetadata, DatabaseError> FolderResourceDatabase::find(const StringId resource_id)
 {
-    if (resources.contains(resource_id))
-        return resources.at(resource_id);
+    std::shared_lock guard(resources_lock);
+    if (const auto it = resources.find(resource_id); it != resources.end())
+        return it->second;
 
     return std::unexpected{DatabaseErrorBit::MissingResource};
 }
@@ -170,10 +273,17 @@ DatabaseError FolderResourceDatabase::add(StringId resource_id, SourceMetadata m
 
     JsonArchive archiver;
     meta.archive(archiver);
-    archiver.dump(metadata_path);
+    dump_if_changed(archiver, metadata_path);
+    index.update(
+        STRING_ID(fmt::format("{}{}", source_path.generic_string(), RESOURCE_METADATA_EXTENSION)),
+        FileSystem::stat_file(metadata_path),
+        meta
+    );
 
-    // TODO(#45): thread safety?
-    resources[resource_id] = meta;
+    {
+        std::unique_lock guard(resources_lock);
+        resources[resource_id] = meta;
+    }
     add_to_structure(resource_id);
 
     return DatabaseErrorBit::Success;
@@ -189,10 +299,16 @@ DatabaseError FolderResourceDatabase::remove(const StringId resource_id)
 
     auto meta = resources.at(resource_id);
 
-    FileSystem::remove(root_path / fmt::format("{}{}", meta.source.string, RESOURCE_METADATA_EXTENSION));
+    const auto metadata_path = fmt::format("{}{}", meta.source.string, RESOURCE_METADATA_EXTENSION);
+    FileSystem::remove(root_path / metadata_path);
+    index.erase(STRING_ID(metadata_path));
     // TODO: remove resource file as well?
 
-    resources.erase(resource_id);
+    {
+        std::unique_lock guard(resources_lock);
+        resources.erase(resource_id);
+    }
+    remove_from_structure(resource_id);
 
     LOGGER_DEBUG("Removed resource with handle: {}", resource_id);
     return DatabaseErrorBit::Success;
@@ -213,7 +329,25 @@ Reference<resources::ResourceSource> FolderResourceDatabase::create_source(Strin
     // }
 
     // TODO: if source starts with 'http://' use network source
-    return make_reference<resources::FileSource>(root_path / meta.source.string);
+    const auto source_path = root_path / meta.source.string;
+
+    // Prefer the cooked resource, as long as the source was not modified since it was cooked
+    const auto cooked_path = get_cooked_path(source_path);
+    if (FileSystem::exists(cooked_path))
+    {
+        const auto header = resources::read_cooked_header(cooked_path);
+        if (header && header->type == meta.type && header->matches(FileSystem::stat_file(source_path)))
+            return make_reference<resources::FileSource>(cooked_path);
+
+        LOGGER_DEBUG("Ignoring stale cooked resource: {}", cooked_path.generic_string());
+    }
+
+    return make_reference<resources::FileSource>(source_path);
+}
+
+std::filesystem::path FolderResourceDatabase::get_cooked_path(const std::filesystem::path& source_path)
+{
+    return std::filesystem::path(source_path).concat(COOKED_RESOURCE_EXTENSION);
 }
 
 resources::DatabaseEntry& FolderResourceDatabase::get_structure() const
@@ -221,33 +355,112 @@ resources::DatabaseEntry& FolderResourceDatabase::get_structure() const
     return const_cast<resources::FolderDatabaseEntry&>(structure);
 }
 
-void FolderResourceDatabase::populate()
+FolderResourceDatabase::DirectoryScan FolderResourceDatabase::scan() const
 {
+    PORTAL_PROF_ZONE();
+
+    DirectoryScan result;
     for (auto& entry : std::filesystem::recursive_directory_iterator(root_path))
     {
         // TODO: support links?
-        if (entry.is_regular_file())
+        if (!entry.is_regular_file())
+            continue;
+
+        // TODO: handle nested databases
+        const auto& path = entry.path();
+        if (path.extension() == RESOURCE_METADATA_EXTENSION)
         {
-            // TODO: handle nested databases
-            if (entry.path().extension() == RESOURCE_METADATA_EXTENSION)
-            {
-                JsonArchive archiver;
-                archiver.read(entry.path());
+            const auto relative_path = path.lexically_relative(root_path).generic_string();
+            result.metadata_files.emplace_back(STRING_ID(relative_path), FileSystem::stat_file(path));
+        }
+        else if (!is_database_file(path) && !is_ignored(path))
+        {
+            const auto relative_path = path.lexically_relative(root_path).generic_string();
+            result.resource_files.insert(STRING_ID(relative_path));
+        }
+    }
 
-                // TODO: Add serialization checks
-                auto resource_metadata = SourceMetadata::dearchive(archiver);
-                resource_metadata.full_source_path = STRING_ID((root_path / entry.path()).replace_extension("").generic_string());
-                resources[resource_metadata.resource_id] = resource_metadata;
-                add_to_structure(resource_metadata.resource_id);
+    return result;
+}
 
-                if (resource_metadata.type == ResourceType::Composite)
-                    populate_from_composite(resource_metadata);
+bool FolderResourceDatabase::is_ignored(const std::filesystem::path& path) const
+{
+    return std::ranges::any_of(metadata.ignored_extensions, [&path](const auto& ext) { return path.extension() == ext; }) ||
+        std::ranges::any_of(metadata.ignored_files, [&path](const auto& file) { return path.filename() == file; });
+}
 
-                // TODO: update to new version if necessary
-                resource_metadata.archive(archiver);
-                archiver.dump(entry.path());
-            }
+void FolderResourceDatabase::refresh_index(const DirectoryScan& scan)
+{
+    PORTAL_PROF_ZONE();
+
+    std::unordered_set<StringId> scanned;
+    scanned.reserve(scan.metadata_files.size());
+
+    std::vector<std::pair<StringId, FileStat>> modified;
+    for (const auto& [path, stat] : scan.metadata_files)
+    {
+        scanned.insert(path);
+        if (!index.find(path, stat))
+            modified.emplace_back(path, stat);
+    }
+    index.retain([&scanned](const StringId& path) { return scanned.contains(path); });
+
+    if (modified.empty())
+        return;
+
+    std::vector<ParsedMetadata> parsed(modified.size());
+    if (modified.size() < PARALLEL_PARSE_THRESHOLD)
+    {
+        for (size_t i = 0; i < modified.size(); ++i)
+            parsed[i] = parse_metadata(root_path / modified[i].first.string, modified[i].second);
+    }
+    else
+    {
+        // The database is created with the project, before the engine scheduler exists. Plain threads are used since a
+        // second scheduler would share the worker id of the thread local scheduler context with the engine one.
+        const size_t thread_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, modified.size() / PARALLEL_PARSE_THRESHOLD + 1);
+        const size_t chunk_size = (modified.size() + thread_count - 1) / thread_count;
+
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count);
+        for (size_t begin = 0; begin < modified.size(); begin += chunk_size)
+        {
+            const size_t end = std::min(begin + chunk_size, modified.size());
+            threads.emplace_back(
+                [this, &modified, &parsed, begin, end]
+                {
+                    for (size_t i = begin; i < end; ++i)
+                        parsed[i] = parse_metadata(root_path / modified[i].first.string, modified[i].second);
+                }
+            );
         }
+        // Joined on destruction
+        threads.clear();
+    }
+
+    for (size_t i = 0; i < modified.size(); ++i)
+    {
+        // Corrupt files are left out of the index, so they are parsed again once they are fixed
+        if (parsed[i].corrupt)
+            index.erase(modified[i].first);
+        else
+            index.update(modified[i].first, parsed[i].stat, std::move(parsed[i].meta));
+    }
+
+    LOGGER_DEBUG("Parsed {} of {} metadata files in {}", modified.size(), scan.metadata_files.size(), metadata.name);
+}
+
+void FolderResourceDatabase::populate(const DirectoryScan& scan)
+{
+    PORTAL_PROF_ZONE();
+
+    refresh_index(scan);
+
+    std::vector<StringId> inserted;
+    for (const auto& path : scan.metadata_files | std::views::keys)
+    {
+        if (const auto* entry = index.find(path))
+            insert_resources(path, entry->meta, inserted);
     }
 }
 
@@ -257,11 +470,184 @@ void FolderResourceDatabase::populate_from_composite(const SourceMetadata& meta)
     for (auto& [name, source_meta] : children)
     {
         source_meta.full_source_path = meta.resource_id;
-        resources[STRING_ID(name)] = source_meta;
+        {
+            std::unique_lock guard(resources_lock);
+            resources[STRING_ID(name)] = source_meta;
+        }
         add_to_structure(STRING_ID(name));
     }
 }
 
+void FolderResourceDatabase::insert_resources(const StringId& metadata_path, SourceMetadata meta, std::vector<StringId>& inserted)
+{
+    meta.full_source_path = STRING_ID((root_path / metadata_path.string).replace_extension("").generic_string());
+    {
+        std::unique_lock guard(resources_lock);
+        resources[meta.resource_id] = meta;
+    }
+    add_to_structure(meta.resource_id);
+    inserted.push_back(meta.resource_id);
+
+    if (meta.type == ResourceType::Composite)
+    {
+        populate_from_composite(meta);
+        for (const auto& name : std::get<CompositeMetadata>(meta.meta).children | std::views::keys)
+            inserted.push_back(STRING_ID(name));
+    }
+}
+
+void FolderResourceDatabase::erase_resources(const SourceMetadata& meta, std::vector<StringId>& erased)
+{
+    llvm::SmallVector<StringId> resource_ids{meta.resource_id};
+    if (meta.type == ResourceType::Composite)
+    {
+        for (const auto& name : std::get<CompositeMetadata>(meta.meta).children | std::views::keys)
+            resource_ids.push_back(STRING_ID(name));
+    }
+
+    {
+        std::unique_lock guard(resources_lock);
+        for (const auto& resource_id : resource_ids)
+            resources.erase(resource_id);
+    }
+
+    for (const auto& resource_id : resource_ids)
+    {
+        remove_from_structure(resource_id);
+        erased.push_back(resource_id);
+    }
+}
+
+StringId FolderResourceDatabase::create_metadata(const StringId& resource_file)
+{
+    LOGGER_DEBUG("Creating metadata for resource: {}", resource_file);
+    auto relative_path = std::filesystem::path(resource_file.string);
+    auto extension = relative_path.extension();
+    auto value = utils::find_extension_type(extension.generic_string());
+    if (!value.has_value())
+        return INVALID_STRING_ID;
+    auto [resource_type, source_format] = value.value();
+
+    // TODO: calculate dependencies?
+    auto resource_id = STRING_ID(
+        fmt::format("{}/{}", get_name().string, relative_path.replace_extension("").generic_string())
+    );
+    SourceMetadata meta{
+        .resource_id = resource_id,
+        .type = resource_type,
+        .source = resource_file,
+        .format = source_format,
+    };
+
+    if (add(meta.resource_id, meta) != DatabaseErrorBit::Success)
+        return INVALID_STRING_ID;
+    return resource_id;
+}
+
+std::vector<StringId> FolderResourceDatabase::poll_changes()
+{
+    if (!watcher)
+        return {};
+
+    PORTAL_PROF_ZONE();
+
+    std::vector<StringId> changed;
+    if (watcher->consume_overflow())
+    {
+        // Events were lost, the metadata is brought up to date from a full scan, changes to resource files are lost
+        LOGGER_WARN("Missed file changes in {}, scanning it again", metadata.name);
+        const auto scan_result = scan();
+        std::unordered_set<StringId> scanned;
+        for (const auto& [path, stat] : scan_result.metadata_files)
+        {
+            scanned.insert(path);
+            if (!index.find(path, stat))
+                update_metadata_file(path, FileChangeType::Modified, changed);
+        }
+
+        for (const auto& path : index.get_paths())
+        {
+            if (!scanned.contains(path))
+                update_metadata_file(path, FileChangeType::Removed, changed);
+        }
+    }
+
+    for (const auto& [path, type] : watcher->poll())
+    {
+        const auto relative_path = STRING_ID(path.generic_string());
+        if (path.extension() == RESOURCE_METADATA_EXTENSION)
+            update_metadata_file(relative_path, type, changed);
+        else if (!is_database_file(path) && !is_ignored(path))
+            update_resource_file(relative_path, type, changed);
+    }
+
+    if (changed.empty())
+        return changed;
+
+    std::ranges::sort(changed, {}, [](const StringId& id) { return id.id; });
+    const auto [first, last] = std::ranges::unique(changed);
+    changed.erase(first, last);
+
+    metadata.resource_count = resources.size();
+    index.save(index_path);
+    LOGGER_DEBUG("{} resources changed in {}", changed.size(), metadata.name);
+    return changed;
+}
+
+void FolderResourceDatabase::update_metadata_file(const StringId& metadata_path, const FileChangeType type, std::vector<StringId>& changed)
+{
+    const auto full_path = root_path / metadata_path.string;
+    const auto stat = type == FileChangeType::Removed ? FileStat{} : FileSystem::stat_file(full_path);
+
+    // Metadata the database wrote itself is indexed as it is written
+    if (stat.is_file && index.find(metadata_path, stat))
+        return;
+
+    if (const auto* entry = index.find(metadata_path))
+    {
+        const auto previous = entry->meta;
+        erase_resources(previous, changed);
+    }
+
+    if (!stat.is_file)
+    {
+        LOGGER_DEBUG("Removed metadata: {}", metadata_path);
+        index.erase(metadata_path);
+        return;
+    }
+
+    LOGGER_DEBUG("Reading modified metadata: {}", metadata_path);
+    auto [meta, parsed_stat, corrupt] = parse_metadata(full_path, stat);
+    if (corrupt)
+    {
+        index.erase(metadata_path);
+        return;
+    }
+
+    if (validate_metadata(meta) != DatabaseErrorBit::Success)
+        LOGGER_WARN("Corrupt metadata: {}", metadata_path);
+
+    index.update(metadata_path, parsed_stat, meta);
+    insert_resources(metadata_path, std::move(meta), changed);
+}
+
+void FolderResourceDatabase::update_resource_file(const StringId& resource_file, const FileChangeType type, std::vector<StringId>& changed)
+{
+    const auto previous_size = changed.size();
+    for (const auto& [resource_id, meta] : resources)
+    {
+        if (meta.source == resource_file)
+            changed.push_back(resource_id);
+    }
+
+    // Resources that lost their source stay until their metadata is removed, they fail to load until then
+    if (changed.size() != previous_size || type == FileChangeType::Removed)
+        return;
+
+    if (const auto resource_id = create_metadata(resource_file); resource_id != INVALID_STRING_ID)
+        changed.push_back(resource_id);
+}
+
 std::filesystem::path resources::FolderDatabaseEntry::get_path() const
 {
     std::vector<std::string_view> segments;
@@ -303,7 +689,44 @@ void FolderResourceDatabase::add_to_structure(StringId resource_id)
     current_entry->children[part_string] = make_reference<resources::FolderDatabaseEntry>(resource_id, current_entry);
 }
 
+void FolderResourceDatabase::remove_from_structure(StringId resource_id)
+{
+    auto split_view = resource_id.string | std::views::split('/') | std::views::drop(1);
+    size_t part_number = std::ranges::distance(split_view);
+
+    StringId part_string;
+    resources::DatabaseEntry* current_entry = &structure;
+    for (auto part : split_view)
+    {
+        part_string = STRING_ID(std::string_view(part));
+
+        if (part_number-- == 1)
+            break;
+
+        const auto it = current_entry->children.find(part_string);
+        if (it == current_entry->children.end())
+            return;
+        current_entry = it->second.get();
+    }
+    current_entry->children.erase(part_string);
+
+    // Folders are only there for the resources in them
+    while (current_entry != &structure && current_entry->children.empty())
+    {
+        auto* parent = current_entry->parent;
+        parent->children.erase(current_entry->name);
+        current_entry = parent;
+    }
+}
+
 DatabaseError FolderResourceDatabase::validate()
+{
+    const auto scan_result = scan();
+    refresh_index(scan_result);
+    return validate(scan_result);
+}
+
+DatabaseError FolderResourceDatabase::validate(const DirectoryScan& scan)
 {
     DatabaseError error;
 
@@ -326,45 +749,34 @@ DatabaseError FolderResourceDatabase::validate()
     std::unordered_set<StringId> missing_metadata;
     std::unordered_set<StringId> corrupt_meta;
 
-    for (auto& entry : std::filesystem::recursive_directory_iterator(root_path))
+    for (const auto& file : scan.resource_files)
     {
-        // TODO: support links?
-        if (entry.is_regular_file())
-        {
-            if (entry.path().extension() != RESOURCE_METADATA_EXTENSION && entry.path().extension() != DATABASE_METADATA_EXTENSION &&
-                std::ranges::none_of(metadata.ignored_extensions, [&entry](const auto& ext) { return entry.path().extension() == ext; }) &&
-                std::ranges::none_of(metadata.ignored_files, [&entry](const auto& file) { return entry.path().filename() == file; })
-            )
-            {
-                auto relative_path = std::filesystem::relative(entry.path(), root_path);
-                auto file_as_string_id = STRING_ID(relative_path.generic_string());
-                if (corresponding_meta.contains(file_as_string_id))
-                    corresponding_meta[file_as_string_id] = true;
-                else
-                    missing_metadata.insert(file_as_string_id);
-            }
-            else if (entry.path().extension() == RESOURCE_METADATA_EXTENSION)
-            {
-                auto relative_path = std::filesystem::relative(entry.path(), root_path);
-                auto file_as_string_id = STRING_ID(relative_path.generic_string());
+        if (corresponding_meta.contains(file))
+            corresponding_meta[file] = true;
+        else
+            missing_metadata.insert(file);
+    }
 
-                JsonArchive archiver;
-                archiver.read(entry.path());
-                SourceMetadata meta = SourceMetadata::dearchive(archiver);
-                if (validate_metadata(meta) != DatabaseErrorBit::Success)
-                {
-                    LOGGER_WARN("Corrupt metadata: {}", relative_path.generic_string());
-                    corrupt_meta.insert(file_as_string_id);
-                }
+    // The metadata is validated from the index, without parsing it again
+    for (const auto& path : scan.metadata_files | std::views::keys)
+    {
+        const auto* entry = index.find(path);
+        if (!entry)
+            continue;
 
-                if (meta.type == ResourceType::Composite)
-                {
-                    auto [children, _] = std::get<CompositeMetadata>(meta.meta);
-                    for (auto& source_meta : children | std::views::values)
-                    {
-                        corresponding_meta[source_meta.source] = true;
-                    }
-                }
+        const auto& meta = entry->meta;
+        if (validate_metadata(meta) != DatabaseErrorBit::Success)
+        {
+            LOGGER_WARN("Corrupt metadata: {}", path);
+            corrupt_meta.insert(path);
+        }
+
+        if (meta.type == ResourceType::Composite)
+        {
+            const auto& children = std::get<CompositeMetadata>(meta.meta).children;
+            for (auto& source_meta : children | std::views::values)
+            {
+                corresponding_meta[source_meta.source] = true;
             }
         }
     }
@@ -393,6 +805,13 @@ DatabaseError FolderResourceDatabase::validate()
     return error;
 }
 
+bool FolderResourceDatabase::is_database_file(const std::filesystem::path& path)
+{
+    const auto extension = path.extension();
+    return extension == RESOURCE_METADATA_EXTENSION || extension == DATABASE_METADATA_EXTENSION || extension == COOKED_RESOURCE_EXTENSION ||
+        extension == DATABASE_INDEX_EXTENSION || extension == PackResourceDatabase::PACK_EXTENSION;
+}
+
 DatabaseError FolderResourceDatabase::validate_metadata(const SourceMetadata& meta) const
 {
     const auto resource_path = root_path / std::filesystem::path(meta.source.string);
@@ -413,7 +832,7 @@ DatabaseError FolderResourceDatabase::validate_metadata(const SourceMetadata& me
     return DatabaseErrorBit::Success;
 }
 
-void FolderResourceDatabase::mend(const DatabaseError error)
+void FolderResourceDatabase::mend(const DatabaseError error, const DirectoryScan& scan)
 {
     if (error & DatabaseErrorBit::MissingResource)
     {
@@ -428,42 +847,10 @@ void FolderResourceDatabase::mend(const DatabaseError error)
         for (auto& [_, meta] : resources)
             corresponding_meta[meta.source] = false;
 
-        for (auto& entry : std::filesystem::recursive_directory_iterator(root_path))
+        for (const auto& file : scan.resource_files)
         {
-            // TODO: support links?
-            if (entry.is_regular_file())
-            {
-                if (entry.path().extension() != RESOURCE_METADATA_EXTENSION && entry.path().extension() != DATABASE_METADATA_EXTENSION &&
-                    std::ranges::none_of(metadata.ignored_extensions, [&entry](const auto& ext) { return entry.path().extension() == ext; }) &&
-                    std::ranges::none_of(metadata.ignored_files, [&entry](const auto& file) { return entry.path().filename() == file; })
-                )
-                {
-                    auto relative_path = std::filesystem::relative(entry.path(), root_path);
-                    auto file_as_string_id = STRING_ID(relative_path.generic_string());
-                    if (corresponding_meta.contains(file_as_string_id))
-                        continue;
-
-                    LOGGER_DEBUG("Creating metadata for resource: {}", file_as_string_id);
-                    auto extension = relative_path.extension();
-                    auto value = utils::find_extension_type(extension.generic_string());
-                    if (!value.has_value())
-                        continue;
-                    auto [resource_type, source_format] = value.value();
-
-                    // TODO: calculate dependencies?
-                    auto resource_id = STRING_ID(
-                        fmt::format("{}/{}", get_name().string, relative_path.replace_extension("").generic_string())
-                    );
-                    SourceMetadata meta{
-                        .resource_id = resource_id,
-                        .type = resource_type,
-                        .source = file_as_string_id,
-                        .format = source_format,
-                    };
-
-                    add(meta.resource_id, meta);
-                }
-            }
+            if (!corresponding_meta.contains(file))
+                create_metadata(file);
         }
 
         metadata.dirty |= ResourceDirtyBits::DataChange;
@@ -471,41 +858,35 @@ void FolderResourceDatabase::mend(const DatabaseError error)
 
     if (error & DatabaseErrorBit::CorruptMetadata || error & DatabaseErrorBit::MissingName)
     {
-        for (auto& entry : std::filesystem::recursive_directory_iterator(root_path))
+        for (const auto& path : scan.metadata_files | std::views::keys)
         {
-            // TODO: support links?
-            if (entry.is_regular_file())
+            const auto* entry = index.find(path);
+            if (!entry)
+                continue;
+
+            auto relative_path = std::filesystem::path(path.string);
+            SourceMetadata meta = entry->meta;
+
+            auto meta_errors = validate_metadata(meta);
+            if (meta_errors != DatabaseErrorBit::Success)
             {
-                if (entry.path().extension() == RESOURCE_METADATA_EXTENSION)
+                remove(meta.resource_id);
+
+                if (meta_errors & DatabaseErrorBit::CorruptMetadata)
                 {
-                    auto relative_path = std::filesystem::relative(entry.path(), root_path);
-
-                    JsonArchive archiver;
-                    archiver.read(entry.path());
-                    SourceMetadata meta = SourceMetadata::dearchive(archiver);
-
-                    auto meta_errors = validate_metadata(meta);
-                    if (meta_errors != DatabaseErrorBit::Success)
-                    {
-                        remove(meta.resource_id);
-
-                        if (meta_errors & DatabaseErrorBit::CorruptMetadata)
-                        {
-                            LOGGER_DEBUG("Mending corrupt metadata: {}", relative_path.generic_string());
-                            meta.resource_id = STRING_ID(
-                                fmt::format("{}/{}", get_name().string, relative_path.replace_extension("").generic_string())
-                            );
-                        }
-                        if (meta_errors & DatabaseErrorBit::MissingName)
-                        {
-
-                            LOGGER_DEBUG("Mending missing name: {}", relative_path.generic_string());
-                            meta.name = STRING_ID(get_last_part(meta.resource_id.string));
-                        }
-
-                        add(meta.resource_id, meta);
-                    }
+                    LOGGER_DEBUG("Mending corrupt metadata: {}", relative_path.generic_string());
+                    meta.resource_id = STRING_ID(
+                        fmt::format("{}/{}", get_name().string, relative_path.replace_extension("").generic_string())
+                    );
+                }
+                if (meta_errors & DatabaseErrorBit::MissingName)
+                {
+
+                    LOGGER_DEBUG("Mending missing name: {}", relative_path.generic_string());
+                    meta.name = STRING_ID(get_last_part(meta.resource_id.string));
                 }
+
+                add(meta.resource_id, meta);
             }
         }
 
@@ -528,7 +909,7 @@ void FolderResourceDatabase::save_meta(const std::filesystem::path& meta_path, D
 {
     JsonArchive archiver;
     metadata.archive(archiver);
-    archiver.dump(meta_path);
+    dump_if_changed(archiver, meta_path);
 }
 
 DatabaseMetadata FolderResourceDatabase::load_meta(const std::filesystem::path& meta_path)
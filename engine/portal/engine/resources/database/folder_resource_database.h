@@ -5,10 +5,14 @@
 
 #pragma once
 #include <filesystem>
+#include <shared_mutex>
+#include <unordered_set>
 #include <llvm/ADT/DenseMap.h>
 
+#include "metadata_index.h"
 #include "resource_database.h"
 #include "portal/core/files/file_system.h"
+#include "portal/core/files/file_watcher.h"
 
 namespace portal
 {
@@ -43,10 +47,23 @@ class FolderResourceDatabase final : public ResourceDatabase
 public:
     constexpr static auto RESOURCE_METADATA_EXTENSION = ".pmeta";
     constexpr static auto DATABASE_METADATA_EXTENSION = ".podb";
+    constexpr static auto COOKED_RESOURCE_EXTENSION = ".pcooked";
+    constexpr static auto DATABASE_INDEX_EXTENSION = ".pindex";
+
+    // Below this amount of modified metadata files, parsing them is cheaper than starting worker threads
+    constexpr static size_t PARALLEL_PARSE_THRESHOLD = 64;
 
 public:
     static std::unique_ptr<FolderResourceDatabase> create(const Project& project, const std::filesystem::path& database_path);
 
+    /**
+     * @brief Opens the database in an existing folder, without a project.
+     *
+     * @param root_path The folder of the database, holding its metadata file
+     * @param watch Watch the folder for changes, see `poll_changes`
+     */
+    static std::unique_ptr<FolderResourceDatabase> open(const std::filesystem::path& root_path, bool watch = false);
+
     ~FolderResourceDatabase() override;
 
     std::expected<SourceMetadata, DatabaseError> find(StringId resource_id) override;
@@ -55,25 +72,89 @@ public:
 
     Reference<resources::ResourceSource> create_source(StringId resource_id, SourceMetadata meta) override;
 
+    /**
+     * @brief Applies the file changes reported by the watcher, when the database is watched.
+     *
+     * Modified metadata files are parsed again and replace the resources they described, the index is updated with
+     * them. Resource files report the resources they are the source of, new resource files get metadata, the same as
+     * they would when the database is opened.
+     */
+    std::vector<StringId> poll_changes() override;
+
     [[nodiscard]] resources::DatabaseEntry& get_structure() const override;
 
+    /**
+     * @brief Returns the path of the cooked resource of a source file, next to the source.
+     */
+    [[nodiscard]] static std::filesystem::path get_cooked_path(const std::filesystem::path& source_path);
+
 protected:
+    /**
+     * @brief The files of the database folder, collected in a single walk and shared by populating, validating and
+     * mending the database.
+     */
+    struct DirectoryScan
+    {
+        // Metadata files, relative to the root, with their stat
+        std::vector<std::pair<StringId, FileStat>> metadata_files;
+        // Resource files that are not ignored, relative to the root
+        std::unordered_set<StringId> resource_files;
+    };
+
     FolderResourceDatabase(
         std::filesystem::path root_path,
         std::filesystem::path meta_path,
-        DatabaseMetadata metadata
+        DatabaseMetadata metadata,
+        bool watch
     );
 
-    void populate();
+    [[nodiscard]] DirectoryScan scan() const;
+    [[nodiscard]] bool is_ignored(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Brings the metadata index up to date with the scanned metadata files.
+     *
+     * Only metadata files that were modified since they were indexed are parsed, in parallel when there are many of
+     * them. Parsed files are rewritten in the current metadata format, but only if that changes their content.
+     */
+    void refresh_index(const DirectoryScan& scan);
+
+    void populate(const DirectoryScan& scan);
     void populate_from_composite(const SourceMetadata& meta);
 
+    /**
+     * @brief Adds the resources described by a metadata file, with the children of composites.
+     */
+    void insert_resources(const StringId& metadata_path, SourceMetadata meta, std::vector<StringId>& inserted);
+
+    /**
+     * @brief Removes the resources described by a metadata file, with the children of composites.
+     */
+    void erase_resources(const SourceMetadata& meta, std::vector<StringId>& erased);
+
+    /**
+     * @brief Creates the metadata of a resource file that has none.
+     *
+     * @return The id of the new resource, or an invalid id if the file is not a known resource type
+     */
+    StringId create_metadata(const StringId& resource_file);
+
+    void update_metadata_file(const StringId& metadata_path, FileChangeType type, std::vector<StringId>& changed);
+    void update_resource_file(const StringId& resource_file, FileChangeType type, std::vector<StringId>& changed);
+
     void add_to_structure(StringId resource_id);
     void remove_from_structure(StringId resource_id);
 
     DatabaseError validate();
+
+    /**
+     * @brief Validates the database against a scan of its folder, the index must be up to date with the scan.
+     */
+    DatabaseError validate(const DirectoryScan& scan);
+    [[nodiscard]] static bool is_database_file(const std::filesystem::path& path);
     [[nodiscard]] DatabaseError validate_metadata(const SourceMetadata& meta) const;
 
-    void mend(DatabaseError error);
+    void mend(DatabaseError error, const DirectoryScan& scan);
     void clean_metadata();
 
     static void save_meta(const std::filesystem::path& meta_path, DatabaseMetadata& metadata);
@@ -85,10 +166,15 @@ protected:
 private:
     std::filesystem::path root_path;
     std::filesystem::path meta_path;
+    std::filesystem::path index_path;
     DatabaseMetadata metadata;
+    MetadataIndex index;
 
     resources::FolderDatabaseEntry structure;
+    std::unique_ptr<FileWatcher> watcher;
 
+    // Only written from the thread that polls changes, `find` is called from load jobs
+    std::shared_mutex resources_lock;
 #ifdef PORTAL_DEBUG
     std::unordered_map<StringId, SourceMetadata> resources;
 #else
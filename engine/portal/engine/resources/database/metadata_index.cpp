@@ -0,0 +1,196 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "metadata_index.h"
+
+#include <cstring>
+#include <fstream>
+#include <ranges>
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/strings/hash.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+namespace portal
+{
+static auto logger = Log::get_logger("Resources");
+
+bool MetadataIndexHeader::is_valid() const
+{
+    return magic == MAGIC && version == VERSION;
+}
+
+bool MetadataIndexEntry::matches(const FileStat& stat) const
+{
+    return stat.is_file && size == stat.size && last_write_time == stat.last_write_time;
+}
+
+MetadataIndex MetadataIndex::load(const std::filesystem::path& path)
+{
+    PORTAL_PROF_ZONE();
+
+    MetadataIndex index;
+    if (!FileSystem::exists(path))
+        return index;
+
+    auto entries = read(FileSystem::read_file_binary(path));
+    if (!entries)
+    {
+        LOGGER_WARN("Ignoring invalid metadata index: {}", path.generic_string());
+        return index;
+    }
+
+    index.entries = std::move(entries.value());
+    return index;
+}
+
+bool MetadataIndex::save(const std::filesystem::path& path)
+{
+    PORTAL_PROF_ZONE();
+
+    if (!dirty)
+        return true;
+
+    // Written next to the index and renamed over it, a crash mid write never leaves a partial index behind
+    const auto temporary_path = std::filesystem::path(path).concat(".tmp");
+    {
+        std::ofstream output(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            LOGGER_ERROR("Failed to open {} for writing", temporary_path.generic_string());
+            return false;
+        }
+
+        write(output, entries);
+        if (!output.good())
+        {
+            LOGGER_ERROR("Failed to write {}", temporary_path.generic_string());
+            output.close();
+            FileSystem::remove(temporary_path);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        LOGGER_ERROR("Failed to move metadata index to {}: {}", path.generic_string(), error.message());
+        FileSystem::remove(temporary_path);
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+const MetadataIndexEntry* MetadataIndex::find(const StringId& metadata_path, const FileStat& stat) const
+{
+    const auto it = entries.find(metadata_path);
+    if (it == entries.end() || !it->second.matches(stat))
+        return nullptr;
+    return &it->second;
+}
+
+const MetadataIndexEntry* MetadataIndex::find(const StringId& metadata_path) const
+{
+    const auto it = entries.find(metadata_path);
+    return it == entries.end() ? nullptr : &it->second;
+}
+
+void MetadataIndex::update(const StringId& metadata_path, const FileStat& stat, SourceMetadata meta)
+{
+    entries.insert_or_assign(
+        metadata_path,
+        MetadataIndexEntry{
+            .last_write_time = stat.last_write_time,
+            .size = stat.size,
+            .meta = std::move(meta)
+        }
+    );
+    dirty = true;
+}
+
+void MetadataIndex::erase(const StringId& metadata_path)
+{
+    dirty |= entries.erase(metadata_path) > 0;
+}
+
+std::vector<StringId> MetadataIndex::get_paths() const
+{
+    std::vector<StringId> paths;
+    paths.reserve(entries.size());
+    for (const auto& path : entries | std::views::keys)
+        paths.push_back(path);
+    return paths;
+}
+
+void MetadataIndex::write(std::ostream& output, const std::unordered_map<StringId, MetadataIndexEntry>& entries)
+{
+    Buffer buffer;
+    BufferStreamWriter stream(buffer);
+    {
+        // Long paths and composites with many children do not fit in the default 16 bit element count
+        BinarySerializer serializer(stream, BinarySerializationParams{.large_element_size = true});
+        for (const auto& [path, entry] : entries)
+        {
+            serializer.add_value(path.string);
+            serializer.add_value(entry.last_write_time);
+            serializer.add_value(entry.size);
+            entry.meta.serialize(serializer);
+        }
+    }
+    stream.flush();
+    const auto payload = stream.get_buffer();
+
+    const MetadataIndexHeader header{
+        .entry_count = entries.size(),
+        .payload_hash = payload ? hash::rapidhash(payload.as<const char*>(), payload.size) : 0,
+    };
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(payload.as<const char*>(), static_cast<std::streamsize>(payload.size));
+}
+
+std::optional<std::unordered_map<StringId, MetadataIndexEntry>> MetadataIndex::read(const Buffer& data)
+{
+    if (!data || data.size < sizeof(MetadataIndexHeader))
+        return std::nullopt;
+
+    MetadataIndexHeader header;
+    std::memcpy(&header, data.data, sizeof(header));
+    if (!header.is_valid())
+        return std::nullopt;
+
+    // An index without entries might have no payload at all
+    if (header.entry_count == 0 && data.size == sizeof(header))
+        return std::unordered_map<StringId, MetadataIndexEntry>{};
+
+    // The binary deserializer trusts its input, the hash makes sure a truncated or corrupt index is never read
+    const Buffer payload{data, sizeof(header), data.size - sizeof(header)};
+    if (!payload || hash::rapidhash(payload.as<const char*>(), payload.size) != header.payload_hash)
+        return std::nullopt;
+
+    std::unordered_map<StringId, MetadataIndexEntry> entries;
+    entries.reserve(header.entry_count);
+
+    BufferStreamReader stream(payload);
+    BinaryDeserializer deserializer(stream);
+    for (uint64_t i = 0; i < header.entry_count; ++i)
+    {
+        std::string path;
+        MetadataIndexEntry entry;
+        deserializer.get_value(path);
+        deserializer.get_value(entry.last_write_time);
+        deserializer.get_value(entry.size);
+        entry.meta = SourceMetadata::deserialize(deserializer);
+        entries.insert_or_assign(STRING_ID(path), std::move(entry));
+    }
+
+    return entries;
+}
+} // portal
@@ -0,0 +1,118 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "portal/core/buffer.h"
+#include "portal/core/files/file_system.h"
+#include "portal/engine/resources/database/resource_database.h"
+
+namespace portal
+{
+/**
+ * @brief Header at the start of the metadata index file.
+ */
+struct MetadataIndexHeader
+{
+    constexpr static std::array MAGIC = {'P', 'M', 'I', 'X'};
+    // Bump whenever the binary layout of `SourceMetadata` changes
+    constexpr static uint32_t VERSION = 1;
+
+    std::array<char, 4> magic = MAGIC;
+    uint32_t version = VERSION;
+    uint64_t entry_count = 0;
+    uint64_t payload_hash = 0;
+
+    [[nodiscard]] bool is_valid() const;
+};
+
+static_assert(std::is_trivially_copyable_v<MetadataIndexHeader>);
+static_assert(sizeof(MetadataIndexHeader) == 24, "The metadata index header is written as is, it must not have padding");
+
+/**
+ * @brief Parsed metadata of a single metadata file, with the stat of the file it was parsed from.
+ */
+struct MetadataIndexEntry
+{
+    uint64_t last_write_time = 0;
+    uint64_t size = 0;
+    SourceMetadata meta;
+
+    /**
+     * @brief Checks if the entry was parsed from a file with the given stat.
+     */
+    [[nodiscard]] bool matches(const FileStat& stat) const;
+};
+
+/**
+ * @brief Binary cache of every metadata file of a folder database, keyed by the metadata file path.
+ *
+ * Parsing the json metadata of every resource dominates the startup of large databases, the index lets the database
+ * parse only the metadata files that were modified since the index was written, which are detected by their size and
+ * write time. The index is a local cache, it is rebuilt from the metadata files when it is missing, corrupt or of another
+ * version, and should not be committed.
+ */
+class MetadataIndex
+{
+public:
+    /**
+     * @brief Reads an index file.
+     *
+     * @return The index, or an empty index if the file is missing or invalid
+     */
+    static MetadataIndex load(const std::filesystem::path& path);
+
+    /**
+     * @brief Writes the index to a file, if it was modified since it was loaded or saved.
+     *
+     * @return false if the index failed to write
+     */
+    bool save(const std::filesystem::path& path);
+
+    /**
+     * @brief Finds the entry of a metadata file, as long as it was not modified since it was indexed.
+     *
+     * @param metadata_path The path of the metadata file, relative to the database root
+     * @param stat The current stat of the metadata file
+     * @return The up to date entry, or nullptr
+     */
+    [[nodiscard]] const MetadataIndexEntry* find(const StringId& metadata_path, const FileStat& stat) const;
+
+    /**
+     * @brief Finds the entry of a metadata file, regardless of the stat it was indexed with.
+     */
+    [[nodiscard]] const MetadataIndexEntry* find(const StringId& metadata_path) const;
+
+    void update(const StringId& metadata_path, const FileStat& stat, SourceMetadata meta);
+    void erase(const StringId& metadata_path);
+
+    /**
+     * @brief Removes every entry that does not match the predicate.
+     */
+    template <typename Predicate>
+    void retain(Predicate&& predicate)
+    {
+        dirty |= std::erase_if(entries, [&predicate](const auto& entry) { return !predicate(entry.first); }) > 0;
+    }
+
+    [[nodiscard]] std::vector<StringId> get_paths() const;
+    [[nodiscard]] size_t size() const { return entries.size(); }
+    [[nodiscard]] bool is_dirty() const { return dirty; }
+
+    static void write(std::ostream& output, const std::unordered_map<StringId, MetadataIndexEntry>& entries);
+    static std::optional<std::unordered_map<StringId, MetadataIndexEntry>> read(const Buffer& data);
+
+private:
+    std::unordered_map<StringId, MetadataIndexEntry> entries;
+    bool dirty = false;
+};
+} // portal
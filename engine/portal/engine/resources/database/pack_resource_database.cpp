@@ -0,0 +1,253 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "pack_resource_database.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/core/strings/hash.h"
+#include "portal/engine/project/project.h"
+#include "portal/engine/resources/source/pack_source.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+namespace portal
+{
+static auto logger = Log::get_logger("Resources");
+
+namespace
+{
+    bool in_range(const uint64_t offset, const uint64_t size, const uint64_t begin, const uint64_t end)
+    {
+        return offset >= begin && offset <= end && size <= end - offset;
+    }
+
+    // The pack is mapped as a whole, the layout is checked before anything in it is read
+    bool validate_layout(const MappedFile& file, const PackHeader& header)
+    {
+        const uint64_t file_size = file.get_size();
+        if (header.table_offset < sizeof(PackHeader) || header.table_offset % alignof(PackEntry) != 0)
+            return false;
+
+        if (header.table_offset > file_size || header.entry_count > (file_size - header.table_offset) / sizeof(PackEntry))
+            return false;
+
+        const uint64_t table_end = header.table_offset + header.entry_count * sizeof(PackEntry);
+        if (table_end > header.strings_offset || header.strings_offset > header.metadata_offset || header.metadata_offset > file_size)
+            return false;
+
+        // The binary deserializer trusts its input, the hash makes sure a truncated or corrupt index is never read
+        const auto index = file.get_buffer(header.table_offset, file_size - header.table_offset);
+        if (hash::rapidhash(index.as<const char*>(), index.size) != header.index_hash)
+            return false;
+
+        if (!in_range(header.strings_offset + header.name_offset, header.name_size, header.strings_offset, header.metadata_offset))
+            return false;
+
+        const std::span entries{file.get_buffer(header.table_offset, 0).as<const PackEntry*>(), header.entry_count};
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const auto& entry = entries[i];
+            // Lookups binary search the table
+            if (i > 0 && entries[i - 1].resource_id >= entry.resource_id)
+                return false;
+
+            if (!in_range(entry.data_offset, entry.stored_size, sizeof(PackHeader), header.table_offset) || entry.stored_size > entry.raw_size)
+                return false;
+
+            if (!in_range(header.strings_offset + entry.string_offset, entry.string_size, header.strings_offset, header.metadata_offset))
+                return false;
+
+            if (!in_range(header.metadata_offset + entry.metadata_offset, entry.metadata_size, header.metadata_offset, file_size))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+bool PackHeader::is_valid() const
+{
+    return magic == MAGIC && version == VERSION;
+}
+
+std::filesystem::path resources::PackDatabaseEntry::get_path() const
+{
+    std::vector<std::string_view> segments;
+    for (auto* node = static_cast<const DatabaseEntry*>(this); node != nullptr && node->parent != nullptr; node = node->parent)
+    {
+        segments.push_back(node->name.string);
+    }
+    std::ranges::reverse(segments);
+
+    std::filesystem::path result;
+    for (auto& seg : segments)
+    {
+        result /= seg;
+    }
+    return result;
+}
+
+std::unique_ptr<PackResourceDatabase> PackResourceDatabase::create(const Project& project, const std::filesystem::path& pack_path)
+{
+    const auto path = pack_path.is_absolute() ? pack_path : project.get_resource_directory() / pack_path;
+
+    auto database = open(path);
+    if (!database)
+    {
+        LOGGER_ERROR("Failed to open resource pack: {}", path.generic_string());
+        throw std::runtime_error("Failed to open resource pack");
+    }
+    return database;
+}
+
+std::unique_ptr<PackResourceDatabase> PackResourceDatabase::open(const std::filesystem::path& pack_path)
+{
+    PORTAL_PROF_ZONE();
+
+    auto file = make_reference<MappedFile>(MappedFile::open(pack_path));
+    if (!file->is_valid() || file->get_size() < sizeof(PackHeader))
+    {
+        LOGGER_WARN("Missing or truncated resource pack: {}", pack_path.generic_string());
+        return nullptr;
+    }
+
+    PackHeader header;
+    std::memcpy(&header, file->get_buffer().data, sizeof(header));
+    if (!header.is_valid())
+    {
+        LOGGER_WARN("{} is not a resource pack of version {}", pack_path.generic_string(), PackHeader::VERSION);
+        return nullptr;
+    }
+
+    if (!validate_layout(*file, header))
+    {
+        LOGGER_WARN("Corrupt resource pack: {}", pack_path.generic_string());
+        return nullptr;
+    }
+
+    return std::unique_ptr<PackResourceDatabase>(new PackResourceDatabase(pack_path, std::move(file), header));
+}
+
+PackResourceDatabase::PackResourceDatabase(std::filesystem::path pack_path, Reference<MappedFile> file, const PackHeader& header)
+    : pack_path(std::move(pack_path)),
+      root_path(this->pack_path.parent_path()),
+      file(std::move(file)),
+      header(header),
+      entries(this->file->get_buffer(header.table_offset, 0).as<const PackEntry*>(), header.entry_count),
+      name(STRING_ID(this->file->get_buffer(header.strings_offset + header.name_offset, header.name_size).as_string())),
+      structure(name)
+{
+    // Strings are registered once, ids read back from metadata resolve to them
+    const auto strings = this->file->get_buffer(header.strings_offset, header.metadata_offset - header.strings_offset);
+    for (const auto& entry : entries)
+    {
+        const std::string_view string{strings.as<const char*>() + entry.string_offset, entry.string_size};
+        add_to_structure(StringId(entry.resource_id, string));
+    }
+
+    LOGGER_INFO("Loaded resource pack {}, {} resources", name, entries.size());
+}
+
+std::expected<SourceMetadata, DatabaseError> PackResourceDatabase::find(const StringId resource_id)
+{
+    const auto* entry = find_entry(resource_id);
+    if (!entry)
+        return std::unexpected{DatabaseErrorBit::MissingResource};
+
+    const auto blob = file->get_buffer(header.metadata_offset + entry->metadata_offset, entry->metadata_size);
+    BufferStreamReader stream(blob);
+    BinaryDeserializer deserializer(stream);
+    auto meta = SourceMetadata::deserialize(deserializer);
+
+    // Resources of a composite point at it, like they do in a folder database
+    if (entry->composite_id != 0)
+        meta.full_source_path = StringId(entry->composite_id);
+    else
+        meta.full_source_path = STRING_ID((root_path / meta.source.string).generic_string());
+
+    return meta;
+}
+
+DatabaseError PackResourceDatabase::add(const StringId resource_id, SourceMetadata)
+{
+    LOGGER_ERROR("Cannot add {} to resource pack {}, packs are read only", resource_id, name);
+    return DatabaseErrorBit::Conflict;
+}
+
+DatabaseError PackResourceDatabase::remove(const StringId resource_id)
+{
+    LOGGER_ERROR("Cannot remove {} from resource pack {}, packs are read only", resource_id, name);
+    return DatabaseErrorBit::Conflict;
+}
+
+Reference<resources::ResourceSource> PackResourceDatabase::create_source(const StringId resource_id, SourceMetadata)
+{
+    const auto* entry = find_entry(resource_id);
+    if (!entry || entry->raw_size == 0)
+    {
+        LOGGER_ERROR("Resource {} has no data in resource pack {}", resource_id, name);
+        return nullptr;
+    }
+
+    return make_reference<resources::PackSource>(
+        file,
+        file->get_buffer(entry->data_offset, entry->stored_size),
+        entry->raw_size,
+        entry->is_compressed()
+    );
+}
+
+resources::DatabaseEntry& PackResourceDatabase::get_structure() const
+{
+    return const_cast<resources::PackDatabaseEntry&>(structure);
+}
+
+StringId PackResourceDatabase::get_name() const
+{
+    return name;
+}
+
+const std::filesystem::path& PackResourceDatabase::get_root_path() const
+{
+    return root_path;
+}
+
+const PackEntry* PackResourceDatabase::find_entry(const StringId& resource_id) const
+{
+    const auto it = std::ranges::lower_bound(entries, resource_id.id, {}, &PackEntry::resource_id);
+    if (it == entries.end() || it->resource_id != resource_id.id)
+        return nullptr;
+    return &*it;
+}
+
+void PackResourceDatabase::add_to_structure(StringId resource_id)
+{
+    auto split_view = resource_id.string | std::views::split('/') | std::views::drop(1);
+    size_t part_number = std::ranges::distance(split_view);
+
+    StringId part_string;
+    resources::DatabaseEntry* current_entry = &structure;
+    for (auto part : split_view)
+    {
+        part_string = STRING_ID(std::string_view(part));
+
+        if (part_number-- == 1)
+            break;
+
+        auto& child = current_entry->children[part_string];
+        if (!child)
+        {
+            child = make_reference<resources::PackDatabaseEntry>(part_string, current_entry);
+        }
+        current_entry = child.get();
+    }
+    current_entry->children[part_string] = make_reference<resources::PackDatabaseEntry>(resource_id, current_entry);
+}
+} // portal
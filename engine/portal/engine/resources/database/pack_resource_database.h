@@ -0,0 +1,148 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <span>
+
+#include "resource_database.h"
+#include "portal/core/files/mapped_file.h"
+
+namespace portal
+{
+class Project;
+
+/**
+ * @brief Header at the start of a pack file.
+ *
+ * A pack is laid out as the header, the data of every resource, and the index. The index is the entry table, sorted by
+ * resource id, followed by the strings and the binary metadata the entries point to. Only the index is hashed, resource
+ * data is read lazily through the mapping and is never touched when the pack is opened.
+ */
+struct PackHeader
+{
+    constexpr static std::array MAGIC = {'P', 'P', 'A', 'K'};
+    // Bump whenever the layout of the pack, or the binary layout of `SourceMetadata`, changes
+    constexpr static uint32_t VERSION = 1;
+
+    std::array<char, 4> magic = MAGIC;
+    uint32_t version = VERSION;
+    uint64_t entry_count = 0;
+    uint64_t table_offset = 0;
+    uint64_t strings_offset = 0;
+    uint64_t metadata_offset = 0;
+    // Hash of everything from the table to the end of the file
+    uint64_t index_hash = 0;
+    // The name of the database, in the strings
+    uint32_t name_offset = 0;
+    uint32_t name_size = 0;
+
+    [[nodiscard]] bool is_valid() const;
+};
+
+static_assert(std::is_trivially_copyable_v<PackHeader>);
+static_assert(sizeof(PackHeader) == 56, "The pack header is written as is, it must not have padding");
+
+/**
+ * @brief A resource in a pack.
+ *
+ * Resources that share a source file share its data, resources inside of a composite that are loaded through the
+ * composite have none.
+ */
+struct PackEntry
+{
+    uint64_t resource_id = 0;
+    // The composite the resource is a part of, 0 if it is not
+    uint64_t composite_id = 0;
+    // Offset of the data from the start of the pack
+    uint64_t data_offset = 0;
+    // Size of the data in the pack, smaller than the raw size when the data is a compressed container
+    uint64_t stored_size = 0;
+    uint64_t raw_size = 0;
+    // Offsets from the start of the strings and the metadata
+    uint32_t string_offset = 0;
+    uint32_t string_size = 0;
+    uint32_t metadata_offset = 0;
+    uint32_t metadata_size = 0;
+
+    [[nodiscard]] bool is_compressed() const { return stored_size < raw_size; }
+};
+
+static_assert(std::is_trivially_copyable_v<PackEntry>);
+static_assert(sizeof(PackEntry) == 56, "Pack entries are written as is, they must not have padding");
+
+namespace resources
+{
+    struct PackDatabaseEntry final : DatabaseEntry
+    {
+        using DatabaseEntry::DatabaseEntry;
+
+        std::filesystem::path get_path() const override;
+    };
+}
+
+/**
+ * @brief A read only database of resources packed into a single file, for shipping builds.
+ *
+ * Where a folder database opens a file per resource and parses a json file per resource when it is opened, a pack is
+ * a single file that is mapped into memory. Opening it only reads and verifies the index, metadata is decoded from the
+ * mapping when a resource is looked up, and sources read the data of uncompressed resources straight from the mapping,
+ * without copying it.
+ *
+ * Packs are built from another database with `resources::PackBuilder`, or the `portal-pack` tool.
+ *
+ * @note Loaders that read files next to their source (glTF external buffers, fonts) read them relative to the folder
+ * of the pack, those files have to be shipped next to it.
+ */
+class PackResourceDatabase final : public ResourceDatabase
+{
+public:
+    constexpr static auto PACK_EXTENSION = ".ppak";
+
+public:
+    static std::unique_ptr<PackResourceDatabase> create(const Project& project, const std::filesystem::path& pack_path);
+
+    /**
+     * @brief Opens a pack file.
+     *
+     * @return The database, or nullptr if the file is missing, truncated or not a pack of the current version
+     */
+    static std::unique_ptr<PackResourceDatabase> open(const std::filesystem::path& pack_path);
+
+    std::expected<SourceMetadata, DatabaseError> find(StringId resource_id) override;
+
+    /** @note Packs are read only, adding a resource always fails */
+    DatabaseError add(StringId resource_id, SourceMetadata meta) override;
+    /** @note Packs are read only, removing a resource always fails */
+    DatabaseError remove(StringId resource_id) override;
+
+    Reference<resources::ResourceSource> create_source(StringId resource_id, SourceMetadata meta) override;
+
+    [[nodiscard]] resources::DatabaseEntry& get_structure() const override;
+    [[nodiscard]] StringId get_name() const override;
+    [[nodiscard]] const std::filesystem::path& get_root_path() const override;
+
+    [[nodiscard]] size_t size() const { return entries.size(); }
+
+private:
+    PackResourceDatabase(std::filesystem::path pack_path, Reference<MappedFile> file, const PackHeader& header);
+
+    [[nodiscard]] const PackEntry* find_entry(const StringId& resource_id) const;
+    void add_to_structure(StringId resource_id);
+
+    std::filesystem::path pack_path;
+    std::filesystem::path root_path;
+    // Shared with the sources, which read from it
+    Reference<MappedFile> file;
+
+    PackHeader header;
+    std::span<const PackEntry> entries;
+    StringId name;
+
+    resources::PackDatabaseEntry structure;
+};
+} // portal
@@ -15,6 +15,23 @@
 
 namespace portal
 {
+namespace
+{
+    // The binary serializer only writes the hash of a string id, metadata is read back in another run so the string is
+    // written instead
+    void write_string_id(Serializer& serializer, const StringId& id)
+    {
+        serializer.add_value(id.string);
+    }
+
+    StringId read_string_id(Deserializer& deserializer)
+    {
+        std::string string;
+        deserializer.get_value(string);
+        return STRING_ID(string);
+    }
+}
+
 void CompositeMetadata::archive(ArchiveObject& archive) const
 {
     auto* child = archive.create_child("composite");
@@ -34,6 +51,35 @@ CompositeMetadata CompositeMetadata::dearchive(ArchiveObject& archive)
     return CompositeMetadata{children, type};
 }
 
+void CompositeMetadata::serialize(Serializer& serializer) const
+{
+    serializer.add_value(type);
+    serializer.add_value(children.size());
+    for (const auto& [name, child] : children)
+    {
+        serializer.add_value(name);
+        child.serialize(serializer);
+    }
+}
+
+CompositeMetadata CompositeMetadata::deserialize(Deserializer& deserializer)
+{
+    CompositeMetadata metadata;
+    deserializer.get_value(metadata.type);
+
+    size_t count = 0;
+    deserializer.get_value(count);
+    metadata.children.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string name;
+        deserializer.get_value(name);
+        metadata.children.emplace(std::move(name), SourceMetadata::deserialize(deserializer));
+    }
+
+    return metadata;
+}
+
 void TextureMetadata::archive(ArchiveObject& archive) const
 {
     auto* child = archive.create_child("texture");
@@ -62,6 +108,24 @@ TextureMetadata TextureMetadata::dearchive(const ArchiveObject& archive)
     };
 }
 
+void TextureMetadata::serialize(Serializer& serializer) const
+{
+    serializer.add_value(hdr);
+    serializer.add_value(width);
+    serializer.add_value(height);
+    serializer.add_value(format);
+}
+
+TextureMetadata TextureMetadata::deserialize(Deserializer& deserializer)
+{
+    TextureMetadata metadata{};
+    deserializer.get_value(metadata.hdr);
+    deserializer.get_value(metadata.width);
+    deserializer.get_value(metadata.height);
+    deserializer.get_value(metadata.format);
+    return metadata;
+}
+
 void MaterialMetadata::archive(ArchiveObject& archive) const
 {
     auto* child = archive.create_child("material");
@@ -77,6 +141,16 @@ MaterialMetadata MaterialMetadata::dearchive(const ArchiveObject& archive)
     return MaterialMetadata{STRING_ID(shader_name)};
 }
 
+void MaterialMetadata::serialize(Serializer& serializer) const
+{
+    write_string_id(serializer, shader);
+}
+
+MaterialMetadata MaterialMetadata::deserialize(Deserializer& deserializer)
+{
+    return MaterialMetadata{read_string_id(deserializer)};
+}
+
 void FontMetadata::archive(ArchiveObject& archive) const
 {
     auto* child = archive.create_child("font");
@@ -97,6 +171,21 @@ FontMetadata FontMetadata::dearchive(const ArchiveObject& archive)
     return FontMetadata{STRING_ID(name), glyph_range_min, glyph_range_max};
 }
 
+void FontMetadata::serialize(Serializer& serializer) const
+{
+    write_string_id(serializer, name);
+    serializer.add_value(glyph_range_min);
+    serializer.add_value(glyph_range_max);
+}
+
+FontMetadata FontMetadata::deserialize(Deserializer& deserializer)
+{
+    FontMetadata metadata{.name = read_string_id(deserializer)};
+    deserializer.get_value(metadata.glyph_range_min);
+    deserializer.get_value(metadata.glyph_range_max);
+    return metadata;
+}
+
 void SourceMetadata::archive(ArchiveObject& archive) const
 {
     archive.add_property("name", name);
@@ -165,4 +254,71 @@ SourceMetadata SourceMetadata::dearchive(ArchiveObject& archive)
     }
     return metadata;
 }
+
+void SourceMetadata::serialize(Serializer& serializer) const
+{
+    write_string_id(serializer, name);
+    write_string_id(serializer, resource_id);
+    serializer.add_value(type);
+    serializer.add_value(dependencies.size());
+    for (const auto& dependency : dependencies)
+        write_string_id(serializer, dependency);
+
+    write_string_id(serializer, source);
+    serializer.add_value(format);
+
+    serializer.add_value(static_cast<uint8_t>(meta.index()));
+    std::visit(
+        [&serializer](const auto& specific_meta)
+        {
+            specific_meta.serialize(serializer);
+        },
+        meta
+    );
+}
+
+SourceMetadata SourceMetadata::deserialize(Deserializer& deserializer)
+{
+    SourceMetadata metadata;
+    metadata.name = read_string_id(deserializer);
+    metadata.resource_id = read_string_id(deserializer);
+    deserializer.get_value(metadata.type);
+
+    size_t dependency_count = 0;
+    deserializer.get_value(dependency_count);
+    metadata.dependencies.reserve(dependency_count);
+    for (size_t i = 0; i < dependency_count; ++i)
+        metadata.dependencies.push_back(read_string_id(deserializer));
+
+    metadata.source = read_string_id(deserializer);
+    deserializer.get_value(metadata.format);
+
+    using MetaVariant = decltype(metadata.meta);
+    static_assert(std::is_same_v<std::variant_alternative_t<0, MetaVariant>, TextureMetadata>);
+    static_assert(std::is_same_v<std::variant_alternative_t<1, MetaVariant>, CompositeMetadata>);
+    static_assert(std::is_same_v<std::variant_alternative_t<2, MetaVariant>, MaterialMetadata>);
+    static_assert(std::is_same_v<std::variant_alternative_t<4, MetaVariant>, FontMetadata>);
+
+    uint8_t meta_index = 0;
+    deserializer.get_value(meta_index);
+    switch (meta_index)
+    {
+    case 0:
+        metadata.meta = TextureMetadata::deserialize(deserializer);
+        break;
+    case 1:
+        metadata.meta = CompositeMetadata::deserialize(deserializer);
+        break;
+    case 2:
+        metadata.meta = MaterialMetadata::deserialize(deserializer);
+        break;
+    case 4:
+        metadata.meta = FontMetadata::deserialize(deserializer);
+        break;
+    default:
+        metadata.meta = EmptyMeta{};
+        break;
+    }
+    return metadata;
+}
 } // portal
@@ -25,6 +25,7 @@
 #include "portal/engine/renderer/image/image_types.h"
 #include "portal/engine/resources/resources/resource.h"
 #include "portal/serialization/archive.h"
+#include "portal/serialization/serialize.h"
 
 
 namespace portal
@@ -46,6 +47,9 @@ struct SourceMetadata;
 struct EmptyMeta
 {
     void archive(ArchiveObject&) const {}
+
+    void serialize(Serializer&) const {}
+    static EmptyMeta deserialize(Deserializer&) { return {}; }
 };
 
 /**
@@ -70,6 +74,9 @@ struct CompositeMetadata
 
     void archive(ArchiveObject& archive) const;
     static CompositeMetadata dearchive(ArchiveObject& archive);
+
+    void serialize(Serializer& serializer) const;
+    static CompositeMetadata deserialize(Deserializer& deserializer);
 };
 
 /**
@@ -88,6 +95,9 @@ struct TextureMetadata
 
     void archive(ArchiveObject& archive) const;
     static TextureMetadata dearchive(const ArchiveObject& archive);
+
+    void serialize(Serializer& serializer) const;
+    static TextureMetadata deserialize(Deserializer& deserializer);
 };
 
 /**
@@ -103,6 +113,9 @@ struct MaterialMetadata
 
     void archive(ArchiveObject& archive) const;
     static MaterialMetadata dearchive(const ArchiveObject& archive);
+
+    void serialize(Serializer& serializer) const;
+    static MaterialMetadata deserialize(Deserializer& deserializer);
 };
 
 /**
@@ -117,6 +130,9 @@ struct FontMetadata
 
     void archive(ArchiveObject& archive) const;
     static FontMetadata dearchive(const ArchiveObject& archive);
+
+    void serialize(Serializer& serializer) const;
+    static FontMetadata deserialize(Deserializer& deserializer);
 };
 
 /**
@@ -179,6 +195,9 @@ struct SourceMetadata
 
     void archive(ArchiveObject& archive) const;
     static SourceMetadata dearchive(ArchiveObject& archive);
+
+    void serialize(Serializer& serializer) const;
+    static SourceMetadata deserialize(Deserializer& deserializer);
 };
 
 /**
@@ -280,6 +299,16 @@ public:
      */
     virtual Reference<resources::ResourceSource> create_source(StringId resource_id, SourceMetadata meta) = 0;
 
+    /**
+     * @brief Applies the changes made to the database files since the last call
+     *
+     * Databases that do not watch their files never report anything. Must be called from a single thread, `find` and
+     * `create_source` can be called concurrently.
+     *
+     * @return The resources whose metadata or source changed, including added and removed resources
+     */
+    virtual std::vector<StringId> poll_changes() { return {}; }
+
     [[nodiscard]] virtual resources::DatabaseEntry& get_structure() const = 0;
 
     [[nodiscard]] virtual StringId get_name() const = 0;
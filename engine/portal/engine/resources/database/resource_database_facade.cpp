@@ -5,6 +5,8 @@
 
 #include "resource_database_facade.h"
 
+#include <algorithm>
+#include <iterator>
 #include <ranges>
 
 #include "portal/engine/resources/source/resource_source.h"
@@ -78,6 +80,14 @@ Reference<resources::ResourceSource> ResourceDatabaseFacade::create_source(Strin
     LOGGER_ERROR("Cannot find database named: '{}'", prefix);
     return nullptr;
 }
+std::vector<StringId> ResourceDatabaseFacade::poll_changes()
+{
+    std::vector<StringId> changes;
+    for (const auto& database : databases | std::views::values)
+        std::ranges::move(database->poll_changes(), std::back_inserter(changes));
+    return changes;
+}
+
 const std::filesystem::path& ResourceDatabaseFacade::get_root_path() const
 {
     static const std::filesystem::path empty_path;
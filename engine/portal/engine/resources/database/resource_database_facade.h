@@ -34,6 +34,8 @@ public:
     DatabaseError add(StringId resource_id, SourceMetadata meta) override;
     DatabaseError remove(StringId resource_id) override;
 
+    std::vector<StringId> poll_changes() override;
+
     [[nodiscard]] StringId get_name() const override { return STRING_ID("Resource Database Facade"); }
     [[nodiscard]] resources::DatabaseEntry& get_structure() const override { return const_cast<resources::FacadeDatabaseEntry&>(structure); }
     [[nodiscard]] const std::filesystem::path& get_root_path() const override;
@@ -6,6 +6,7 @@
 #include "resource_database_factory.h"
 
 #include "folder_resource_database.h"
+#include "pack_resource_database.h"
 #include "resource_database.h"
 #include "portal/application/modules/module_stack.h"
 
@@ -45,6 +46,10 @@ std::unique_ptr<ResourceDatabase> ResourceDatabaseFactory::create(const Project&
     case DatabaseType::Folder:
         PORTAL_ASSERT(description.path.has_value(), "Invalid database description for Folder database");
         return FolderResourceDatabase::create(project, description.path.value());
+
+    case DatabaseType::Pack:
+        PORTAL_ASSERT(description.path.has_value(), "Invalid database description for Pack database");
+        return PackResourceDatabase::create(project, description.path.value());
     }
 
     return nullptr;
@@ -16,7 +16,8 @@ class Project;
 enum class DatabaseType
 {
     Unknown,
-    Folder
+    Folder,
+    Pack
 };
 
 class ModuleStack;
@@ -0,0 +1,87 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "load_timeline.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "portal/core/log.h"
+
+namespace portal
+{
+static auto logger = Log::get_logger("Resources");
+
+static double to_milliseconds(const LoadTimeline::Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::vector<size_t> LoadTimeline::get_critical_path() const
+{
+    if (entries.empty())
+        return {};
+
+    const auto last = std::ranges::max_element(entries, {}, &LoadTimelineEntry::decode_end);
+    auto current = static_cast<size_t>(std::distance(entries.begin(), last));
+
+    std::vector<size_t> path{current};
+    while (true)
+    {
+        const auto& entry = entries[current];
+
+        std::optional<size_t> gate;
+        for (const auto dependency : entry.dependencies)
+        {
+            if (!gate || entries[dependency].decode_end > entries[*gate].decode_end)
+                gate = dependency;
+        }
+
+        // When the entry's own read finished after all of its dependencies, the I/O is what it waited on
+        if (!gate || entries[*gate].decode_end <= entry.io_end)
+            break;
+
+        current = *gate;
+        path.push_back(current);
+    }
+
+    std::ranges::reverse(path);
+    return path;
+}
+
+void LoadTimeline::log() const
+{
+    size_t bytes_read = 0;
+    size_t failed = 0;
+    for (const auto& entry : entries)
+    {
+        bytes_read += entry.bytes_read;
+        failed += entry.failed ? 1 : 0;
+    }
+
+    const auto critical_path = get_critical_path();
+    LOGGER_INFO(
+        "Loaded {} with {} resources ({:.2f} MB, {} failed) in {:.2f} ms",
+        root,
+        entries.size(),
+        static_cast<double>(bytes_read) / (1024.0 * 1024.0),
+        failed,
+        to_milliseconds(get_duration())
+    );
+
+    LOGGER_INFO("Critical path ({} resources):", critical_path.size());
+    for (const auto index : critical_path)
+    {
+        const auto& entry = entries[index];
+        LOGGER_INFO(
+            "    {}: io {:.2f} ms, decode {:.2f} ms, done at {:.2f} ms",
+            entry.resource_id,
+            to_milliseconds(entry.io_end - entry.io_start),
+            to_milliseconds(entry.decode_end - entry.decode_start),
+            to_milliseconds(entry.decode_end - start)
+        );
+    }
+}
+} // portal
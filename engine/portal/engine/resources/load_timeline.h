@@ -0,0 +1,64 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/strings/string_id.h"
+
+namespace portal
+{
+/**
+ * @brief Timing of a single resource in a dependency aware load.
+ */
+struct LoadTimelineEntry
+{
+    using Clock = std::chrono::steady_clock;
+
+    StringId resource_id = INVALID_STRING_ID;
+    // Indices of the entries this one waited on before decoding
+    llvm::SmallVector<size_t> dependencies{};
+
+    Clock::time_point io_start{};
+    Clock::time_point io_end{};
+    Clock::time_point decode_start{};
+    Clock::time_point decode_end{};
+
+    size_t bytes_read = 0;
+    bool failed = false;
+};
+
+/**
+ * @brief The timeline of a `ResourceRegistry::load_with_dependencies` call.
+ *
+ * Records when every resource in the dependency graph was read and decoded. The critical path is the chain of
+ * resources that gated the end of the load: starting from the last resource to finish, each step goes to the dependency
+ * it waited on, as long as it waited on a dependency and not on its own I/O. Shortening anything off the critical path
+ * does not make the load faster.
+ */
+struct LoadTimeline
+{
+    using Clock = LoadTimelineEntry::Clock;
+
+    StringId root = INVALID_STRING_ID;
+    Clock::time_point start{};
+    Clock::time_point end{};
+    std::vector<LoadTimelineEntry> entries;
+
+    [[nodiscard]] Clock::duration get_duration() const { return end - start; }
+
+    /**
+     * @brief Returns the indices of the entries on the critical path, from the first one to start to the last to finish.
+     */
+    [[nodiscard]] std::vector<size_t> get_critical_path() const;
+
+    /** @brief Logs the duration of the load and the timing of every resource on its critical path */
+    void log() const;
+};
+} // portal
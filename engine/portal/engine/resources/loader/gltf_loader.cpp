@@ -446,7 +446,7 @@ Job<> GltfLoader::load_texture(
     const auto parent_path = std::filesystem::path(texture_meta.source.string).parent_path();
     const auto base_name = std::filesystem::path(texture_meta.resource_id.string).parent_path();
     const auto texture_name = texture_meta.resource_id;
-    if (registry.get<renderer::vulkan::VulkanTexture>(texture_name).get_state() == ResourceState::Loaded)
+    if (registry.get<renderer::vulkan::VulkanTexture>(texture_name).get_state() == ResourceState::Loaded && !registry.is_reloading(texture_name))
         co_return;
 
     const auto result = find_image_source(composite_id, base_name, parent_path, asset, texture);
@@ -498,7 +498,7 @@ Job<> GltfLoader::load_material(
     const auto parent_path = std::filesystem::path(material_meta.source.string).parent_path();
 
     const auto& material_name = material_meta.resource_id;
-    if (registry.get<renderer::vulkan::VulkanMaterial>(material_name).get_state() == ResourceState::Loaded)
+    if (registry.get<renderer::vulkan::VulkanMaterial>(material_name).get_state() == ResourceState::Loaded && !registry.is_reloading(material_name))
         co_return;
 
     MaterialDetails details{
@@ -555,7 +555,7 @@ Job<> GltfLoader::load_mesh(
 {
     const auto parent_path = std::filesystem::path(mesh_meta.resource_id.string).parent_path();
 
-    if (registry.get<MeshGeometry>(mesh_meta.resource_id).get_state() == ResourceState::Loaded)
+    if (registry.get<MeshGeometry>(mesh_meta.resource_id).get_state() == ResourceState::Loaded && !registry.is_reloading(mesh_meta.resource_id))
         co_return;
 
     MeshData mesh_data;
@@ -16,7 +16,7 @@
 
 namespace portal::resources
 {
-LoaderFactory::LoaderFactory(const Project& project, ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context) : stub_loader(registry), context(context)
+LoaderFactory::LoaderFactory(const Project& project, ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context) : stub_loader(registry)
 {
     loaders[ResourceType::Texture] = std::make_shared<TextureLoader>(registry, context);
     loaders[ResourceType::Shader] = std::make_shared<ShaderLoader>(registry, context);
@@ -27,6 +27,13 @@ LoaderFactory::LoaderFactory(const Project& project, ResourceRegistry& registry,
     loaders[ResourceType::Font] = std::make_shared<FontLoader>(registry);
 }
 
+LoaderFactory::LoaderFactory(ResourceRegistry& registry) : stub_loader(registry) {}
+
+void LoaderFactory::set_loader(const ResourceType type, std::shared_ptr<ResourceLoader> loader)
+{
+    loaders[type] = std::move(loader);
+}
+
 ResourceLoader& LoaderFactory::get(const SourceMetadata& meta)
 {
     if (!loaders.contains(meta.type))
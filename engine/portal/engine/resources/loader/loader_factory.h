@@ -39,14 +39,16 @@ class LoaderFactory
 {
 public:
     LoaderFactory(const Project& project, ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context);
+    /** @brief Creates a factory without loaders, every type is loaded by the stub loader until a loader is set */
+    explicit LoaderFactory(ResourceRegistry& registry);
 
     ResourceLoader& get(const SourceMetadata& meta);
+    void set_loader(ResourceType type, std::shared_ptr<ResourceLoader> loader);
 
     static void enrich_metadata(SourceMetadata& meta, const ResourceSource& source);
 
 protected:
     StubLoader stub_loader;
     llvm::DenseMap<ResourceType, std::shared_ptr<ResourceLoader>> loaders;
-    const renderer::vulkan::VulkanContext& context;
 };
 } // portal
@@ -5,6 +5,8 @@
 
 #include "material_loader.h"
 
+#include <array>
+
 #include "portal/core/buffer_stream.h"
 #include "portal/engine/project/project.h"
 #include "portal/engine/renderer/renderer_context.h"
@@ -26,6 +28,24 @@ class VulkanMaterial;
 
 namespace portal::resources
 {
+namespace
+{
+    constexpr size_t NORMAL_TEXTURE_BIT = 1 << 0;
+    constexpr size_t ROUGHNESS_TEXTURE_BIT = 1 << 1;
+    constexpr size_t METALLIC_TEXTURE_BIT = 1 << 2;
+    constexpr size_t MATERIAL_VARIANT_COUNT = 1 << 3;
+
+    // Specialization constants matching the order of extern const static declarations in the shader
+    std::vector<renderer::ShaderStaticConstants> make_spec_constants(const bool has_normal, const bool has_roughness, const bool has_metallic)
+    {
+        return {
+            {"has_normal_texture", "bool", has_normal ? "true" : "false"},
+            {"has_roughness_texture", "bool", has_roughness ? "true" : "false"},
+            {"has_metallic_texture", "bool", has_metallic ? "true" : "false"},
+        };
+    }
+}
+
 MaterialDetails MaterialDetails::dearchive(ArchiveObject& archive)
 {
     MaterialDetails details;
@@ -68,16 +88,16 @@ ResourceData MaterialLoader::load(const SourceMetadata& meta, Reference<Resource
     const bool has_roughness = details.roughness_texture != INVALID_STRING_ID;
     const bool has_metallic = details.metallic_texture != INVALID_STRING_ID;
 
-    // Build specialization constants matching the order of extern const static declarations in the shader
-    std::vector<renderer::ShaderStaticConstants> spec_constants = {
-        {"has_normal_texture", "bool", has_normal ? "true" : "false"},
-        {"has_roughness_texture", "bool", has_roughness ? "true" : "false"},
-        {"has_metallic_texture", "bool", has_metallic ? "true" : "false"},
-    };
+    // Every combination of texture flags is compiled together the first time the shader is used by a material, the
+    // variants compile in parallel and the materials loaded after it find theirs already compiled
+    std::array<renderer::ShaderPermutation, MATERIAL_VARIANT_COUNT> permutations;
+    for (size_t i = 0; i < permutations.size(); ++i)
+        permutations[i].static_constants = make_spec_constants((i & NORMAL_TEXTURE_BIT) != 0, (i & ROUGHNESS_TEXTURE_BIT) != 0, (i & METALLIC_TEXTURE_BIT) != 0);
 
     auto shader = registry.immediate_load<renderer::vulkan::VulkanShader>(material_meta.shader);
-    const auto hash = shader->compile_with_permutations({}, spec_constants);
-    const auto variant = shader->get_shader(hash).lock();
+    const auto hashes = shader->compile_permutations(permutations);
+    const auto variant_index = (has_normal ? NORMAL_TEXTURE_BIT : 0) | (has_roughness ? ROUGHNESS_TEXTURE_BIT : 0) | (has_metallic ? METALLIC_TEXTURE_BIT : 0);
+    const auto variant = shader->get_shader(hashes[variant_index]).lock();
 
     renderer::MaterialProperties properties{
         .id = meta.resource_id,
@@ -8,6 +8,7 @@
 #include <tiny_obj_loader.h>
 
 #include "portal/core/buffer_stream.h"
+#include "portal/engine/resources/cook/cooked_resource.h"
 #include "portal/engine/resources/source/resource_source.h"
 
 namespace portal::resources
@@ -174,19 +175,24 @@ MeshData MeshLoader::load_mesh_data(const SourceMetadata& meta, const ResourceSo
     if (meta.format == SourceFormat::Memory)
         return source.load().read<MeshData>();
     if (meta.format == SourceFormat::Obj)
-        return load_from_obj(source);
+    {
+        const auto data = source.load();
+
+        // Cooked meshes are already parsed and have their tangents calculated
+        if (auto cooked = read_cooked_mesh(data))
+            return std::move(cooked.value());
+
+        return parse_obj(std::string_view{data.as<const char*>(), data.size});
+    }
 
     throw std::runtime_error("Unsupported mesh format");
 }
 
-MeshData MeshLoader::load_from_obj(const ResourceSource& source)
+MeshData parse_obj(const std::string_view content)
 {
-    const auto data_stream = source.istream();
-    std::string content(std::istreambuf_iterator<char>(*data_stream), {});
-
     tinyobj::ObjReader reader;
     tinyobj::ObjReaderConfig config;
-    if (!reader.ParseFromString(content, "", config))
+    if (!reader.ParseFromString(std::string(content), "", config))
         throw std::runtime_error(std::format("Failed to parse OBJ: {}", reader.Error()));
 
     if (!reader.Warning().empty())
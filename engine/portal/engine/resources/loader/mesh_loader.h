@@ -20,6 +20,11 @@ struct MeshData
 
 void calculate_tangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
 
+/**
+ * @brief Parses the content of a Wavefront OBJ file into mesh data, one submesh per shape, and calculates its tangents.
+ */
+MeshData parse_obj(std::string_view content);
+
 class MeshLoader final : public ResourceLoader
 {
 public:
@@ -30,7 +35,6 @@ public:
 
 protected:
     static MeshData load_mesh_data(const SourceMetadata& meta, const ResourceSource& source);
-    static MeshData load_from_obj(const ResourceSource& source);
 
 private:
     const renderer::vulkan::VulkanContext& context;
@@ -5,7 +5,14 @@
 
 #include "scene_loader.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+
 #include "portal/core/buffer_stream.h"
+#include "portal/core/files/file_system.h"
+#include "portal/core/jobs/scheduler.h"
 #include "portal/core/variant.h"
 #include "portal/engine/components/mesh.h"
 #include "portal/engine/components/relationship.h"
@@ -20,6 +27,111 @@
 
 namespace portal::resources
 {
+namespace
+{
+    // Registered up front, jobs should only ever read from the string registry
+    const auto UNNAMED_ENTITY = STRING_ID("Unnamed");
+    const auto ARCHIVE_FUNC_ID = STRING_ID("archive");
+    const auto SERIALIZE_FUNC_ID = STRING_ID("serialize");
+
+    // Precedes the chunk table of binary scenes. Scenes written before the chunked layout have no header and are a single
+    // binary serialized stream.
+    struct SceneHeader
+    {
+        constexpr static std::array MAGIC = {'P', 'S', 'C', 'N'};
+        constexpr static uint32_t VERSION = 1;
+
+        std::array<char, 4> magic = MAGIC;
+        uint32_t version = VERSION;
+        uint64_t table_size = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<SceneHeader>);
+    static_assert(sizeof(SceneHeader) == 16, "The scene header is written as is, it must not have padding");
+
+    void archive_entity(Entity entity, ArchiveObject& object, ecs::Registry& ecs_registry)
+    {
+        auto& raw_registry = ecs_registry.get_raw_registry();
+
+        if (entity.has_component<NameComponent>())
+        {
+            auto& [name, icon] = entity.get_component<NameComponent>();
+            object.add_property("name", name);
+            object.add_property("icon", icon);
+        }
+        else
+        {
+            object.add_property("name", UNNAMED_ENTITY);
+            object.add_property("icon", ICON_FA_CUBE);
+        }
+
+        for (auto&& [type_id, storage] : raw_registry.storage())
+        {
+            auto type = entt::resolve(storage.info());
+            if (type)
+            {
+                auto result = type.invoke(
+                    static_cast<entt::id_type>(ARCHIVE_FUNC_ID.id),
+                    {},
+                    entt::forward_as_meta(entity),
+                    entt::forward_as_meta(object),
+                    entt::forward_as_meta(ecs_registry)
+                );
+
+                if (!result)
+                {
+                    LOG_WARN("Failed to invoke archive for type: {}", type.name());
+                }
+            }
+        }
+    }
+
+    // Chunk jobs only read from the ECS registry, so they can run concurrently as long as nothing modifies the scene meanwhile
+    Job<> archive_chunk_job(const std::span<const Entity> entities, ecs::Registry& ecs_registry, std::span<ArchiveObject> nodes)
+    {
+        PORTAL_PROF_ZONE();
+        for (size_t i = 0; i < entities.size(); ++i)
+            archive_entity(entities[i], nodes[i], ecs_registry);
+        co_return;
+    }
+
+    Job<> serialize_chunk_job(const std::span<const Entity> entities, ecs::Registry& ecs_registry, Buffer& output)
+    {
+        PORTAL_PROF_ZONE();
+        Buffer buffer;
+        BufferStreamWriter stream(buffer);
+        BinarySerializer serializer(stream);
+
+        for (const auto entity : entities)
+            SceneLoader::serialize_entity(entity, serializer, ecs_registry);
+
+        stream.flush();
+        output = stream.get_buffer();
+        co_return;
+    }
+
+    std::vector<Entity> collect_descendants(const Reference<Scene>& scene)
+    {
+        std::vector<Entity> entities;
+        entities.reserve(scene->get_scene_entity().descendants_count());
+        for (auto descendant : scene->get_scene_entity().descendants())
+            entities.push_back(descendant);
+        return entities;
+    }
+
+    size_t get_chunk_count(const size_t node_count)
+    {
+        return (node_count + SceneLoader::SCENE_CHUNK_SIZE - 1) / SceneLoader::SCENE_CHUNK_SIZE;
+    }
+
+    std::span<const Entity> get_chunk(const std::vector<Entity>& entities, const size_t chunk)
+    {
+        const auto begin = chunk * SceneLoader::SCENE_CHUNK_SIZE;
+        const auto count = std::min(SceneLoader::SCENE_CHUNK_SIZE, entities.size() - begin);
+        return std::span{entities}.subspan(begin, count);
+    }
+}
+
 SceneLoader::SceneLoader(ResourceRegistry& registry) : ResourceLoader(registry)
 {}
 
@@ -89,73 +201,52 @@ void SceneLoader::save(ResourceData& resource_data)
         resource_data.metadata.dependencies = std::ranges::to<llvm::SmallVector<StringId>>(unique_elements);
 
         // TODO: This should be in the resource source class
+        const auto metadata_path = std::filesystem::path(fmt::format("{}.pmeta", resource_data.metadata.full_source_path.string));
         JsonArchive meta_archive;
-        resource_data.metadata.archive(meta_archive);
-        const auto metadata_path = fmt::format("{}.pmeta", resource_data.metadata.full_source_path.string);
-        meta_archive.dump(std::filesystem::path(metadata_path));
+        if (FileSystem::exists(metadata_path))
+            meta_archive.read(metadata_path);
+
+        // Only the changed properties are merged into the metadata on disk, which is not rewritten when nothing changed
+        JsonArchive updated_archive;
+        resource_data.metadata.archive(updated_archive);
+        if (auto changes = ArchiveObject::diff(meta_archive, updated_archive); changes != ArchiveObject{})
+        {
+            meta_archive.update(std::move(changes));
+            meta_archive.dump(metadata_path);
+        }
     }
 }
 
 void SceneLoader::load_snapshot(const ResourceData& resource_data, const Reference<ResourceSource> snapshot_source)
 {
-    const auto istream = snapshot_source->istream();
-    BinaryDeserializer deserializer(*istream);
-
-    deserialize_scene(reference_cast<Scene>(resource_data.resource), deserializer);
+    deserialize_scene(reference_cast<Scene>(resource_data.resource), snapshot_source->load());
 }
 
 void SceneLoader::snapshot(const ResourceData& resource_data, const Reference<ResourceSource> snapshot_source)
 {
     const auto ostream = snapshot_source->ostream();
-    BinarySerializer serializer(*ostream);
-
-    serialize_scene(reference_cast<Scene>(resource_data.resource), serializer);
+    serialize_scene(reference_cast<Scene>(resource_data.resource), *ostream);
 }
 
-void SceneLoader::archive_scene(const Reference<Scene>& scene, ArchiveObject& archive)
+void SceneLoader::archive_scene(const Reference<Scene>& scene, ArchiveObject& archive) const
 {
     auto& ecs_registry = scene->get_registry();
-    auto& raw_registry = scene->get_registry().get_raw_registry();
 
     archive.add_property("name", scene->get_id());
 
-    std::vector<ArchiveObject> nodes;
-    auto descendants = scene->get_scene_entity().descendants();
-    for (auto descendant : descendants)
-    {
-        auto& object = nodes.emplace_back(ArchiveObject{});
-        if (descendant.has_component<NameComponent>())
-        {
-            auto& [name, icon] = descendant.get_component<NameComponent>();
-            object.add_property("name", name);
-            object.add_property("icon", icon);
-        }
-        else
-        {
-            object.add_property("name", STRING_ID("Unnamed"));
-            object.add_property("icon", ICON_FA_CUBE);
-        }
-
-        for (auto&& [type_id, storage] : raw_registry.storage())
-        {
-            auto type = entt::resolve(storage.info());
-            if (type)
-            {
-                auto result = type.invoke(
-                    static_cast<entt::id_type>(STRING_ID("archive").id),
-                    {},
-                    entt::forward_as_meta(descendant),
-                    entt::forward_as_meta(object),
-                    entt::forward_as_meta(ecs_registry)
-                );
+    const auto descendants = collect_descendants(scene);
+    std::vector<ArchiveObject> nodes(descendants.size());
 
-                if (!result)
-                {
-                    LOG_WARN("Failed to invoke archive for type: {}", type.name());
-                }
-            }
-        }
+    const auto chunk_count = get_chunk_count(descendants.size());
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        const auto entities = get_chunk(descendants, chunk);
+        jobs.push_back(archive_chunk_job(entities, ecs_registry, std::span{nodes}.subspan(chunk * SCENE_CHUNK_SIZE, entities.size())));
     }
+    registry.get_scheduler().wait_for_jobs(std::span<Job<>>{jobs});
+
     archive.add_property("nodes", nodes);
 }
 
@@ -226,123 +317,256 @@ void SceneLoader::dearchive_scene(const Reference<Scene>& scene, ArchiveObject&
     }
 }
 
-void SceneLoader::serialize_scene(const Reference<Scene>& scene, Serializer& serializer)
+void SceneLoader::serialize_scene(const Reference<Scene>& scene, std::ostream& output) const
 {
     auto& ecs_registry = scene->get_registry();
-    auto& raw_registry = scene->get_registry().get_raw_registry();
 
-    serializer.add_value(scene->get_id());
-    serializer.add_value(scene->get_scene_entity().descendants_count());
-    auto descendants = scene->get_scene_entity().descendants();
-    for (auto descendant : descendants)
+    const auto descendants = collect_descendants(scene);
+    const auto chunk_count = get_chunk_count(descendants.size());
+
+    std::vector<Buffer> chunks(chunk_count);
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+        jobs.push_back(serialize_chunk_job(get_chunk(descendants, chunk), ecs_registry, chunks[chunk]));
+    registry.get_scheduler().wait_for_jobs(std::span<Job<>>{jobs});
+
+    Buffer table_buffer;
+    BufferStreamWriter table_stream(table_buffer);
+    BinarySerializer table(table_stream);
+    table.add_value(scene->get_id());
+    table.add_value(descendants.size());
+    table.add_value(chunk_count);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
     {
-        if (descendant.has_component<NameComponent>())
-        {
-            auto& [name, icon] = descendant.get_component<NameComponent>();
-            serializer.add_value(name);
-            serializer.add_value(icon);
-        }
-        else
+        table.add_value(get_chunk(descendants, chunk).size());
+        table.add_value(chunks[chunk].size);
+    }
+    table_stream.flush();
+
+    const SceneHeader header{.table_size = table_stream.size()};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(table_buffer.as<const char*>(), static_cast<std::streamsize>(header.table_size));
+    for (const auto& chunk : chunks)
+        output.write(chunk.as<const char*>(), static_cast<std::streamsize>(chunk.size));
+}
+
+void SceneLoader::deserialize_scene(const Reference<Scene>& scene, const Buffer& data) const
+{
+    auto& ecs_registry = scene->get_registry();
+
+    if (!data)
+    {
+        LOG_ERROR("Failed to deserialize scene {}, no data", scene->get_id());
+        return;
+    }
+
+    SceneHeader header;
+    if (data.size >= sizeof(header))
+        std::memcpy(&header, data.data, sizeof(header));
+
+    if (data.size < sizeof(header) || header.magic != SceneHeader::MAGIC)
+    {
+        LOG_INFO("Scene {} has no chunk table, reading it as a single stream", scene->get_id());
+        deserialize_legacy_scene(scene, data);
+        return;
+    }
+
+    if (header.version != SceneHeader::VERSION)
+    {
+        LOG_ERROR("Failed to deserialize scene {}, unsupported binary scene version {} (expected {})", scene->get_id(), header.version, SceneHeader::VERSION);
+        return;
+    }
+
+    size_t offset = sizeof(header);
+    if (data.size - offset < header.table_size)
+    {
+        LOG_ERROR("Failed to deserialize scene {}, truncated chunk table", scene->get_id());
+        return;
+    }
+
+    const Buffer table_buffer{data, offset, header.table_size};
+    BufferStreamReader table_stream(table_buffer);
+    BinaryDeserializer table(table_stream);
+    offset += header.table_size;
+
+    StringId name;
+    size_t node_count;
+    size_t chunk_count;
+    table.get_value(name);
+    table.get_value(node_count);
+    table.get_value(chunk_count);
+
+    // Components are deserialized straight into the ECS registry, which is not thread safe, so chunks are applied one
+    // after the other in their serialized order. Only serialization runs on jobs.
+    size_t deserialized_count = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        size_t chunk_nodes;
+        size_t chunk_size;
+        table.get_value(chunk_nodes);
+        table.get_value(chunk_size);
+
+        if (data.size - offset < chunk_size)
         {
-            serializer.add_value(STRING_ID("Unnamed"));
-            serializer.add_value(std::string{ICON_FA_CUBE});
+            LOG_ERROR("Failed to deserialize scene {}, chunk {} is truncated", name, chunk);
+            break;
         }
 
-        auto num_comps = serializer.reserve<size_t>();
-        size_t comp_count = 0;
-        for (auto&& [type_id, storage] : raw_registry.storage())
-        {
-            auto type = entt::resolve(storage.info());
-            if (type)
-            {
-                const auto result = type.invoke(
-                    static_cast<entt::id_type>(STRING_ID("serialize").id),
-                    {},
-                    entt::forward_as_meta(descendant),
-                    entt::forward_as_meta(serializer),
-                    entt::forward_as_meta(ecs_registry)
-                );
+        const Buffer chunk_buffer{data, offset, chunk_size};
+        BufferStreamReader chunk_stream(chunk_buffer);
+        BinaryDeserializer deserializer(chunk_stream);
+        for (size_t i = 0; i < chunk_nodes; ++i)
+            deserialize_entity(deserializer, ecs_registry);
 
-                if (!result)
-                {
-                    LOG_WARN("Failed to invoke serialize for type: {}", type.name());
-                }
-                else
-                {
-                    auto result_has_comp = result.cast<bool>();
-                    if (result_has_comp)
-                        ++comp_count;
-                }
-            }
-        }
-        num_comps.write(comp_count);
+        offset += chunk_size;
+        deserialized_count += chunk_nodes;
+    }
+
+    if (deserialized_count != node_count)
+        LOG_WARN("Scene {} expected {} nodes, deserialized {}", name, node_count, deserialized_count);
+
+    // Post-Serialization pass
+    auto descendants = scene->get_scene_entity().descendants();
+    for (auto entity : descendants)
+    {
+        post_serialize_entity(entity, registry);
     }
 }
 
-void SceneLoader::deserialize_scene(const Reference<Scene>& scene, Deserializer& deserializer) const
+void SceneLoader::deserialize_legacy_scene(const Reference<Scene>& scene, const Buffer& data) const
 {
     auto& ecs_registry = scene->get_registry();
 
+    BufferStreamReader stream(data);
+    BinaryDeserializer deserializer(stream);
+
     StringId name;
     size_t node_count;
     deserializer.get_value(name);
     deserializer.get_value(node_count);
 
     for (size_t i = 0; i < node_count; ++i)
-    {
-        StringId entity_name;
-        std::string icon;
-        deserializer.get_value(entity_name);
-        deserializer.get_value(icon);
+        deserialize_entity(deserializer, ecs_registry);
 
-        auto entity = ecs_registry.find_or_create(entity_name);
-        entity.get_component<NameComponent>().icon = icon;
+    // Post-Serialization pass
+    for (auto entity : scene->get_scene_entity().descendants())
+        post_serialize_entity(entity, registry);
+}
 
-        size_t component_count;
-        deserializer.get_value(component_count);
+void SceneLoader::serialize_entity(Entity entity, Serializer& serializer, ecs::Registry& ecs_registry)
+{
+    auto& raw_registry = ecs_registry.get_raw_registry();
 
-        for (size_t j = 0; j < component_count; ++j)
+    if (entity.has_component<NameComponent>())
+    {
+        auto& [name, icon] = entity.get_component<NameComponent>();
+        serializer.add_value(name);
+        serializer.add_value(icon);
+    }
+    else
+    {
+        serializer.add_value(UNNAMED_ENTITY);
+        serializer.add_value(std::string{ICON_FA_CUBE});
+    }
+
+    auto num_comps = serializer.reserve<size_t>();
+    size_t comp_count = 0;
+    for (auto&& [type_id, storage] : raw_registry.storage())
+    {
+        auto type = entt::resolve(storage.info());
+        if (type)
         {
-            StringId component_type;
-            deserializer.get_value(component_type);
+            const auto result = type.invoke(
+                static_cast<entt::id_type>(SERIALIZE_FUNC_ID.id),
+                {},
+                entt::forward_as_meta(entity),
+                entt::forward_as_meta(serializer),
+                entt::forward_as_meta(ecs_registry)
+            );
 
-            auto type = entt::resolve(static_cast<entt::id_type>(component_type.id));
-            if (type)
+            if (!result)
             {
-                const auto result = type.invoke(
-                    static_cast<entt::id_type>(STRING_ID("deserialize").id),
-                    {},
-                    entt::forward_as_meta(entity),
-                    entt::forward_as_meta(deserializer),
-                    entt::forward_as_meta(ecs_registry)
-                );
-
-                if (!result)
-                {
-                    LOG_WARN("Failed to invoke deserialize for type: {}", type.name());
-                }
+                LOG_WARN("Failed to invoke serialize for type: {}", type.name());
+            }
+            else
+            {
+                auto result_has_comp = result.cast<bool>();
+                if (result_has_comp)
+                    ++comp_count;
             }
         }
     }
+    num_comps.write(comp_count);
+}
 
-    // Post-Serialization pass
-    auto descendants = scene->get_scene_entity().descendants();
-    for (auto entity : descendants)
+Entity SceneLoader::deserialize_entity(Deserializer& deserializer, ecs::Registry& ecs_registry, const bool replace_components)
+{
+    StringId entity_name;
+    std::string icon;
+    deserializer.get_value(entity_name);
+    deserializer.get_value(icon);
+
+    auto entity = ecs_registry.find_or_create(entity_name);
+    entity.get_component<NameComponent>().icon = icon;
+
+    size_t component_count;
+    deserializer.get_value(component_count);
+
+    llvm::SmallVector<entt::id_type, 8> component_types;
+    for (size_t j = 0; j < component_count; ++j)
     {
-        for (auto&& [type_id, storage] : ecs_registry.get_raw_registry().storage())
+        StringId component_type;
+        deserializer.get_value(component_type);
+        component_types.push_back(static_cast<entt::id_type>(component_type.id));
+
+        auto type = entt::resolve(static_cast<entt::id_type>(component_type.id));
+        if (type)
         {
-            auto type = entt::resolve(storage.info());
-            if (type)
+            const auto result = type.invoke(
+                static_cast<entt::id_type>(STRING_ID("deserialize").id),
+                {},
+                entt::forward_as_meta(entity),
+                entt::forward_as_meta(deserializer),
+                entt::forward_as_meta(ecs_registry)
+            );
+
+            if (!result)
             {
-                type.invoke(
-                    static_cast<entt::id_type>(STRING_ID("post_serialization").id),
-                    {},
-                    entt::forward_as_meta(entity),
-                    entt::forward_as_meta(registry)
-                );
+                LOG_WARN("Failed to invoke deserialize for type: {}", type.name());
             }
         }
     }
+
+    if (replace_components)
+    {
+        for (auto&& [type_id, storage] : ecs_registry.get_raw_registry().storage())
+        {
+            // Only registered components are serialized, anything else on the entity is not part of the record
+            const auto type = entt::resolve(storage.info());
+            if (type && storage.contains(entity) && std::ranges::find(component_types, type.id()) == component_types.end())
+                storage.remove(entity);
+        }
+    }
+
+    return entity;
+}
+
+void SceneLoader::post_serialize_entity(Entity entity, ResourceRegistry& resource_registry)
+{
+    for (auto&& [type_id, storage] : entity.get_registry().storage())
+    {
+        auto type = entt::resolve(storage.info());
+        if (type)
+        {
+            type.invoke(
+                static_cast<entt::id_type>(STRING_ID("post_serialization").id),
+                {},
+                entt::forward_as_meta(entity),
+                entt::forward_as_meta(resource_registry)
+            );
+        }
+    }
 }
 
 
@@ -357,9 +581,6 @@ void SceneLoader::load_portal_scene(const Reference<Scene>& scene, const Resourc
 
 void SceneLoader::load_binary_portal_scene(const Reference<Scene>& scene, const ResourceSource& source) const
 {
-    const auto stream = source.istream();
-    BinaryDeserializer deserializer(*stream);
-
-    deserialize_scene(scene, deserializer);
+    deserialize_scene(scene, source.load());
 }
 }
@@ -22,6 +22,9 @@ namespace portal::resources
 class SceneLoader final : public ResourceLoader
 {
 public:
+    /** @brief Number of scene nodes serialized by a single job */
+    constexpr static size_t SCENE_CHUNK_SIZE = 512;
+
     explicit SceneLoader(ResourceRegistry& registry);
 
     ResourceData load(const SourceMetadata& meta, Reference<ResourceSource> source) override;
@@ -30,13 +33,49 @@ public:
     void load_snapshot(const ResourceData& resource_data, Reference<ResourceSource> snapshot_source) override;
     void snapshot(const ResourceData& resource_data, Reference<ResourceSource> snapshot_source) override;
 
+    /**
+     * @brief Serializes a single scene node: its name, icon and every registered component it owns.
+     */
+    static void serialize_entity(Entity entity, Serializer& serializer, ecs::Registry& ecs_registry);
+
+    /**
+     * @brief Deserializes a single scene node written by `serialize_entity`.
+     *
+     * The entity is looked up by name and created if it does not exist, existing components are patched in place.
+     *
+     * @param replace_components Remove the registered components of an existing entity that are not in the record, so
+     * the entity ends up with exactly the components it was serialized with
+     * @return The deserialized entity
+     */
+    static Entity deserialize_entity(Deserializer& deserializer, ecs::Registry& ecs_registry, bool replace_components = false);
+
+    /**
+     * @brief Runs the post serialization pass (resolving resource references etc.) of every component of an entity.
+     */
+    static void post_serialize_entity(Entity entity, ResourceRegistry& resource_registry);
 
 protected:
-    static void archive_scene(const Reference<Scene>& scene, ArchiveObject& archive);
-    static void serialize_scene(const Reference<Scene>& scene, Serializer& serializer);
+    void archive_scene(const Reference<Scene>& scene, ArchiveObject& archive) const;
+
+    /**
+     * @brief Serializes the scene as independent chunks of `SCENE_CHUNK_SIZE` nodes, each chunk is serialized on its own job.
+     *
+     * Layout: a header (magic, version and the size of the chunk table), the chunk table (a binary serialized stream
+     * holding the scene id, node count, chunk count and the node count and byte size of every chunk), followed by the
+     * chunks themselves, each one a standalone binary serialized stream.
+     *
+     * Chunk boundaries only depend on the node count, so the output is identical regardless of the number of workers.
+     */
+    void serialize_scene(const Reference<Scene>& scene, std::ostream& output) const;
 
     void dearchive_scene(const Reference<Scene>& scene, ArchiveObject& archive) const;
-    void deserialize_scene(const Reference<Scene>& scene, Deserializer& deserializer) const;
+    /**
+     * @brief Deserializes a scene written by `serialize_scene`, chunks are applied in order on the calling thread.
+     *
+     * Scenes written before the chunked layout (no header) are read as a single stream.
+     */
+    void deserialize_scene(const Reference<Scene>& scene, const Buffer& data) const;
+    void deserialize_legacy_scene(const Reference<Scene>& scene, const Buffer& data) const;
 
     void load_portal_scene(const Reference<Scene>& scene, const ResourceSource& source) const;
     void load_binary_portal_scene(const Reference<Scene>& scene, const ResourceSource& source) const;
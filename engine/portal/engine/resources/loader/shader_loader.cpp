@@ -14,13 +14,23 @@
 #include "portal/engine/resources/resource_registry.h"
 #include "portal/engine/resources/source/resource_source.h"
 #include "portal/engine/renderer/shaders/shader.h"
+#include "portal/engine/renderer/shaders/shader_cache.h"
+#include "portal/engine/renderer/shaders/shader_compile_service.h"
 #include "portal/engine/renderer/vulkan/vulkan_shader.h"
 
 namespace portal::resources
 {
 static auto logger = Log::get_logger("Resources");
 
-ShaderLoader::ShaderLoader(ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context) : ResourceLoader(registry), context(context)
+ShaderLoader::ShaderLoader(ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context) :
+    ResourceLoader(registry),
+    context(context),
+    compile_service(
+        std::make_shared<renderer::ShaderCompileService>(
+            registry.get_scheduler(),
+            std::make_shared<renderer::ShaderCache>(FileSystem::get_cache_dir("portal") / "shaders")
+        )
+    )
 {}
 
 ResourceData ShaderLoader::load(const SourceMetadata& meta, const Reference<ResourceSource> source)
@@ -40,38 +50,23 @@ Reference<Resource> ShaderLoader::load_shader(const SourceMetadata& meta, const
 {
     auto shader = make_reference<renderer::vulkan::VulkanShader>(meta.resource_id, context);
     auto& project = registry.get_project();
-    shader->load_source(source.load(), meta.full_source_path.string, project.get_engine_resource_directory() / "shaders");
+    shader->load_source(source.load(), meta.full_source_path.string, project.get_engine_resource_directory() / "shaders", compile_service);
     return shader;
 }
 
-Reference<Resource> ShaderLoader::load_precompiled_shader(const SourceMetadata&, const ResourceSource&) const
+Reference<Resource> ShaderLoader::load_precompiled_shader(const SourceMetadata& meta, const ResourceSource& source) const
 {
-    // TODO: load shader cache from disk / memory
-    // const auto builder = vulkan::DescriptorLayoutBuilder{}
-    //                      .add_binding(0, vk::DescriptorType::eUniformBuffer)
-    //                      .add_binding(1, vk::DescriptorType::eCombinedImageSampler)
-    //                      .add_binding(2, vk::DescriptorType::eCombinedImageSampler);
-    // shader->descriptor_layout = std::make_shared<vk::raii::DescriptorSetLayout>(
-    //     context->create_descriptor_set_layout(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment, builder)
-    //     );
-    // shader->code = Buffer::copy(data);
-    //
-    // shader->shader_data[vk::ShaderStageFlagBits::eVertex] = {
-    //     .push_constant_range = vk::PushConstantRange{
-    //         .stageFlags = vk::ShaderStageFlagBits::eVertex,
-    //         .offset = 0,
-    //         .size = sizeof(vulkan::GPUDrawPushConstants)
-    //     },
-    //     .shader_module = std::make_shared<vk::raii::ShaderModule>(context->create_shader_module(shader->code)),
-    //     .entry_point.h = "vert_main"
-    // };
-    //
-    // shader->shader_data[vk::ShaderStageFlagBits::eFragment] = {
-    //     .push_constant_range = {},
-    //     .shader_module = std::make_shared<vk::raii::ShaderModule>(context->create_shader_module(shader->code)),
-    //     .entry_point.h = "frag_main"
-    // };
+    // Raw SPIR-V has no reflection to build descriptor layouts from, precompiled shaders are shader cache entries.
+    // They are loaded by resource id, so whatever key they were compiled under is accepted.
+    auto compiled = renderer::ShaderCache::read_entry(source.load(), std::nullopt);
+    if (!compiled)
+    {
+        LOGGER_ERROR("Failed to load precompiled shader {}, it is not a shader cache entry", meta.resource_id);
+        return nullptr;
+    }
 
-    return nullptr;
+    auto shader = make_reference<renderer::vulkan::VulkanShader>(meta.resource_id, context);
+    shader->load_compiled(std::move(compiled.value()));
+    return shader;
 }
 } // portal
@@ -11,6 +11,11 @@
 namespace portal
 {
 class RendererContext;
+
+namespace renderer
+{
+    class ShaderCompileService;
+}
 }
 
 
@@ -30,5 +35,6 @@ protected:
 
 private:
     const renderer::vulkan::VulkanContext& context;
+    std::shared_ptr<renderer::ShaderCompileService> compile_service;
 };
 } // portal
@@ -14,6 +14,7 @@
 #include "portal/engine/renderer/vulkan/vulkan_context.h"
 #include "portal/engine/renderer/vulkan/image/vulkan_texture.h"
 #include "portal/engine/resources/resource_registry.h"
+#include "portal/engine/resources/cook/cooked_resource.h"
 #include "portal/engine/resources/database/resource_database.h"
 #include "portal/engine/resources/source/resource_source.h"
 #include "portal/engine/renderer/image/image.h"
@@ -22,6 +23,15 @@ namespace portal::resources
 {
 static auto logger = Log::get_logger("Resources");
 
+// Cooked and decoded textures must sample the same, cooking a texture should not change how it looks
+static std::optional<renderer::SamplerProperties> get_sampler_properties(const SourceMetadata& meta)
+{
+    // TODO: get sampler info from metadata
+    if (meta.format != SourceFormat::Memory)
+        return renderer::SamplerProperties{.filter = renderer::TextureFilter::Linear};
+    return std::nullopt;
+}
+
 
 TextureLoader::TextureLoader(ResourceRegistry& registry, const renderer::vulkan::VulkanContext& context) : ResourceLoader(registry), context(context)
 {
@@ -65,6 +75,23 @@ TextureLoader::TextureLoader(ResourceRegistry& registry, const renderer::vulkan:
 ResourceData TextureLoader::load(const SourceMetadata& meta, Reference<ResourceSource> source)
 {
     auto data = source->load();
+
+    // Cooked textures are already decoded and hold their whole mip chain, they are only copied to the GPU
+    if (const auto cooked = read_cooked_texture(data))
+    {
+        const renderer::TextureProperties properties = {
+            .format = cooked->format,
+            .width = cooked->width,
+            .height = cooked->height,
+            .depth = 1,
+            .sampler_prop = get_sampler_properties(meta),
+            .precomputed_mips = cooked->mip_count
+        };
+
+        auto texture = make_reference<renderer::vulkan::VulkanTexture>(meta.resource_id, properties, cooked->data, context);
+        return ResourceData{texture, source, meta};
+    }
+
     int width, height, n_channels;
     void* image_data = nullptr;
     renderer::ImageFormat format;
@@ -89,21 +116,14 @@ ResourceData TextureLoader::load(const SourceMetadata& meta, Reference<ResourceS
         return ResourceData{};
     }
 
-    renderer::TextureProperties properties = {
+    const renderer::TextureProperties properties = {
         .format = format,
         .width = static_cast<size_t>(width),
         .height = static_cast<size_t>(height),
-        .depth = 1
+        .depth = 1,
+        .sampler_prop = get_sampler_properties(meta)
     };
 
-    if (meta.format != SourceFormat::Memory)
-    {
-        properties.sampler_prop = {
-            .filter = renderer::TextureFilter::Linear
-        };
-    }
-    // TODO: get sampler info from metadata
-
     auto texture = make_reference<renderer::vulkan::VulkanTexture>(meta.resource_id, properties, Buffer{image_data, size}, context);
 
     stbi_image_free(image_data);
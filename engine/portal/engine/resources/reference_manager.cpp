@@ -5,57 +5,87 @@
 
 #include "reference_manager.h"
 
-#include "resource_reference.h"
+#include <mutex>
+
+#include "portal/core/log.h"
 
 namespace portal
 {
 static auto logger = Log::get_logger("Resources");
 
-ReferenceManager::~ReferenceManager()
+ReferenceList::ReferenceList()
 {
-    [[maybe_unused]] bool ok = true;
-    for (auto& [ref, set] : references)
-    {
-        if (!set.empty())
-        {
-            LOG_ERROR("Reference manager destroyed with {} references still registered for reference: {}", set.size(), ref);
-            ok = false;
-        }
-    }
-
-    PORTAL_ASSERT(ok, "Reference manager destroyed with references still registered");
+    head.previous = &head;
+    head.next = &head;
 }
 
-void ReferenceManager::register_reference(const StringId& id, void* reference)
+void ReferenceList::link(ReferenceNode& node)
 {
+    PORTAL_ASSERT(!node.is_linked(), "Reference is already registered");
+
     std::lock_guard guard(lock);
-    references[id].insert(reference);
+    node.previous = &head;
+    node.next = head.next;
+    head.next->previous = &node;
+    head.next = &node;
+    count.fetch_add(1, std::memory_order_release);
 }
 
-void ReferenceManager::unregister_reference(const StringId& id, void* reference)
+void ReferenceList::unlink(ReferenceNode& node)
 {
-    if (id == INVALID_STRING_ID)
-        return;
-
-    std::lock_guard guard(lock);
-    if (!references.contains(id))
+    if (!node.is_linked())
     {
-        LOG_WARN("Attempted to unregister reference for resource handle {} that does not exist", id);
+        LOG_WARN("Attempted to unregister a reference that is not registered");
         return;
     }
-    if (!references.at(id).contains(reference))
+
+    std::lock_guard guard(lock);
+    node.previous->next = node.next;
+    node.next->previous = node.previous;
+    node.previous = nullptr;
+    node.next = nullptr;
+    count.fetch_sub(1, std::memory_order_release);
+}
+
+void ReferenceList::replace(ReferenceNode& old_node, ReferenceNode& new_node)
+{
+    PORTAL_ASSERT(old_node.is_linked(), "Replaced reference is not registered");
+    PORTAL_ASSERT(!new_node.is_linked(), "Reference is already registered");
+
+    std::lock_guard guard(lock);
+    new_node.previous = old_node.previous;
+    new_node.next = old_node.next;
+    new_node.previous->next = &new_node;
+    new_node.next->previous = &new_node;
+    old_node.previous = nullptr;
+    old_node.next = nullptr;
+}
+
+ReferenceManager::~ReferenceManager()
+{
+    [[maybe_unused]] bool ok = true;
+    for (auto& [ref, list] : references)
     {
-        LOG_WARN("Attempted to unregister reference for resource handle {} that does not exist", id);
-        return;
+        if (list.size() != 0)
+        {
+            LOG_ERROR("Reference manager destroyed with {} references still registered for reference: {}", list.size(), ref);
+            ok = false;
+        }
     }
 
-    references[id].erase(reference);
+    PORTAL_ASSERT(ok, "Reference manager destroyed with references still registered");
+}
+
+ReferenceList& ReferenceManager::get_references(const StringId& id)
+{
+    std::lock_guard guard(lock);
+    return references.try_emplace(id).first->second;
 }
 
-void ReferenceManager::move_reference(const StringId& id, void* old_ref, void* new_ref)
+size_t ReferenceManager::get_reference_count(const StringId& id)
 {
     std::lock_guard guard(lock);
-    unregister_reference(id, old_ref);
-    register_reference(id, new_ref);
+    const auto it = references.find(id);
+    return it == references.end() ? 0 : it->second.size();
 }
 } // portal
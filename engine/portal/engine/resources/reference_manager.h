@@ -5,56 +5,84 @@
 
 #pragma once
 
+#include <atomic>
+#include <unordered_map>
 #include <unordered_set>
 
-#include "llvm/ADT/DenseMap.h"
-#include "llvm/ADT/SmallSet.h"
 #include "portal/application/modules/module.h"
-#include "portal/core/concurrency/reentrant_spin_lock.h"
 #include "portal/core/concurrency/spin_lock.h"
 
 #include "resources/resource.h"
 
 namespace portal
 {
-class ReferenceManager
+/**
+ * Intrusive node embedded in every registered `ResourceReference`, linking it into the `ReferenceList` of its resource.
+ */
+struct ReferenceNode
+{
+    ReferenceNode* previous = nullptr;
+    ReferenceNode* next = nullptr;
+
+    [[nodiscard]] bool is_linked() const { return next != nullptr; }
+};
+
+/**
+ * The references to a single resource, as an intrusive circular list.
+ *
+ * Linking, unlinking and replacing a node are O(1) and never allocate, the only cost is the list's spin lock, which is
+ * only shared by references to the same resource. Lists live in the `ReferenceManager` at a stable address, references
+ * keep a pointer to theirs.
+ */
+class ReferenceList
 {
 public:
-    ~ReferenceManager();
+    ReferenceList();
+
+    ReferenceList(const ReferenceList&) = delete;
+    ReferenceList& operator=(const ReferenceList&) = delete;
+
+    void link(ReferenceNode& node);
+    void unlink(ReferenceNode& node);
 
     /**
-     * Registers a new reference for the reference counting
-     * @note we are using void* here because `ResourceReference` is a template function, and we don't need to access it directly from the registry
-     *
-     * @param id the handle to the resource in the registry
-     * @param reference a void* pointer to the reference.
+     * Puts `new_node` in the place of `old_node`, the same as calling `unlink(old) link(new)` but makes sure that the
+     * list is never empty in between (used in the ResourceReference move operators)
      */
-    void register_reference(const StringId& id, void* reference);
+    void replace(ReferenceNode& old_node, ReferenceNode& new_node);
+
+    [[nodiscard]] size_t size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    SpinLock lock;
+    ReferenceNode head;
+    std::atomic<size_t> count = 0;
+};
+
+/**
+ * Tracks every `ResourceReference` to each resource, used by the registry to know which resources are still in use.
+ */
+class ReferenceManager
+{
+public:
+    ~ReferenceManager();
 
     /**
-     * Removes a reference from the reference counting
+     * Returns the reference list of a resource, creating it if needed. The list lives as long as the manager.
      *
-    * @param id the handle to the resource in the registry
-     * @param reference a void* pointer to the reference.
+     * @param id the handle to the resource in the registry
      */
-    void unregister_reference(const StringId& id, void* reference);
+    ReferenceList& get_references(const StringId& id);
 
     /**
-     * Switches between two references in the reference counting, the same as calling `unregister(old) register(new)` but makes sure that there is always
-     * a valid reference (used in the ResourceReference move operators)
+     * Returns the number of references registered for a resource
      *
      * @param id The resource handle
-     * @param old_ref The old reference (as a void*)
-     * @param new_ref The new reference (as a void*)
      */
-    void move_reference(const StringId& id, void* old_ref, void* new_ref);
+    [[nodiscard]] size_t get_reference_count(const StringId& id);
 
 private:
-    ReentrantSpinLock<> lock;
-#ifdef PORTAL_DEBUG
-    std::unordered_map<StringId, std::unordered_set<void*>> references;
-#else
-    llvm::DenseMap<StringId, llvm::SmallSet<void*, 16>> references;
-#endif
+    SpinLock lock;
+    std::unordered_map<StringId, ReferenceList> references;
 };
 } // portal
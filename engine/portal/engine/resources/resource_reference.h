@@ -42,11 +42,13 @@ namespace portal
  * resource lives in the ResourceRegistry's internal storage. Multiple references can
  * point to the same resource, and references are cheap to copy.
  *
- * **Lazy State Synchronization**:
- * References cache their state (Unknown/Pending/Loaded/Error) and only query the
- * registry when needed. Calling get_state() or is_valid() triggers a registry lookup
- * if the cached state isn't Loaded. This avoids redundant lookups and enables efficient
- * state polling.
+ * **Lock Free State Checks**:
+ * Each reference points to the ResourceSlot of its resource, which the registry updates on
+ * every state transition. Calling get_state() or is_valid() is a single atomic load of the
+ * slot, the cached resource pointer is only refreshed (under the slot lock) when the slot's
+ * generation changes, so polling a loaded resource every frame never touches the registry lock.
+ * State checks also mark the resource as used for the registry's memory budgets, and load
+ * back resources that were evicted.
  *
  * **Reference Counting**:
  * The ReferenceManager tracks how many ResourceReferences point to each resource. This
@@ -54,9 +56,9 @@ namespace portal
  * Copy/move operations automatically update the reference counts.
  *
  * **Thread Safety**:
- * State queries are thread-safe. The registry uses internal locking to ensure state
- * transitions are atomic. However, the underlying resource (accessed via get()) must
- * be used in accordance with its own thread-safety guarantees.
+ * State queries are thread-safe. The registry publishes state transitions atomically into
+ * the slot. However, the underlying resource (accessed via get()) must be used in accordance
+ * with its own thread-safety guarantees.
  *
  * Distinction from Reference<T>:
  *
@@ -146,8 +148,8 @@ public:
 
     ~ResourceReference()
     {
-        if (resource_id != INVALID_STRING_ID && reference_manager.has_value())
-            reference_manager.value().get().unregister_reference(resource_id, this);
+        if (reference_list)
+            reference_list->unlink(reference_node);
     }
 
     ResourceReference(const ResourceReference& other) :
@@ -157,14 +159,18 @@ public:
         resource_name(other.resource_name),
         type(other.type),
         state(other.state),
-        resource(other.resource)
+        resource(other.resource),
+        slot(other.slot),
+        generation(other.generation),
+        reference_list(other.reference_list)
     {
         PORTAL_ASSERT(resource_id != INVALID_STRING_ID, "Resource handle is invalid");
         PORTAL_ASSERT(reference_manager.has_value(), "Invalid reference manager");
         PORTAL_ASSERT(registry.has_value(), "Invalid resource registry");
         PORTAL_ASSERT(state != ResourceState::Loaded || resource != nullptr, "Resource is empty");
 
-        reference_manager.value().get().register_reference(resource_id, this);
+        if (reference_list)
+            reference_list->link(reference_node);
     }
 
     ResourceReference(ResourceReference&& other) noexcept :
@@ -174,7 +180,10 @@ public:
         resource_name(std::exchange(other.resource_name, STRING_ID("Unnamed"))),
         type(std::exchange(other.type, ResourceType::Unknown)),
         state(std::exchange(other.state, ResourceState::Unknown)),
-        resource(std::exchange(other.resource, nullptr))
+        resource(std::exchange(other.resource, nullptr)),
+        slot(std::exchange(other.slot, nullptr)),
+        generation(std::exchange(other.generation, 0)),
+        reference_list(std::exchange(other.reference_list, nullptr))
     {
         if (state != ResourceState::Null && state != ResourceState::Missing)
         {
@@ -182,9 +191,10 @@ public:
             PORTAL_ASSERT(reference_manager.has_value(), "Invalid reference manager");
             PORTAL_ASSERT(registry.has_value(), "Invalid resource registry");
             PORTAL_ASSERT(state != ResourceState::Loaded || resource != nullptr, "Resource is empty");
-
-            reference_manager.value().get().move_reference(resource_id, &other, this);
         }
+
+        if (reference_list)
+            reference_list->replace(other.reference_node, reference_node);
     }
 
     ResourceReference& operator=(const ResourceReference& other)
@@ -192,9 +202,8 @@ public:
         if (&other == this)
             return *this;
 
-
-        if (reference_manager.has_value())
-            reference_manager.value().get().unregister_reference(resource_id, this);
+        if (reference_list)
+            reference_list->unlink(reference_node);
 
         PORTAL_ASSERT((type == ResourceType::Unknown || other.type == ResourceType::Unknown) || type == other.type, "Resource types don't match");
 
@@ -203,15 +212,18 @@ public:
         type = other.type;
         state = other.state;
         resource = other.resource;
+        slot = other.slot;
+        generation = other.generation;
         reference_manager = other.reference_manager;
         registry = other.registry;
+        reference_list = other.reference_list;
 
         PORTAL_ASSERT(reference_manager.has_value(), "Invalid reference manager");
         PORTAL_ASSERT(registry.has_value(), "Invalid resource registry");
         PORTAL_ASSERT(state != ResourceState::Loaded || resource != nullptr, "Resource is empty");
 
-        if (resource_id != INVALID_STRING_ID && reference_manager.has_value())
-            reference_manager.value().get().register_reference(resource_id, this);
+        if (reference_list)
+            reference_list->link(reference_node);
         return *this;
     }
 
@@ -220,8 +232,8 @@ public:
         if (&other == this)
             return *this;
 
-        if (reference_manager.has_value())
-            reference_manager.value().get().unregister_reference(resource_id, this);
+        if (reference_list)
+            reference_list->unlink(reference_node);
 
         PORTAL_ASSERT((type == ResourceType::Unknown || other.type == ResourceType::Unknown) || type == other.type, "Resource types don't match");
 
@@ -230,19 +242,22 @@ public:
         type = std::exchange(other.type, ResourceType::Unknown);
         state = std::exchange(other.state, ResourceState::Unknown);
         resource = std::exchange(other.resource, nullptr);
+        slot = std::exchange(other.slot, nullptr);
+        generation = std::exchange(other.generation, 0);
         reference_manager = std::exchange(other.reference_manager, std::nullopt);
         registry = std::exchange(other.registry, std::nullopt);
+        reference_list = std::exchange(other.reference_list, nullptr);
 
         if (state != ResourceState::Null && state != ResourceState::Missing)
         {
             PORTAL_ASSERT(reference_manager.has_value(), "Invalid reference manager");
             PORTAL_ASSERT(registry.has_value(), "Invalid resource registry");
             PORTAL_ASSERT(state != ResourceState::Loaded || resource != nullptr, "Resource is empty");
-
-            if (resource_id != INVALID_STRING_ID && reference_manager.has_value())
-                reference_manager.value().get().move_reference(resource_id, &other, this);
         }
 
+        if (reference_list)
+            reference_list->replace(other.reference_node, reference_node);
+
         return *this;
     }
 
@@ -254,23 +269,18 @@ public:
      */
     ResourceState get_state() const
     {
-        if (state == ResourceState::Null)
+        if (state == ResourceState::Null || slot == nullptr)
             return state;
 
-        // Check the state only when not yet loaded
-        if (state != ResourceState::Loaded)
+        // The cached resource is still the one in the slot as long as the generation did not change
+        const auto status = slot->get_status();
+        if (state == ResourceState::Loaded && status.state == ResourceState::Loaded && status.generation == generation)
         {
-            const auto result = registry->get().get_resource(resource_id);
-            if (result.has_value())
-            {
-                resource = reference_cast<T, Resource>(result.value());
-                if (!resource)
-                    LOG_ERROR_TAG("Resource", "Failed to cast resource \"{}\" to type \"{}\"", resource_id, T::static_type());
-            }
-
-            state = result.error_or(ResourceState::Loaded);
+            slot->touch();
+            return state;
         }
-        return state;
+
+        return refresh_state(status);
     }
 
     ResourceDirtyFlags get_dirty() const
@@ -412,7 +422,9 @@ private:
     {
         if (resource_id != INVALID_STRING_ID)
         {
-            reference_manager.register_reference(resource_id, this);
+            reference_list = &reference_manager.get_references(resource_id);
+            reference_list->link(reference_node);
+            slot = &registry.get_slot(resource_id);
             get_state();
         }
         else
@@ -421,6 +433,43 @@ private:
         }
     }
 
+    /**
+     * Slow path of `get_state`, updates the cached state and resource from the slot.
+     */
+    ResourceState refresh_state(ResourceSlot::Status status) const
+    {
+        // Missing is the only state the registry does not publish a way out of, a resource might have been added to
+        // the database since. Querying the registry republishes the slot.
+        if (status.state == ResourceState::Missing)
+        {
+            std::ignore = registry->get().get_resource(resource_id);
+            status = slot->get_status();
+        }
+
+        // The resource was evicted to meet a memory budget, accessing it loads it back
+        if (status.evicted)
+        {
+            registry->get().reload_evicted(resource_id);
+            status = slot->get_status();
+        }
+
+        if (status.state != ResourceState::Loaded)
+        {
+            resource = nullptr;
+            state = status.state;
+            return state;
+        }
+
+        auto [slot_resource, slot_status] = slot->get_resource();
+        generation = slot_status.generation;
+        state = slot_status.state;
+        resource = reference_cast<T, Resource>(slot_resource);
+        slot->touch();
+        if (state == ResourceState::Loaded && !resource)
+            LOG_ERROR_TAG("Resource", "Failed to cast resource \"{}\" to type \"{}\"", resource_id, T::static_type());
+        return state;
+    }
+
 private:
     std::optional<std::reference_wrapper<ReferenceManager>> reference_manager = std::nullopt;
     std::optional<std::reference_wrapper<ResourceRegistry>> registry = std::nullopt;
@@ -431,6 +480,14 @@ private:
 
     mutable ResourceState state = ResourceState::Null;
     mutable Reference<T> resource = nullptr;
+
+    // Owned by the registry, outlives the reference
+    const ResourceSlot* slot = nullptr;
+    mutable uint32_t generation = 0;
+
+    // Owned by the reference manager, the node is per object and is never copied or moved
+    ReferenceList* reference_list = nullptr;
+    ReferenceNode reference_node;
 };
 }
 
@@ -5,17 +5,40 @@
 
 #include "resource_registry.h"
 
+#include <array>
+#include <deque>
 #include <ranges>
 
+#include "portal/core/debug/profile.h"
 #include "portal/engine/modules/system_orchestrator.h"
+#include "portal/engine/project/project.h"
 #include "portal/engine/renderer/renderer_context.h"
 #include "portal/engine/resources/source/file_source.h"
 #include "source/memory_source.h"
+#include "source/prefetched_source.h"
 
 namespace portal
 {
 static auto logger = Log::get_logger("Resources");
 
+namespace
+{
+    constexpr std::array BUDGETED_TYPES{
+        ResourceType::Material,
+        ResourceType::Texture,
+        ResourceType::Shader,
+        ResourceType::Mesh,
+        ResourceType::Scene,
+        ResourceType::Font,
+        ResourceType::EnvironmentMap
+    };
+
+    bool is_within_budget(const ResourceMemoryUsage& usage, const ResourceBudget& budget)
+    {
+        return (budget.cpu_bytes == 0 || usage.cpu_bytes <= budget.cpu_bytes) && (budget.gpu_bytes == 0 || usage.gpu_bytes <= budget.gpu_bytes);
+    }
+}
+
 ResourceRegistry::ResourceRegistry(
     const Project& project,
     ecs::Registry& ecs_registry,
@@ -34,16 +57,63 @@ ResourceRegistry::ResourceRegistry(
         *this,
         context
     )
-{}
+{
+    read_budgets();
+}
+
+ResourceRegistry::ResourceRegistry(
+    const Project& project,
+    ecs::Registry& ecs_registry,
+    jobs::Scheduler& scheduler,
+    ResourceDatabase& database,
+    ReferenceManager& reference_manager
+) :
+    project(project),
+    ecs_registry(ecs_registry),
+    scheduler(scheduler),
+    database(database),
+    reference_manager(reference_manager),
+    loader_factory(*this)
+{
+    read_budgets();
+}
+
+void ResourceRegistry::read_budgets()
+{
+    auto& settings = project.get_settings();
+    frames_in_flight = settings.get_setting<size_t>("application.frames_in_flight", 3);
+
+    constexpr size_t megabyte = 1024 * 1024;
+    for (const auto type : BUDGETED_TYPES)
+    {
+        const auto prefix = fmt::format("resources.budgets.{}", to_lower_copy(to_string(type)));
+        const ResourceBudget budget{
+            .cpu_bytes = settings.get_setting<size_t>(fmt::format("{}.cpu_mb", prefix), 0) * megabyte,
+            .gpu_bytes = settings.get_setting<size_t>(fmt::format("{}.gpu_mb", prefix), 0) * megabyte,
+        };
+
+        if (budget.cpu_bytes != 0 || budget.gpu_bytes != 0)
+            budgets[type] = budget;
+    }
+}
+
+void ResourceRegistry::set_loader(const ResourceType type, std::shared_ptr<resources::ResourceLoader> loader)
+{
+    loader_factory.set_loader(type, std::move(loader));
+}
 
 ResourceRegistry::~ResourceRegistry() noexcept
 {
+    retired_resources.clear();
+
     std::unordered_map<StringId, WeakReference<Resource>> weak_resources;
     weak_resources.reserve(resources.size());
     for (auto& [resource_name, ref] : resources)
         weak_resources[resource_name] = ref.resource;
 
     resources.clear();
+    for (auto& slot : slots | std::views::values)
+        slot.publish(ResourceState::Unloaded);
 
     for (auto& [resource_name, ref] : weak_resources)
     {
@@ -94,7 +164,13 @@ Job<resources::ResourceData> ResourceRegistry::load_direct(SourceMetadata meta,
     }
 
     std::lock_guard guard(lock);
-    resources[meta.resource_id] = resource_data;
+    auto& entry = resources[meta.resource_id];
+    // The resource is being reloaded, frames in flight might still use the previous version
+    if (entry.resource && entry.resource != resource_data.resource)
+        retired_resources.emplace_back(residency_frame, std::move(entry.resource));
+    entry = resource_data;
+    track_memory_locked(meta.resource_id);
+    refresh_slot_locked(meta.resource_id);
     co_return resource_data;
 }
 
@@ -161,20 +237,463 @@ void ResourceRegistry::load_snapshot(const StringId& resource_id, Buffer snapsho
 std::expected<Reference<Resource>, ResourceState> ResourceRegistry::get_resource(const StringId& id)
 {
     std::lock_guard guard(lock);
-    if (resources.contains(id))
-        return resources.at(id).resource;
+    if (const auto it = resources.find(id); it != resources.end())
+        return it->second.resource;
+
+    const auto state = find_state_locked(id);
+    if (state == ResourceState::Missing)
+        LOG_ERROR("Attempted to get resource with handle {} that does not exist", id);
+
+    // The database may have changed since the slot was last published
+    refresh_slot_locked(id);
+    return std::unexpected{state};
+}
+
+ResourceState ResourceRegistry::find_state_locked(const StringId& resource_id) const
+{
+    if (pending_resources.contains(resource_id))
+        return ResourceState::Pending;
+
+    if (errored_resources.contains(resource_id))
+        return ResourceState::Error;
+
+    if (database.find(resource_id).has_value())
+        return ResourceState::Unloaded;
+
+    return ResourceState::Missing;
+}
+
+ResourceSlot& ResourceRegistry::get_slot(const StringId& resource_id)
+{
+    std::lock_guard guard(lock);
+    auto [it, inserted] = slots.try_emplace(resource_id);
+    if (inserted)
+        refresh_slot_locked(resource_id);
+    return it->second;
+}
+
+void ResourceRegistry::refresh_slot_locked(const StringId& resource_id)
+{
+    const auto slot_it = slots.find(resource_id);
+    if (slot_it == slots.end())
+        return;
+
+    auto& slot = slot_it->second;
+    if (const auto it = resources.find(resource_id); it != resources.end())
+    {
+        // Publishing bumps the generation, only do it when the resource changed, so references keep their cached resource
+        const auto& resource = it->second.resource;
+        if (slot.get_state() != ResourceState::Loaded || slot.get_resource().first != resource)
+            slot.publish(resource);
+        return;
+    }
+
+    const auto state = find_state_locked(resource_id);
+    const bool evicted = state == ResourceState::Unloaded && evicted_resources.contains(resource_id);
+    if (const auto status = slot.get_status(); status.state != state || status.evicted != evicted)
+        slot.publish(state, evicted);
+}
+
+void ResourceRegistry::set_budget(const ResourceType type, const ResourceBudget& budget)
+{
+    std::lock_guard guard(lock);
+    budgets[type] = budget;
+}
+
+ResourceBudget ResourceRegistry::get_budget(const ResourceType type)
+{
+    std::lock_guard guard(lock);
+    const auto it = budgets.find(type);
+    return it == budgets.end() ? ResourceBudget{} : it->second;
+}
+
+ResourceMemoryUsage ResourceRegistry::get_memory_usage(const ResourceType type)
+{
+    std::lock_guard guard(lock);
+    const auto it = memory_usage.find(type);
+    return it == memory_usage.end() ? ResourceMemoryUsage{} : it->second;
+}
+
+void ResourceRegistry::update_residency()
+{
+    PORTAL_PROF_ZONE();
+
+    // Destroyed after the lock is released, destroying resources frees GPU memory
+    std::vector<Reference<Resource>> released;
+
+    std::lock_guard guard(lock);
+    ++residency_frame;
+
+    while (!retired_resources.empty() && residency_frame - retired_resources.front().first > frames_in_flight)
+    {
+        released.push_back(std::move(retired_resources.front().second));
+        retired_resources.pop_front();
+    }
+
+    for (auto& [resource_id, entry] : residency)
+    {
+        if (const auto slot = slots.find(resource_id); slot != slots.end() && slot->second.consume_access())
+            entry.last_used = residency_frame;
+    }
+
+    for (const auto& [type, budget] : budgets)
+    {
+        if (!is_within_budget(memory_usage[type], budget))
+            evict_to_budget_locked(type, budget);
+    }
+}
+
+void ResourceRegistry::reload_evicted(const StringId& resource_id)
+{
+    {
+        std::lock_guard guard(lock);
+        // Only the first access after the eviction loads the resource back
+        if (!evicted_resources.erase(resource_id))
+            return;
+        refresh_slot_locked(resource_id);
+    }
+
+    LOGGER_TRACE("Reloading evicted resource: {}", resource_id);
+    create_resource(resource_id, ResourceType::Unknown);
+}
+
+void ResourceRegistry::update_sources()
+{
+    PORTAL_PROF_ZONE();
+
+    const auto changed = database.poll_changes();
+
+    std::vector<StringId> batch;
+    {
+        std::lock_guard guard(lock);
+        for (const auto& resource_id : changed)
+        {
+            // The change might have fixed a resource that failed to load, or added or removed it from the database
+            errored_resources.erase(resource_id);
+            refresh_slot_locked(resource_id);
+
+            if (can_reload_locked(resource_id))
+                stale_resources.insert(resource_id);
+        }
+
+        if (!changed.empty())
+            mark_dependents_stale_locked();
+
+        if (reload_running || stale_resources.empty())
+            return;
+
+        for (const auto& resource_id : stale_resources)
+        {
+            // Resources that are still loading might have read the previous source, they are reloaded once loaded
+            if (!pending_resources.contains(resource_id))
+                batch.push_back(resource_id);
+        }
+
+        for (const auto& resource_id : batch)
+            stale_resources.erase(resource_id);
+
+        if (batch.empty())
+            return;
+        reload_running = true;
+    }
+
+    LOGGER_DEBUG("Reloading {} changed resources", batch.size());
+    scheduler.dispatch_job(reload_resources(std::move(batch)), JobPriority::Low);
+}
+
+bool ResourceRegistry::is_reloading(const StringId& resource_id)
+{
+    std::lock_guard guard(lock);
+    return reloading_resources.contains(resource_id);
+}
+
+bool ResourceRegistry::can_reload_locked(const StringId& resource_id) const
+{
+    if (pending_resources.contains(resource_id))
+        return true;
+
+    const auto it = resources.find(resource_id);
+    if (it == resources.end())
+        return false;
+
+    if (it->second.dirty != ResourceDirtyBits::Clean)
+    {
+        LOGGER_WARN("Not reloading {}, it has unsaved changes", resource_id);
+        return false;
+    }
+    return true;
+}
+
+void ResourceRegistry::mark_dependents_stale_locked()
+{
+    std::unordered_map<StringId, llvm::SmallVector<StringId>> dependents;
+    for (const auto& [resource_id, resource_data] : resources)
+    {
+        for (const auto& dependency : resource_data.metadata.dependencies)
+            dependents[dependency].push_back(resource_id);
+    }
+
+    std::deque<StringId> queue(stale_resources.begin(), stale_resources.end());
+    while (!queue.empty())
+    {
+        const auto resource_id = queue.front();
+        queue.pop_front();
+
+        const auto it = dependents.find(resource_id);
+        if (it == dependents.end())
+            continue;
+
+        for (const auto& dependent : it->second)
+        {
+            if (!stale_resources.contains(dependent) && can_reload_locked(dependent))
+            {
+                stale_resources.insert(dependent);
+                queue.push_back(dependent);
+            }
+        }
+    }
+}
+
+Job<> ResourceRegistry::reload_resources(std::vector<StringId> resource_ids)
+{
+    PORTAL_PROF_ZONE();
+
+    /**
+     * A resource to load again. Resources inside of a composite share the node of the composite, as loading the
+     * composite loads all of them.
+     */
+    struct ReloadNode
+    {
+        SourceMetadata meta;
+        llvm::SmallVector<StringId> resource_ids;
+        llvm::SmallVector<StringId> dependency_ids;
+    };
+
+    std::vector<ReloadNode> nodes;
+    std::unordered_map<StringId, size_t> node_by_load_id;
+    std::unordered_map<StringId, size_t> node_by_resource_id;
+    for (const auto& resource_id : resource_ids)
+    {
+        const auto meta = database.find(resource_id);
+        if (!meta)
+        {
+            LOGGER_WARN("Not reloading {}, it was removed from the database", resource_id);
+            continue;
+        }
+
+        const auto load_meta = resolve_load_metadata(*meta);
+        const auto [it, inserted] = node_by_load_id.try_emplace(load_meta.resource_id, nodes.size());
+        if (inserted)
+        {
+            auto& node = nodes.emplace_back(ReloadNode{.meta = load_meta});
+            node.resource_ids.push_back(load_meta.resource_id);
+            node.dependency_ids.append(load_meta.dependencies.begin(), load_meta.dependencies.end());
+            node_by_resource_id[load_meta.resource_id] = it->second;
+
+            // The whole composite is loaded again, not only the parts that changed
+            if (load_meta.type == ResourceType::Composite)
+            {
+                for (const auto& child : std::get<CompositeMetadata>(load_meta.meta).children | std::views::values)
+                {
+                    node.resource_ids.push_back(child.resource_id);
+                    node.dependency_ids.append(child.dependencies.begin(), child.dependencies.end());
+                    node_by_resource_id[child.resource_id] = it->second;
+                }
+            }
+        }
+
+        auto& node = nodes[it->second];
+        if (!node_by_resource_id.contains(resource_id))
+        {
+            node.resource_ids.push_back(resource_id);
+            node.dependency_ids.append(meta->dependencies.begin(), meta->dependencies.end());
+            node_by_resource_id[resource_id] = it->second;
+        }
+    }
+
+    std::vector<llvm::SmallVector<size_t>> dependents(nodes.size());
+    std::vector<size_t> in_degree(nodes.size(), 0);
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        llvm::DenseSet<size_t> dependencies;
+        for (const auto& dependency_id : nodes[index].dependency_ids)
+        {
+            // Only dependencies that are reloaded as well gate the reload
+            const auto it = node_by_resource_id.find(dependency_id);
+            if (it == node_by_resource_id.end() || it->second == index || !dependencies.insert(it->second).second)
+                continue;
+
+            dependents[it->second].push_back(index);
+            ++in_degree[index];
+        }
+    }
+
+    {
+        std::lock_guard guard(lock);
+        for (const auto& node : nodes)
+            reloading_resources.insert(node.resource_ids.begin(), node.resource_ids.end());
+    }
+
+    // Reloaded in waves, every wave only depends on the waves before it
+    std::vector<bool> reloaded(nodes.size(), false);
+    size_t reloaded_count = 0;
+    std::vector<size_t> wave;
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        if (in_degree[index] == 0)
+            wave.push_back(index);
+    }
+
+    while (reloaded_count < nodes.size())
+    {
+        if (wave.empty())
+        {
+            for (size_t index = 0; index < nodes.size(); ++index)
+            {
+                if (reloaded[index])
+                    continue;
+
+                LOGGER_WARN("Resource {} is part of a dependency cycle, reloading it without waiting on its dependencies", nodes[index].meta.resource_id);
+                wave.push_back(index);
+            }
+        }
+
+        jobs::Counter counter{};
+        llvm::SmallVector<Job<>> jobs;
+        jobs.reserve(wave.size());
+        for (const auto index : wave)
+        {
+            jobs.push_back(reload_resource(nodes[index].meta));
+            reloaded[index] = true;
+        }
+        scheduler.dispatch_jobs(std::span<Job<>>{jobs}, JobPriority::Low, &counter);
+        scheduler.wait_for_counter(counter);
+        reloaded_count += wave.size();
+
+        std::vector<size_t> next_wave;
+        for (const auto index : wave)
+        {
+            for (const auto dependent : dependents[index])
+            {
+                if (!reloaded[dependent] && --in_degree[dependent] == 0)
+                    next_wave.push_back(dependent);
+            }
+        }
+        wave = std::move(next_wave);
+    }
+
+    std::lock_guard guard(lock);
+    for (const auto& node : nodes)
+    {
+        for (const auto& resource_id : node.resource_ids)
+            reloading_resources.erase(resource_id);
+    }
+    reload_running = false;
+    co_return;
+}
+
+Job<> ResourceRegistry::reload_resource(const SourceMetadata meta)
+{
+    LOGGER_TRACE("Reloading resource: {}", meta.resource_id);
+
+    const auto source = database.create_source(meta.resource_id, meta);
+    auto job = load_direct(meta, source);
+    co_await job;
+    const auto resource_data = job.result();
+    if (!resource_data || resource_data.value().resource == nullptr)
+        LOGGER_ERROR("Failed to reload resource: {}, keeping the previous version", meta.resource_id);
+    co_return;
+}
+
+void ResourceRegistry::track_memory_locked(const StringId& resource_id)
+{
+    if (const auto it = residency.find(resource_id); it != residency.end())
+    {
+        memory_usage[it->second.type] -= it->second.memory;
+        residency.erase(it);
+    }
+
+    const auto it = resources.find(resource_id);
+    if (it == resources.end() || !it->second.resource)
+        return;
+
+    const auto& resource = it->second.resource;
+    const Residency entry{
+        .type = resource->get_resource_type(),
+        .memory = resource->get_memory_usage(),
+        .last_used = residency_frame
+    };
+    memory_usage[entry.type] += entry.memory;
+    residency[resource_id] = entry;
+}
+
+bool ResourceRegistry::is_evictable_locked(const StringId& resource_id)
+{
+    const auto it = resources.find(resource_id);
+    if (it == resources.end() || it->second.dirty != ResourceDirtyBits::Clean)
+        return false;
+
+    // Only resources that can be loaded back on their own
+    const auto meta = database.find(resource_id);
+    if (!meta || meta->source.string.starts_with("composite://"))
+        return false;
+
+    if (reference_manager.get_reference_count(resource_id) > 0)
+        return false;
+
+    // Beside the registry and the slot, anything holding the resource pointer is still using it
+    const auto slot = slots.find(resource_id);
+    const long holders = slot != slots.end() && slot->second.get_state() == ResourceState::Loaded ? 2 : 1;
+    return it->second.resource.use_count() <= holders;
+}
 
-    if (pending_resources.contains(id))
-        return std::unexpected{ResourceState::Pending};
+void ResourceRegistry::evict_locked(const StringId& resource_id)
+{
+    auto node = resources.extract(resource_id);
+    retired_resources.emplace_back(residency_frame, std::move(node.mapped().resource));
+    evicted_resources.insert(resource_id);
+
+    track_memory_locked(resource_id);
+    refresh_slot_locked(resource_id);
+}
+
+void ResourceRegistry::evict_to_budget_locked(const ResourceType type, const ResourceBudget& budget)
+{
+    PORTAL_PROF_ZONE();
+
+    std::vector<std::pair<uint64_t, StringId>> candidates;
+    for (const auto& [resource_id, entry] : residency)
+    {
+        // Resources used this frame stay, as do resources that do not count against the budget
+        if (entry.type != type || entry.last_used == residency_frame || entry.memory == ResourceMemoryUsage{})
+            continue;
+
+        if (is_evictable_locked(resource_id))
+            candidates.emplace_back(entry.last_used, resource_id);
+    }
+    std::ranges::sort(candidates, {}, &std::pair<uint64_t, StringId>::first);
 
-    if (errored_resources.contains(id))
-        return std::unexpected{ResourceState::Error};
+    const auto& usage = memory_usage[type];
+    size_t evicted = 0;
+    for (const auto& resource_id : candidates | std::views::values)
+    {
+        if (is_within_budget(usage, budget))
+            break;
 
-    if (database.find(id).has_value())
-        return std::unexpected{ResourceState::Unloaded};
+        evict_locked(resource_id);
+        ++evicted;
+    }
 
-    LOG_ERROR("Attempted to get resource with handle {} that does not exist", id);
-    return std::unexpected{ResourceState::Missing};
+    if (evicted > 0)
+    {
+        LOGGER_DEBUG(
+            "Evicted {} resources of type {}, using {} KB of CPU memory and {} KB of GPU memory",
+            evicted,
+            type,
+            usage.cpu_bytes / 1024,
+            usage.gpu_bytes / 1024
+        );
+    }
 }
 
 void ResourceRegistry::create_resource(const StringId& resource_id, [[maybe_unused]] ResourceType type)
@@ -207,6 +726,8 @@ Job<Reference<Resource>> ResourceRegistry::load_resource(const StringId resource
     {
         std::lock_guard guard(lock);
         pending_resources.insert(resource_id);
+        evicted_resources.erase(resource_id);
+        refresh_slot_locked(resource_id);
     }
 
     const auto meta_result = database.find(resource_id);
@@ -216,20 +737,11 @@ Job<Reference<Resource>> ResourceRegistry::load_resource(const StringId resource
         LOGGER_ERROR("Failed to find metadata for resource with id: {}", resource_id);
         errored_resources.insert(resource_id);
         pending_resources.erase(resource_id);
+        refresh_slot_locked(resource_id);
         co_return nullptr;
     }
 
-    SourceMetadata meta = *meta_result;
-    // TODO these checks should be done in the database
-    if (meta.source.string.starts_with("composite://"))
-    {
-        auto source_view = std::string_view(meta_result->source.string);
-        source_view.remove_prefix(std::strlen("composite://"));
-
-        const auto composite_id = STRING_ID(source_view.substr(0, source_view.find("/gltf")));
-        meta = database.find(composite_id).value();
-    }
-
+    const auto meta = resolve_load_metadata(*meta_result);
     const auto source = database.create_source(meta.resource_id, meta);
     auto job = load_direct(meta, source);
     co_await job;
@@ -239,14 +751,261 @@ Job<Reference<Resource>> ResourceRegistry::load_resource(const StringId resource
         std::lock_guard guard(lock);
         errored_resources.insert(meta.resource_id);
         pending_resources.erase(meta.resource_id);
+        refresh_slot_locked(meta.resource_id);
+        refresh_slot_locked(resource_id);
         co_return nullptr;
     }
 
     std::lock_guard guard(lock);
     pending_resources.erase(resource_id);
+    refresh_slot_locked(resource_id);
     co_return resource_data.value().resource;
 }
 
+SourceMetadata ResourceRegistry::resolve_load_metadata(const SourceMetadata& meta) const
+{
+    // TODO these checks should be done in the database
+    if (!meta.source.string.starts_with("composite://"))
+        return meta;
+
+    auto source_view = std::string_view(meta.source.string);
+    source_view.remove_prefix(std::strlen("composite://"));
+
+    const auto composite_id = STRING_ID(source_view.substr(0, source_view.find("/gltf")));
+    return database.find(composite_id).value();
+}
+
+struct ResourceRegistry::PrefetchGraph
+{
+    /**
+     * A resource to load. Resources inside of a composite share the node of the composite, as loading the composite
+     * loads all of them.
+     */
+    struct Node
+    {
+        SourceMetadata meta;
+        // The resources that are loaded by this node, which are marked as pending until it is decoded
+        llvm::SmallVector<StringId> resource_ids;
+        llvm::SmallVector<StringId> dependency_ids;
+        llvm::SmallVector<size_t> dependents;
+
+        // The dependencies that were not decoded yet, plus one for the read of the node itself
+        std::atomic<size_t> remaining = 1;
+        Reference<resources::PrefetchedSource> source = nullptr;
+    };
+
+    // Nodes hold atomics and are never moved, so a deque
+    std::deque<Node> nodes;
+    // Node indices, leaves first
+    std::vector<size_t> order;
+    LoadTimeline timeline;
+    jobs::Counter counter{};
+};
+
+Job<LoadTimeline> ResourceRegistry::load_with_dependencies(const StringId resource_id)
+{
+    PORTAL_PROF_ZONE();
+
+    PrefetchGraph graph;
+    graph.timeline.root = resource_id;
+    graph.timeline.start = LoadTimeline::Clock::now();
+
+    build_prefetch_graph(resource_id, graph);
+    LOGGER_DEBUG("Loading {} with {} resources", resource_id, graph.nodes.size());
+
+    // Every read starts right away, leaves first. Decoding is started by whichever read or dependency finishes last
+    llvm::SmallVector<Job<>> jobs;
+    jobs.reserve(graph.order.size());
+    for (const auto index : graph.order)
+        jobs.push_back(prefetch_node(graph, index));
+    scheduler.dispatch_jobs(std::span<Job<>>{jobs}, JobPriority::Normal, &graph.counter);
+    scheduler.wait_for_counter(graph.counter);
+
+    graph.timeline.end = LoadTimeline::Clock::now();
+    co_return std::move(graph.timeline);
+}
+
+void ResourceRegistry::build_prefetch_graph(const StringId& resource_id, PrefetchGraph& graph)
+{
+    PORTAL_PROF_ZONE();
+
+    std::unordered_map<StringId, size_t> node_by_load_id;
+    std::unordered_map<StringId, size_t> node_by_resource_id;
+
+    llvm::DenseSet<StringId> visited{resource_id};
+    std::deque<StringId> queue{resource_id};
+    while (!queue.empty())
+    {
+        const auto id = queue.front();
+        queue.pop_front();
+
+        {
+            std::lock_guard guard(lock);
+            if (resources.contains(id) || pending_resources.contains(id))
+                continue;
+        }
+
+        const auto meta = database.find(id);
+        if (!meta)
+        {
+            LOGGER_WARN("Skipping dependency {}, it is missing from the database", id);
+            continue;
+        }
+
+        const auto load_meta = resolve_load_metadata(*meta);
+        const auto [it, inserted] = node_by_load_id.try_emplace(load_meta.resource_id, graph.nodes.size());
+        if (inserted)
+        {
+            auto& new_node = graph.nodes.emplace_back();
+            new_node.meta = load_meta;
+            if (load_meta.resource_id != id)
+            {
+                new_node.resource_ids.push_back(load_meta.resource_id);
+                node_by_resource_id[load_meta.resource_id] = it->second;
+            }
+        }
+
+        auto& node = graph.nodes[it->second];
+        node.resource_ids.push_back(id);
+        node_by_resource_id[id] = it->second;
+
+        for (const auto& dependency : meta->dependencies)
+        {
+            node.dependency_ids.push_back(dependency);
+            if (visited.insert(dependency).second)
+                queue.push_back(dependency);
+        }
+    }
+
+    std::vector<llvm::SmallVector<size_t>> dependencies(graph.nodes.size());
+    std::vector<size_t> in_degree(graph.nodes.size(), 0);
+    for (size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        for (const auto& dependency_id : graph.nodes[index].dependency_ids)
+        {
+            // Dependencies that are already loaded, or inside of the same composite, do not gate anything
+            const auto it = node_by_resource_id.find(dependency_id);
+            if (it == node_by_resource_id.end() || it->second == index || std::ranges::contains(dependencies[index], it->second))
+                continue;
+
+            dependencies[index].push_back(it->second);
+            graph.nodes[it->second].dependents.push_back(index);
+            ++in_degree[index];
+        }
+    }
+
+    // Order the nodes leaves first, whatever is left out is part of a cycle
+    std::vector<bool> ordered(graph.nodes.size(), false);
+    for (size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        if (in_degree[index] == 0)
+            graph.order.push_back(index);
+    }
+    for (size_t i = 0; i < graph.order.size(); ++i)
+    {
+        ordered[graph.order[i]] = true;
+        for (const auto dependent : graph.nodes[graph.order[i]].dependents)
+        {
+            if (--in_degree[dependent] == 0)
+                graph.order.push_back(dependent);
+        }
+    }
+
+    if (graph.order.size() != graph.nodes.size())
+    {
+        // A node in a cycle would wait on itself forever, those are decoded without waiting on their dependencies
+        for (size_t index = 0; index < graph.nodes.size(); ++index)
+        {
+            if (ordered[index])
+                continue;
+
+            LOGGER_WARN("Resource {} is part of a dependency cycle, loading it without waiting on its dependencies", graph.nodes[index].meta.resource_id);
+            for (const auto dependency : dependencies[index])
+                std::erase(graph.nodes[dependency].dependents, index);
+            dependencies[index].clear();
+            graph.order.push_back(index);
+        }
+    }
+
+    graph.timeline.entries.resize(graph.nodes.size());
+    for (size_t index = 0; index < graph.nodes.size(); ++index)
+    {
+        auto& node = graph.nodes[index];
+        node.remaining.store(dependencies[index].size() + 1, std::memory_order_relaxed);
+
+        auto& entry = graph.timeline.entries[index];
+        entry.resource_id = node.meta.resource_id;
+        entry.dependencies = std::move(dependencies[index]);
+    }
+
+    std::lock_guard guard(lock);
+    for (const auto& node : graph.nodes)
+    {
+        for (const auto& id : node.resource_ids)
+        {
+            pending_resources.insert(id);
+            evicted_resources.erase(id);
+            refresh_slot_locked(id);
+        }
+    }
+}
+
+Job<> ResourceRegistry::prefetch_node(PrefetchGraph& graph, const size_t index)
+{
+    PORTAL_PROF_ZONE();
+
+    auto& node = graph.nodes[index];
+    auto& entry = graph.timeline.entries[index];
+
+    entry.io_start = LoadTimeline::Clock::now();
+    node.source = make_reference<resources::PrefetchedSource>(database.create_source(node.meta.resource_id, node.meta));
+    entry.io_end = LoadTimeline::Clock::now();
+    entry.bytes_read = node.source->get_prefetched_size();
+
+    if (node.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        co_await decode_prefetched_node(graph, index);
+    co_return;
+}
+
+Job<> ResourceRegistry::decode_prefetched_node(PrefetchGraph& graph, const size_t index)
+{
+    PORTAL_PROF_ZONE();
+
+    auto& node = graph.nodes[index];
+    auto& entry = graph.timeline.entries[index];
+
+    entry.decode_start = LoadTimeline::Clock::now();
+    auto job = load_direct(node.meta, node.source);
+    co_await job;
+    const auto resource_data = job.result();
+    const bool loaded = resource_data.has_value() && resource_data.value().resource != nullptr;
+    entry.decode_end = LoadTimeline::Clock::now();
+    entry.failed = !loaded;
+
+    {
+        std::lock_guard guard(lock);
+        // Saving goes through the original source, the prefetched data is not needed once decoded
+        if (const auto it = resources.find(node.meta.resource_id); it != resources.end() && it->second.source == node.source)
+            it->second.source = node.source->get_source();
+
+        for (const auto& id : node.resource_ids)
+        {
+            pending_resources.erase(id);
+            if (!loaded)
+                errored_resources.insert(id);
+            refresh_slot_locked(id);
+        }
+    }
+    node.source = nullptr;
+
+    for (const auto dependent : node.dependents)
+    {
+        if (graph.nodes[dependent].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            scheduler.dispatch_job(decode_prefetched_node(graph, dependent), JobPriority::Normal, &graph.counter);
+    }
+    co_return;
+}
+
 void ResourceRegistry::set_dirty(const StringId& resource_id, const ResourceDirtyFlags flags)
 {
     std::lock_guard guard(lock);
@@ -18,12 +18,16 @@
 
 #pragma once
 
+#include <deque>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
 #include <portal/core/jobs/scheduler.h>
 
 #include "portal/engine/resources/utils.h"
+#include "load_timeline.h"
 #include "reference_manager.h"
+#include "resource_slot.h"
 #include "database/resource_database.h"
 #include "loader/loader_factory.h"
 #include "portal/core/concurrency/spin_lock.h"
@@ -42,6 +46,15 @@ namespace portal
 template <ResourceConcept T>
 class ResourceReference;
 
+/**
+ * @brief Memory budget of a resource type, 0 bytes is unlimited.
+ */
+struct ResourceBudget
+{
+    size_t cpu_bytes = 0;
+    size_t gpu_bytes = 0;
+};
+
 /**
  * @class ResourceRegistry
  * @brief Central manager for asynchronous resource loading and lifetime management
@@ -64,7 +77,8 @@ class ResourceReference;
  * - `pending_resources`: DenseSet of resources currently loading
  * - `errored_resources`: DenseSet of resources that failed to load
  *
- * All access to these structures is protected by a SpinLock for thread safety.
+ * All access to these structures is protected by a SpinLock for thread safety. Every state transition is also published
+ * into the `ResourceSlot` of the resource, which references read without taking the lock.
  *
  * Loading Flow:
  *
@@ -73,7 +87,7 @@ class ResourceReference;
  * 3. Registry dispatches load_resource() coroutine to job system
  * 4. Coroutine queries database for metadata → creates source → loads via loader
  * 5. Resource moves from pending_resources to resources
- * 6. ResourceReference lazily discovers loaded resource when queried
+ * 6. The slot of the resource is published as loaded, references pick the resource up on their next state check
  *
  * Resource Identity:
  *
@@ -81,10 +95,20 @@ class ResourceReference;
  * - resource_id: The StringId used for lookups (e.g., STRING_ID("textures/albedo.png"))
  * - resource_handle: Internal handle (currently same as resource_id)
  *
+ * Hot Reload:
+ *
+ * When the database watches its files, `update_sources` applies the changes once a frame. Every loaded resource whose
+ * metadata or source changed, and every loaded resource that depends on it, is loaded again on background jobs,
+ * dependencies first. The previous version stays loaded until the new one replaces it, at which point references pick
+ * the new one up.
+ *
+ * Residency:
+ *
+ * Every type can have a memory budget, `update_residency` evicts unreferenced resources of a type that is over its
+ * budget once a frame, least recently used first. Evicted resources are loaded back when a reference next touches them.
+ *
  * Current Limitations:
- * - No unloading: Resources stay loaded forever (TODO at line 77)
  * - No streaming: Large resources must fit in memory
- * - No hot-reload: Changes require restart
  *
  * Usage Example (Async):
  * @code
@@ -129,8 +153,26 @@ public:
         ReferenceManager& reference_manager,
         const renderer::vulkan::VulkanContext& context
     );
+
+    /**
+     * @brief Creates a registry without loaders, for tools and tests that do not render.
+     *
+     * Resources fail to load until a loader is set for their type with `set_loader`.
+     */
+    ResourceRegistry(
+        const Project& project,
+        ecs::Registry& ecs_registry,
+        jobs::Scheduler& scheduler,
+        ResourceDatabase& database,
+        ReferenceManager& reference_manager
+    );
     ~ResourceRegistry() noexcept;
 
+    /**
+     * Replaces the loader of a resource type, must be called before resources of that type are loaded.
+     */
+    void set_loader(ResourceType type, std::shared_ptr<resources::ResourceLoader> loader);
+
     /**
      * Request an asynchronous load for a resource based on its unique id and returns a reference.
      * The returned reference is invalid until the resource is loaded, once its loaded it can be accessed through the `ResourceReference` api
@@ -166,14 +208,84 @@ public:
         return get<T>(resource_id);
     }
 
+    /**
+     * Loads a resource together with every resource it depends on, and blocks until all of them are loaded.
+     *
+     * With `immediate_load`, dependencies are discovered one at a time as loaders decode and ask for them, so reading a
+     * dependency waits for its parent to be parsed. Here the dependency graph is walked from the metadata up front
+     * instead, every resource in it is read concurrently, and each one is decoded as soon as its own read and the
+     * decoding of its dependencies are done. By the time a loader asks for a dependency, it is already loaded.
+     *
+     * @tparam T The underlying requested resource type
+     * @param resource_id The resource id
+     * @param timeline When given, filled with the timing of every resource in the load
+     * @return A reference to the resource
+     */
+    template <ResourceConcept T>
+    ResourceReference<T> immediate_load_with_dependencies(StringId resource_id, LoadTimeline* timeline = nullptr)
+    {
+        auto result = scheduler.wait_for_job(load_with_dependencies(resource_id));
+        if (timeline)
+            *timeline = std::move(result);
+
+        return get<T>(resource_id);
+    }
+
+    /**
+     * Sets the memory budget of a resource type, enforced by `update_residency`.
+     * Budgets are also read from the project settings, as `resources.budgets.<type>.cpu_mb` and `gpu_mb`.
+     */
+    void set_budget(ResourceType type, const ResourceBudget& budget);
+    [[nodiscard]] ResourceBudget get_budget(ResourceType type);
+
+    /**
+     * Returns the memory used by all loaded resources of a type, as reported by the resources.
+     */
+    [[nodiscard]] ResourceMemoryUsage get_memory_usage(ResourceType type);
+
+    /**
+     * Evicts resources from every type that is over its budget, least recently used first. Called once a frame.
+     *
+     * Only resources that nothing references (no `ResourceReference` and no other owner of the resource pointer), that
+     * have no unsaved changes and that can be loaded back from the database are evicted. Resources inside of a
+     * composite are not, since loading one back loads the whole composite.
+     *
+     * An evicted resource is `ResourceState::Unloaded`. The first reference that checks its state afterwards loads it
+     * back, so it is `Pending` for a few frames and then `Loaded` again. The evicted resource itself is kept alive for
+     * the frames in flight that might still use it on the GPU.
+     */
+    void update_residency();
+
+    /**
+     * Applies the changes the database picked up in its files and reloads the resources they affect. Called once a frame.
+     *
+     * Changed resources and the resources that depend on them are reloaded in the background, dependencies first, the
+     * previous version is replaced only once the new one is loaded, and kept alive for the frames in flight.
+     * Resources with unsaved changes are not reloaded, neither are resources that failed to reload, which keep their
+     * previous version. Resources that are still loading are reloaded once they finish.
+     */
+    void update_sources();
+
+    /**
+     * Returns true while a resource is being reloaded, loaders use it to load the resources inside of a composite again
+     * even though they are loaded.
+     */
+    [[nodiscard]] bool is_reloading(const StringId& resource_id);
+
+    /**
+     * Creates a job loading a resource together with its dependencies, see `immediate_load_with_dependencies`.
+     * Resources that are already loaded or loading, and their dependencies, are left out of the load.
+     *
+     * @param resource_id The resource id
+     * @return The timeline of the load
+     */
+    Job<LoadTimeline> load_with_dependencies(StringId resource_id);
+
     void save(const StringId& resource_id);
 
     void load_snapshot(const StringId& resource_id, Buffer snapshot_data);
     Buffer snapshot(const StringId& resource_id);
 
-
-    // TODO: Unload
-
     /**
      * Get a reference to an existing resource of type T, but does not attempt to create it if not loaded.
      * If the resource does not exist, returns a null reference.
@@ -216,6 +328,8 @@ public:
 
         std::lock_guard guard(lock);
         resources[id] = {ref};
+        track_memory_locked(id);
+        refresh_slot_locked(id);
         return ref;
     }
 
@@ -254,6 +368,7 @@ public:
     [[nodiscard]] ecs::Registry& get_ecs_registry() const { return ecs_registry; }
     [[nodiscard]] const Project& get_project() const { return project; }
     [[nodiscard]] ResourceDatabase& get_resource_database() const { return database; }
+    [[nodiscard]] jobs::Scheduler& get_scheduler() const { return scheduler; }
 
     void save_resource(resources::ResourceData& resource_data);
     Buffer snapshot_resource(const resources::ResourceData& resource_data);
@@ -289,12 +404,59 @@ protected:
     Job<Reference<Resource>> load_resource(StringId handle);
 
 private:
+    struct PrefetchGraph;
+
+    struct Residency
+    {
+        ResourceType type = ResourceType::Unknown;
+        ResourceMemoryUsage memory{};
+        // The last `update_residency` call in which the resource was accessed
+        uint64_t last_used = 0;
+    };
+
+    /**
+     * Returns the metadata of the resource that has to be loaded to load `meta`, which is the composite for resources
+     * inside of a composite (a gltf mesh, material...)
+     */
+    [[nodiscard]] SourceMetadata resolve_load_metadata(const SourceMetadata& meta) const;
+
+    void build_prefetch_graph(const StringId& resource_id, PrefetchGraph& graph);
+    Job<> prefetch_node(PrefetchGraph& graph, size_t index);
+    Job<> decode_prefetched_node(PrefetchGraph& graph, size_t index);
+
     template <ResourceConcept T>
     friend class ResourceReference;
 
     void set_dirty(const StringId& resource_id, ResourceDirtyFlags flags);
     ResourceDirtyFlags get_dirty(const StringId& resource_id);
 
+    /** @brief Returns the slot of a resource, creating it from the current state of the resource if needed */
+    ResourceSlot& get_slot(const StringId& resource_id);
+
+    /** @brief Publishes the current state of a resource into its slot, if it has one, must be called under `lock` */
+    void refresh_slot_locked(const StringId& resource_id);
+
+    /** @brief Returns the state of a resource that is not loaded, must be called under `lock` */
+    [[nodiscard]] ResourceState find_state_locked(const StringId& resource_id) const;
+
+    /** @brief Loads an evicted resource back, called by references that access it */
+    void reload_evicted(const StringId& resource_id);
+
+    /** @brief Updates the memory accounting of a resource after it was loaded or removed, must be called under `lock` */
+    void track_memory_locked(const StringId& resource_id);
+    [[nodiscard]] bool is_evictable_locked(const StringId& resource_id);
+    void evict_locked(const StringId& resource_id);
+    void evict_to_budget_locked(ResourceType type, const ResourceBudget& budget);
+
+    void read_budgets();
+
+    /** @brief Checks that reloading a resource does not lose anything, must be called under `lock` */
+    [[nodiscard]] bool can_reload_locked(const StringId& resource_id) const;
+    /** @brief Marks every loaded resource that depends on a stale resource as stale, must be called under `lock` */
+    void mark_dependents_stale_locked();
+    Job<> reload_resources(std::vector<StringId> resource_ids);
+    Job<> reload_resource(SourceMetadata meta);
+
     const Project& project;
     ecs::Registry& ecs_registry;
     jobs::Scheduler& scheduler;
@@ -307,6 +469,23 @@ private:
     std::unordered_map<StringId, resources::ResourceData> resources;
     llvm::DenseSet<StringId> pending_resources;
     llvm::DenseSet<StringId> errored_resources;
+    // Slots are never removed, references keep pointers to them. Node based, so the pointers survive rehashing
+    std::unordered_map<StringId, ResourceSlot> slots;
+
+    std::unordered_map<StringId, Residency> residency;
+    std::unordered_map<ResourceType, ResourceMemoryUsage> memory_usage;
+    std::unordered_map<ResourceType, ResourceBudget> budgets;
+    llvm::DenseSet<StringId> evicted_resources;
+    // Evicted resources, with the frame they were evicted in, kept alive until the GPU is done with them
+    std::deque<std::pair<uint64_t, Reference<Resource>>> retired_resources;
+    uint64_t residency_frame = 0;
+    size_t frames_in_flight = 3;
+
+    // Loaded resources whose source changed, waiting for the next reload
+    llvm::DenseSet<StringId> stale_resources;
+    llvm::DenseSet<StringId> reloading_resources;
+    // Only one reload runs at a time, changes picked up while it runs wait for it
+    bool reload_running = false;
 
     resources::LoaderFactory loader_factory;
 };
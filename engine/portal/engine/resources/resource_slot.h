@@ -0,0 +1,133 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include "portal/core/concurrency/spin_lock.h"
+#include "portal/engine/reference.h"
+#include "portal/engine/resources/resource_types.h"
+#include "portal/engine/resources/resources/resource.h"
+
+namespace portal
+{
+/**
+ * @brief The registry side state of a single resource, shared by every `ResourceReference` to it.
+ *
+ * The registry owns one slot per referenced resource, at a stable address for the lifetime of the registry, and publishes
+ * every state transition of the resource into it. References keep a pointer to their slot, so checking the state of a
+ * resource is a single acquire load instead of a locked registry lookup.
+ *
+ * The state and a generation are packed into a single atomic. The generation is bumped every time a resource is
+ * published, which lets a reference know that the resource it cached is still the one in the slot without reading the
+ * resource pointer itself. The resource pointer is only read when the generation changes, under the slot lock.
+ *
+ * Slots also carry what the registry needs for memory budgets: whether the resource was accessed since the registry last
+ * looked, and whether its unloaded state comes from an eviction (in which case the next access reloads it).
+ */
+class ResourceSlot
+{
+public:
+    struct Status
+    {
+        ResourceState state = ResourceState::Unknown;
+        uint32_t generation = 0;
+        // The resource was evicted to meet a memory budget, only set for `ResourceState::Unloaded`
+        bool evicted = false;
+    };
+
+    explicit ResourceSlot(const ResourceState state = ResourceState::Unknown) : status(pack({state, 0, false})) {}
+
+    ResourceSlot(const ResourceSlot&) = delete;
+    ResourceSlot& operator=(const ResourceSlot&) = delete;
+
+    /**
+     * @brief Returns the current state and generation of the slot, lock free.
+     */
+    [[nodiscard]] Status get_status() const
+    {
+        return unpack(status.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] ResourceState get_state() const { return get_status().state; }
+
+    /**
+     * @brief Returns the resource in the slot along with the generation it was published with.
+     *
+     * The resource is null unless the returned state is `ResourceState::Loaded`.
+     */
+    [[nodiscard]] std::pair<Reference<Resource>, Status> get_resource() const
+    {
+        std::lock_guard guard(lock);
+        return {resource, get_status()};
+    }
+
+    /**
+     * @brief Publishes a loaded resource, bumping the generation.
+     */
+    void publish(Reference<Resource> new_resource)
+    {
+        std::lock_guard guard(lock);
+        const auto generation = get_status().generation + 1;
+        resource = std::move(new_resource);
+        status.store(pack({resource ? ResourceState::Loaded : ResourceState::Error, generation, false}), std::memory_order_release);
+    }
+
+    /**
+     * @brief Publishes a state without a resource (pending, error, unloaded...), releasing the previous resource.
+     */
+    void publish(const ResourceState state, const bool evicted = false)
+    {
+        PORTAL_ASSERT(state != ResourceState::Loaded, "Loaded resources are published with their resource");
+        PORTAL_ASSERT(!evicted || state == ResourceState::Unloaded, "Only unloaded resources can be evicted");
+
+        std::lock_guard guard(lock);
+        const auto generation = get_status().generation;
+        resource = nullptr;
+        status.store(pack({state, generation, evicted}), std::memory_order_release);
+    }
+
+    /**
+     * @brief Marks the resource as accessed, only writes to the slot on the first access since the last `consume_access`.
+     */
+    void touch() const
+    {
+        if (!accessed.load(std::memory_order_relaxed))
+            accessed.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns whether the resource was accessed since the last call, and clears the access.
+     */
+    bool consume_access()
+    {
+        return accessed.exchange(false, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint64_t EVICTED_BIT = 1 << 8;
+
+    static uint64_t pack(const Status value)
+    {
+        return static_cast<uint64_t>(value.generation) << 9 | (value.evicted ? EVICTED_BIT : 0) | static_cast<uint64_t>(value.state);
+    }
+
+    static Status unpack(const uint64_t value)
+    {
+        return {static_cast<ResourceState>(value & 0xFF), static_cast<uint32_t>(value >> 9), (value & EVICTED_BIT) != 0};
+    }
+
+private:
+    std::atomic<uint64_t> status;
+    mutable std::atomic<bool> accessed = false;
+    mutable SpinLock lock;
+    Reference<Resource> resource;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+} // portal
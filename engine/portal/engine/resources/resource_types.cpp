@@ -15,7 +15,7 @@ static std::vector<std::pair<std::unordered_set<std::string_view>, std::pair<Res
     {{".obj"}, {ResourceType::Mesh, SourceFormat::Obj}},
     {{".mtl"}, {ResourceType::Material, SourceFormat::Material}},
     {{".slang"}, {ResourceType::Shader, SourceFormat::Shader}},
-    {{".spv"}, {ResourceType::Shader, SourceFormat::PrecompiledShader}},
+    {{".spv", ".pshc"}, {ResourceType::Shader, SourceFormat::PrecompiledShader}},
     {{".glb", ".gltf"}, {ResourceType::Composite, SourceFormat::Glft}},
     {{".ttf"}, {ResourceType::Font, SourceFormat::FontFile}},
     {{".pscene"}, {ResourceType::Scene, SourceFormat::Scene}}
@@ -32,4 +32,19 @@ const std::vector<resources::MeshGeometryData::Submesh>& MeshGeometry::get_subme
 {
     return geometry.submeshes;
 }
+
+ResourceMemoryUsage MeshGeometry::get_memory_usage() const
+{
+    ResourceMemoryUsage usage{
+        .cpu_bytes = geometry.vertices.size() * sizeof(resources::Vertex)
+        + geometry.indices.size() * sizeof(uint32_t)
+        + geometry.submeshes.size() * sizeof(resources::MeshGeometryData::Submesh)
+    };
+
+    if (geometry.vertex_buffer)
+        usage.gpu_bytes += geometry.vertex_buffer->get_size();
+    if (geometry.index_buffer)
+        usage.gpu_bytes += geometry.index_buffer->get_size();
+    return usage;
+}
 } // portal
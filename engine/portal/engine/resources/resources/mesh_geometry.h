@@ -69,6 +69,8 @@ public:
     [[nodiscard]] const resources::MeshGeometryData& get_geometry() const;
     [[nodiscard]] const std::vector<resources::MeshGeometryData::Submesh>& get_submeshes() const;
 
+    [[nodiscard]] ResourceMemoryUsage get_memory_usage() const override;
+
 private:
     friend class scene::MeshNode;
 
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "portal/core/flags.h"
 #include "portal/core/strings/string_id.h"
 #include "portal/core/strings/string_utils.h"
@@ -31,6 +33,31 @@ struct FlagTraits<ResourceDirtyBits>
         ResourceDirtyBits::ConfigChange;
 };
 
+/**
+ * @brief Memory owned by a resource, counted against the memory budget of its type in the registry.
+ */
+struct ResourceMemoryUsage
+{
+    size_t cpu_bytes = 0;
+    size_t gpu_bytes = 0;
+
+    ResourceMemoryUsage& operator+=(const ResourceMemoryUsage& other)
+    {
+        cpu_bytes += other.cpu_bytes;
+        gpu_bytes += other.gpu_bytes;
+        return *this;
+    }
+
+    ResourceMemoryUsage& operator-=(const ResourceMemoryUsage& other)
+    {
+        cpu_bytes -= std::min(cpu_bytes, other.cpu_bytes);
+        gpu_bytes -= std::min(gpu_bytes, other.gpu_bytes);
+        return *this;
+    }
+
+    bool operator==(const ResourceMemoryUsage&) const = default;
+};
+
 class Resource
 {
 public:
@@ -41,6 +68,12 @@ public:
     [[nodiscard]] virtual ResourceType get_resource_type() const { return static_type(); }
     [[nodiscard]] const StringId& get_id() const { return id; }
 
+    /**
+     * @brief Returns the CPU and GPU memory owned by the resource.
+     * Resources that do not report their memory are never evicted to meet a budget.
+     */
+    [[nodiscard]] virtual ResourceMemoryUsage get_memory_usage() const { return {}; }
+
     bool operator==(const Resource& other) const;
 
 protected:
@@ -0,0 +1,77 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "pack_source.h"
+
+#include <mutex>
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/log.h"
+#include "portal/core/debug/profile.h"
+#include "portal/serialization/compression/block_compression.h"
+
+namespace portal::resources
+{
+static auto logger = Log::get_logger("Resources");
+
+PackSource::PackSource(Reference<MappedFile> file, const Buffer data, const size_t raw_size, const bool compressed) :
+    file(std::move(file)),
+    data(data),
+    raw_size(raw_size),
+    compressed(compressed)
+{}
+
+Buffer PackSource::load() const
+{
+    if (!compressed)
+        return data;
+
+    PORTAL_PROF_ZONE();
+    // Loaders keep the buffers they load, each load gets its own copy
+    auto raw = decompress(data);
+    if (raw.size != raw_size)
+        LOGGER_ERROR("Corrupt resource data in pack, expected {} bytes, got {}", raw_size, raw.size);
+    return raw;
+}
+
+Buffer PackSource::load(const size_t offset, const size_t size) const
+{
+    const auto& raw = get_raw();
+    if (offset + size > raw.size)
+        return {};
+
+    return Buffer{raw, offset, size};
+}
+
+std::unique_ptr<std::istream> PackSource::istream() const
+{
+    return std::make_unique<BufferStreamReader>(get_raw());
+}
+
+void PackSource::save(Buffer, size_t)
+{
+    LOGGER_ERROR("Cannot save a resource into a pack, packs are read only");
+}
+
+std::unique_ptr<std::ostream> PackSource::ostream()
+{
+    LOGGER_ERROR("Cannot save a resource into a pack, packs are read only");
+    return std::make_unique<BufferStreamWriter>(discarded);
+}
+
+const Buffer& PackSource::get_raw() const
+{
+    if (!compressed)
+        return data;
+
+    std::lock_guard guard(lock);
+    if (!decompressed)
+    {
+        PORTAL_PROF_ZONE();
+        decompressed = decompress(data);
+    }
+    return decompressed;
+}
+} // portal
@@ -0,0 +1,51 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include "portal/core/concurrency/spin_lock.h"
+#include "portal/core/files/mapped_file.h"
+#include "portal/engine/reference.h"
+#include "portal/engine/resources/source/resource_source.h"
+
+namespace portal::resources
+{
+/**
+ * @brief A source reading the data of a resource from a mapped pack file.
+ *
+ * Uncompressed data is handed out as buffers pointing straight into the mapping, without copying it, the source keeps
+ * the mapping alive. Compressed data is decompressed on every full `load()`, and once for partial loads and streams.
+ *
+ * Packs are read only, writes are dropped.
+ */
+class PackSource final : public ResourceSource
+{
+public:
+    PackSource(Reference<MappedFile> file, Buffer data, size_t raw_size, bool compressed);
+
+    [[nodiscard]] Buffer load() const override;
+    [[nodiscard]] Buffer load(size_t offset, size_t size) const override;
+
+    /** @note Streams read from the source, they must not outlive it */
+    [[nodiscard]] std::unique_ptr<std::istream> istream() const override;
+
+    void save(Buffer data, size_t offset) override;
+    [[nodiscard]] std::unique_ptr<std::ostream> ostream() override;
+
+private:
+    /** @brief Returns the raw data, decompressing it once if needed */
+    const Buffer& get_raw() const;
+
+    Reference<MappedFile> file;
+    // The data as it is stored in the pack
+    Buffer data;
+    size_t raw_size;
+    bool compressed;
+
+    mutable SpinLock lock;
+    mutable Buffer decompressed;
+    Buffer discarded;
+};
+} // portal
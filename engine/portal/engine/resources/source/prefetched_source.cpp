@@ -0,0 +1,74 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "prefetched_source.h"
+
+#include <mutex>
+
+#include "portal/core/buffer_stream.h"
+#include "portal/core/debug/profile.h"
+
+namespace portal::resources
+{
+PrefetchedSource::PrefetchedSource(Reference<ResourceSource> source) : source(std::move(source))
+{
+    PORTAL_PROF_ZONE();
+    buffer = this->source->load();
+    prefetched_size = buffer.size;
+}
+
+Buffer PrefetchedSource::load() const
+{
+    {
+        std::lock_guard guard(lock);
+        if (buffer)
+            return std::move(buffer);
+    }
+
+    return source->load();
+}
+
+Buffer PrefetchedSource::load(const size_t offset, const size_t size) const
+{
+    {
+        std::lock_guard guard(lock);
+        if (buffer && offset + size <= buffer.size)
+            return Buffer::copy(static_cast<const std::byte*>(buffer.data) + offset, size);
+    }
+
+    return source->load(offset, size);
+}
+
+std::unique_ptr<std::istream> PrefetchedSource::istream() const
+{
+    {
+        std::lock_guard guard(lock);
+        if (buffer)
+            return std::make_unique<BufferStreamReader>(buffer);
+    }
+
+    return source->istream();
+}
+
+void PrefetchedSource::save(const Buffer data, const size_t offset)
+{
+    {
+        std::lock_guard guard(lock);
+        buffer = {};
+    }
+
+    source->save(data, offset);
+}
+
+std::unique_ptr<std::ostream> PrefetchedSource::ostream()
+{
+    {
+        std::lock_guard guard(lock);
+        buffer = {};
+    }
+
+    return source->ostream();
+}
+} // portal
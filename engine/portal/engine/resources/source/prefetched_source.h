@@ -0,0 +1,49 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include "portal/core/concurrency/spin_lock.h"
+#include "portal/engine/reference.h"
+#include "portal/engine/resources/source/resource_source.h"
+
+namespace portal::resources
+{
+/**
+ * @brief A source that reads all of the data of another source up front.
+ *
+ * Used by dependency prefetching to separate the I/O of a resource from its decoding: the read happens when the source
+ * is constructed, on whichever worker gets there first, and the loader later decodes from memory.
+ *
+ * The first full `load()` hands the prefetched buffer over to the caller, loaders are free to keep it (as they do with
+ * the buffers of a `FileSource`). Any later read goes back to the original source. Writes always go to the original
+ * source.
+ */
+class PrefetchedSource final : public ResourceSource
+{
+public:
+    explicit PrefetchedSource(Reference<ResourceSource> source);
+
+    [[nodiscard]] Buffer load() const override;
+    [[nodiscard]] Buffer load(size_t offset, size_t size) const override;
+
+    /** @note Streams read from the prefetched buffer, they must not outlive the source */
+    [[nodiscard]] std::unique_ptr<std::istream> istream() const override;
+
+    void save(Buffer data, size_t offset) override;
+    [[nodiscard]] std::unique_ptr<std::ostream> ostream() override;
+
+    /** @brief Returns the number of bytes read up front */
+    [[nodiscard]] size_t get_prefetched_size() const { return prefetched_size; }
+    [[nodiscard]] const Reference<ResourceSource>& get_source() const { return source; }
+
+private:
+    Reference<ResourceSource> source;
+    size_t prefetched_size = 0;
+
+    mutable SpinLock lock;
+    mutable Buffer buffer;
+};
+} // portal
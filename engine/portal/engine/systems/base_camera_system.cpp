@@ -12,6 +12,14 @@ namespace portal
 void BaseCameraSystem::connect(ecs::Registry&, entt::dispatcher&) {}
 void BaseCameraSystem::disconnect(ecs::Registry&, entt::dispatcher&) {}
 
+void BaseCameraSystem::declare_access(ecs::ComponentAccess& access)
+{
+    // Moves the camera and tags it for the transform hierarchy
+    access.write<CameraComponent>();
+    access.write<TransformComponent>();
+    access.write<TransformDirtyTag>();
+}
+
 void BaseCameraSystem::execute(FrameContext& frame, ecs::Registry& registry)
 {
     for (auto&& [entity_id, controller, camera, transform] : group(registry).each())
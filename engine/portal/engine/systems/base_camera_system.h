@@ -24,6 +24,8 @@ public:
 
     static void execute(FrameContext& frame, ecs::Registry& registry);
 
+    static void declare_access(ecs::ComponentAccess& access);
+
     static void on_component_added(Entity entity, CameraComponent& camera_component);
     static void on_component_changed(Entity entity, CameraComponent& camera_component);
 
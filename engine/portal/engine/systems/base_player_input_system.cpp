@@ -40,6 +40,12 @@ void BasePlayerInputSystem::disconnect(ecs::Registry& registry, entt::dispatcher
     }
 }
 
+void BasePlayerInputSystem::declare_access(ecs::ComponentAccess& access)
+{
+    // Input is applied to the viewed controller
+    access.write<BaseCameraController>();
+}
+
 void BasePlayerInputSystem::execute(ecs::Registry& registry) const
 {
     const auto player_group = group(registry);
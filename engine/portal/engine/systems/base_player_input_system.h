@@ -26,6 +26,8 @@ public:
 
     void execute(ecs::Registry& registry) const;
 
+    static void declare_access(ecs::ComponentAccess& access);
+
     void on_key_pressed(const KeyPressedEvent& event);
     void on_key_released(const KeyReleasedEvent& event);
     void on_mouse_moved(const MouseMovedEvent& event);
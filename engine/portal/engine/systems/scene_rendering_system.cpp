@@ -5,6 +5,11 @@
 
 #include "scene_rendering_system.h"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "portal/core/jobs/scheduler.h"
 #include "portal/engine/components/camera.h"
 #include "portal/engine/components/light_components.h"
 #include "portal/engine/renderer/rendering_context.h"
@@ -16,9 +21,23 @@ namespace portal
 
 static auto logger = Log::get_logger("SceneRenderingSystem");
 
+SceneRenderingSystem::SceneRenderingSystem(jobs::Scheduler& scheduler) : scheduler(scheduler) {}
+
 void SceneRenderingSystem::connect(ecs::Registry&, entt::dispatcher&) {}
 void SceneRenderingSystem::disconnect(ecs::Registry&, entt::dispatcher&) {}
 
+void SceneRenderingSystem::declare_access(ecs::ComponentAccess& access)
+{
+    // The main camera viewport is updated from the scene
+    access.write<CameraComponent>();
+    access.read<MainCameraTag>();
+    access.read<DirectionalLightComponent>();
+    access.read<PointLightComponent>();
+    access.read<SpotlightComponent>();
+    // Consumed to refresh the cached transforms of the render scene
+    access.write<WorldTransformChangedTag>();
+}
+
 void SceneRenderingSystem::execute(FrameContext& frame, ecs::Registry& registry)
 {
     update_global_descriptors(frame, registry);
@@ -68,7 +87,7 @@ void SceneRenderingSystem::update_global_descriptors(FrameContext& frame, ecs::R
     }
 }
 
-void SceneRenderingSystem::update_lights(FrameContext& frame, const ecs::Registry& registry)
+void SceneRenderingSystem::update_lights(FrameContext& frame, ecs::Registry& registry)
 {
     // TODO: add dirty system, most lights wont change every frame.
 
@@ -96,6 +115,89 @@ void SceneRenderingSystem::update_lights(FrameContext& frame, const ecs::Registr
         found_directional_light = true;
     }
 
+    // Point lights come first in the cluster light indices, an index past the point light count refers to a spot light
+    auto& raw_registry = registry.get_raw_registry();
+    const auto& view = rendering_context->scene_data.camera.view;
+    light_bounds.clear();
+
+    auto& point_lights = rendering_context->scene_lights.point_lights;
+    point_lights.light_count = 0;
+    for (auto&& [entity, point_light, transform] : raw_registry.view<PointLightComponent, TransformComponent>().each())
+    {
+        if (point_lights.light_count == vulkan::MAX_POINT_LIGHTS)
+        {
+            if (!light_limit_warned)
+                LOGGER_WARN("Too many point lights, only the first {} are rendered", vulkan::MAX_POINT_LIGHTS);
+            light_limit_warned = true;
+            break;
+        }
+
+        const glm::vec3 position{transform.get_world_matrix()[3]};
+        point_lights.point_lights[point_lights.light_count++] = {
+            .position = position,
+            .multiplier = point_light.intensity,
+            .radiance = point_light.radiance,
+            .min_radius = point_light.min_radius,
+            .radius = point_light.radius,
+            .falloff = point_light.falloff,
+            .light_size = point_light.light_size,
+            .casts_shadows = false
+        };
+        light_bounds.push_back({glm::vec3(view * glm::vec4(position, 1.f)), point_light.radius});
+    }
+
+    auto& spot_lights = rendering_context->scene_lights.spot_lights;
+    spot_lights.light_count = 0;
+    for (auto&& [entity, spotlight, transform] : raw_registry.view<SpotlightComponent, TransformComponent>().each())
+    {
+        if (spot_lights.light_count == vulkan::MAX_SPOT_LIGHTS)
+        {
+            if (!light_limit_warned)
+                LOGGER_WARN("Too many spot lights, only the first {} are rendered", vulkan::MAX_SPOT_LIGHTS);
+            light_limit_warned = true;
+            break;
+        }
+
+        const auto& world_matrix = transform.get_world_matrix();
+        const glm::vec3 position{world_matrix[3]};
+        const glm::vec3 direction = glm::normalize(glm::vec3(world_matrix * glm::vec4(0.f, 0.f, -1.f, 0.f)));
+        spot_lights.spot_lights[spot_lights.light_count++] = {
+            .position = position,
+            .multiplier = spotlight.intensity,
+            .radiance = spotlight.radiance,
+            .angle_attenuation = spotlight.angle_attenuation,
+            .direction = direction,
+            .range = spotlight.range,
+            .angle = spotlight.angle,
+            .falloff = spotlight.falloff,
+            .soft_shadows = false,
+            .casts_shadows = false
+        };
+        light_bounds.push_back(
+            renderer::LightBounds::from_cone(
+                glm::vec3(view * glm::vec4(position, 1.f)),
+                glm::normalize(glm::vec3(view * glm::vec4(direction, 0.f))),
+                spotlight.range,
+                glm::radians(spotlight.angle) * 0.5f
+            )
+        );
+    }
+
+    // Bin the lights with the projection the frame is rendered with
+    {
+        const auto main_camera_group = registry.group<MainCameraTag, CameraComponent>();
+        const auto& camera = registry.entity_from_id(main_camera_group.front()).get_component<CameraComponent>();
+
+        // The camera uses a reversed depth range, the near clip is the larger distance
+        light_clusters.configure(
+            rendering_context->scene_data.camera.proj,
+            std::min(camera.near_clip, camera.far_clip),
+            std::max(camera.near_clip, camera.far_clip)
+        );
+        light_clusters.assign(light_bounds, scheduler);
+    }
+    rendering_context->light_clusters = &light_clusters;
+
     // bool found_skylight = false;
     // for (auto entity: registry.view<SkylightComponent>())
     // {
@@ -118,37 +220,152 @@ void SceneRenderingSystem::update_lights(FrameContext& frame, const ecs::Registr
     // }
 }
 
+void SceneRenderingSystem::on_component_added(const Entity entity, StaticMeshComponent&)
+{
+    pending_refresh.push_back(entity.get_id());
+}
+
+void SceneRenderingSystem::on_component_removed(const Entity entity, StaticMeshComponent&)
+{
+    pending_remove.push_back(entity.get_id());
+}
+
+void SceneRenderingSystem::on_component_changed(const Entity entity, StaticMeshComponent&)
+{
+    pending_refresh.push_back(entity.get_id());
+}
+
+void SceneRenderingSystem::sync_render_scene(ecs::Registry& registry)
+{
+    PORTAL_PROF_ZONE();
+    auto& raw_registry = registry.get_raw_registry();
+
+    // Picks up the meshes that existed before the system was registered
+    if (!render_scene_initialized)
+    {
+        for (const auto entity : group(registry))
+            pending_refresh.push_back(entity);
+        render_scene_initialized = true;
+    }
+
+    for (const auto entity : pending_remove)
+        render_scene.remove(entity);
+    pending_remove.clear();
+
+    std::swap(pending_refresh, refreshing);
+    for (const auto entity : refreshing)
+    {
+        if (!add_to_render_scene(raw_registry, entity))
+            pending_refresh.push_back(entity);
+    }
+    refreshing.clear();
+
+    render_scene.commit();
+
+    for (auto&& [entity, static_mesh, transform] : raw_registry.view<WorldTransformChangedTag, StaticMeshComponent, TransformComponent>().each())
+        render_scene.set_transform(entity, transform.get_world_matrix());
+    raw_registry.clear<WorldTransformChangedTag>();
+}
+
+bool SceneRenderingSystem::add_to_render_scene(entt::registry& registry, const entt::entity entity)
+{
+    render_scene.remove(entity);
+    if (!registry.valid(entity))
+        return true;
+
+    auto* static_mesh = registry.try_get<StaticMeshComponent>(entity);
+    if (!static_mesh || !static_mesh->visible)
+        return true;
+
+    // The mesh may still be loading, try again next frame
+    if (!static_mesh->mesh.is_valid())
+        return false;
+
+    const auto* transform = registry.try_get<TransformComponent>(entity);
+    const auto world_matrix = transform ? transform->get_world_matrix() : glm::mat4(1.0f);
+    const auto& index_buffer = static_mesh->mesh->get_index_buffer();
+
+    uint32_t submesh_index = 0;
+    for (const auto& [start_index, count, bounds] : static_mesh->mesh->get_submeshes())
+    {
+        const renderer::RenderDraw draw{
+            .index_count = count,
+            .first_index = start_index,
+            .index_buffer = index_buffer->get_handle(),
+            .vertex_buffer_address = static_mesh->mesh->get_vertex_buffer_address(),
+        };
+
+        render_scene.add(
+            entity,
+            draw,
+            static_mesh->materials[submesh_index++].underlying(),
+            index_buffer,
+            world_matrix,
+            {bounds.origin, bounds.extents}
+        );
+    }
+    return true;
+}
+
+void SceneRenderingSystem::build_draw_list(const glm::mat4& view)
+{
+    PORTAL_PROF_ZONE();
+
+    // View space depth (the camera looks down -z), quantized over the range of the visible objects
+    const auto world_bounds = render_scene.get_world_bounds();
+    visible_depths.resize(visible_objects.size());
+    float min_depth = std::numeric_limits<float>::max();
+    float max_depth = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < visible_objects.size(); ++i)
+    {
+        const auto& center = world_bounds[visible_objects[i]].center;
+        const float depth = -(view[0][2] * center.x + view[1][2] * center.y + view[2][2] * center.z + view[3][2]);
+        visible_depths[i] = depth;
+        min_depth = std::min(min_depth, depth);
+        max_depth = std::max(max_depth, depth);
+    }
+
+    const auto state_keys = render_scene.get_state_keys();
+    draw_list.clear();
+    draw_list.reserve(visible_objects.size());
+    for (size_t i = 0; i < visible_objects.size(); ++i)
+    {
+        const auto object = visible_objects[i];
+        draw_list.add(state_keys[object] | renderer::DrawKey::quantize_depth(visible_depths[i], min_depth, max_depth), object);
+    }
+    draw_list.build();
+}
+
 void SceneRenderingSystem::add_static_mesh_to_context(FrameContext& frame, ecs::Registry& registry)
 {
     auto* rendering_context = std::any_cast<renderer::FrameRenderingContext>(&frame.rendering_context);
 
     PORTAL_PROF_ZONE("Render Static Mesh");
-    for (auto&& [entity, static_mesh, transform] : group(registry).each())
-    {
-        if (!static_mesh.visible)
-            continue;
+    const auto start = std::chrono::high_resolution_clock::now();
 
-        if (static_mesh.mesh.is_valid())
-        {
-            const auto world_matrix = transform.get_world_matrix();
-
-            // TODO: move this to the relevant system
-            int i = 0;
-            for (auto& [start_index, count, bounds] : static_mesh.mesh->get_submeshes())
-            {
-                renderer::RenderObject object{
-                    .index_count = count,
-                    .first_index = start_index,
-                    .index_buffer = static_mesh.mesh->get_index_buffer(),
-                    .material = static_mesh.materials[i++].underlying(),
-                    .bounds = bounds,
-                    .transform = world_matrix,
-                    .vertex_buffer_address = static_mesh.mesh->get_vertex_buffer_address(),
-                };
-
-                rendering_context->render_objects.emplace_back(object);
-            }
-        }
+    sync_render_scene(registry);
+
+    // Refitting is much cheaper than a rebuild, the tree is only rebuilt when objects are added or removed
+    const bool bounds_changed = render_scene.consume_bounds_changed();
+    if (bvh_structure_version != render_scene.get_structure_version())
+    {
+        bvh.build(render_scene.get_world_bounds());
+        bvh_structure_version = render_scene.get_structure_version();
     }
+    else if (bounds_changed)
+    {
+        bvh.refit(render_scene.get_world_bounds());
+    }
+
+    bvh.cull(renderer::Frustum(rendering_context->scene_data.camera.view_proj), scheduler, visible_objects);
+    build_draw_list(rendering_context->scene_data.camera.view);
+
+    rendering_context->render_scene = &render_scene;
+    rendering_context->draw_list = &draw_list;
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    frame.stats.scene_extraction_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.f;
+    frame.stats.render_object_count = static_cast<int>(render_scene.size());
+    frame.stats.visible_object_count = static_cast<int>(visible_objects.size());
 }
 } // portal
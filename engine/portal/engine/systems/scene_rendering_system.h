@@ -8,21 +8,73 @@
 #include "portal/engine/ecs/system.h"
 #include "portal/engine/components/mesh.h"
 #include "portal/engine/components/transform.h"
+#include "portal/engine/renderer/draw_list.h"
+#include "portal/engine/renderer/render_scene.h"
+#include "portal/engine/renderer/culling/bounding_volume_hierarchy.h"
+#include "portal/engine/renderer/lighting/light_clusters.h"
 
 namespace portal
 {
 class SceneRenderingSystem : public ecs::System<SceneRenderingSystem, ecs::Owns<StaticMeshComponent>, ecs::Views<TransformComponent>>
 {
 public:
+    explicit SceneRenderingSystem(jobs::Scheduler& scheduler);
+
     void connect(ecs::Registry& registry, entt::dispatcher& dispatcher) override;
     void disconnect(ecs::Registry& registry, entt::dispatcher& dispatcher) override;
 
-    static void execute(FrameContext& frame, ecs::Registry& registry);
+    void execute(FrameContext& frame, ecs::Registry& registry);
+
+    static void declare_access(ecs::ComponentAccess& access);
 
     static void update_global_descriptors(FrameContext& frame, ecs::Registry& registry);
-    static void update_lights(FrameContext& frame, const ecs::Registry& registry);
-    static void add_static_mesh_to_context(FrameContext& frame, ecs::Registry& registry);
+    /**
+     * @brief Fills the scene lights and bins the point and spot lights into the view space light clusters.
+     */
+    void update_lights(FrameContext& frame, ecs::Registry& registry);
+    void add_static_mesh_to_context(FrameContext& frame, ecs::Registry& registry);
+
+    void on_component_added(Entity entity, StaticMeshComponent& static_mesh);
+    void on_component_removed(Entity entity, StaticMeshComponent& static_mesh);
+    void on_component_changed(Entity entity, StaticMeshComponent& static_mesh);
 
     [[nodiscard]] static StringId get_name() { return STRING_ID("Scene Rendering"); };
+
+private:
+    /**
+     * @brief Applies the mesh additions, removals and transform changes recorded since the last frame to the render scene.
+     */
+    void sync_render_scene(ecs::Registry& registry);
+
+    /**
+     * @brief Replaces the render objects of `entity` with its current submeshes.
+     *
+     * @return False if the mesh is not loaded yet and the entity should be retried
+     */
+    bool add_to_render_scene(entt::registry& registry, entt::entity entity);
+
+    /**
+     * @brief Keys the visible objects by their state and depth, and sorts them into the draw list.
+     */
+    void build_draw_list(const glm::mat4& view);
+
+private:
+    jobs::Scheduler& scheduler;
+
+    renderer::RenderScene render_scene;
+    bool render_scene_initialized = false;
+    std::vector<entt::entity> pending_refresh;
+    std::vector<entt::entity> pending_remove;
+    std::vector<entt::entity> refreshing;
+
+    renderer::BoundingVolumeHierarchy bvh;
+    uint64_t bvh_structure_version = 0;
+    std::vector<uint32_t> visible_objects;
+    std::vector<float> visible_depths;
+    renderer::DrawList draw_list;
+
+    std::vector<renderer::LightBounds> light_bounds;
+    renderer::LightClusterGrid light_clusters;
+    bool light_limit_warned = false;
 };
 } // portal
@@ -0,0 +1,282 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "transform_engine.h"
+
+#include <algorithm>
+#include <span>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/components/relationship.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/registry.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PORTAL_TRANSFORM_SSE 1
+#include <xmmintrin.h>
+#else
+#define PORTAL_TRANSFORM_SSE 0
+#endif
+
+namespace portal
+{
+namespace
+{
+    /**
+     * @brief `out = parent * local`, where local is an affine matrix given by its 3x3 basis (column major) and translation.
+     */
+    void compose_world(const glm::mat4& parent, const float* basis, const glm::vec3& translation, glm::mat4& out)
+    {
+#if PORTAL_TRANSFORM_SSE
+        const float* p = &parent[0][0];
+        const __m128 p0 = _mm_loadu_ps(p);
+        const __m128 p1 = _mm_loadu_ps(p + 4);
+        const __m128 p2 = _mm_loadu_ps(p + 8);
+        const __m128 p3 = _mm_loadu_ps(p + 12);
+
+        float* o = &out[0][0];
+        for (int column = 0; column < 3; ++column)
+        {
+            __m128 result = _mm_mul_ps(p0, _mm_set1_ps(basis[column * 3 + 0]));
+            result = _mm_add_ps(result, _mm_mul_ps(p1, _mm_set1_ps(basis[column * 3 + 1])));
+            result = _mm_add_ps(result, _mm_mul_ps(p2, _mm_set1_ps(basis[column * 3 + 2])));
+            _mm_storeu_ps(o + column * 4, result);
+        }
+
+        __m128 result = _mm_mul_ps(p0, _mm_set1_ps(translation.x));
+        result = _mm_add_ps(result, _mm_mul_ps(p1, _mm_set1_ps(translation.y)));
+        result = _mm_add_ps(result, _mm_mul_ps(p2, _mm_set1_ps(translation.z)));
+        _mm_storeu_ps(o + 12, _mm_add_ps(result, p3));
+#else
+        const glm::mat4 local{
+            glm::vec4(basis[0], basis[1], basis[2], 0.f),
+            glm::vec4(basis[3], basis[4], basis[5], 0.f),
+            glm::vec4(basis[6], basis[7], basis[8], 0.f),
+            glm::vec4(translation, 1.f)
+        };
+        out = parent * local;
+#endif
+    }
+}
+
+void TransformEngine::update(ecs::Registry& registry, jobs::Scheduler& scheduler)
+{
+    PORTAL_PROF_ZONE();
+    auto& raw_registry = registry.get_raw_registry();
+
+    const auto dirty_view = raw_registry.view<TransformDirtyTag>();
+    if (!layout_dirty && dirty_view.empty())
+        return;
+
+    if (layout_dirty)
+    {
+        rebuild_layout(raw_registry);
+    }
+    else
+    {
+        for (const auto entity : dirty_view)
+        {
+            const auto index = static_cast<size_t>(entt::to_entity(entity));
+            if (index >= slots.size() || slots[index] == NO_PARENT || entities[slots[index]] != entity)
+                continue;
+
+            load_local(raw_registry, slots[index]);
+            dirty[slots[index]] = 1;
+        }
+    }
+
+    // Levels only read the world matrices of previous levels, so the batches of a level are independent
+    llvm::SmallVector<Job<>> jobs;
+    for (size_t level = 0; level + 1 < level_offsets.size(); ++level)
+    {
+        const size_t begin = level_offsets[level];
+        const size_t end = level_offsets[level + 1];
+
+        if (end - begin <= BATCH_SIZE)
+        {
+            process_batch(raw_registry, begin, end);
+            continue;
+        }
+
+        jobs.clear();
+        for (size_t batch = begin; batch < end; batch += BATCH_SIZE)
+            jobs.push_back(process_batch_job(*this, raw_registry, batch, std::min(batch + BATCH_SIZE, end)));
+        scheduler.wait_for_jobs(std::span<Job<>>{jobs});
+    }
+
+    // Dirty flags were propagated to the children while processing, so they now cover every recomputed slot
+    for (size_t slot = 0; slot < dirty.size(); ++slot)
+    {
+        if (dirty[slot])
+            raw_registry.emplace_or_replace<WorldTransformChangedTag>(entities[slot]);
+    }
+
+    std::ranges::fill(dirty, uint8_t{0});
+    raw_registry.clear<TransformDirtyTag>();
+}
+
+void TransformEngine::rebuild_layout(entt::registry& registry)
+{
+    PORTAL_PROF_ZONE();
+
+    std::vector<std::pair<uint32_t, entt::entity>> order;
+    for (auto&& [entity, transform, relationship] : registry.view<TransformComponent, RelationshipComponent>().each())
+        order.emplace_back(relationship.depth, entity);
+    // Parents are always shallower than their children, so they end up in an earlier level
+    std::ranges::sort(order);
+
+    const auto count = order.size();
+    entities.resize(count);
+    parents.resize(count);
+    level_offsets.clear();
+    for (auto* values : {
+             &translation_x, &translation_y, &translation_z,
+             &rotation_x, &rotation_y, &rotation_z, &rotation_w,
+             &scale_x, &scale_y, &scale_z
+         })
+    {
+        values->resize(count);
+    }
+    for (auto& values : basis)
+        values.resize(count);
+    world.resize(count);
+    dirty.assign(count, 1);
+
+    slots.clear();
+    for (uint32_t slot = 0; slot < count; ++slot)
+    {
+        const auto [depth, entity] = order[slot];
+        entities[slot] = entity;
+
+        const auto index = static_cast<size_t>(entt::to_entity(entity));
+        if (index >= slots.size())
+            slots.resize(index + 1, NO_PARENT);
+        slots[index] = slot;
+
+        if (slot == 0 || order[slot - 1].first != depth)
+            level_offsets.push_back(slot);
+
+        load_local(registry, slot);
+    }
+    level_offsets.push_back(static_cast<uint32_t>(count));
+
+    for (uint32_t slot = 0; slot < count; ++slot)
+    {
+        const auto& parent = registry.get<RelationshipComponent>(entities[slot]).parent;
+        parents[slot] = NO_PARENT;
+        if (parent != null_entity && parent.has_component<TransformComponent>())
+            parents[slot] = slots[static_cast<size_t>(entt::to_entity(parent.get_id()))];
+    }
+
+    layout_dirty = false;
+}
+
+void TransformEngine::load_local(entt::registry& registry, const uint32_t slot)
+{
+    const auto& transform = registry.get<TransformComponent>(entities[slot]);
+    const auto& translation = transform.get_translation();
+    const auto& rotation = transform.get_rotation();
+    const auto& scale = transform.get_scale();
+
+    translation_x[slot] = translation.x;
+    translation_y[slot] = translation.y;
+    translation_z[slot] = translation.z;
+    rotation_x[slot] = rotation.x;
+    rotation_y[slot] = rotation.y;
+    rotation_z[slot] = rotation.z;
+    rotation_w[slot] = rotation.w;
+    scale_x[slot] = scale.x;
+    scale_y[slot] = scale.y;
+    scale_z[slot] = scale.z;
+}
+
+void TransformEngine::process_batch(entt::registry& registry, const size_t begin, const size_t end)
+{
+    // Dirty flags flow down from the parents, which belong to a level that is already done
+    bool any_dirty = false;
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+        const auto parent = parents[slot];
+        if (parent != NO_PARENT)
+            dirty[slot] |= dirty[parent];
+        any_dirty |= dirty[slot] != 0;
+    }
+
+    if (!any_dirty)
+        return;
+
+    // Quaternion to rotation matrix, scaled per column, written as plain loops over the SoA arrays so they vectorize
+    const float* qx = rotation_x.data();
+    const float* qy = rotation_y.data();
+    const float* qz = rotation_z.data();
+    const float* qw = rotation_w.data();
+    const float* sx = scale_x.data();
+    const float* sy = scale_y.data();
+    const float* sz = scale_z.data();
+    float* m00 = basis[0].data();
+    float* m10 = basis[1].data();
+    float* m20 = basis[2].data();
+    float* m01 = basis[3].data();
+    float* m11 = basis[4].data();
+    float* m21 = basis[5].data();
+    float* m02 = basis[6].data();
+    float* m12 = basis[7].data();
+    float* m22 = basis[8].data();
+
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+        const float xx = qx[slot] * qx[slot];
+        const float yy = qy[slot] * qy[slot];
+        const float zz = qz[slot] * qz[slot];
+        const float xy = qx[slot] * qy[slot];
+        const float xz = qx[slot] * qz[slot];
+        const float yz = qy[slot] * qz[slot];
+        const float wx = qw[slot] * qx[slot];
+        const float wy = qw[slot] * qy[slot];
+        const float wz = qw[slot] * qz[slot];
+
+        m00[slot] = (1.f - 2.f * (yy + zz)) * sx[slot];
+        m10[slot] = 2.f * (xy + wz) * sx[slot];
+        m20[slot] = 2.f * (xz - wy) * sx[slot];
+
+        m01[slot] = 2.f * (xy - wz) * sy[slot];
+        m11[slot] = (1.f - 2.f * (xx + zz)) * sy[slot];
+        m21[slot] = 2.f * (yz + wx) * sy[slot];
+
+        m02[slot] = 2.f * (xz + wy) * sz[slot];
+        m12[slot] = 2.f * (yz - wx) * sz[slot];
+        m22[slot] = (1.f - 2.f * (xx + yy)) * sz[slot];
+    }
+
+    static const glm::mat4 identity{1.0f};
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+        if (!dirty[slot])
+            continue;
+
+        const float local_basis[9] = {
+            m00[slot], m10[slot], m20[slot],
+            m01[slot], m11[slot], m21[slot],
+            m02[slot], m12[slot], m22[slot]
+        };
+        const glm::vec3 translation{translation_x[slot], translation_y[slot], translation_z[slot]};
+
+        const auto parent = parents[slot];
+        compose_world(parent == NO_PARENT ? identity : world[parent], local_basis, translation, world[slot]);
+
+        // Lookups only, safe to do from several jobs as long as the registry is not modified
+        registry.get<TransformComponent>(entities[slot]).get_world_matrix() = world[slot];
+    }
+}
+
+Job<> TransformEngine::process_batch_job(TransformEngine& engine, entt::registry& registry, const size_t begin, const size_t end)
+{
+    PORTAL_PROF_ZONE();
+    engine.process_batch(registry, begin, end);
+    co_return;
+}
+} // portal
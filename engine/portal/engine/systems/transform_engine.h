@@ -0,0 +1,93 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include <entt/entity/registry.hpp>
+
+#include "portal/core/glm.h"
+#include "portal/core/jobs/job.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+
+namespace ecs
+{
+    class Registry;
+}
+
+/**
+ * @brief Parallel world matrix propagation over a structure of arrays copy of the transform hierarchy.
+ *
+ * Every entity with a `TransformComponent` gets a slot, slots are sorted by hierarchy depth and grouped into levels.
+ * Local transforms are kept in SoA arrays and parents are referenced by slot index, so a level only reads the world
+ * matrices of the levels before it. Each level is split into batches that run as a parallel-for on the scheduler:
+ * the local matrices of a batch are composed in branch free loops over the SoA arrays, and the world matrices are
+ * multiplied with SSE where available. Results are written back into `TransformComponent` for the rest of the engine.
+ *
+ * Only dirty slots (tagged with `TransformDirtyTag`) and their descendants are recomputed. The level layout is rebuilt
+ * lazily after `invalidate_layout`, which must be called whenever the hierarchy changes (reparenting, creating or
+ * destroying transforms).
+ */
+class TransformEngine
+{
+public:
+    /** @brief Number of slots processed by a single job */
+    constexpr static size_t BATCH_SIZE = 1024;
+
+    /**
+     * @brief Marks the level layout as stale, it is rebuilt (and every transform recomputed) on the next update.
+     */
+    void invalidate_layout() { layout_dirty = true; }
+
+    /**
+     * @brief Recomputes the world matrices of every dirty transform and its descendants, and clears the dirty tags.
+     *
+     * Structural changes to the registry must not happen while this runs.
+     */
+    void update(ecs::Registry& registry, jobs::Scheduler& scheduler);
+
+    [[nodiscard]] size_t size() const { return entities.size(); }
+    [[nodiscard]] size_t get_level_count() const { return level_offsets.empty() ? 0 : level_offsets.size() - 1; }
+
+private:
+    constexpr static uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+    void rebuild_layout(entt::registry& registry);
+    void load_local(entt::registry& registry, uint32_t slot);
+    void process_batch(entt::registry& registry, size_t begin, size_t end);
+
+    static Job<> process_batch_job(TransformEngine& engine, entt::registry& registry, size_t begin, size_t end);
+
+private:
+    std::vector<entt::entity> entities;
+    std::vector<uint32_t> parents;
+    // Slot ranges of each level, level `i` spans [level_offsets[i], level_offsets[i + 1])
+    std::vector<uint32_t> level_offsets;
+    // Maps an entity index (`entt::to_entity`) to its slot
+    std::vector<uint32_t> slots;
+
+    // Local transforms
+    std::vector<float> translation_x, translation_y, translation_z;
+    std::vector<float> rotation_x, rotation_y, rotation_z, rotation_w;
+    std::vector<float> scale_x, scale_y, scale_z;
+
+    // Rotation * scale part of the local matrices, column major, only valid for the batch being processed
+    std::array<std::vector<float>, 9> basis;
+
+    std::vector<glm::mat4> world;
+    std::vector<uint8_t> dirty;
+
+    bool layout_dirty = true;
+};
+} // portal
@@ -5,68 +5,117 @@
 
 #include "transform_hierarchy_system.h"
 
+#include <algorithm>
+
 #include "portal/engine/components/base.h"
 #include "portal/engine/components/relationship.h"
 #include "portal/core/log.h"
 
 namespace portal
 {
+TransformHierarchySystem::TransformHierarchySystem(const ecs::ExecutionPolicy policy) : System(policy) {}
+
 void TransformHierarchySystem::connect(ecs::Registry&, entt::dispatcher&) {}
 void TransformHierarchySystem::disconnect(ecs::Registry&, entt::dispatcher&) {}
 
+void TransformHierarchySystem::declare_access(ecs::ComponentAccess& access)
+{
+    access.write<WorldTransformChangedTag>();
+}
+
 void TransformHierarchySystem::execute(ecs::Registry& registry)
 {
-    const auto transforms_to_update = group(registry);
+    PORTAL_PROF_ZONE();
 
-    auto get_depth = [&registry](entt::entity e) -> int
-    {
-        int depth = 0;
-        auto entity = registry.entity_from_id(e);
-        while (entity.get_component<RelationshipComponent>().parent != null_entity)
-        {
-            entity = entity.get_component<RelationshipComponent>().parent;
-            ++depth;
-        }
-        return depth;
-    };
+    dirty_entities.clear();
+    for (auto&& [entity_raw, transform, relationship] : group(registry).each())
+        dirty_entities.emplace_back(relationship.depth, entity_raw);
 
-    transforms_to_update.sort(
-        [&get_depth](const entt::entity lhs_raw, const entt::entity rhs_raw)
-        {
-            const int left_depth = get_depth(lhs_raw);
-            const int right_depth = get_depth(rhs_raw);
+    if (dirty_entities.empty())
+        return;
 
-            if (left_depth != right_depth)
-                return left_depth < right_depth;
+    // Shallow entities first, a dirty entity below another dirty entity is then already handled by its ancestor's subtree
+    std::ranges::sort(dirty_entities);
 
-            return lhs_raw < rhs_raw;
-        }
-    );
+    auto& raw_registry = registry.get_raw_registry();
+    for (const auto& [depth, entity_raw] : dirty_entities)
+    {
+        if (raw_registry.all_of<TransformDirtyTag>(entity_raw))
+            update_subtree(raw_registry, entity_raw);
+    }
+}
+
+Job<> TransformHierarchySystem::execute(ecs::Registry& registry, jobs::Scheduler& scheduler)
+{
+    PORTAL_PROF_ZONE();
+    transform_engine.update(registry, scheduler);
+    co_return;
+}
 
-    for (auto&& [entity_raw, transform, relationship] : transforms_to_update.each())
+void TransformHierarchySystem::update_subtree(entt::registry& registry, const entt::entity root)
+{
+    // Depth first, a child is only pushed once its parent's world matrix is up to date
+    pending.clear();
+    pending.push_back(root);
+    while (!pending.empty())
     {
-        auto parent_matrix = glm::mat4(1.0f);
-        if (relationship.parent != null_entity)
+        const auto entity_raw = pending.back();
+        pending.pop_back();
+
+        const auto& relationship = registry.get<RelationshipComponent>(entity_raw);
+        if (auto* transform = registry.try_get<TransformComponent>(entity_raw))
         {
-            if (relationship.parent.has_component<TransformComponent>())
+            auto parent_matrix = glm::mat4(1.0f);
+            if (relationship.parent != null_entity)
             {
-                auto& parent_transform = relationship.parent.get_component<TransformComponent>();
-                parent_matrix = parent_transform.get_world_matrix();
+                if (const auto* parent_transform = relationship.parent.try_get_component<TransformComponent>())
+                    parent_matrix = parent_transform->get_world_matrix();
             }
+            transform->calculate_world_matrix(parent_matrix);
+            registry.emplace_or_replace<WorldTransformChangedTag>(entity_raw);
         }
-        transform.calculate_world_matrix(parent_matrix);
-    }
+        registry.remove<TransformDirtyTag>(entity_raw);
 
-    registry.clear<TransformDirtyTag>();
+        for (auto child = relationship.first; child != null_entity; child = child.get_component<RelationshipComponent>().next)
+            pending.push_back(child.get_id());
+    }
 }
 
 void TransformHierarchySystem::on_component_added(const Entity entity, TransformComponent&)
 {
     entity.get_registry().emplace_or_replace<TransformDirtyTag>(entity);
+    transform_engine.invalidate_layout();
+}
+
+void TransformHierarchySystem::on_entities_spawned(entt::registry& registry, const std::span<const entt::entity> entities)
+{
+    // One bulk insert of the dirty tags and a single layout invalidation, instead of one of each per spawned entity
+    const auto& transforms = registry.storage<TransformComponent>();
+    pending.clear();
+    for (const auto entity_raw : entities)
+    {
+        if (transforms.contains(entity_raw) && !registry.all_of<TransformDirtyTag>(entity_raw))
+            pending.push_back(entity_raw);
+    }
+    registry.insert<TransformDirtyTag>(pending.begin(), pending.end());
+    transform_engine.invalidate_layout();
+}
+
+void TransformHierarchySystem::on_component_removed(Entity, TransformComponent&)
+{
+    transform_engine.invalidate_layout();
 }
 
 void TransformHierarchySystem::on_component_changed(const Entity entity, TransformComponent&)
 {
     entity.get_registry().emplace_or_replace<TransformDirtyTag>(entity);
 }
+
+void TransformHierarchySystem::on_component_changed(const Entity entity, RelationshipComponent&)
+{
+    // Reparenting moves the whole subtree under a new parent matrix
+    if (entity.has_component<TransformComponent>())
+        entity.get_registry().emplace_or_replace<TransformDirtyTag>(entity);
+    transform_engine.invalidate_layout();
+}
 } // portal
@@ -9,20 +9,52 @@
 
 #include "portal/engine/components/transform.h"
 #include "portal/engine/components/relationship.h"
+#include "portal/engine/systems/transform_engine.h"
 
 namespace portal
 {
+/**
+ * @brief Recomputes the world matrices of dirty transforms and of everything below them in the hierarchy.
+ *
+ * Entities are marked with `TransformDirtyTag` when their transform or their parent changes. Each frame the dirty
+ * entities are ordered by their cached hierarchy depth (`RelationshipComponent::depth`), and every dirty subtree is
+ * recomputed once, parents before children. Clean subtrees are not touched. Every entity whose world matrix was
+ * recomputed is tagged with `WorldTransformChangedTag`.
+ *
+ * Entities spawned with `Registry::spawn_bulk` are tagged dirty in one batch by `on_entities_spawned`.
+ *
+ * With the `Parallel` policy the update is delegated to a `TransformEngine`, which propagates the world matrices level
+ * by level over a SoA copy of the hierarchy using the job scheduler.
+ */
 class TransformHierarchySystem final : public ecs::System<TransformHierarchySystem, ecs::Owns<TransformDirtyTag>, ecs::Owns<TransformComponent>, ecs::Views<RelationshipComponent>>
 {
 public:
+    explicit TransformHierarchySystem(ecs::ExecutionPolicy policy = ecs::ExecutionPolicy::Sequential);
+
     void connect(ecs::Registry& registry, entt::dispatcher& dispatcher) override;
     void disconnect(ecs::Registry& registry, entt::dispatcher& dispatcher) override;
 
-    static void execute(ecs::Registry& registry);
+    static void declare_access(ecs::ComponentAccess& access);
+
+    void execute(ecs::Registry& registry);
+    Job<> execute(ecs::Registry& registry, jobs::Scheduler& scheduler);
 
-    static void on_component_added(Entity entity, TransformComponent& transform);
+    void on_component_added(Entity entity, TransformComponent& transform);
+    void on_component_removed(Entity entity, TransformComponent& transform);
     static void on_component_changed(Entity entity, TransformComponent& transform);
+    void on_component_changed(Entity entity, RelationshipComponent& relationship);
+    void on_entities_spawned(entt::registry& registry, std::span<const entt::entity> entities);
 
     [[nodiscard]] static StringId get_name() { return STRING_ID("Transform Hierarchy"); };
+
+private:
+    void update_subtree(entt::registry& registry, entt::entity root);
+
+private:
+    // Scratch buffers, kept between frames to avoid reallocating them
+    std::vector<std::pair<uint32_t, entt::entity>> dirty_entities;
+    std::vector<entt::entity> pending;
+
+    TransformEngine transform_engine;
 };
 } // portal
@@ -0,0 +1,127 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/glm.h"
+#include "portal/engine/components/base.h"
+#include "portal/engine/components/relationship.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/prefab.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/systems/transform_hierarchy_system.h"
+
+using namespace portal;
+
+SCENARIO("Prefabs precompute their hierarchy")
+{
+    GIVEN("A root with two children and a grandchild")
+    {
+        ecs::Prefab prefab;
+        const auto first = prefab.add_node(ecs::Prefab::ROOT);
+        const auto second = prefab.add_node(ecs::Prefab::ROOT);
+        const auto grandchild = prefab.add_node(first);
+
+        THEN("The node links match the hierarchy")
+        {
+            const auto nodes = prefab.get_nodes();
+            REQUIRE(prefab.get_node_count() == 4);
+            REQUIRE(nodes[ecs::Prefab::ROOT].children == 2);
+            REQUIRE(nodes[ecs::Prefab::ROOT].first_child == first);
+            REQUIRE(nodes[first].next == second);
+            REQUIRE(nodes[second].prev == first);
+            REQUIRE(nodes[second].next == ecs::Prefab::NO_NODE);
+            REQUIRE(nodes[grandchild].parent == first);
+            REQUIRE(nodes[grandchild].depth == 2);
+        }
+    }
+
+    GIVEN("A component set twice on a node")
+    {
+        ecs::Prefab prefab;
+        prefab.set_component(ecs::Prefab::ROOT, TransformComponent{glm::vec3{1.f}});
+        prefab.set_component(ecs::Prefab::ROOT, TransformComponent{glm::vec3{2.f}});
+
+        THEN("The last value replaces the first")
+        {
+            REQUIRE(prefab.get_components().size() == 1);
+        }
+    }
+}
+
+SCENARIO("Registry spawns prefab instances in bulk")
+{
+    ModuleStack stack;
+    auto& registry = stack.add_module<ecs::Registry>();
+    auto& raw_registry = registry.get_raw_registry();
+
+    TransformHierarchySystem transform_system;
+    transform_system.register_to(registry);
+
+    ecs::Prefab prefab;
+    prefab.set_component(ecs::Prefab::ROOT, NameComponent{STRING_ID("prop")});
+    prefab.set_component(ecs::Prefab::ROOT, TransformComponent{});
+    const auto part = prefab.add_node(ecs::Prefab::ROOT);
+    prefab.set_component(part, TransformComponent{glm::vec3{0.f, 1.f, 0.f}});
+
+    GIVEN("A transform per instance")
+    {
+        constexpr size_t count = 100;
+        std::vector<glm::mat4> transforms;
+        for (size_t i = 0; i < count; ++i)
+            transforms.push_back(glm::translate(glm::mat4(1.f), glm::vec3{static_cast<float>(i), 0.f, 0.f}));
+
+        WHEN("The prefab is spawned")
+        {
+            const auto entities = registry.spawn_bulk(prefab, count, transforms);
+
+            THEN("Every instance is linked to its own entities")
+            {
+                REQUIRE(entities.size() == count * prefab.get_node_count());
+                for (size_t instance = 0; instance < count; ++instance)
+                {
+                    const auto root = registry.entity_from_id(entities[instance]);
+                    const auto child = registry.entity_from_id(entities[part * count + instance]);
+
+                    REQUIRE(root.get_component<RelationshipComponent>().children == 1);
+                    REQUIRE(root.get_component<RelationshipComponent>().first == child);
+                    REQUIRE(child.get_parent() == root);
+                    REQUIRE(child.get_component<RelationshipComponent>().depth == 1);
+                }
+            }
+
+            THEN("The spawned names are indexed")
+            {
+                REQUIRE(registry.find_all_by_name(STRING_ID("prop")).size() == count);
+            }
+
+            THEN("Every transform is dirty, and world matrices include the instance transform")
+            {
+                REQUIRE(raw_registry.storage<TransformDirtyTag>().size() == entities.size());
+
+                transform_system.execute(registry);
+                for (size_t instance = 0; instance < count; ++instance)
+                {
+                    const auto& world = raw_registry.get<TransformComponent>(entities[part * count + instance]).get_world_matrix();
+                    REQUIRE(world[3] == glm::vec4{static_cast<float>(instance), 1.f, 0.f, 1.f});
+                }
+            }
+        }
+    }
+
+    GIVEN("No instances")
+    {
+        THEN("Nothing is spawned")
+        {
+            REQUIRE(registry.spawn_bulk(prefab, 0).empty());
+        }
+    }
+
+    registry.clear();
+    transform_system.unregister_from(registry);
+}
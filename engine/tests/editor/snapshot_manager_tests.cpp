@@ -0,0 +1,198 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <ranges>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../resources/registry/registry_fixture.h"
+#include "portal/core/glm.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/editor/snapshot_manager.h"
+#include "portal/engine/resources/loader/scene_loader.h"
+#include "portal/engine/scene/scene.h"
+
+using namespace portal;
+using namespace portal::test;
+
+namespace
+{
+const auto PROJECT_PATH = std::filesystem::temp_directory_path() / "portal_snapshot_test";
+
+/** @brief Creates empty scenes, snapshots are taken and loaded by the scene loader */
+class EmptySceneLoader final : public resources::ResourceLoader
+{
+public:
+    explicit EmptySceneLoader(ResourceRegistry& registry) : ResourceLoader(registry), scene_loader(registry) {}
+
+    resources::ResourceData load(const SourceMetadata& meta, Reference<resources::ResourceSource> source) override
+    {
+        return {
+            .resource = make_reference<Scene>(meta.resource_id, registry.get_ecs_registry()),
+            .source = source,
+            .metadata = meta
+        };
+    }
+
+    void save(resources::ResourceData&) override {}
+
+    void snapshot(const resources::ResourceData& resource_data, const Reference<resources::ResourceSource> snapshot_source) override
+    {
+        scene_loader.snapshot(resource_data, snapshot_source);
+    }
+
+    void load_snapshot(const resources::ResourceData& resource_data, const Reference<resources::ResourceSource> snapshot_source) override
+    {
+        scene_loader.load_snapshot(resource_data, snapshot_source);
+    }
+
+private:
+    resources::SceneLoader scene_loader;
+};
+
+/** @brief A scene holding a single entity, every snapshot records a different translation of that entity */
+struct SnapshotFixture
+{
+    explicit SnapshotFixture(const size_t keyframe_interval) :
+        snapshot_manager(fixture.registry, {}, keyframe_interval)
+    {
+        const auto scene_id = STRING_ID("scene");
+        database.add_resource(scene_id, ResourceType::Scene, 0);
+        fixture.registry.set_loader(ResourceType::Scene, std::make_shared<EmptySceneLoader>(fixture.registry));
+
+        scene = fixture.registry.immediate_load<Scene>(scene_id);
+        entity = fixture.ecs_registry.create_child_entity(scene->get_scene_entity(), STRING_ID("cube"));
+        entity.add_component<TransformComponent>();
+
+        snapshot_manager.set_scene_id(scene_id);
+    }
+
+    /** @brief Moves the entity to `x`, then takes a snapshot of the scene */
+    void take_snapshot(const float x)
+    {
+        move(x);
+        snapshot_manager.prepare_snapshot(STRING_ID(fmt::format("snapshot_{}", x)));
+        snapshot_manager.commit_snapshot();
+    }
+
+    void move(const float x)
+    {
+        entity.patch_component<TransformComponent>([x](auto& transform) { transform.set_translation(glm::vec3{x, 0.f, 0.f}); });
+    }
+
+    [[nodiscard]] float get_x() const
+    {
+        return entity.get_component<TransformComponent>().get_translation().x;
+    }
+
+    [[nodiscard]] std::vector<size_t> list_slots() const
+    {
+        return snapshot_manager.list_snapshots() | std::views::transform(&SnapshotManager::SnapshotView::index) | std::ranges::to<std::vector>();
+    }
+
+    [[nodiscard]] std::vector<size_t> list_keyframes() const
+    {
+        return snapshot_manager.list_snapshots()
+            | std::views::filter(&SnapshotManager::SnapshotView::keyframe)
+            | std::views::transform(&SnapshotManager::SnapshotView::index)
+            | std::ranges::to<std::vector>();
+    }
+
+    MemoryDatabase database;
+    RegistryFixture fixture{database, PROJECT_PATH};
+    ResourceReference<Scene> scene;
+    Entity entity;
+    SnapshotManager snapshot_manager;
+};
+}
+
+SCENARIO("Undo and redo restore delta snapshots across a keyframe boundary")
+{
+    SnapshotFixture snapshots(4);
+
+    GIVEN("Six snapshots with a keyframe every fourth snapshot")
+    {
+        for (size_t index = 0; index < 6; ++index)
+            snapshots.take_snapshot(static_cast<float>(index));
+
+        REQUIRE(snapshots.list_slots() == std::vector<size_t>{0, 1, 2, 3, 4, 5});
+        REQUIRE(snapshots.list_keyframes() == std::vector<size_t>{0, 4});
+
+        // An edit that was never snapshot, undo drops it
+        snapshots.move(100.f);
+
+        WHEN("Undoing past the second keyframe")
+        {
+            snapshots.snapshot_manager.undo();
+            REQUIRE(snapshots.get_x() == 5.f);
+            snapshots.snapshot_manager.undo();
+            REQUIRE(snapshots.get_x() == 4.f);
+            snapshots.snapshot_manager.undo();
+
+            THEN("The delta before it is restored from the first keyframe")
+            {
+                REQUIRE(snapshots.get_x() == 3.f);
+                REQUIRE(snapshots.snapshot_manager.get_current_snapshot_index() == 3);
+            }
+
+            AND_WHEN("Redoing back over the keyframe")
+            {
+                snapshots.snapshot_manager.redo();
+                REQUIRE(snapshots.get_x() == 4.f);
+                snapshots.snapshot_manager.redo();
+
+                THEN("The delta after the keyframe is restored")
+                {
+                    REQUIRE(snapshots.get_x() == 5.f);
+                    REQUIRE_FALSE(snapshots.snapshot_manager.can_redo());
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Snapshots that wrap around the ring rebase onto the next keyframe")
+{
+    SnapshotFixture snapshots(3);
+
+    GIVEN("One more snapshot than the ring holds, with a keyframe every third snapshot")
+    {
+        // Keyframes are in slots 0, 3, 6, 9, 12 and 15, the last snapshot is written over the first keyframe
+        for (size_t index = 0; index <= static_cast<size_t>(MAX_SNAPSHOTS); ++index)
+            snapshots.take_snapshot(static_cast<float>(index));
+
+        THEN("The deltas of the overwritten keyframe are dropped")
+        {
+            const auto slots = snapshots.list_slots();
+            REQUIRE(slots.size() == static_cast<size_t>(MAX_SNAPSHOTS) - 2);
+            REQUIRE(slots.front() == 0);
+            REQUIRE(slots[1] == 3);
+            REQUIRE(snapshots.list_keyframes() == std::vector<size_t>{3, 6, 9, 12, 15});
+        }
+
+        THEN("The oldest remaining chain is restored from its keyframe")
+        {
+            snapshots.snapshot_manager.revert_snapshot(3);
+            REQUIRE(snapshots.get_x() == 3.f);
+            snapshots.snapshot_manager.revert_snapshot(5);
+            REQUIRE(snapshots.get_x() == 5.f);
+        }
+
+        THEN("The newest snapshot is a delta of the keyframe at the end of the ring")
+        {
+            snapshots.snapshot_manager.revert_snapshot(3);
+            snapshots.snapshot_manager.revert_snapshot(0);
+            REQUIRE(snapshots.get_x() == static_cast<float>(MAX_SNAPSHOTS));
+            REQUIRE(snapshots.snapshot_manager.can_undo());
+        }
+
+        THEN("Dropped snapshots cannot be restored")
+        {
+            snapshots.snapshot_manager.revert_snapshot(1);
+            REQUIRE(snapshots.get_x() == static_cast<float>(MAX_SNAPSHOTS));
+            REQUIRE_FALSE(snapshots.snapshot_manager.can_redo());
+        }
+    }
+}
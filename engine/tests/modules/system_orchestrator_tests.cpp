@@ -0,0 +1,259 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+#include <entt/signal/dispatcher.hpp>
+
+#include "portal/application/frame_context.h"
+#include "portal/application/settings.h"
+#include "portal/application/modules/module_stack.h"
+#include "portal/engine/components/base.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/change_tracker.h"
+#include "portal/engine/ecs/system.h"
+#include "portal/engine/modules/system_orchestrator.h"
+
+using namespace portal;
+
+namespace
+{
+ProjectSettings make_settings(const std::string_view content)
+{
+    const auto root_path = std::filesystem::temp_directory_path() / "portal_orchestrator_test";
+    std::filesystem::remove_all(root_path);
+    std::filesystem::create_directories(root_path);
+    std::ofstream(root_path / "settings.json") << content;
+    return ProjectSettings::create_settings(SettingsArchiveType::Json, root_path, "settings.json");
+}
+
+/** @brief An orchestrator without the built in systems, only the systems registered by a scenario run */
+struct OrchestratorFixture
+{
+    explicit OrchestratorFixture(const std::string_view settings_content = "{}") :
+        settings(make_settings(settings_content)),
+        registry(stack.add_module<ecs::Registry>())
+    {
+        stack.add_module<SchedulerModule>(2);
+        stack.add_module<InputManager>(engine_dispatcher, input_dispatcher);
+        orchestrator = &stack.add_module<SystemOrchestrator>(settings);
+
+        for (const auto& name : {
+                 BasePlayerInputSystem::get_name(),
+                 BaseCameraSystem::get_name(),
+                 SceneRenderingSystem::get_name(),
+                 TransformHierarchySystem::get_name()
+             })
+            orchestrator->unregister_system(name);
+    }
+
+    void run_frame()
+    {
+        FrameContext frame{};
+        frame.ecs_registry = &registry;
+        orchestrator->update(frame);
+    }
+
+    ProjectSettings settings;
+    entt::dispatcher engine_dispatcher;
+    entt::dispatcher input_dispatcher;
+
+    ModuleStack stack;
+    ecs::Registry& registry;
+    SystemOrchestrator* orchestrator = nullptr;
+};
+
+class MoveSystem final : public ecs::System<MoveSystem, ecs::Views<TransformComponent>>
+{
+public:
+    [[nodiscard]] static StringId get_name() { return STRING_ID("Move"); }
+
+    static void declare_access(ecs::ComponentAccess& access)
+    {
+        access.write<TransformComponent>();
+    }
+
+    void execute(ecs::Registry& registry)
+    {
+        auto& raw_registry = registry.get_raw_registry();
+        for (const auto entity : group(registry))
+            raw_registry.patch<TransformComponent>(entity, [](auto& transform) { transform.set_translation(glm::vec3{1.f}); });
+    }
+};
+
+class RenameSystem final : public ecs::System<RenameSystem, ecs::Views<NameComponent>>
+{
+public:
+    // Names are created up front, creating string ids is not thread safe
+    explicit RenameSystem(std::unordered_map<StringId, StringId> renames) : renames(std::move(renames)) {}
+
+    [[nodiscard]] static StringId get_name() { return STRING_ID("Rename"); }
+
+    static void declare_access(ecs::ComponentAccess& access)
+    {
+        access.write<NameComponent>();
+    }
+
+    void execute(ecs::Registry& registry)
+    {
+        auto& raw_registry = registry.get_raw_registry();
+        for (const auto entity : group(registry))
+        {
+            const auto it = renames.find(raw_registry.get<NameComponent>(entity).name);
+            if (it != renames.end())
+                raw_registry.patch<NameComponent>(entity, [&it](auto& name) { name.name = it->second; });
+        }
+    }
+
+private:
+    std::unordered_map<StringId, StringId> renames;
+};
+
+/** @brief Systems that all write the same component, so they run one after the other, each one records when it runs */
+template <size_t Index>
+class OrderedSystem final : public ecs::System<OrderedSystem<Index>, ecs::Views<TransformComponent>>
+{
+public:
+    // The name is created up front, creating string ids is not thread safe
+    explicit OrderedSystem(std::vector<StringId>& log) : name(get_name()), log(log) {}
+
+    [[nodiscard]] static StringId get_name() { return STRING_ID(fmt::format("Ordered{}", Index)); }
+
+    static void declare_access(ecs::ComponentAccess& access)
+    {
+        access.write<TransformComponent>();
+    }
+
+    void execute(ecs::Registry&)
+    {
+        log.push_back(name);
+    }
+
+private:
+    StringId name;
+    std::vector<StringId>& log;
+};
+}
+
+SCENARIO("Systems writing different components run concurrently with a change tracker attached")
+{
+    constexpr size_t entity_count = 2048;
+
+    OrchestratorFixture fixture;
+    auto& registry = fixture.registry;
+
+    std::unordered_map<StringId, StringId> renames;
+    for (size_t index = 0; index < entity_count; ++index)
+    {
+        const auto name = STRING_ID(fmt::format("entity_{}", index));
+        renames[name] = STRING_ID(fmt::format("renamed_{}", index));
+        std::ignore = registry.create_entity(name, TransformComponent{});
+    }
+
+    fixture.orchestrator->register_system<MoveSystem>({});
+    fixture.orchestrator->register_system<RenameSystem>({}, renames);
+
+    ecs::ChangeTracker tracker;
+    tracker.attach(registry);
+
+    GIVEN("A frame in which both systems run")
+    {
+        fixture.run_frame();
+
+        THEN("Every entity is recorded once under its new name")
+        {
+            const auto changes = tracker.consume();
+            REQUIRE(changes.size() == entity_count);
+            for (const auto& [entity, name] : changes)
+            {
+                REQUIRE(name.string.starts_with("renamed_"));
+                REQUIRE(registry.get_raw_registry().get<TransformComponent>(entity).get_translation() == glm::vec3{1.f});
+            }
+        }
+
+        THEN("The name index only holds the new names")
+        {
+            for (const auto& [name, renamed] : renames)
+            {
+                REQUIRE_FALSE(registry.find_by_name(name).has_value());
+                REQUIRE(registry.find_all_by_name(renamed).size() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("Conflicting systems run in the configured order, unless run_after says otherwise")
+{
+    const auto first = OrderedSystem<0>::get_name();
+    const auto second = OrderedSystem<1>::get_name();
+    const auto third = OrderedSystem<2>::get_name();
+
+    std::vector<StringId> log;
+
+    GIVEN("No configured order")
+    {
+        OrchestratorFixture fixture;
+
+        WHEN("A system runs after a system registered after it")
+        {
+            fixture.orchestrator->register_system<OrderedSystem<0>>({}, log);
+            fixture.orchestrator->register_system<OrderedSystem<1>>({third}, log);
+            fixture.orchestrator->register_system<OrderedSystem<2>>({}, log);
+            fixture.run_frame();
+
+            THEN("The other systems keep their registration order")
+            {
+                REQUIRE(log == std::vector{first, third, second});
+            }
+        }
+    }
+
+    GIVEN("An order configured in systems.order")
+    {
+        OrchestratorFixture fixture(R"({"systems": {"order": ["Ordered0", "Ordered1", "Ordered2"]}})");
+
+        WHEN("The systems are registered in reverse")
+        {
+            fixture.orchestrator->register_system<OrderedSystem<2>>({}, log);
+            fixture.orchestrator->register_system<OrderedSystem<1>>({}, log);
+            fixture.orchestrator->register_system<OrderedSystem<0>>({}, log);
+            fixture.run_frame();
+
+            THEN("They run in the configured order")
+            {
+                REQUIRE(log == std::vector{first, second, third});
+            }
+        }
+
+        WHEN("The first configured system runs after the last one")
+        {
+            fixture.orchestrator->register_system<OrderedSystem<0>>({third}, log);
+            fixture.orchestrator->register_system<OrderedSystem<1>>({}, log);
+            fixture.orchestrator->register_system<OrderedSystem<2>>({}, log);
+            fixture.run_frame();
+
+            THEN("run_after wins over the configured order")
+            {
+                REQUIRE(log == std::vector{second, third, first});
+            }
+        }
+    }
+
+    GIVEN("Two systems that run after each other")
+    {
+        OrchestratorFixture fixture(R"({"systems": {"order": ["Ordered2", "Ordered1", "Ordered0"]}})");
+
+        fixture.orchestrator->register_system<OrderedSystem<0>>({second}, log);
+        fixture.orchestrator->register_system<OrderedSystem<1>>({first}, log);
+        fixture.orchestrator->register_system<OrderedSystem<2>>({}, log);
+        fixture.run_frame();
+
+        THEN("The systems in the cycle fall back to the configured order, after the systems that are free to run")
+        {
+            REQUIRE(log == std::vector{third, second, first});
+        }
+    }
+}
@@ -0,0 +1,184 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "portal/core/glm.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/culling/bounding_volume_hierarchy.h"
+#include "portal/engine/renderer/culling/frustum.h"
+
+using namespace portal;
+using namespace portal::renderer;
+
+namespace
+{
+// Looks down -z from the origin, the visible box is x and y in [-10, 10] and z in [-50, -0.1]
+Frustum make_ortho_frustum()
+{
+    return Frustum(glm::orthoZO(-10.f, 10.f, -10.f, 10.f, 0.1f, 50.f));
+}
+
+// A 16^3 grid of unit boxes, partly outside the frustum on every axis
+std::vector<BoundingBox> make_grid(const glm::vec3& offset = glm::vec3{0.f})
+{
+    constexpr size_t side = 16;
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(side * side * side);
+    for (size_t x = 0; x < side; ++x)
+    {
+        for (size_t y = 0; y < side; ++y)
+        {
+            for (size_t z = 0; z < side; ++z)
+            {
+                const glm::vec3 center{
+                    -16.f + 2.f * static_cast<float>(x),
+                    -16.f + 2.f * static_cast<float>(y),
+                    -2.f - 4.f * static_cast<float>(z)
+                };
+                boxes.push_back({center + offset, glm::vec3{0.5f}});
+            }
+        }
+    }
+    return boxes;
+}
+
+std::vector<uint32_t> cull_brute_force(const Frustum& frustum, const std::vector<BoundingBox>& boxes)
+{
+    std::vector<uint32_t> visible;
+    for (uint32_t i = 0; i < boxes.size(); ++i)
+    {
+        if (frustum.test(boxes[i]) != Visibility::Outside)
+            visible.push_back(i);
+    }
+    return visible;
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> indices)
+{
+    std::ranges::sort(indices);
+    return indices;
+}
+}
+
+SCENARIO("Frustums classify boxes against their planes")
+{
+    GIVEN("An orthographic frustum")
+    {
+        const auto frustum = make_ortho_frustum();
+
+        THEN("Boxes are inside, intersecting or outside")
+        {
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, -25.f}, glm::vec3{1.f}) == Visibility::Inside);
+            REQUIRE(frustum.test(glm::vec3{10.f, 0.f, -25.f}, glm::vec3{1.f}) == Visibility::Intersecting);
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, -50.f}, glm::vec3{1.f}) == Visibility::Intersecting);
+            REQUIRE(frustum.test(glm::vec3{30.f, 0.f, -25.f}, glm::vec3{1.f}) == Visibility::Outside);
+            REQUIRE(frustum.test(glm::vec3{0.f, -30.f, -25.f}, glm::vec3{1.f}) == Visibility::Outside);
+        }
+
+        THEN("Boxes behind the near plane or past the far plane are outside")
+        {
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, 5.f}, glm::vec3{1.f}) == Visibility::Outside);
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, -80.f}, glm::vec3{1.f}) == Visibility::Outside);
+        }
+
+        THEN("The planes face inwards")
+        {
+            for (size_t i = 0; i < Frustum::PLANE_COUNT; ++i)
+            {
+                const auto plane = frustum.get_plane(i);
+                REQUIRE(glm::dot(glm::vec3(plane), glm::vec3{0.f, 0.f, -25.f}) + plane.w > 0.f);
+            }
+        }
+    }
+
+    GIVEN("A perspective frustum")
+    {
+        const Frustum frustum(glm::perspectiveZO(glm::radians(60.f), 1.f, 0.1f, 100.f));
+
+        THEN("Boxes are tested against the widening sides")
+        {
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, -10.f}, glm::vec3{0.5f}) == Visibility::Inside);
+            // tan(30) * 50 ~ 28.9, so this box is visible far away but would be outside close to the camera
+            REQUIRE(frustum.test(glm::vec3{20.f, 0.f, -50.f}, glm::vec3{0.5f}) == Visibility::Inside);
+            REQUIRE(frustum.test(glm::vec3{20.f, 0.f, -5.f}, glm::vec3{0.5f}) == Visibility::Outside);
+            REQUIRE(frustum.test(glm::vec3{0.f, 0.f, 10.f}, glm::vec3{0.5f}) == Visibility::Outside);
+        }
+    }
+}
+
+SCENARIO("Bounding volume hierarchies cull the same boxes as testing every box")
+{
+    const auto frustum = make_ortho_frustum();
+    auto boxes = make_grid();
+
+    BoundingVolumeHierarchy bvh;
+    bvh.build(boxes);
+
+    GIVEN("A tree built over a grid of boxes")
+    {
+        const auto expected = cull_brute_force(frustum, boxes);
+        REQUIRE_FALSE(expected.empty());
+        REQUIRE(expected.size() < boxes.size());
+
+        THEN("Every box is in the tree")
+        {
+            REQUIRE(bvh.size() == boxes.size());
+            REQUIRE(bvh.get_node_count() > boxes.size() / BoundingVolumeHierarchy::LEAF_SIZE);
+        }
+
+        THEN("The culled boxes match the boxes that are not outside")
+        {
+            std::vector<uint32_t> visible;
+            bvh.cull(frustum, visible);
+            REQUIRE(sorted(visible) == expected);
+        }
+
+        WHEN("The boxes move and the tree is refit")
+        {
+            boxes = make_grid(glm::vec3{7.f, -5.f, 3.f});
+            bvh.refit(boxes);
+
+            THEN("The culled boxes follow the moved boxes")
+            {
+                std::vector<uint32_t> visible;
+                bvh.cull(frustum, visible);
+                REQUIRE(sorted(visible) == cull_brute_force(frustum, boxes));
+            }
+        }
+
+        WHEN("The tree is culled in parallel")
+        {
+            jobs::Scheduler scheduler(2);
+
+            std::vector<uint32_t> serial;
+            bvh.cull(frustum, serial);
+            std::vector<uint32_t> parallel;
+            bvh.cull(frustum, scheduler, parallel);
+
+            THEN("The result is the same as the serial cull, including the order")
+            {
+                REQUIRE(parallel == serial);
+            }
+        }
+    }
+
+    GIVEN("An empty tree")
+    {
+        BoundingVolumeHierarchy empty;
+        empty.build({});
+
+        THEN("Nothing is visible")
+        {
+            std::vector<uint32_t> visible{1, 2, 3};
+            empty.cull(frustum, visible);
+            REQUIRE(visible.empty());
+        }
+    }
+}
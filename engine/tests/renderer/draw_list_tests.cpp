@@ -0,0 +1,203 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/renderer/draw_list.h"
+
+using namespace portal;
+using namespace portal::renderer;
+
+SCENARIO("Draw keys pack the draw state")
+{
+    GIVEN("A key made of every state")
+    {
+        const auto key = DrawKey::make(1, 2, 3, 4);
+
+        THEN("Each state can be read back")
+        {
+            REQUIRE(DrawKey::get_pipeline(key) == 1);
+            REQUIRE(DrawKey::get_material(key) == 2);
+            REQUIRE(DrawKey::get_index_buffer(key) == 3);
+            REQUIRE(DrawKey::get_depth(key) == 4);
+        }
+
+        THEN("The pipeline is the most significant state")
+        {
+            REQUIRE(key < DrawKey::make(2, 0, 0, 0));
+            REQUIRE(key > DrawKey::make(0, 0xFFFF, 0xFFFF, 0xFFFF));
+        }
+    }
+
+    GIVEN("Depths in a range")
+    {
+        THEN("Depth is quantized in order and clamped to the range")
+        {
+            REQUIRE(DrawKey::quantize_depth(0.f, 0.f, 10.f) == 0);
+            REQUIRE(DrawKey::quantize_depth(10.f, 0.f, 10.f) == 0xFFFF);
+            REQUIRE(DrawKey::quantize_depth(2.f, 0.f, 10.f) < DrawKey::quantize_depth(3.f, 0.f, 10.f));
+            REQUIRE(DrawKey::quantize_depth(-5.f, 0.f, 10.f) == 0);
+            REQUIRE(DrawKey::quantize_depth(50.f, 0.f, 10.f) == 0xFFFF);
+        }
+
+        THEN("An empty range maps every depth to zero")
+        {
+            REQUIRE(DrawKey::quantize_depth(5.f, 1.f, 1.f) == 0);
+        }
+    }
+}
+
+SCENARIO("Radix sort orders keys and their values")
+{
+    std::vector<uint64_t> key_scratch;
+    std::vector<uint32_t> value_scratch;
+
+    GIVEN("Random keys")
+    {
+        std::mt19937_64 random(7);
+        std::vector<uint64_t> keys(10'000);
+        for (auto& key : keys)
+            key = random();
+        std::vector<uint32_t> values(keys.size());
+        std::iota(values.begin(), values.end(), 0u);
+        const auto original = keys;
+
+        WHEN("The keys are sorted")
+        {
+            radix_sort(keys, values, key_scratch, value_scratch);
+
+            THEN("The keys are in ascending order")
+            {
+                REQUIRE(std::ranges::is_sorted(keys));
+            }
+
+            THEN("Every value still belongs to its key")
+            {
+                for (size_t i = 0; i < keys.size(); ++i)
+                    REQUIRE(original[values[i]] == keys[i]);
+            }
+        }
+    }
+
+    GIVEN("Keys that only differ in their low bytes, with duplicates")
+    {
+        std::vector<uint64_t> keys;
+        for (uint64_t i = 0; i < 1000; ++i)
+            keys.push_back(DrawKey::make(7, 7, 7, static_cast<uint16_t>((i * 37) % 100)));
+        std::vector<uint32_t> values(keys.size());
+        std::iota(values.begin(), values.end(), 0u);
+        const auto original = keys;
+
+        WHEN("The keys are sorted")
+        {
+            radix_sort(keys, values, key_scratch, value_scratch);
+
+            THEN("The result matches a stable sort")
+            {
+                std::vector<uint32_t> expected(original.size());
+                std::iota(expected.begin(), expected.end(), 0u);
+                std::ranges::stable_sort(expected, std::less{}, [&original](const uint32_t index) { return original[index]; });
+
+                REQUIRE(std::ranges::is_sorted(keys));
+                REQUIRE(values == expected);
+            }
+        }
+    }
+
+    GIVEN("Empty and single key inputs")
+    {
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> values;
+
+        THEN("Sorting them does nothing")
+        {
+            radix_sort(keys, values, key_scratch, value_scratch);
+            REQUIRE(keys.empty());
+
+            keys.push_back(42);
+            values.push_back(3);
+            radix_sort(keys, values, key_scratch, value_scratch);
+            REQUIRE(keys.front() == 42);
+            REQUIRE(values.front() == 3);
+        }
+    }
+}
+
+SCENARIO("Draw list batches draws by state")
+{
+    DrawList draw_list;
+
+    GIVEN("Draws added out of order")
+    {
+        draw_list.add(DrawKey::make(1, 1, 0, 5), 0);
+        draw_list.add(DrawKey::make(0, 0, 0, 9), 1);
+        draw_list.add(DrawKey::make(0, 0, 0, 1), 2);
+        draw_list.add(DrawKey::make(0, 1, 0, 0), 3);
+        draw_list.add(DrawKey::make(1, 1, 1, 0), 4);
+
+        WHEN("The list is built")
+        {
+            draw_list.build();
+            const auto commands = draw_list.get_commands();
+
+            THEN("Draws are ordered by state, then front to back")
+            {
+                REQUIRE(commands.size() == 5);
+                REQUIRE(commands[0].object == 2);
+                REQUIRE(commands[1].object == 1);
+                REQUIRE(commands[2].object == 3);
+                REQUIRE(commands[3].object == 0);
+                REQUIRE(commands[4].object == 4);
+            }
+
+            THEN("Only changed state is bound")
+            {
+                REQUIRE(commands[0].changes == FlagTraits<DrawStateBits>::all_flags);
+                REQUIRE(commands[1].changes == DrawStateChanges(DrawStateBits::None));
+                REQUIRE(commands[2].changes == DrawStateChanges(DrawStateBits::Material));
+                REQUIRE(commands[3].changes == (DrawStateBits::Pipeline | DrawStateBits::Material));
+                REQUIRE(commands[4].changes == DrawStateChanges(DrawStateBits::IndexBuffer));
+            }
+        }
+    }
+
+    GIVEN("Draws with overflowing state ids")
+    {
+        draw_list.add(DrawKey::make(0, DrawKey::OVERFLOW_ID, 0, 0), 0);
+        draw_list.add(DrawKey::make(0, DrawKey::OVERFLOW_ID, 0, 1), 1);
+
+        WHEN("The list is built")
+        {
+            draw_list.build();
+
+            THEN("The overflowing state is rebound for every draw")
+            {
+                REQUIRE(draw_list.get_commands()[1].changes == DrawStateChanges(DrawStateBits::Material));
+            }
+        }
+    }
+
+    GIVEN("A built list")
+    {
+        draw_list.add(DrawKey::make(0, 0, 0, 0), 0);
+        draw_list.build();
+
+        WHEN("The list is cleared")
+        {
+            draw_list.clear();
+
+            THEN("It has no commands")
+            {
+                REQUIRE(draw_list.empty());
+                REQUIRE(draw_list.get_commands().empty());
+            }
+        }
+    }
+}
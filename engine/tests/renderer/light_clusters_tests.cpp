@@ -0,0 +1,198 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "portal/core/glm.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/lighting/light_clusters.h"
+
+using namespace portal;
+using namespace portal::renderer;
+
+namespace
+{
+constexpr float NEAR_DEPTH = 0.1f;
+constexpr float FAR_DEPTH = 1000.f;
+
+bool cluster_contains(const LightClusterGrid& grid, const uint32_t cluster, const uint32_t light)
+{
+    const auto& [offset, count] = grid.get_clusters()[cluster];
+    for (const auto index : grid.get_light_indices().subspan(offset, count))
+    {
+        if (index == light)
+            return true;
+    }
+    return false;
+}
+}
+
+SCENARIO("Light clusters bin lights by their view space position")
+{
+    LightClusterGrid grid;
+    grid.configure(glm::perspectiveZO(glm::radians(60.f), 16.f / 9.f, NEAR_DEPTH, FAR_DEPTH), NEAR_DEPTH, FAR_DEPTH);
+
+    const auto& dimensions = grid.get_dimensions();
+    REQUIRE(grid.get_cluster_count() == static_cast<size_t>(dimensions.x) * dimensions.y * dimensions.z);
+
+    GIVEN("A small light in the middle of the screen")
+    {
+        const std::vector<LightBounds> lights{{{0.01f, 0.01f, -10.f}, 0.001f}};
+
+        WHEN("The lights are assigned")
+        {
+            grid.assign(lights);
+
+            THEN("Only the cluster containing the light references it")
+            {
+                const auto expected = grid.get_cluster_index(dimensions.x / 2, dimensions.y / 2, grid.get_slice(10.f));
+                REQUIRE(cluster_contains(grid, expected, 0));
+                REQUIRE(grid.get_light_indices().size() == 1);
+            }
+        }
+    }
+
+    GIVEN("A light behind the camera")
+    {
+        const std::vector<LightBounds> lights{{{0.f, 0.f, 10.f}, 1.f}};
+
+        WHEN("The lights are assigned")
+        {
+            grid.assign(lights);
+
+            THEN("No cluster references it")
+            {
+                REQUIRE(grid.get_light_indices().empty());
+            }
+        }
+    }
+
+    GIVEN("Many random lights")
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> lateral(-50.f, 50.f);
+        std::uniform_real_distribution<float> depth(0.f, 100.f);
+        std::vector<LightBounds> lights;
+        for (int i = 0; i < 500; ++i)
+            lights.push_back({{lateral(random), lateral(random), -depth(random)}, 5.f});
+
+        WHEN("The lights are assigned")
+        {
+            grid.assign(lights);
+
+            THEN("The cluster lists are packed back to back")
+            {
+                uint32_t offset = 0;
+                for (const auto& cluster : grid.get_clusters())
+                {
+                    REQUIRE(cluster.offset == offset);
+                    offset += cluster.count;
+                }
+                REQUIRE(offset == grid.get_light_indices().size());
+            }
+
+            THEN("A cluster references a light exactly when their bounds overlap")
+            {
+                const auto bounds = grid.get_cluster_bounds();
+                for (uint32_t cluster = 0; cluster < bounds.size(); cluster += 97)
+                {
+                    for (uint32_t light = 0; light < lights.size(); ++light)
+                    {
+                        const auto distance = glm::max(glm::abs(lights[light].center - bounds[cluster].center) - bounds[cluster].extents, glm::vec3{0.f});
+                        const bool overlaps = glm::dot(distance, distance) <= lights[light].radius * lights[light].radius;
+                        REQUIRE(cluster_contains(grid, cluster, light) == overlaps);
+                    }
+                }
+            }
+        }
+
+        WHEN("The lights are assigned in parallel")
+        {
+            grid.assign(lights);
+            const std::vector serial_clusters(grid.get_clusters().begin(), grid.get_clusters().end());
+            const std::vector serial_indices(grid.get_light_indices().begin(), grid.get_light_indices().end());
+
+            jobs::Scheduler scheduler(0);
+            grid.assign(lights, scheduler);
+
+            THEN("The result matches the serial assignment")
+            {
+                REQUIRE(grid.get_light_indices().size() == serial_indices.size());
+                REQUIRE(std::ranges::equal(grid.get_light_indices(), serial_indices));
+                for (size_t i = 0; i < serial_clusters.size(); ++i)
+                {
+                    REQUIRE(grid.get_clusters()[i].offset == serial_clusters[i].offset);
+                    REQUIRE(grid.get_clusters()[i].count == serial_clusters[i].count);
+                }
+            }
+        }
+    }
+
+    GIVEN("Depths along the view direction")
+    {
+        THEN("Slices grow with depth and are clamped to the grid")
+        {
+            REQUIRE(grid.get_slice(0.f) == 0);
+            REQUIRE(grid.get_slice(NEAR_DEPTH) == 0);
+            REQUIRE(grid.get_slice(1.f) <= grid.get_slice(10.f));
+            REQUIRE(grid.get_slice(10.f) < grid.get_slice(100.f));
+            REQUIRE(grid.get_slice(FAR_DEPTH * 2.f) == dimensions.z - 1);
+        }
+    }
+}
+
+SCENARIO("Light clusters support a reversed depth projection")
+{
+    GIVEN("A grid configured with a reversed Z projection")
+    {
+        LightClusterGrid grid;
+        grid.configure(glm::perspectiveZO(glm::radians(60.f), 16.f / 9.f, FAR_DEPTH, NEAR_DEPTH), NEAR_DEPTH, FAR_DEPTH);
+        const auto& dimensions = grid.get_dimensions();
+
+        WHEN("A light in the middle of the screen is assigned")
+        {
+            const std::vector<LightBounds> lights{{{0.01f, 0.01f, -10.f}, 0.001f}};
+            grid.assign(lights);
+
+            THEN("It is binned in the same cluster")
+            {
+                REQUIRE(cluster_contains(grid, grid.get_cluster_index(dimensions.x / 2, dimensions.y / 2, grid.get_slice(10.f)), 0));
+            }
+        }
+    }
+}
+
+SCENARIO("Spot light cones are bound by a sphere")
+{
+    GIVEN("Narrow and wide cones")
+    {
+        const glm::vec3 apex{1.f, 2.f, 3.f};
+        const glm::vec3 direction{0.f, 0.f, -1.f};
+        constexpr float range = 10.f;
+
+        for (const float half_angle : {glm::radians(10.f), glm::radians(45.f), glm::radians(80.f)})
+        {
+            const auto bounds = LightBounds::from_cone(apex, direction, range, half_angle);
+
+            THEN("The sphere contains the apex, the tip and the rim of the lit region")
+            {
+                constexpr float epsilon = 1e-3f;
+                const float axial = range * std::cos(half_angle);
+                const float rim_radius = range * std::sin(half_angle);
+
+                REQUIRE(glm::distance(bounds.center, apex) <= bounds.radius + epsilon);
+                REQUIRE(glm::distance(bounds.center, apex + direction * range) <= bounds.radius + epsilon);
+                REQUIRE(glm::distance(bounds.center, apex + direction * axial + glm::vec3(rim_radius, 0.f, 0.f)) <= bounds.radius + epsilon);
+                REQUIRE(glm::distance(bounds.center, apex + direction * axial - glm::vec3(0.f, rim_radius, 0.f)) <= bounds.radius + epsilon);
+            }
+        }
+    }
+}
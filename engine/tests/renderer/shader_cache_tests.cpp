@@ -0,0 +1,245 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/renderer/shaders/shader_cache.h"
+
+using namespace portal;
+using namespace portal::renderer;
+
+namespace
+{
+constexpr std::array<uint32_t, 4> SPIRV_CODE{0x07230203, 0x00010500, 0x0008000b, 0x0000002a};
+
+std::filesystem::path make_temporary_directory(const std::string_view name)
+{
+    const auto path = std::filesystem::temp_directory_path() / "portal_shader_cache_tests" / name;
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    return path;
+}
+
+void write_text(const std::filesystem::path& path, const std::string_view text)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << text;
+}
+
+CompiledShader make_compiled_shader()
+{
+    CompiledShader compiled{.code = Buffer::copy(SPIRV_CODE.data(), sizeof(SPIRV_CODE))};
+
+    shader_reflection::BufferDescriptor buffer{
+        .type = DescriptorType::UniformBuffer,
+        .stage = ShaderStage::Fragment,
+        .size = 16,
+        .offset = 0,
+        .range = 16,
+        .binding_point = 1,
+        .name = STRING_ID("material"),
+    };
+    buffer.uniforms[STRING_ID("material.color")] = shader_reflection::Uniform{
+        .name = STRING_ID("material.color"),
+        .property = {
+            .value = Buffer::copy("float4", 6),
+            .type = reflection::PropertyType::floating32,
+            .container_type = reflection::PropertyContainerType::vector,
+            .elements_number = 4
+        },
+        .size = 16,
+        .offset = 0
+    };
+
+    compiled.reflection.descriptor_sets.resize(1);
+    compiled.reflection.descriptor_sets[0].uniform_buffers[1] = buffer;
+    compiled.reflection.descriptor_sets[0].image_samplers[2] = shader_reflection::ImageSamplerDescriptor{
+        .type = DescriptorType::CombinedImageSampler,
+        .stage = ShaderStage::Fragment,
+        .binding_point = 2,
+        .dimensions = 2,
+        .array_size = 1,
+        .name = STRING_ID("albedo")
+    };
+    compiled.reflection.resources[STRING_ID("albedo")] = {
+        .name = STRING_ID("albedo"),
+        .type = DescriptorType::CombinedImageSampler,
+        .set = 0,
+        .binding_index = 2,
+        .count = 1
+    };
+    compiled.reflection.push_constants.push_back({.stage = ShaderStage::Vertex, .offset = 0, .size = 64});
+    compiled.reflection.stages.push_back({.stage = ShaderStage::Vertex, .entry_point = "vertex_main"});
+    compiled.reflection.stages.push_back({.stage = ShaderStage::Fragment, .entry_point = "fragment_main"});
+    return compiled;
+}
+
+Buffer to_buffer(const std::string& data)
+{
+    return Buffer::copy(data.data(), data.size());
+}
+}
+
+SCENARIO("Shader cache keys cover everything that affects compilation")
+{
+    GIVEN("A shader that imports a module which imports another module")
+    {
+        const auto directory = make_temporary_directory("keys");
+        write_text(directory / "common.slang", "float4 white() { return float4(1); }\n");
+        write_text(directory / "lights.slang", "import common;\nfloat4 light() { return white(); }\n");
+
+        const std::string source = "import lights;\n[shader(\"fragment\")] float4 main() : SV_Target { return light(); }\n";
+        const ShaderCompiler::CompileRequest request{
+            .name = STRING_ID("shader"),
+            .shader_path = directory / "shader.slang",
+            .engine_shader_path = directory / "engine",
+            .shader_data = Buffer{source.data(), source.size()},
+            .defines = {{"USE_SHADOWS", "1"}},
+        };
+        const auto key = ShaderCache::calculate_key(request);
+
+        THEN("The same request gets the same key")
+        {
+            REQUIRE(ShaderCache::calculate_key(request) == key);
+        }
+
+        WHEN("A define changes")
+        {
+            auto changed = request;
+            changed.defines[0].value = "0";
+
+            THEN("The key changes")
+            {
+                REQUIRE(ShaderCache::calculate_key(changed) != key);
+            }
+        }
+
+        WHEN("A static constant is added")
+        {
+            auto changed = request;
+            changed.static_constants.push_back({"USE_FOG", "bool", "true"});
+
+            THEN("The key changes")
+            {
+                REQUIRE(ShaderCache::calculate_key(changed) != key);
+            }
+        }
+
+        WHEN("A transitively imported module changes")
+        {
+            write_text(directory / "common.slang", "float4 white() { return float4(1, 1, 1, 0); }\n");
+
+            THEN("The key changes")
+            {
+                REQUIRE(ShaderCache::calculate_key(request) != key);
+            }
+        }
+    }
+}
+
+SCENARIO("Shader cache entries round trip")
+{
+    GIVEN("A compiled shader")
+    {
+        const auto compiled = make_compiled_shader();
+
+        std::stringstream stream;
+        ShaderCache::write_entry(stream, 42, compiled);
+        const auto data = to_buffer(stream.str());
+
+        THEN("It is read back with its reflection")
+        {
+            const auto read = ShaderCache::read_entry(data, 42);
+            REQUIRE(read.has_value());
+            REQUIRE(read->code.size == sizeof(SPIRV_CODE));
+            REQUIRE(std::memcmp(read->code.data, SPIRV_CODE.data(), sizeof(SPIRV_CODE)) == 0);
+
+            const auto& reflection = read->reflection;
+            REQUIRE(reflection.descriptor_sets.size() == 1);
+
+            const auto& buffer = reflection.descriptor_sets[0].uniform_buffers.at(1);
+            REQUIRE(buffer.name == STRING_ID("material"));
+            REQUIRE(buffer.size == 16);
+            const auto& uniform = buffer.uniforms.at(STRING_ID("material.color"));
+            REQUIRE(uniform.property == compiled.reflection.descriptor_sets[0].uniform_buffers.at(1).uniforms.at(STRING_ID("material.color")).property);
+            REQUIRE(uniform.property.value.as_string() == "float4");
+
+            const auto& image = reflection.descriptor_sets[0].image_samplers.at(2);
+            REQUIRE(image.type == DescriptorType::CombinedImageSampler);
+            REQUIRE(image.name == STRING_ID("albedo"));
+
+            REQUIRE(reflection.resources.at(STRING_ID("albedo")).binding_index == 2);
+            REQUIRE(reflection.push_constants.size() == 1);
+            REQUIRE(reflection.push_constants[0].size == 64);
+            REQUIRE(reflection.stages.size() == 2);
+            REQUIRE(reflection.stages[1].entry_point == "fragment_main");
+        }
+
+        THEN("A corrupted entry is rejected")
+        {
+            auto corrupted = Buffer::copy(data);
+            corrupted.as<uint8_t*>()[sizeof(ShaderCacheHeader) + 1] ^= 0xFF;
+            REQUIRE_FALSE(ShaderCache::read_entry(corrupted, 42).has_value());
+            REQUIRE_FALSE(ShaderCache::read_entry(Buffer{data, data.size - 1}, 42).has_value());
+        }
+
+        THEN("An entry read under another key is rejected")
+        {
+            REQUIRE_FALSE(ShaderCache::read_entry(data, 43).has_value());
+        }
+    }
+}
+
+SCENARIO("The shader cache evicts the least recently used entries")
+{
+    GIVEN("A cache that fits two entries")
+    {
+        const auto compiled = make_compiled_shader();
+        std::stringstream stream;
+        ShaderCache::write_entry(stream, 0, compiled);
+        const auto entry_size = stream.str().size();
+
+        const auto directory = make_temporary_directory("eviction");
+        ShaderCache cache(directory, entry_size * 2 + entry_size / 2);
+        cache.store(1, compiled);
+        cache.store(2, compiled);
+
+        // Make the existing entries older than anything written from now on
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            std::filesystem::last_write_time(entry.path(), std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+
+        WHEN("The first entry is used and a third one is stored")
+        {
+            REQUIRE(cache.load(1).has_value());
+            cache.store(3, compiled);
+
+            THEN("The unused entry is evicted")
+            {
+                REQUIRE(cache.get_size() <= entry_size * 2 + entry_size / 2);
+                REQUIRE(cache.load(1).has_value());
+                REQUIRE_FALSE(cache.load(2).has_value());
+                REQUIRE(cache.load(3).has_value());
+            }
+        }
+
+        WHEN("The cache is reopened")
+        {
+            ShaderCache reopened(directory, entry_size * 2 + entry_size / 2);
+
+            THEN("The stored entries are still there")
+            {
+                REQUIRE(reopened.get_size() == entry_size * 2);
+                REQUIRE(reopened.load(2).has_value());
+                REQUIRE_FALSE(reopened.load(4).has_value());
+            }
+        }
+    }
+}
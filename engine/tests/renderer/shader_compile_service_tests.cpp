@@ -0,0 +1,117 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/renderer/shaders/shader_compile_service.h"
+
+using namespace portal;
+using namespace portal::renderer;
+
+namespace
+{
+constexpr std::string_view SHADER_SOURCE = R"(
+RWStructuredBuffer<float> output;
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    output[id.x] = float(id.x) * SCALE;
+}
+)";
+
+ShaderCompiler::CompileRequest make_request(const std::string& scale)
+{
+    return {
+        .name = STRING_ID("test_compute"),
+        .shader_path = std::filesystem::temp_directory_path() / "test_compute.slang",
+        .shader_data = Buffer{SHADER_SOURCE.data(), SHADER_SOURCE.size()},
+        .defines = {{"SCALE", scale}},
+    };
+}
+
+bool same_code(const CompiledShader& a, const CompiledShader& b)
+{
+    return a.code.size == b.code.size && std::memcmp(a.code.data, b.code.data, a.code.size) == 0;
+}
+}
+
+SCENARIO("Compiled shaders can be deep copied")
+{
+    GIVEN("A compiled shader with a reflected uniform")
+    {
+        const std::array<uint8_t, 4> code{1, 2, 3, 4};
+        CompiledShader compiled{.code = Buffer::copy(code.data(), code.size())};
+        compiled.reflection.descriptor_sets.resize(1);
+        auto& buffer = compiled.reflection.descriptor_sets[0].uniform_buffers[0];
+        buffer.uniforms[STRING_ID("data.color")].property.value = Buffer::copy("float4", 6);
+
+        WHEN("It is cloned")
+        {
+            const auto cloned = compiled.clone();
+
+            THEN("The clone owns its code and type names")
+            {
+                REQUIRE(cloned.code.data != compiled.code.data);
+                REQUIRE(same_code(cloned, compiled));
+
+                const auto& value = cloned.reflection.descriptor_sets[0].uniform_buffers.at(0).uniforms.at(STRING_ID("data.color")).property.value;
+                REQUIRE(value.data != buffer.uniforms.at(STRING_ID("data.color")).property.value.data);
+                REQUIRE(value.as_string() == "float4");
+            }
+        }
+    }
+}
+
+SCENARIO("The compile service compiles permutations in jobs")
+{
+    GIVEN("A service running on the main thread")
+    {
+        jobs::Scheduler scheduler(0);
+        ShaderCompileService service(scheduler);
+
+        WHEN("Permutations are compiled, one of them twice")
+        {
+            const std::vector requests{make_request("1.0"), make_request("2.0"), make_request("1.0")};
+            const auto compiled = service.compile_all(requests);
+
+            THEN("Every request gets its own result, in order")
+            {
+                REQUIRE(compiled.size() == 3);
+                for (const auto& variant : compiled)
+                {
+                    REQUIRE(variant.code);
+                    REQUIRE(variant.reflection.stages.size() == 1);
+                }
+
+                REQUIRE(same_code(compiled[0], compiled[2]));
+                REQUIRE(compiled[0].code.data != compiled[2].code.data);
+                REQUIRE_FALSE(same_code(compiled[0], compiled[1]));
+            }
+
+            THEN("A single compiler is shared by all of them")
+            {
+                REQUIRE(service.get_compiler_count() == 1);
+            }
+        }
+
+        WHEN("A permutation is compiled immediately")
+        {
+            const auto compiled = service.compile_immediate(make_request("3.0"));
+
+            THEN("It is compiled on the calling thread")
+            {
+                REQUIRE(compiled.code);
+                REQUIRE(service.get_compiler_count() == 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,188 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/resources/cook/cooked_resource.h"
+
+using namespace portal;
+using namespace portal::resources;
+
+namespace
+{
+const auto TRIANGLE_OBJ = R"(
+v 0 0 0
+v 1 0 0
+v 0 1 0
+vt 0 0
+vt 1 0
+vt 0 1
+vn 0 0 1
+f 1/1/1 2/2/1 3/3/1
+)";
+
+Buffer to_buffer(const std::string& data)
+{
+    return Buffer::copy(data.data(), data.size());
+}
+}
+
+SCENARIO("Mip chains are generated with a box filter")
+{
+    GIVEN("A non square texture")
+    {
+        THEN("The chain goes down to a single pixel")
+        {
+            REQUIRE(get_full_mip_count(4, 2) == 3);
+            REQUIRE(get_full_mip_count(1, 1) == 1);
+            REQUIRE(get_full_mip_count(1024, 1) == 11);
+            REQUIRE(get_mip_chain_size(renderer::ImageFormat::RGBA8_UNorm, 4, 2, 3) == (8 + 2 + 1) * 4);
+            REQUIRE(get_mip_chain_size(renderer::ImageFormat::RGBA32_Float, 4, 2, 3) == (8 + 2 + 1) * 16);
+        }
+    }
+
+    GIVEN("A 2x2 RGBA8 image")
+    {
+        const std::array<uint8_t, 16> pixels{
+            0, 10, 100, 255, 4, 20, 100, 255,
+            8, 30, 100, 255, 12, 40, 100, 255
+        };
+
+        WHEN("Its mips are generated")
+        {
+            const auto chain = generate_mip_chain(renderer::ImageFormat::RGBA8_UNorm, Buffer{pixels.data(), pixels.size()}, 2, 2, 2);
+
+            THEN("The first mip is the image and the second one is the average")
+            {
+                REQUIRE(chain.size == 20);
+                REQUIRE(std::memcmp(chain.data, pixels.data(), pixels.size()) == 0);
+
+                const auto* mip = chain.as<const uint8_t*>() + pixels.size();
+                REQUIRE(mip[0] == 6);
+                REQUIRE(mip[1] == 25);
+                REQUIRE(mip[2] == 100);
+                REQUIRE(mip[3] == 255);
+            }
+        }
+    }
+
+    GIVEN("A 3x1 float image")
+    {
+        const std::array pixels{
+            1.f, 1.f, 1.f, 1.f,
+            3.f, 3.f, 3.f, 3.f,
+            8.f, 8.f, 8.f, 8.f
+        };
+
+        WHEN("Its mips are generated")
+        {
+            const auto chain = generate_mip_chain(
+                renderer::ImageFormat::RGBA32_Float,
+                Buffer{pixels.data(), sizeof(pixels)},
+                3,
+                1,
+                get_full_mip_count(3, 1)
+            );
+
+            THEN("The odd column is dropped and the single row is reused")
+            {
+                REQUIRE(chain.size == (3 + 1) * 4 * sizeof(float));
+                const auto* mip = chain.as<const float*>() + pixels.size();
+                REQUIRE(mip[0] == 2.f);
+            }
+        }
+    }
+}
+
+SCENARIO("Cooked resources round trip")
+{
+    const CookedHeader texture_header{.type = ResourceType::Texture, .source_size = 128, .source_write_time = 42, .source_hash = 7};
+
+    GIVEN("A cooked texture")
+    {
+        const std::array<uint8_t, 20> mips{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+        const CookedTexture texture{
+            .format = renderer::ImageFormat::RGBA8_UNorm,
+            .width = 2,
+            .height = 2,
+            .mip_count = 2,
+            .data = Buffer{mips.data(), mips.size()}
+        };
+
+        std::stringstream stream;
+        write_cooked_texture(stream, texture_header, texture);
+        const auto data = to_buffer(stream.str());
+
+        THEN("It is read back as is")
+        {
+            const auto header = read_cooked_header(data);
+            REQUIRE(header.has_value());
+            REQUIRE(header->type == ResourceType::Texture);
+            REQUIRE(header->source_hash == 7);
+            REQUIRE(header->matches(FileStat{.is_file = true, .is_directory = false, .last_write_time = 42, .size = 128}));
+            REQUIRE_FALSE(header->matches(FileStat{.is_file = true, .is_directory = false, .last_write_time = 43, .size = 128}));
+
+            const auto read = read_cooked_texture(data);
+            REQUIRE(read.has_value());
+            REQUIRE(read->width == 2);
+            REQUIRE(read->height == 2);
+            REQUIRE(read->mip_count == 2);
+            REQUIRE(read->data.size == mips.size());
+            REQUIRE(std::memcmp(read->data.data, mips.data(), mips.size()) == 0);
+        }
+
+        THEN("It is not a cooked mesh")
+        {
+            REQUIRE_FALSE(read_cooked_mesh(data).has_value());
+        }
+
+        THEN("A truncated texture is rejected")
+        {
+            REQUIRE_FALSE(read_cooked_texture(Buffer{data, data.size - 1}).has_value());
+        }
+    }
+
+    GIVEN("A cooked mesh")
+    {
+        const auto mesh = parse_obj(TRIANGLE_OBJ);
+        const CookedHeader mesh_header{.type = ResourceType::Mesh};
+
+        std::stringstream stream;
+        write_cooked_mesh(stream, mesh_header, mesh);
+        const auto data = to_buffer(stream.str());
+
+        THEN("It is read back with its tangents")
+        {
+            const auto read = read_cooked_mesh(data);
+            REQUIRE(read.has_value());
+            REQUIRE(read->vertices.size() == 3);
+            REQUIRE(read->indices == mesh.indices);
+            REQUIRE(read->submeshes.size() == 1);
+            REQUIRE(read->submeshes[0].count == 3);
+            for (size_t i = 0; i < mesh.vertices.size(); ++i)
+            {
+                REQUIRE(read->vertices[i].position == mesh.vertices[i].position);
+                REQUIRE(read->vertices[i].tangent == mesh.vertices[i].tangent);
+            }
+        }
+    }
+
+    GIVEN("Data that was not cooked")
+    {
+        const auto data = to_buffer("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+
+        THEN("It has no cooked header")
+        {
+            REQUIRE_FALSE(read_cooked_header(data).has_value());
+            REQUIRE_FALSE(read_cooked_texture(data).has_value());
+            REQUIRE_FALSE(read_cooked_mesh(data).has_value());
+        }
+    }
+}
@@ -0,0 +1,158 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/resources/database/metadata_index.h"
+
+using namespace portal;
+
+namespace
+{
+Buffer to_buffer(const std::string& data)
+{
+    return Buffer::copy(data.data(), data.size());
+}
+
+SourceMetadata make_composite()
+{
+    SourceMetadata texture{
+        .name = STRING_ID("albedo"),
+        .resource_id = STRING_ID("root/models/albedo"),
+        .type = ResourceType::Texture,
+        .source = STRING_ID("models/albedo.png"),
+        .format = SourceFormat::Image,
+        .meta = TextureMetadata{.hdr = false, .width = 512, .height = 256, .format = renderer::ImageFormat::RGBA8_UNorm},
+    };
+
+    SourceMetadata material{
+        .name = STRING_ID("material"),
+        .resource_id = STRING_ID("root/models/material"),
+        .type = ResourceType::Material,
+        .dependencies = {STRING_ID("root/models/albedo")},
+        .source = STRING_ID("models/model.gltf"),
+        .format = SourceFormat::Material,
+        .meta = MaterialMetadata{STRING_ID("pbr")},
+    };
+
+    return SourceMetadata{
+        .name = STRING_ID("model"),
+        .resource_id = STRING_ID("root/models/model"),
+        .type = ResourceType::Composite,
+        .source = STRING_ID("models/model.gltf"),
+        .format = SourceFormat::Glft,
+        .meta = CompositeMetadata{.children = {{"albedo", texture}, {"material", material}}, .type = "gltf"},
+    };
+}
+}
+
+SCENARIO("The metadata index round trips source metadata")
+{
+    GIVEN("An index of a composite resource")
+    {
+        const FileStat stat{.is_file = true, .is_directory = false, .last_write_time = 1234, .size = 42};
+        const auto path = STRING_ID("models/model.gltf.pmeta");
+
+        std::unordered_map<StringId, MetadataIndexEntry> entries;
+        entries.emplace(path, MetadataIndexEntry{.last_write_time = stat.last_write_time, .size = stat.size, .meta = make_composite()});
+
+        std::ostringstream output;
+        MetadataIndex::write(output, entries);
+        const auto data = output.str();
+
+        WHEN("It is read back")
+        {
+            const auto read = MetadataIndex::read(to_buffer(data));
+
+            THEN("The metadata is the same")
+            {
+                REQUIRE(read.has_value());
+                REQUIRE(read->size() == 1);
+
+                const auto& entry = read->at(path);
+                REQUIRE(entry.matches(stat));
+                REQUIRE(entry.meta.resource_id == STRING_ID("root/models/model"));
+                REQUIRE(entry.meta.type == ResourceType::Composite);
+
+                const auto& composite = std::get<CompositeMetadata>(entry.meta.meta);
+                REQUIRE(composite.type == "gltf");
+                REQUIRE(composite.children.size() == 2);
+
+                const auto& texture = composite.children.at("albedo");
+                REQUIRE(texture.source.string == "models/albedo.png");
+                REQUIRE(std::get<TextureMetadata>(texture.meta).width == 512);
+                REQUIRE(std::get<TextureMetadata>(texture.meta).height == 256);
+
+                const auto& material = composite.children.at("material");
+                REQUIRE(material.dependencies.size() == 1);
+                REQUIRE(material.dependencies[0].string == "root/models/albedo");
+                REQUIRE(std::get<MaterialMetadata>(material.meta).shader.string == "pbr");
+            }
+        }
+
+        WHEN("The metadata file was modified since it was indexed")
+        {
+            const FileStat modified{.is_file = true, .is_directory = false, .last_write_time = 5678, .size = 42};
+
+            THEN("The entry does not match it")
+            {
+                REQUIRE_FALSE(entries.at(path).matches(modified));
+            }
+        }
+
+        WHEN("The index is truncated")
+        {
+            const auto truncated = data.substr(0, data.size() - 8);
+
+            THEN("It is rejected")
+            {
+                REQUIRE_FALSE(MetadataIndex::read(to_buffer(truncated)).has_value());
+            }
+        }
+    }
+
+    GIVEN("An empty index")
+    {
+        std::ostringstream output;
+        MetadataIndex::write(output, {});
+        const auto data = output.str();
+
+        THEN("It is read back without entries")
+        {
+            const auto read = MetadataIndex::read(to_buffer(data));
+            REQUIRE(read.has_value());
+            REQUIRE(read->empty());
+        }
+
+        THEN("Trailing data is rejected")
+        {
+            REQUIRE_FALSE(MetadataIndex::read(to_buffer(data + "garbage")).has_value());
+        }
+    }
+
+    GIVEN("An empty index without a payload")
+    {
+        const MetadataIndexHeader header{};
+        const std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        THEN("It is read back without entries")
+        {
+            const auto read = MetadataIndex::read(to_buffer(data));
+            REQUIRE(read.has_value());
+            REQUIRE(read->empty());
+        }
+    }
+
+    GIVEN("A file that is not an index")
+    {
+        THEN("It is rejected")
+        {
+            REQUIRE_FALSE(MetadataIndex::read(to_buffer("{\"version\": 1}")).has_value());
+            REQUIRE_FALSE(MetadataIndex::read(Buffer{}).has_value());
+        }
+    }
+}
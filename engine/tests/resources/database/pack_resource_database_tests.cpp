@@ -0,0 +1,156 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <cstring>
+#include <fstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/resources/cook/pack_builder.h"
+#include "portal/engine/resources/database/folder_resource_database.h"
+#include "portal/engine/resources/database/pack_resource_database.h"
+#include "portal/engine/resources/source/resource_source.h"
+
+using namespace portal;
+
+namespace
+{
+const std::string SHADER = "float4 main() : SV_Target { return float4(1, 0, 0, 1); }\n";
+
+std::string make_content(const size_t repeat)
+{
+    std::string content;
+    for (size_t i = 0; i < repeat; ++i)
+        content += SHADER;
+    return content;
+}
+
+// Shaders have no metadata to enrich, the folder database is created without decoding any file
+void make_folder_database(const std::filesystem::path& root_path)
+{
+    std::filesystem::remove_all(root_path);
+    std::filesystem::create_directories(root_path / "shaders");
+
+    std::ofstream(root_path / "root.podb") << R"({"dirty": 0, "ignored_extensions": [], "ignored_files": [], "name": "packed", "resource_count": 2, "version": 1})";
+    std::ofstream(root_path / "shaders/small.slang", std::ios::binary) << SHADER;
+    std::ofstream(root_path / "shaders/large.slang", std::ios::binary) << make_content(64);
+}
+
+bool equals(const Buffer& buffer, const std::string& expected)
+{
+    return buffer.size == expected.size() && std::memcmp(buffer.data, expected.data(), expected.size()) == 0;
+}
+}
+
+SCENARIO("Pack databases serve the resources of the database they were built from")
+{
+    const auto root_path = std::filesystem::temp_directory_path() / "portal_pack_database_test";
+    const auto pack_path = root_path / "packed.ppak";
+    make_folder_database(root_path);
+
+    jobs::Scheduler scheduler(0);
+    resources::PackBuilder builder(scheduler);
+
+    GIVEN("A compressed pack of a folder database")
+    {
+        {
+            const auto folder = FolderResourceDatabase::open(root_path);
+            const auto report = builder.build(*folder, pack_path);
+            REQUIRE(report.resources == 2);
+            REQUIRE(report.failed == 0);
+            // The large shader compresses, the small one does not get smaller and is stored as is
+            REQUIRE(report.stored_bytes < report.raw_bytes);
+        }
+
+        WHEN("It is opened")
+        {
+            const auto pack = PackResourceDatabase::open(pack_path);
+            REQUIRE(pack);
+
+            THEN("It has the resources and the structure of the folder database")
+            {
+                REQUIRE(pack->size() == 2);
+                REQUIRE(pack->get_name() == STRING_ID("packed"));
+                REQUIRE(pack->get_structure().children.at(STRING_ID("shaders"))->children.size() == 2);
+
+                const auto meta = pack->find(STRING_ID("packed/shaders/large"));
+                REQUIRE(meta.has_value());
+                REQUIRE(meta->type == ResourceType::Shader);
+                REQUIRE(meta->source.string == "shaders/large.slang");
+                REQUIRE(meta->full_source_path.string == (root_path / "shaders/large.slang").generic_string());
+
+                REQUIRE_FALSE(pack->find(STRING_ID("packed/shaders/missing")).has_value());
+            }
+
+            THEN("Sources load the data of the resources")
+            {
+                const auto large_id = STRING_ID("packed/shaders/large");
+                const auto large = pack->create_source(large_id, pack->find(large_id).value());
+                REQUIRE(equals(large->load(), make_content(64)));
+                REQUIRE(equals(large->load(SHADER.size(), SHADER.size()), SHADER));
+                REQUIRE_FALSE(large->load(make_content(64).size(), 1));
+
+                const auto small_id = STRING_ID("packed/shaders/small");
+                const auto small = pack->create_source(small_id, pack->find(small_id).value());
+                const auto data = small->load();
+                REQUIRE(equals(data, SHADER));
+                // Read straight from the mapping
+                REQUIRE_FALSE(data.is_allocated());
+            }
+
+            THEN("Resources cannot be added or removed")
+            {
+                REQUIRE(pack->remove(STRING_ID("packed/shaders/small")) != DatabaseErrorBit::Success);
+                REQUIRE(pack->find(STRING_ID("packed/shaders/small")).has_value());
+            }
+        }
+
+        WHEN("The pack is truncated")
+        {
+            std::filesystem::resize_file(pack_path, std::filesystem::file_size(pack_path) - 8);
+
+            THEN("It is rejected")
+            {
+                REQUIRE_FALSE(PackResourceDatabase::open(pack_path));
+            }
+        }
+    }
+
+    GIVEN("An uncompressed pack of a folder database")
+    {
+        {
+            const auto folder = FolderResourceDatabase::open(root_path);
+            const auto report = builder.build(*folder, pack_path, {.compress = false});
+            REQUIRE(report.stored_bytes == report.raw_bytes);
+        }
+
+        WHEN("A resource is loaded")
+        {
+            const auto pack = PackResourceDatabase::open(pack_path);
+            const auto large_id = STRING_ID("packed/shaders/large");
+            const auto data = pack->create_source(large_id, pack->find(large_id).value())->load();
+
+            THEN("It is read straight from the mapping")
+            {
+                REQUIRE(equals(data, make_content(64)));
+                REQUIRE_FALSE(data.is_allocated());
+            }
+        }
+    }
+
+    GIVEN("A file that is not a pack")
+    {
+        std::ofstream(pack_path, std::ios::binary | std::ios::trunc) << R"({"version": 1})";
+
+        THEN("It is rejected")
+        {
+            REQUIRE_FALSE(PackResourceDatabase::open(pack_path));
+            REQUIRE_FALSE(PackResourceDatabase::open(root_path / "missing.ppak"));
+        }
+    }
+
+    std::filesystem::remove_all(root_path);
+}
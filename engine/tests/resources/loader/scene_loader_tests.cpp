@@ -0,0 +1,79 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/buffer_stream.h"
+#include "portal/core/glm.h"
+#include "portal/engine/components/base.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/resources/loader/scene_loader.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+using namespace portal;
+
+namespace
+{
+Buffer serialize(const Entity entity, ecs::Registry& registry)
+{
+    Buffer buffer;
+    BufferStreamWriter stream(buffer);
+    {
+        BinarySerializer serializer(stream);
+        resources::SceneLoader::serialize_entity(entity, serializer, registry);
+    }
+    stream.flush();
+    return stream.get_buffer();
+}
+
+Entity deserialize(const Buffer& buffer, ecs::Registry& registry, const bool replace_components)
+{
+    BufferStreamReader stream(buffer);
+    BinaryDeserializer deserializer(stream);
+    return resources::SceneLoader::deserialize_entity(deserializer, registry, replace_components);
+}
+}
+
+SCENARIO("Scene nodes are deserialized onto existing entities")
+{
+    ModuleStack stack;
+    auto& registry = stack.add_module<ecs::Registry>();
+
+    GIVEN("An entity recorded with a transform, that gained a tag after it was recorded")
+    {
+        auto entity = registry.create_entity(STRING_ID("player"), TransformComponent{glm::vec3{1.f, 2.f, 3.f}});
+        const auto record = serialize(entity, registry);
+
+        entity.add_component<PlayerTag>();
+        entity.get_component<TransformComponent>().set_translation(glm::vec3{0.f});
+
+        WHEN("The record is patched onto the entity")
+        {
+            const auto result = deserialize(record, registry, false);
+
+            THEN("Recorded components are restored and the tag is kept")
+            {
+                REQUIRE(result == entity);
+                REQUIRE(result.get_component<TransformComponent>().get_translation() == glm::vec3{1.f, 2.f, 3.f});
+                REQUIRE(result.has_component<PlayerTag>());
+            }
+        }
+
+        WHEN("The record replaces the components of the entity")
+        {
+            const auto result = deserialize(record, registry, true);
+
+            THEN("Components missing from the record are removed")
+            {
+                REQUIRE(result == entity);
+                REQUIRE(result.get_component<TransformComponent>().get_translation() == glm::vec3{1.f, 2.f, 3.f});
+                REQUIRE_FALSE(result.has_component<PlayerTag>());
+                REQUIRE(result.get_name() == STRING_ID("player"));
+            }
+        }
+    }
+}
@@ -0,0 +1,204 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+// The file watcher is only implemented on Linux, other platforms never report changes
+#if defined(__linux__)
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "registry_fixture.h"
+#include "portal/engine/resources/database/folder_resource_database.h"
+#include "portal/serialization/archive/json_archive.h"
+
+using namespace portal;
+using namespace portal::test;
+
+namespace
+{
+using TestShader = FakeResource<ResourceType::Shader>;
+
+const auto DATABASE_PATH = std::filesystem::temp_directory_path() / "portal_hot_reload_database";
+const auto PROJECT_PATH = std::filesystem::temp_directory_path() / "portal_hot_reload_test";
+
+void write_shader(const std::string_view path, const std::string_view content)
+{
+    std::ofstream(DATABASE_PATH / path, std::ios::binary) << content;
+}
+
+void write_metadata(const SourceMetadata& meta)
+{
+    JsonArchive archive;
+    meta.archive(archive);
+    archive.dump(DATABASE_PATH / fmt::format("{}{}", meta.source.string, FolderResourceDatabase::RESOURCE_METADATA_EXTENSION));
+}
+
+/**
+ * @brief Creates a database with two shaders, `lit` depends on `base`, and opens it watched.
+ *
+ * The database is opened once without watching it first, so the metadata of both shaders exists before the watcher starts.
+ */
+std::unique_ptr<FolderResourceDatabase> open_database(const StringId& base, const StringId& lit)
+{
+    std::filesystem::remove_all(DATABASE_PATH);
+    std::filesystem::create_directories(DATABASE_PATH / "shaders");
+    std::ofstream(DATABASE_PATH / fmt::format("root{}", FolderResourceDatabase::DATABASE_METADATA_EXTENSION))
+        << R"({"dirty": 0, "ignored_extensions": [], "ignored_files": [], "name": "test", "resource_count": 2, "version": 1})";
+
+    write_shader("shaders/base.slang", "float4 base = float4(1.0);\n");
+    write_shader("shaders/lit.slang", "float4 lit = float4(0.5);\n");
+
+    {
+        const auto database = FolderResourceDatabase::open(DATABASE_PATH);
+        auto meta = database->find(lit).value();
+        meta.dependencies = {base};
+        write_metadata(meta);
+    }
+
+    return FolderResourceDatabase::open(DATABASE_PATH, true);
+}
+
+/** @brief Polls the database until `resource_id` is reported as changed, changes settle before they are reported */
+bool wait_for_change(FolderResourceDatabase& database, const StringId& resource_id)
+{
+    std::vector<StringId> changed;
+    return wait_until(
+        [&]
+        {
+            std::ranges::copy(database.poll_changes(), std::back_inserter(changed));
+            return std::ranges::find(changed, resource_id) != changed.end();
+        }
+    );
+}
+}
+
+SCENARIO("Watched folder databases apply the file changes they poll")
+{
+    const auto base = STRING_ID("test/shaders/base");
+    const auto lit = STRING_ID("test/shaders/lit");
+    const auto extra = STRING_ID("test/shaders/extra");
+
+    const auto database = open_database(base, lit);
+    REQUIRE(database->find(lit)->dependencies.size() == 1);
+    REQUIRE(database->find(lit)->dependencies.front() == base);
+
+    WHEN("The metadata of a resource is edited")
+    {
+        auto meta = database->find(lit).value();
+        meta.dependencies.clear();
+        write_metadata(meta);
+
+        THEN("The resource is reported with its new metadata")
+        {
+            REQUIRE(wait_for_change(*database, lit));
+            REQUIRE(database->find(lit)->dependencies.empty());
+        }
+    }
+
+    WHEN("The source of a resource is modified")
+    {
+        write_shader("shaders/base.slang", "float4 base = float4(0.0);\n");
+
+        THEN("The resource is reported")
+        {
+            REQUIRE(wait_for_change(*database, base));
+        }
+    }
+
+    WHEN("A new resource file is added")
+    {
+        write_shader("shaders/extra.slang", "float4 extra = float4(0.25);\n");
+
+        THEN("It gets metadata and is added to the database")
+        {
+            REQUIRE(wait_for_change(*database, extra));
+            REQUIRE(database->find(extra).has_value());
+            REQUIRE(std::filesystem::exists(DATABASE_PATH / "shaders/extra.slang.pmeta"));
+        }
+    }
+
+    WHEN("A resource and its metadata are removed")
+    {
+        std::filesystem::remove(DATABASE_PATH / "shaders/base.slang");
+        std::filesystem::remove(DATABASE_PATH / "shaders/base.slang.pmeta");
+
+        THEN("The resource is removed from the database")
+        {
+            REQUIRE(wait_for_change(*database, base));
+            REQUIRE_FALSE(database->find(base).has_value());
+            REQUIRE(database->find(lit).has_value());
+        }
+    }
+}
+
+SCENARIO("Changed resources are reloaded together with their dependents, dependencies first")
+{
+    const auto base = STRING_ID("test/shaders/base");
+    const auto lit = STRING_ID("test/shaders/lit");
+
+    const auto database = open_database(base, lit);
+
+    RegistryFixture fixture(*database, PROJECT_PATH);
+    auto& registry = fixture.registry;
+    const auto loader = std::make_shared<FakeLoader<ResourceType::Shader>>(registry);
+    registry.set_loader(ResourceType::Shader, loader);
+
+    GIVEN("A loaded shader and a shader depending on it")
+    {
+        const auto base_reference = registry.immediate_load<TestShader>(base);
+        const auto lit_reference = registry.immediate_load<TestShader>(lit);
+        const auto initial_loads = loader->get_loaded().size();
+
+        WHEN("The source of the dependency is modified")
+        {
+            write_shader("shaders/base.slang", "float4 base = float4(0.0, 0.0, 0.0, 1.0);\n");
+
+            THEN("Both shaders are loaded again, the dependency first")
+            {
+                REQUIRE(
+                    wait_until(
+                        [&]
+                        {
+                            registry.update_sources();
+                            return loader->get_loaded().size() >= initial_loads + 2;
+                        }
+                    )
+                );
+
+                const auto loaded = loader->get_loaded();
+                REQUIRE(std::vector(loaded.begin() + static_cast<std::ptrdiff_t>(initial_loads), loaded.end()) == std::vector{base, lit});
+            }
+        }
+
+        WHEN("The source of the dependent is modified")
+        {
+            write_shader("shaders/lit.slang", "float4 lit = float4(1.0);\n");
+
+            THEN("Only the dependent is loaded again")
+            {
+                REQUIRE(
+                    wait_until(
+                        [&]
+                        {
+                            registry.update_sources();
+                            return loader->get_loaded().size() >= initial_loads + 1;
+                        }
+                    )
+                );
+
+                // Dependencies are loaded first, a reload of the dependency would have been recorded before the dependent
+                const auto loaded = loader->get_loaded();
+                REQUIRE(std::vector(loaded.begin() + static_cast<std::ptrdiff_t>(initial_loads), loaded.end()) == std::vector{lit});
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/resources/load_timeline.h"
+
+using namespace portal;
+using namespace std::chrono_literals;
+
+namespace
+{
+LoadTimelineEntry make_entry(
+    const LoadTimeline& timeline,
+    const std::string_view name,
+    const LoadTimeline::Clock::duration io_end,
+    const LoadTimeline::Clock::duration decode_start,
+    const LoadTimeline::Clock::duration decode_end,
+    const llvm::SmallVector<size_t> dependencies = {}
+)
+{
+    return {
+        .resource_id = STRING_ID(name),
+        .dependencies = dependencies,
+        .io_start = timeline.start,
+        .io_end = timeline.start + io_end,
+        .decode_start = timeline.start + decode_start,
+        .decode_end = timeline.start + decode_end,
+    };
+}
+}
+
+SCENARIO("The critical path follows the dependencies that gated the load")
+{
+    GIVEN("A scene waiting on a material that waited on a slow texture")
+    {
+        LoadTimeline timeline{.root = STRING_ID("scene")};
+        timeline.start = LoadTimeline::Clock::now();
+
+        timeline.entries.push_back(make_entry(timeline, "texture", 40ms, 40ms, 60ms));
+        timeline.entries.push_back(make_entry(timeline, "mesh", 5ms, 5ms, 10ms));
+        timeline.entries.push_back(make_entry(timeline, "material", 2ms, 60ms, 65ms, {0}));
+        timeline.entries.push_back(make_entry(timeline, "scene", 1ms, 65ms, 70ms, {1, 2}));
+        timeline.end = timeline.start + 70ms;
+
+        THEN("The path goes from the texture to the scene")
+        {
+            REQUIRE(timeline.get_critical_path() == std::vector<size_t>{0, 2, 3});
+        }
+
+        WHEN("The material takes longer to read than the texture takes to load")
+        {
+            timeline.entries[2].io_end = timeline.start + 62ms;
+
+            THEN("The path starts at the material")
+            {
+                REQUIRE(timeline.get_critical_path() == std::vector<size_t>{2, 3});
+            }
+        }
+    }
+
+    GIVEN("An empty timeline")
+    {
+        const LoadTimeline timeline;
+
+        THEN("There is no critical path")
+        {
+            REQUIRE(timeline.get_critical_path().empty());
+        }
+    }
+}
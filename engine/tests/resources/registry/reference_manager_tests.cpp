@@ -0,0 +1,75 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/resources/reference_manager.h"
+
+using namespace portal;
+
+SCENARIO("Reference lists track the references to a resource")
+{
+    GIVEN("A reference manager")
+    {
+        ReferenceManager manager;
+        auto& list = manager.get_references(STRING_ID("resource"));
+
+        THEN("The same list is returned for the same resource")
+        {
+            REQUIRE(&manager.get_references(STRING_ID("resource")) == &list);
+            REQUIRE(&manager.get_references(STRING_ID("other")) != &list);
+            REQUIRE(manager.get_reference_count(STRING_ID("unknown")) == 0);
+        }
+
+        WHEN("Nodes are linked")
+        {
+            ReferenceNode first;
+            ReferenceNode second;
+            list.link(first);
+            list.link(second);
+
+            THEN("They are counted")
+            {
+                REQUIRE(first.is_linked());
+                REQUIRE(second.is_linked());
+                REQUIRE(manager.get_reference_count(STRING_ID("resource")) == 2);
+            }
+
+            AND_WHEN("A node is replaced")
+            {
+                ReferenceNode moved;
+                list.replace(first, moved);
+
+                THEN("The count is unchanged and the old node is unlinked")
+                {
+                    REQUIRE_FALSE(first.is_linked());
+                    REQUIRE(moved.is_linked());
+                    REQUIRE(list.size() == 2);
+                }
+
+                list.unlink(moved);
+            }
+
+            AND_WHEN("The nodes are unlinked")
+            {
+                list.unlink(second);
+                list.unlink(first);
+
+                THEN("The list is empty")
+                {
+                    REQUIRE_FALSE(first.is_linked());
+                    REQUIRE_FALSE(second.is_linked());
+                    REQUIRE(list.size() == 0);
+                }
+            }
+
+            for (auto* node : {&first, &second})
+            {
+                if (node->is_linked())
+                    list.unlink(*node);
+            }
+        }
+    }
+}
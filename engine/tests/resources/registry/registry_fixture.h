@@ -0,0 +1,193 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/project/project.h"
+#include "portal/engine/resources/reference_manager.h"
+#include "portal/engine/resources/resource_registry.h"
+#include "portal/engine/resources/database/resource_database.h"
+#include "portal/engine/resources/loader/loader.h"
+#include "portal/engine/resources/source/memory_source.h"
+
+/**
+ * Helpers for testing the resource registry without a GPU: resources that report a fixed amount of memory, a loader
+ * creating them from the size of their source and a database kept in memory.
+ */
+namespace portal::test
+{
+template <ResourceType Type>
+class FakeResource final : public Resource
+{
+public:
+    DECLARE_RESOURCE(Type);
+
+    FakeResource(const StringId& id, const size_t size) : Resource(id), size(size) {}
+
+    [[nodiscard]] ResourceMemoryUsage get_memory_usage() const override { return {.cpu_bytes = size, .gpu_bytes = 0}; }
+
+private:
+    size_t size;
+};
+
+/** @brief Creates a `FakeResource` as large as the source of the resource, and records the resources it loaded */
+template <ResourceType Type>
+class FakeLoader final : public resources::ResourceLoader
+{
+public:
+    explicit FakeLoader(ResourceRegistry& registry) : ResourceLoader(registry) {}
+
+    resources::ResourceData load(const SourceMetadata& meta, Reference<resources::ResourceSource> source) override
+    {
+        const auto data = source->load();
+        {
+            std::lock_guard guard(lock);
+            loaded.push_back(meta.resource_id);
+        }
+
+        return {
+            .resource = make_reference<FakeResource<Type>>(meta.resource_id, data.size),
+            .source = source,
+            .metadata = meta
+        };
+    }
+
+    void save(resources::ResourceData&) override {}
+
+    std::vector<StringId> get_loaded()
+    {
+        std::lock_guard guard(lock);
+        return loaded;
+    }
+
+private:
+    std::mutex lock;
+    std::vector<StringId> loaded;
+};
+
+class MemoryDatabaseEntry final : public resources::DatabaseEntry
+{
+public:
+    using DatabaseEntry::DatabaseEntry;
+
+    [[nodiscard]] std::filesystem::path get_path() const override { return name.string; }
+};
+
+/** @brief A database of resources that only exist in memory, the source of each resource is `size` bytes long */
+class MemoryDatabase final : public ResourceDatabase
+{
+public:
+    void add_resource(const StringId& resource_id, const ResourceType type, const size_t size, const StringId& source = INVALID_STRING_ID)
+    {
+        std::lock_guard guard(lock);
+        entries[resource_id] = {
+            .meta = SourceMetadata{
+                .name = resource_id,
+                .resource_id = resource_id,
+                .type = type,
+                .source = source == INVALID_STRING_ID ? resource_id : source,
+                .format = SourceFormat::Memory
+            },
+            .size = size
+        };
+    }
+
+    std::expected<SourceMetadata, DatabaseError> find(const StringId resource_id) override
+    {
+        std::lock_guard guard(lock);
+        const auto it = entries.find(resource_id);
+        if (it == entries.end())
+            return std::unexpected{DatabaseErrorBit::NotFound};
+        return it->second.meta;
+    }
+
+    DatabaseError add(const StringId resource_id, SourceMetadata meta) override
+    {
+        std::lock_guard guard(lock);
+        entries[resource_id] = {.meta = std::move(meta), .size = 0};
+        return DatabaseErrorBit::Success;
+    }
+
+    DatabaseError remove(const StringId resource_id) override
+    {
+        std::lock_guard guard(lock);
+        return entries.erase(resource_id) ? DatabaseErrorBit::Success : DatabaseErrorBit::NotFound;
+    }
+
+    Reference<resources::ResourceSource> create_source(const StringId resource_id, SourceMetadata) override
+    {
+        std::lock_guard guard(lock);
+        return make_reference<resources::MemorySource>(Buffer::allocate(entries.at(resource_id).size));
+    }
+
+    [[nodiscard]] resources::DatabaseEntry& get_structure() const override { return const_cast<MemoryDatabaseEntry&>(root); }
+    [[nodiscard]] StringId get_name() const override { return STRING_ID("memory"); }
+    [[nodiscard]] const std::filesystem::path& get_root_path() const override { return root_path; }
+
+private:
+    struct Entry
+    {
+        SourceMetadata meta;
+        size_t size;
+    };
+
+    std::mutex lock;
+    std::unordered_map<StringId, Entry> entries;
+    MemoryDatabaseEntry root{STRING_ID("memory")};
+    std::filesystem::path root_path = "memory";
+};
+
+/** @brief Opens a project without engine resources, keeping resources retired for two frames */
+inline Reference<Project> make_test_project(const std::filesystem::path& root_path)
+{
+    std::filesystem::remove_all(root_path);
+    std::filesystem::create_directories(root_path);
+    std::ofstream(root_path / "settings.json") << R"({
+        "application": {"frames_in_flight": 2},
+        "project": {"include_engine_resources": false, "name": "Test", "resources": [], "starting_scene": "none"}
+    })";
+
+    return Project::open_project(ProjectType::Editor, root_path);
+}
+
+/** @brief A registry over `database` that loads resources on a single worker thread */
+struct RegistryFixture
+{
+    RegistryFixture(ResourceDatabase& database, const std::filesystem::path& project_path) :
+        ecs_registry(stack.add_module<ecs::Registry>()),
+        project(make_test_project(project_path)),
+        registry(*project, ecs_registry, scheduler, database, reference_manager)
+    {}
+
+    ModuleStack stack;
+    ecs::Registry& ecs_registry;
+    jobs::Scheduler scheduler{1};
+    ReferenceManager reference_manager;
+    Reference<Project> project;
+    ResourceRegistry registry;
+};
+
+/** @brief Polls `predicate` until it holds, giving up after a few seconds */
+template <typename Predicate>
+bool wait_until(Predicate&& predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+} // portal::test
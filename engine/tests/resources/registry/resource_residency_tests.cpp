@@ -0,0 +1,197 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "registry_fixture.h"
+
+using namespace portal;
+using namespace portal::test;
+
+namespace
+{
+using TestTexture = FakeResource<ResourceType::Texture>;
+
+const auto PROJECT_PATH = std::filesystem::temp_directory_path() / "portal_residency_test";
+
+void touch(ResourceRegistry& registry, const StringId& resource_id)
+{
+    std::ignore = registry.get<TestTexture>(resource_id).get_state();
+}
+
+size_t cpu_usage(ResourceRegistry& registry)
+{
+    return registry.get_memory_usage(ResourceType::Texture).cpu_bytes;
+}
+}
+
+SCENARIO("Resources over budget are evicted least recently used first")
+{
+    const auto first = STRING_ID("first");
+    const auto second = STRING_ID("second");
+    const auto third = STRING_ID("third");
+
+    MemoryDatabase database;
+    database.add_resource(first, ResourceType::Texture, 1000);
+    database.add_resource(second, ResourceType::Texture, 2000);
+    database.add_resource(third, ResourceType::Texture, 4000);
+
+    RegistryFixture fixture(database, PROJECT_PATH);
+    auto& registry = fixture.registry;
+    registry.set_loader(ResourceType::Texture, std::make_shared<FakeLoader<ResourceType::Texture>>(registry));
+
+    GIVEN("Textures last used in different frames")
+    {
+        for (const auto& resource_id : {first, second, third})
+            std::ignore = registry.immediate_load<TestTexture>(resource_id);
+        registry.update_residency();
+
+        touch(registry, first);
+        registry.update_residency();
+        touch(registry, second);
+        registry.update_residency();
+
+        REQUIRE(cpu_usage(registry) == 7000);
+
+        WHEN("The budget leaves room for two of them")
+        {
+            registry.set_budget(ResourceType::Texture, {.cpu_bytes = 6000});
+            registry.update_residency();
+
+            THEN("Only the least recently used texture is evicted")
+            {
+                REQUIRE(cpu_usage(registry) == 3000);
+            }
+        }
+
+        WHEN("The budget leaves room for one of them")
+        {
+            registry.set_budget(ResourceType::Texture, {.cpu_bytes = 2000});
+            registry.update_residency();
+
+            THEN("Textures are evicted from the least recently used until the budget is met")
+            {
+                REQUIRE(cpu_usage(registry) == 2000);
+            }
+        }
+
+        WHEN("The least recently used texture is used in the frame of the update")
+        {
+            touch(registry, third);
+            registry.set_budget(ResourceType::Texture, {.cpu_bytes = 1});
+            registry.update_residency();
+
+            THEN("It is kept over budget while the others are evicted")
+            {
+                REQUIRE(cpu_usage(registry) == 4000);
+            }
+        }
+    }
+}
+
+SCENARIO("Resources that cannot be loaded back on their own are never evicted")
+{
+    const auto held = STRING_ID("held");
+    const auto dirty = STRING_ID("dirty");
+    const auto composite = STRING_ID("composite");
+    const auto plain = STRING_ID("plain");
+
+    MemoryDatabase database;
+    database.add_resource(held, ResourceType::Texture, 1000);
+    database.add_resource(dirty, ResourceType::Texture, 2000);
+    database.add_resource(composite, ResourceType::Texture, 4000, STRING_ID("composite://model/gltf/composite"));
+    database.add_resource(plain, ResourceType::Texture, 8000);
+
+    RegistryFixture fixture(database, PROJECT_PATH);
+    auto& registry = fixture.registry;
+    registry.set_loader(ResourceType::Texture, std::make_shared<FakeLoader<ResourceType::Texture>>(registry));
+
+    GIVEN("A referenced, a dirty, a composite and a plain texture")
+    {
+        for (const auto& resource_id : {held, dirty, plain})
+            std::ignore = registry.immediate_load<TestTexture>(resource_id);
+        std::ignore = registry.allocate<TestTexture>(composite, composite, size_t{4000});
+
+        auto reference = std::make_optional(registry.get<TestTexture>(held));
+        registry.get<TestTexture>(dirty).set_dirty(ResourceDirtyBits::DataChange);
+
+        // Consumes the accesses above, so none of the textures counts as used in the frame of the eviction
+        registry.update_residency();
+
+        WHEN("The budget is smaller than any of them")
+        {
+            registry.set_budget(ResourceType::Texture, {.cpu_bytes = 1});
+            registry.update_residency();
+
+            THEN("Only the plain texture is evicted")
+            {
+                REQUIRE(cpu_usage(registry) == 7000);
+            }
+
+            AND_WHEN("The reference is released")
+            {
+                reference.reset();
+                registry.update_residency();
+
+                THEN("The texture it referenced is evicted as well")
+                {
+                    REQUIRE(cpu_usage(registry) == 6000);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Evicted resources are retired for the frames in flight and loaded back on access")
+{
+    const auto texture = STRING_ID("texture");
+
+    MemoryDatabase database;
+    database.add_resource(texture, ResourceType::Texture, 1000);
+
+    RegistryFixture fixture(database, PROJECT_PATH);
+    auto& registry = fixture.registry;
+    const auto loader = std::make_shared<FakeLoader<ResourceType::Texture>>(registry);
+    registry.set_loader(ResourceType::Texture, loader);
+
+    GIVEN("An evicted texture")
+    {
+        WeakReference<Resource> evicted = registry.immediate_load<TestTexture>(texture).underlying();
+        registry.update_residency();
+
+        registry.set_budget(ResourceType::Texture, {.cpu_bytes = 1});
+        registry.update_residency();
+        REQUIRE(cpu_usage(registry) == 0);
+
+        THEN("The texture is kept alive until the frames in flight are done with it")
+        {
+            // The test project has two frames in flight
+            for (size_t frame = 0; frame < 2; ++frame)
+            {
+                registry.update_residency();
+                REQUIRE_FALSE(evicted.expired());
+            }
+
+            registry.update_residency();
+            REQUIRE(evicted.expired());
+        }
+
+        WHEN("A reference to the texture is used")
+        {
+            registry.set_budget(ResourceType::Texture, {});
+            const auto reference = registry.get<TestTexture>(texture);
+
+            THEN("The texture is loaded back")
+            {
+                REQUIRE(wait_until([&] { return reference.get_state() == ResourceState::Loaded; }));
+                REQUIRE(loader->get_loaded() == std::vector{texture, texture});
+                REQUIRE(cpu_usage(registry) == 1000);
+                REQUIRE(reference.underlying() != evicted.lock());
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "portal/engine/resources/resource_slot.h"
+
+using namespace portal;
+
+SCENARIO("Resource slots publish state transitions")
+{
+    GIVEN("A slot for a resource that is loading")
+    {
+        ResourceSlot slot(ResourceState::Pending);
+        const auto initial = slot.get_status();
+
+        THEN("It has no resource")
+        {
+            REQUIRE(initial.state == ResourceState::Pending);
+            REQUIRE(slot.get_resource().first == nullptr);
+        }
+
+        WHEN("The resource is published")
+        {
+            const auto resource = make_reference<Resource>(STRING_ID("resource"));
+            slot.publish(resource);
+            const auto loaded = slot.get_status();
+
+            THEN("The slot is loaded with a new generation")
+            {
+                REQUIRE(loaded.state == ResourceState::Loaded);
+                REQUIRE(loaded.generation != initial.generation);
+
+                const auto [published, status] = slot.get_resource();
+                REQUIRE(published == resource);
+                REQUIRE(status.generation == loaded.generation);
+            }
+
+            AND_WHEN("It is unloaded and published again")
+            {
+                slot.publish(ResourceState::Unloaded);
+                REQUIRE(slot.get_state() == ResourceState::Unloaded);
+                REQUIRE(slot.get_resource().first == nullptr);
+
+                slot.publish(resource);
+
+                THEN("References see a different generation than the one they cached")
+                {
+                    REQUIRE(slot.get_state() == ResourceState::Loaded);
+                    REQUIRE(slot.get_status().generation != loaded.generation);
+                }
+            }
+        }
+
+        WHEN("A null resource is published")
+        {
+            slot.publish(Reference<Resource>{});
+
+            THEN("The slot is errored")
+            {
+                REQUIRE(slot.get_state() == ResourceState::Error);
+            }
+        }
+    }
+}
+
+SCENARIO("Resource slots track evictions and accesses")
+{
+    GIVEN("A slot with a loaded resource")
+    {
+        ResourceSlot slot;
+        slot.publish(make_reference<Resource>(STRING_ID("resource")));
+        const auto generation = slot.get_status().generation;
+
+        WHEN("The resource is evicted")
+        {
+            slot.publish(ResourceState::Unloaded, true);
+
+            THEN("The slot is unloaded, marked as evicted and keeps its generation")
+            {
+                const auto status = slot.get_status();
+                REQUIRE(status.state == ResourceState::Unloaded);
+                REQUIRE(status.evicted);
+                REQUIRE(status.generation == generation);
+            }
+
+            AND_WHEN("It starts loading again")
+            {
+                slot.publish(ResourceState::Pending);
+
+                THEN("It is no longer marked as evicted")
+                {
+                    REQUIRE_FALSE(slot.get_status().evicted);
+                }
+            }
+        }
+
+        WHEN("The resource is accessed")
+        {
+            slot.touch();
+            slot.touch();
+
+            THEN("The access is consumed once")
+            {
+                REQUIRE(slot.consume_access());
+                REQUIRE_FALSE(slot.consume_access());
+            }
+        }
+    }
+}
@@ -0,0 +1,196 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/epsilon.hpp>
+
+#include "portal/application/modules/module_stack.h"
+#include "portal/core/glm.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/components/relationship.h"
+#include "portal/engine/components/transform.h"
+#include "portal/engine/ecs/registry.h"
+#include "portal/engine/systems/transform_hierarchy_system.h"
+
+using namespace portal;
+
+namespace
+{
+// Two roots with four children per node, the deepest level is larger than a `TransformEngine` batch
+constexpr size_t ROOT_COUNT = 2;
+constexpr size_t CHILD_COUNT = 4;
+constexpr size_t DEPTH = 5;
+
+TransformComponent make_transform(const size_t index)
+{
+    const auto value = static_cast<float>(index);
+    return TransformComponent{
+        glm::vec3{0.5f + value * 0.01f, 1.f, -value * 0.02f},
+        glm::vec3{value * 0.013f, 0.2f, value * 0.007f},
+        glm::vec3{1.f + static_cast<float>(index % 5) * 0.05f}
+    };
+}
+
+/** @brief Builds the same hierarchy on every call, the entities are returned in creation order */
+std::vector<Entity> build_hierarchy(ecs::Registry& registry)
+{
+    std::vector<Entity> entities;
+    std::vector<Entity> level;
+    for (size_t root = 0; root < ROOT_COUNT; ++root)
+    {
+        auto entity = registry.create_entity(INVALID_STRING_ID, RelationshipComponent{});
+        entity.add_component<TransformComponent>(make_transform(entities.size()));
+        entities.push_back(entity);
+        level.push_back(entity);
+    }
+
+    for (size_t depth = 1; depth <= DEPTH; ++depth)
+    {
+        std::vector<Entity> next_level;
+        for (const auto parent : level)
+        {
+            for (size_t child = 0; child < CHILD_COUNT; ++child)
+            {
+                auto entity = registry.create_child_entity(parent);
+                entity.add_component<TransformComponent>(make_transform(entities.size()));
+                entities.push_back(entity);
+                next_level.push_back(entity);
+            }
+        }
+        level = std::move(next_level);
+    }
+    return entities;
+}
+
+bool approx_equal(const glm::mat4& lhs, const glm::mat4& rhs)
+{
+    for (glm::length_t column = 0; column < 4; ++column)
+    {
+        if (!glm::all(glm::epsilonEqual(lhs[column], rhs[column], 1e-3f)))
+            return false;
+    }
+    return true;
+}
+
+/** @brief The same hierarchy in two registries, updated by the sequential system and by the `TransformEngine` */
+struct HierarchyPair
+{
+    HierarchyPair() :
+        sequential_registry(sequential_stack.add_module<ecs::Registry>()),
+        parallel_registry(parallel_stack.add_module<ecs::Registry>())
+    {
+        sequential_system.register_to(sequential_registry);
+        parallel_system.register_to(parallel_registry);
+
+        sequential_entities = build_hierarchy(sequential_registry);
+        parallel_entities = build_hierarchy(parallel_registry);
+    }
+
+    ~HierarchyPair()
+    {
+        sequential_registry.clear();
+        parallel_registry.clear();
+        sequential_system.unregister_from(sequential_registry);
+        parallel_system.unregister_from(parallel_registry);
+    }
+
+    void update()
+    {
+        sequential_system.execute(sequential_registry);
+        scheduler.wait_for_job(parallel_system.execute(parallel_registry, scheduler));
+    }
+
+    /** @brief Applies the same change to the entity at `index` in both registries */
+    template <typename Func>
+    void apply(const size_t index, Func&& func)
+    {
+        func(sequential_entities[index]);
+        func(parallel_entities[index]);
+    }
+
+    [[nodiscard]] bool world_matrices_match() const
+    {
+        for (size_t index = 0; index < sequential_entities.size(); ++index)
+        {
+            const auto& sequential = sequential_entities[index].get_component<TransformComponent>().get_world_matrix();
+            const auto& parallel = parallel_entities[index].get_component<TransformComponent>().get_world_matrix();
+            if (!approx_equal(sequential, parallel))
+                return false;
+        }
+        return true;
+    }
+
+    jobs::Scheduler scheduler{2};
+
+    ModuleStack sequential_stack;
+    ModuleStack parallel_stack;
+    ecs::Registry& sequential_registry;
+    ecs::Registry& parallel_registry;
+
+    TransformHierarchySystem sequential_system{ecs::ExecutionPolicy::Sequential};
+    TransformHierarchySystem parallel_system{ecs::ExecutionPolicy::Parallel};
+
+    std::vector<Entity> sequential_entities;
+    std::vector<Entity> parallel_entities;
+};
+}
+
+SCENARIO("The transform engine computes the same world matrices as the sequential hierarchy update")
+{
+    HierarchyPair hierarchies;
+    hierarchies.update();
+
+    GIVEN("A multi level hierarchy updated once")
+    {
+        THEN("Every world matrix matches")
+        {
+            REQUIRE(hierarchies.sequential_entities.size() == hierarchies.parallel_entities.size());
+            REQUIRE(hierarchies.world_matrices_match());
+        }
+
+        WHEN("A subset of the transforms changes")
+        {
+            const auto untouched = hierarchies.parallel_entities.back().get_component<TransformComponent>().get_world_matrix();
+
+            // A root, an inner node and a leaf, the inner node is below the changed root
+            for (const auto index : {size_t{0}, ROOT_COUNT + 1, hierarchies.sequential_entities.size() - 2})
+            {
+                hierarchies.apply(
+                    index,
+                    [](Entity& entity)
+                    {
+                        entity.patch_component<TransformComponent>([](auto& transform) { transform.set_translation(glm::vec3{3.f, -2.f, 1.f}); });
+                    }
+                );
+            }
+            hierarchies.update();
+
+            THEN("The changed subtrees match and the rest is unchanged")
+            {
+                REQUIRE(hierarchies.world_matrices_match());
+                REQUIRE(hierarchies.parallel_entities.back().get_component<TransformComponent>().get_world_matrix() == untouched);
+            }
+        }
+
+        WHEN("A subtree is moved under the other root")
+        {
+            // The first child of the first root, with four levels below it
+            constexpr size_t subtree = ROOT_COUNT;
+            const auto previous = hierarchies.parallel_entities[subtree].get_component<TransformComponent>().get_world_matrix();
+
+            hierarchies.sequential_entities[subtree].set_parent(hierarchies.sequential_entities[1]);
+            hierarchies.parallel_entities[subtree].set_parent(hierarchies.parallel_entities[1]);
+            hierarchies.update();
+
+            THEN("The moved subtree follows its new parent")
+            {
+                REQUIRE(hierarchies.world_matrices_match());
+                REQUIRE_FALSE(approx_equal(hierarchies.parallel_entities[subtree].get_component<TransformComponent>().get_world_matrix(), previous));
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <ranges>
+
+#include <argparse/argparse.hpp>
+
+#include "portal/core/log.h"
+#include "portal/core/files/file_system.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/project/project.h"
+#include "portal/engine/resources/cook/asset_cooker.h"
+
+using namespace portal;
+
+/**
+ * Usage: portal-cook [-p project] [-j workers] [--force]
+ *
+ * Cooks the resources of every database of a project, without creating a window or a GPU device.
+ * Returns a non zero exit code if any resource failed to cook.
+ */
+int main(const int argc, char** argv)
+{
+    FileSystem::set_binary_path(std::filesystem::absolute(std::filesystem::path(argv[0])).parent_path());
+    Log::init(
+        {
+            .default_log_level = Log::LogLevel::Info,
+            .default_logger_name = "portal-cook"
+        }
+    );
+
+    argparse::ArgumentParser parser("portal-cook", PORTAL_ENGINE_VERSION);
+    parser.add_argument("-p", "--project")
+          .help("Path to the project folder")
+          .default_value(FileSystem::get_working_directory().string());
+    parser.add_argument("-j", "--jobs")
+          .help("Number of worker threads, -1 for one per core")
+          .default_value(-1)
+          .scan<'i', int>();
+    parser.add_argument("-f", "--force")
+          .help("Cook every resource, even if its cooked file is up to date")
+          .flag();
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        LOG_ERROR("Error in parsing arguments: {}", err.what());
+        Log::shutdown();
+        return 1;
+    }
+
+    resources::CookReport total;
+    try
+    {
+        const auto project = Project::open_project(ProjectType::Editor, std::filesystem::absolute(parser.get<std::string>("-p")));
+        jobs::Scheduler scheduler(parser.get<int>("-j"));
+        resources::AssetCooker cooker(scheduler);
+
+        auto& databases = project->get_resource_database();
+        for (const auto& name : databases.get_structure().children | std::views::keys)
+        {
+            const auto report = cooker.cook(databases.get_database(name), parser.get<bool>("--force"));
+            total.cooked += report.cooked;
+            total.up_to_date += report.up_to_date;
+            total.failed += report.failed;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_FATAL("Failed to cook project: {}", e.what());
+        Log::shutdown();
+        return 1;
+    }
+
+    LOG_INFO("Done: {} cooked, {} up to date, {} failed", total.cooked, total.up_to_date, total.failed);
+    Log::shutdown();
+    return total.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <ranges>
+
+#include <argparse/argparse.hpp>
+
+#include "portal/core/log.h"
+#include "portal/core/files/file_system.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/engine/project/project.h"
+#include "portal/engine/resources/cook/pack_builder.h"
+#include "portal/engine/resources/database/pack_resource_database.h"
+
+using namespace portal;
+
+/**
+ * Usage: portal-pack [-p project] [-o output] [-j workers] [--no-compress]
+ *
+ * Packs every database of a project into `{database}.ppak`, to be opened as a `Pack` database. Cook the project first,
+ * so cooked resources are packed instead of their sources.
+ * Returns a non zero exit code if any resource failed to pack.
+ */
+int main(const int argc, char** argv)
+{
+    FileSystem::set_binary_path(std::filesystem::absolute(std::filesystem::path(argv[0])).parent_path());
+    Log::init(
+        {
+            .default_log_level = Log::LogLevel::Info,
+            .default_logger_name = "portal-pack"
+        }
+    );
+
+    argparse::ArgumentParser parser("portal-pack", PORTAL_ENGINE_VERSION);
+    parser.add_argument("-p", "--project")
+          .help("Path to the project folder")
+          .default_value(FileSystem::get_working_directory().string());
+    parser.add_argument("-o", "--output")
+          .help("Folder to write the packs to, the resource folder of the project by default");
+    parser.add_argument("-j", "--jobs")
+          .help("Number of worker threads, -1 for one per core")
+          .default_value(-1)
+          .scan<'i', int>();
+    parser.add_argument("--no-compress")
+          .help("Store the data of every resource as is")
+          .flag();
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        LOG_ERROR("Error in parsing arguments: {}", err.what());
+        Log::shutdown();
+        return 1;
+    }
+
+    resources::PackReport total;
+    try
+    {
+        const auto project = Project::open_project(ProjectType::Editor, std::filesystem::absolute(parser.get<std::string>("-p")));
+        const auto output_directory = parser.present("-o")
+                                          ? std::filesystem::absolute(parser.get<std::string>("-o"))
+                                          : project->get_resource_directory();
+        if (!FileSystem::is_directory(output_directory) && !FileSystem::create_directory(output_directory))
+            throw std::runtime_error(fmt::format("Failed to create output folder {}", output_directory.generic_string()));
+
+        jobs::Scheduler scheduler(parser.get<int>("-j"));
+        resources::PackBuilder builder(scheduler);
+        const resources::PackParams params{.compress = !parser.get<bool>("--no-compress")};
+
+        auto& databases = project->get_resource_database();
+        for (const auto& name : databases.get_structure().children | std::views::keys)
+        {
+            const auto output_path = output_directory / fmt::format("{}{}", name.string, PackResourceDatabase::PACK_EXTENSION);
+            const auto report = builder.build(databases.get_database(name), output_path, params);
+            total.resources += report.resources;
+            total.raw_bytes += report.raw_bytes;
+            total.stored_bytes += report.stored_bytes;
+            total.failed += report.failed;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_FATAL("Failed to pack project: {}", e.what());
+        Log::shutdown();
+        return 1;
+    }
+
+    LOG_INFO("Done: {} resources, {} bytes ({} raw), {} failed", total.resources, total.stored_bytes, total.raw_bytes, total.failed);
+    Log::shutdown();
+    return total.failed == 0 ? 0 : 1;
+}
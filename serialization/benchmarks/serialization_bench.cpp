@@ -0,0 +1,460 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "portal/core/buffer.h"
+#include "portal/core/buffer_stream.h"
+#include "portal/core/glm.h"
+#include "portal/core/debug/benchmark.h"
+#include "portal/core/strings/string_id.h"
+#include "portal/serialization/archive.h"
+#include "portal/serialization/archive/json_archive.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+PORTAL_BENCHMARK_TRACK_ALLOCATIONS()
+
+using namespace portal;
+
+namespace
+{
+// Mirrors the per node layout written by the scene loader: name, icon, relationship, transform and mesh components
+struct EntityPayload
+{
+    StringId name;
+    std::string icon;
+    StringId parent;
+    glm::vec3 translation{};
+    glm::vec3 rotation{};
+    glm::vec3 scale{1.f};
+    StringId mesh;
+    std::vector<StringId> materials;
+
+    void serialize(Serializer& s) const
+    {
+        s.add_value(name);
+        s.add_value(icon);
+        s.add_value(parent);
+        s.add_value(translation);
+        s.add_value(rotation);
+        s.add_value(scale);
+        s.add_value(mesh);
+        s.add_value(materials);
+    }
+
+    static EntityPayload deserialize(Deserializer& d)
+    {
+        EntityPayload payload;
+        d.get_value(payload.name);
+        d.get_value(payload.icon);
+        d.get_value(payload.parent);
+        d.get_value(payload.translation);
+        d.get_value(payload.rotation);
+        d.get_value(payload.scale);
+        d.get_value(payload.mesh);
+        d.get_value(payload.materials);
+        return payload;
+    }
+
+    void archive(ArchiveObject& archive) const
+    {
+        archive.add_property("name", name);
+        archive.add_property("icon", icon);
+        archive.add_property("parent", parent);
+        archive.add_property("translation", translation);
+        archive.add_property("rotation", rotation);
+        archive.add_property("scale", scale);
+        archive.add_property("mesh", mesh);
+        archive.add_property("materials", materials);
+    }
+
+    static EntityPayload dearchive(ArchiveObject& archive)
+    {
+        EntityPayload payload;
+        archive.get_property("name", payload.name);
+        archive.get_property("icon", payload.icon);
+        archive.get_property("parent", payload.parent);
+        archive.get_property("translation", payload.translation);
+        archive.get_property("rotation", payload.rotation);
+        archive.get_property("scale", payload.scale);
+        archive.get_property("mesh", payload.mesh);
+        archive.get_property("materials", payload.materials);
+        return payload;
+    }
+};
+
+struct MeshPayload
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<uint32_t> indices;
+
+    void serialize(Serializer& s) const
+    {
+        s.add_value(positions);
+        s.add_value(normals);
+        s.add_value(uvs);
+        s.add_value(indices);
+    }
+
+    static MeshPayload deserialize(Deserializer& d)
+    {
+        MeshPayload payload;
+        d.get_value(payload.positions);
+        d.get_value(payload.normals);
+        d.get_value(payload.uvs);
+        d.get_value(payload.indices);
+        return payload;
+    }
+
+    void archive(ArchiveObject& archive) const
+    {
+        archive.add_property("positions", positions);
+        archive.add_property("normals", normals);
+        archive.add_property("uvs", uvs);
+        archive.add_property("indices", indices);
+    }
+
+    static MeshPayload dearchive(ArchiveObject& archive)
+    {
+        MeshPayload payload;
+        archive.get_property("positions", payload.positions);
+        archive.get_property("normals", payload.normals);
+        archive.get_property("uvs", payload.uvs);
+        archive.get_property("indices", payload.indices);
+        return payload;
+    }
+};
+
+// Mirrors the fields of a `.pmeta` file
+struct MetadataPayload
+{
+    StringId resource_id;
+    std::string type;
+    std::string format;
+    std::string source;
+    std::vector<StringId> dependencies;
+    uint64_t source_size = 0;
+    uint64_t timestamp = 0;
+
+    void serialize(Serializer& s) const
+    {
+        s.add_value(resource_id);
+        s.add_value(type);
+        s.add_value(format);
+        s.add_value(source);
+        s.add_value(dependencies);
+        s.add_value(source_size);
+        s.add_value(timestamp);
+    }
+
+    static MetadataPayload deserialize(Deserializer& d)
+    {
+        MetadataPayload payload;
+        d.get_value(payload.resource_id);
+        d.get_value(payload.type);
+        d.get_value(payload.format);
+        d.get_value(payload.source);
+        d.get_value(payload.dependencies);
+        d.get_value(payload.source_size);
+        d.get_value(payload.timestamp);
+        return payload;
+    }
+
+    void archive(ArchiveObject& archive) const
+    {
+        archive.add_property("resource_id", resource_id);
+        archive.add_property("type", type);
+        archive.add_property("format", format);
+        archive.add_property("source", source);
+        archive.add_property("dependencies", dependencies);
+        archive.add_property("source_size", source_size);
+        archive.add_property("timestamp", timestamp);
+    }
+
+    static MetadataPayload dearchive(ArchiveObject& archive)
+    {
+        MetadataPayload payload;
+        archive.get_property("resource_id", payload.resource_id);
+        archive.get_property("type", payload.type);
+        archive.get_property("format", payload.format);
+        archive.get_property("source", payload.source);
+        archive.get_property("dependencies", payload.dependencies);
+        archive.get_property("source_size", payload.source_size);
+        archive.get_property("timestamp", payload.timestamp);
+        return payload;
+    }
+};
+
+std::vector<EntityPayload> make_scene(const size_t entity_count)
+{
+    std::vector<StringId> materials;
+    for (size_t i = 0; i < 8; ++i)
+        materials.push_back(STRING_ID(fmt::format("materials/material_{}", i)));
+
+    std::vector<EntityPayload> entities;
+    entities.reserve(entity_count);
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        auto& entity = entities.emplace_back();
+        entity.name = STRING_ID(fmt::format("entity_{}", i));
+        entity.icon = "\xef\x86\xb2"; // ICON_FA_CUBE
+        // Shallow, wide hierarchy: every 16 entities share a parent
+        entity.parent = i < 16 ? STRING_ID("scene") : entities[i / 16].name;
+        entity.translation = glm::vec3{static_cast<float>(i), static_cast<float>(i % 7), -static_cast<float>(i % 13)};
+        entity.rotation = glm::vec3{0.f, static_cast<float>(i % 360), 0.f};
+        entity.mesh = STRING_ID(fmt::format("meshes/mesh_{}", i % 64));
+        entity.materials.assign(materials.begin(), materials.begin() + static_cast<std::ptrdiff_t>(1 + i % 3));
+    }
+    return entities;
+}
+
+MeshPayload make_mesh(const size_t vertex_count)
+{
+    MeshPayload mesh;
+    mesh.positions.reserve(vertex_count);
+    mesh.normals.reserve(vertex_count);
+    mesh.uvs.reserve(vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        mesh.positions.emplace_back(f * 0.1f, f * 0.2f, f * 0.3f);
+        mesh.normals.emplace_back(0.f, 1.f, 0.f);
+        mesh.uvs.emplace_back(f / static_cast<float>(vertex_count), 1.f - f / static_cast<float>(vertex_count));
+    }
+    mesh.indices.reserve(vertex_count * 3);
+    for (size_t i = 0; i < vertex_count * 3; ++i)
+        mesh.indices.push_back(static_cast<uint32_t>((i * 7) % vertex_count));
+    return mesh;
+}
+
+std::vector<MetadataPayload> make_metadata(const size_t count)
+{
+    std::vector<MetadataPayload> metadata;
+    metadata.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& meta = metadata.emplace_back();
+        meta.resource_id = STRING_ID(fmt::format("game/textures/texture_{}", i));
+        meta.type = "Texture";
+        meta.format = "Image";
+        meta.source = fmt::format("textures/texture_{}.png", i);
+        for (size_t j = 0; j < i % 4; ++j)
+            meta.dependencies.push_back(STRING_ID(fmt::format("game/textures/texture_{}", (i + j + 1) % count)));
+        meta.source_size = 1024 * (i + 1);
+        meta.timestamp = 1700000000 + i;
+    }
+    return metadata;
+}
+
+// Section and key names are formatted once up front, so the measured cases only pay for the archive (which copies them)
+struct SettingsKeys
+{
+    std::vector<std::string> sections;
+    std::vector<std::string> keys;
+};
+
+void build_settings(ArchiveObject& root, const SettingsKeys& names, const int seed)
+{
+    for (const auto& section_name : names.sections)
+    {
+        auto* section = root.create_child(section_name);
+        for (size_t k = 0; k < names.keys.size(); ++k)
+        {
+            const auto& key = names.keys[k];
+            const auto value = static_cast<int>(k) + seed;
+            switch (k % 5)
+            {
+            case 0:
+                section->add_property(key, value);
+                break;
+            case 1:
+                section->add_property(key, static_cast<float>(value) * 0.5f);
+                break;
+            case 2:
+                section->add_property(key, value % 2 == 0);
+                break;
+            case 3:
+                section->add_property(key, fmt::format("value_{}", value));
+                break;
+            default:
+                section->add_property(key, glm::vec3{static_cast<float>(value)});
+                break;
+            }
+        }
+    }
+}
+
+template <typename T>
+Buffer write_binary(const T& payload)
+{
+    Buffer buffer;
+    BufferStreamWriter stream(buffer);
+    BinarySerializer serializer(stream);
+    serializer.add_value(payload);
+    stream.flush();
+    return stream.get_buffer();
+}
+
+template <typename T>
+T read_binary(const Buffer& buffer)
+{
+    BufferStreamReader stream(buffer);
+    BinaryDeserializer deserializer(stream);
+    T payload;
+    deserializer.get_value(payload);
+    return payload;
+}
+
+template <typename T>
+std::string write_json(const T& payload)
+{
+    JsonArchive archive;
+    archive.add_property("payload", payload);
+    std::ostringstream stream;
+    archive.dump(stream);
+    return stream.str();
+}
+
+template <typename T>
+T read_json(const std::string& text)
+{
+    std::istringstream stream(text);
+    JsonArchive archive;
+    archive.read(stream);
+    T payload;
+    archive.get_property("payload", payload);
+    return payload;
+}
+
+template <typename T>
+void bench_binary(benchmark::BenchmarkRunner& runner, const std::string& name, const T& payload)
+{
+    const auto binary = write_binary(payload);
+    runner.run(fmt::format("{}/binary/write", name), binary.size, [&] { benchmark::do_not_optimize(write_binary(payload)); });
+    runner.run(fmt::format("{}/binary/read", name), binary.size, [&] { benchmark::do_not_optimize(read_binary<T>(binary)); });
+}
+
+template <typename T>
+void bench_json(benchmark::BenchmarkRunner& runner, const std::string& name, const T& payload)
+{
+    const auto json = write_json(payload);
+    runner.run(fmt::format("{}/json/write", name), json.size(), [&] { benchmark::do_not_optimize(write_json(payload)); });
+    runner.run(fmt::format("{}/json/read", name), json.size(), [&] { benchmark::do_not_optimize(read_json<T>(json)); });
+}
+
+void bench_update(benchmark::BenchmarkRunner& runner, const std::string& name, const ArchiveObject& base, const ArchiveObject& patch, const size_t bytes)
+{
+    // After the warmup the target already holds the patched values, so this measures comparing the patch against the target
+    ArchiveObject target = base;
+    runner.run(fmt::format("{}/archive/update", name), bytes, [&] { target.update(patch); });
+    runner.run(fmt::format("{}/archive/diff", name), bytes, [&] { benchmark::do_not_optimize(ArchiveObject::diff(base, target)); });
+    runner.run(fmt::format("{}/archive/copy", name), bytes, [&] { benchmark::do_not_optimize(ArchiveObject(base)); });
+}
+}
+
+/**
+ * Usage: portal-serialization-bench [output.json]
+ *
+ * Prints a summary to stderr and the results as JSON to stdout, or to `output.json` if given.
+ */
+int main(const int argc, char** argv)
+{
+    benchmark::BenchmarkRunner runner("portal-serialization");
+
+    for (const size_t entity_count : {size_t{10'000}, size_t{100'000}})
+    {
+        const auto name = fmt::format("scene_{}k", entity_count / 1000);
+        const auto scene = make_scene(entity_count);
+        bench_binary(runner, name, scene);
+        bench_json(runner, name, scene);
+
+        ArchiveObject base;
+        base.add_property("nodes", scene);
+        auto patched_scene = scene;
+        for (size_t i = 0; i < patched_scene.size(); i += 100)
+            patched_scene[i].translation += glm::vec3{1.f};
+        ArchiveObject patch;
+        patch.add_property("nodes", patched_scene);
+        bench_update(runner, name, base, patch, write_json(scene).size());
+    }
+
+    {
+        const auto mesh = make_mesh(64 * 1024);
+        bench_binary(runner, "mesh_64k_vertices", mesh);
+        bench_json(runner, "mesh_64k_vertices", mesh);
+    }
+
+    {
+        SettingsKeys names;
+        for (size_t i = 0; i < 32; ++i)
+            names.sections.push_back(fmt::format("section_{}", i));
+        for (size_t i = 0; i < 64; ++i)
+            names.keys.push_back(fmt::format("key_{}", i));
+
+        JsonArchive base;
+        build_settings(base, names, 0);
+        ArchiveObject patch;
+        build_settings(patch, names, 1);
+
+        std::ostringstream json;
+        base.dump(json);
+        const auto settings_json = json.str();
+
+        runner.run(
+            "settings/json/write",
+            settings_json.size(),
+            [&]
+            {
+                std::ostringstream stream;
+                base.dump(stream);
+                benchmark::do_not_optimize(stream.str());
+            }
+        );
+        runner.run(
+            "settings/json/read",
+            settings_json.size(),
+            [&]
+            {
+                std::istringstream stream(settings_json);
+                JsonArchive archive;
+                archive.read(stream);
+                benchmark::do_not_optimize(archive);
+            }
+        );
+        bench_update(runner, "settings", base, patch, settings_json.size());
+    }
+
+    {
+        const auto metadata = make_metadata(1000);
+        bench_binary(runner, "pmeta_1000", metadata);
+        bench_json(runner, "pmeta_1000", metadata);
+
+        // A single .pmeta file, the common case when the resource database scans a project
+        const auto& single = metadata[3];
+        const auto json = write_json(single);
+        runner.run("pmeta_single/json/write", json.size(), [&] { benchmark::do_not_optimize(write_json(single)); });
+        runner.run("pmeta_single/json/read", json.size(), [&] { benchmark::do_not_optimize(read_json<MetadataPayload>(json)); });
+    }
+
+    if (argc > 1)
+    {
+        std::ofstream output(argv[1]);
+        runner.write_json(output);
+    }
+    else
+    {
+        runner.write_json(std::cout);
+    }
+
+    return 0;
+}
@@ -6,8 +6,65 @@
 
 #include "archive.h"
 
+#include <cstring>
+
 namespace portal
 {
+namespace
+{
+    bool is_object(const reflection::Property& prop)
+    {
+        return prop.type == reflection::PropertyType::object && prop.container_type == reflection::PropertyContainerType::object;
+    }
+
+    bool is_object_array(const reflection::Property& prop)
+    {
+        return prop.type == reflection::PropertyType::object && prop.container_type == reflection::PropertyContainerType::array;
+    }
+
+    size_t get_object_count(const reflection::Property& prop)
+    {
+        return prop.container_type == reflection::PropertyContainerType::array ? prop.elements_number : 1;
+    }
+
+    // Child objects own heap memory of their own, so they are copy constructed instead of copied byte by byte
+    reflection::Property copy_property(const reflection::Property& prop)
+    {
+        if (prop.type != reflection::PropertyType::object)
+            return reflection::Property{Buffer::copy(prop.value), prop.type, prop.container_type, prop.elements_number};
+
+        const auto count = get_object_count(prop);
+        Buffer buffer = Buffer::allocate(count * sizeof(ArchiveObject));
+        const auto* source = prop.value.as<const ArchiveObject*>();
+        for (size_t i = 0; i < count; ++i)
+            new(buffer.as<ArchiveObject*>() + i) ArchiveObject(source[i]);
+
+        return reflection::Property{std::move(buffer), prop.type, prop.container_type, prop.elements_number};
+    }
+
+    bool properties_equal(const reflection::Property& lhs, const reflection::Property& rhs)
+    {
+        if (lhs.type != rhs.type || lhs.container_type != rhs.container_type || lhs.elements_number != rhs.elements_number)
+            return false;
+
+        if (lhs.type == reflection::PropertyType::object)
+        {
+            const auto* lhs_objects = lhs.value.as<const ArchiveObject*>();
+            const auto* rhs_objects = rhs.value.as<const ArchiveObject*>();
+            for (size_t i = 0; i < get_object_count(lhs); ++i)
+            {
+                if (!(lhs_objects[i] == rhs_objects[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        if (lhs.value.size != rhs.value.size)
+            return false;
+        return lhs.value.size == 0 || std::memcmp(lhs.value.data, rhs.value.data, lhs.value.size) == 0;
+    }
+}
+
 ArchiveObject::ArchiveObject(ArchiveObject&& other) noexcept : property_map(std::exchange(other.property_map, {})) {}
 
 ArchiveObject& ArchiveObject::operator=(ArchiveObject&& other) noexcept
@@ -20,16 +77,19 @@ ArchiveObject::ArchiveObject(const ArchiveObject& other)
 {
     for (auto& [key, prop] : other.property_map)
     {
-        property_map[key] = reflection::Property{Buffer::copy(prop.value), prop.type, prop.container_type, prop.elements_number};
+        property_map[key] = copy_property(prop);
     }
 }
 
 ArchiveObject& ArchiveObject::operator=(const ArchiveObject& other)
 {
+    if (this == &other)
+        return *this;
+
     property_map.clear();
     for (auto& [key, prop] : other.property_map)
     {
-        property_map[key] = reflection::Property{Buffer::copy(prop.value), prop.type, prop.container_type, prop.elements_number};
+        property_map[key] = copy_property(prop);
     }
     return *this;
 }
@@ -38,64 +98,106 @@ void ArchiveObject::update(const ArchiveObject& other)
 {
     for (auto& [name, prop] : other.property_map)
     {
-        if (prop.type == reflection::PropertyType::object)
+        auto* existing = find_property(name);
+
+        if (existing && is_object(prop) && is_object(*existing))
         {
-            if (prop.container_type == reflection::PropertyContainerType::object)
+            existing->value.as<ArchiveObject*>()->update(*prop.value.as<const ArchiveObject*>());
+            continue;
+        }
+
+        if (existing && is_object_array(prop) && is_object_array(*existing) && existing->elements_number == prop.elements_number)
+        {
+            // Update each element in the existing array
+            auto* our_objects = existing->value.as<ArchiveObject*>();
+            const auto* other_objects = prop.value.as<const ArchiveObject*>();
+            for (size_t i = 0; i < prop.elements_number; ++i)
             {
-                auto* other_object = other.get_object(name);
-                auto* child = get_object(name);
-                if (child)
-                    child->update(*other_object);
-                else
-                    create_child(name)->update(*other_object);
+                our_objects[i].update(other_objects[i]);
             }
-            if (prop.container_type == reflection::PropertyContainerType::array)
+            continue;
+        }
+
+        // Unchanged values keep their current buffer
+        if (existing && properties_equal(*existing, prop))
+            continue;
+
+        property_map[name] = copy_property(prop);
+    }
+}
+
+void ArchiveObject::update(ArchiveObject&& other)
+{
+    for (auto& [name, prop] : other.property_map)
+    {
+        auto* existing = find_property(name);
+
+        if (existing && is_object(prop) && is_object(*existing))
+        {
+            existing->value.as<ArchiveObject*>()->update(std::move(*prop.value.as<ArchiveObject*>()));
+            continue;
+        }
+
+        if (existing && is_object_array(prop) && is_object_array(*existing) && existing->elements_number == prop.elements_number)
+        {
+            auto* our_objects = existing->value.as<ArchiveObject*>();
+            auto* other_objects = prop.value.as<ArchiveObject*>();
+            for (size_t i = 0; i < prop.elements_number; ++i)
             {
-                auto* other_objects = prop.value.as<ArchiveObject*>();
-
-                // Check if we already have this property as an array
-                auto& existing_prop = get_property_from_map(name);
-                if (existing_prop.type == reflection::PropertyType::object &&
-                    existing_prop.container_type == reflection::PropertyContainerType::array &&
-                    existing_prop.elements_number == prop.elements_number)
-                {
-                    // Update each element in the existing array
-                    auto* our_objects = existing_prop.value.as<ArchiveObject*>();
-                    for (size_t i = 0; i < prop.elements_number; ++i)
-                    {
-                        our_objects[i].update(other_objects[i]);
-                    }
-                }
-                else
-                {
-                    // Create a new array by copying from other
-                    Buffer buffer = Buffer::allocate(prop.elements_number * sizeof(ArchiveObject));
-                    auto* new_objects = buffer.as<ArchiveObject*>();
-
-                    for (size_t i = 0; i < prop.elements_number; ++i)
-                    {
-                        new (new_objects + i) ArchiveObject(other_objects[i]);
-                    }
-
-                    property_map[name] = reflection::Property{
-                        .value = std::move(buffer),
-                        .type = reflection::PropertyType::object,
-                        .container_type = reflection::PropertyContainerType::array,
-                        .elements_number = prop.elements_number
-                    };
-                }
+                our_objects[i].update(std::move(other_objects[i]));
             }
+            continue;
         }
-        else
+
+        // Whole subtrees are handed over as is, only the owning buffer changes hands
+        property_map[name] = std::move(prop);
+    }
+    other.property_map.clear();
+}
+
+ArchiveObject ArchiveObject::diff(const ArchiveObject& from, const ArchiveObject& to)
+{
+    ArchiveObject result;
+    for (auto& [name, prop] : to.property_map)
+    {
+        const auto* base = from.find_property(name);
+
+        if (base && is_object(prop) && is_object(*base))
         {
-            property_map[name] = reflection::Property{
-                .value = Buffer::copy(prop.value),
-                .type = prop.type,
-                .container_type = prop.container_type,
-                .elements_number = prop.elements_number
-            };
+            auto child = diff(*base->value.as<const ArchiveObject*>(), *prop.value.as<const ArchiveObject*>());
+            if (!child.property_map.empty())
+            {
+                result.property_map[name] = reflection::Property{
+                    Buffer::create<ArchiveObject>(std::move(child)),
+                    reflection::PropertyType::object,
+                    reflection::PropertyContainerType::object,
+                    1
+                };
+            }
+            continue;
         }
+
+        // Arrays are diffed as a whole, `update` only merges them element-wise when their sizes match
+        if (base && properties_equal(*base, prop))
+            continue;
+
+        result.property_map[name] = copy_property(prop);
     }
+    return result;
+}
+
+bool ArchiveObject::operator==(const ArchiveObject& other) const
+{
+    if (property_map.size() != other.property_map.size())
+        return false;
+
+    for (auto& [name, prop] : property_map)
+    {
+        const auto* other_prop = other.find_property(name);
+        if (!other_prop || !properties_equal(prop, *other_prop))
+            return false;
+    }
+    return true;
 }
 
 void ArchiveObject::add_property(const PropertyName& name, const char* t)
@@ -186,6 +288,30 @@ ArchiveObject* ArchiveObject::get_object(PropertyName name) const
     return prop.value.as<ArchiveObject*>();
 }
 
+reflection::Property* ArchiveObject::find_property(const PropertyName name)
+{
+#ifdef PORTAL_DEBUG
+    const auto it = property_map.find(std::string{name});
+#else
+    const auto it = property_map.find(name);
+#endif
+    if (it == property_map.end())
+        return nullptr;
+    return &it->second;
+}
+
+const reflection::Property* ArchiveObject::find_property(const PropertyName name) const
+{
+#ifdef PORTAL_DEBUG
+    const auto it = property_map.find(std::string{name});
+#else
+    const auto it = property_map.find(name);
+#endif
+    if (it == property_map.end())
+        return nullptr;
+    return &it->second;
+}
+
 reflection::Property& ArchiveObject::get_property_from_map(const PropertyName name)
 {
 #ifdef PORTAL_DEBUG
@@ -182,12 +182,40 @@ public:
      * @brief Merges properties from another ArchiveObject into this one.
      *
      * Properties from the other object are copied into this object's property map.
-     * If a property with the same name already exists, it will be replaced.
+     * If a property with the same name already exists, it will be replaced, properties whose value is unchanged are left untouched.
      *
      * @param other The source ArchiveObject containing properties to merge.
      */
     void update(const ArchiveObject& other);
 
+    /**
+     * @brief Merges properties from another ArchiveObject into this one, taking ownership of its data.
+     *
+     * Same semantics as `update(const ArchiveObject&)`, but properties and whole subtrees that are missing from this object
+     * are moved over instead of deep copied. `other` is left empty.
+     *
+     * @param other The source ArchiveObject containing properties to merge.
+     */
+    void update(ArchiveObject&& other);
+
+    /**
+     * @brief Returns the properties of `to` that are missing from `from` or differ from it.
+     *
+     * Nested objects are diffed recursively, so the result only holds the changed paths and applying it with
+     * `from.update(diff(from, to))` brings `from` in line with `to`.
+     * Properties that only exist in `from` are not part of the diff, as `update` never removes properties.
+     *
+     * @param from The base archive
+     * @param to The modified archive
+     * @return An archive holding only the changed properties
+     */
+    [[nodiscard]] static ArchiveObject diff(const ArchiveObject& from, const ArchiveObject& to);
+
+    /**
+     * @brief Structural comparison, recursively compares the type, size and content of every property.
+     */
+    bool operator==(const ArchiveObject& other) const;
+
     /**
      * @brief Adds a scalar numeric property (integer or floating-point) to the archive.
      *
@@ -1058,6 +1086,9 @@ protected:
         return true;
     }
 
+    [[nodiscard]] reflection::Property* find_property(PropertyName name);
+    [[nodiscard]] const reflection::Property* find_property(PropertyName name) const;
+
     [[nodiscard]] virtual reflection::Property& get_property_from_map(PropertyName name);
     [[nodiscard]] virtual const reflection::Property& get_property_from_map(PropertyName name) const;
     virtual reflection::Property& add_property_to_map(PropertyName name, reflection::Property&& property);
@@ -0,0 +1,373 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include "block_compression.h"
+
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include "portal/core/log.h"
+#include "portal/core/jobs/scheduler.h"
+
+namespace portal
+{
+namespace
+{
+    constexpr size_t HEADER_SIZE = 20;
+    constexpr size_t BLOCK_ENTRY_SIZE = 2 * sizeof(uint32_t);
+
+    struct BlockEntry
+    {
+        uint32_t raw_size = 0;
+        uint32_t stored_size = 0;
+    };
+
+    struct ContainerHeader
+    {
+        CompressionAlgorithm algorithm = CompressionAlgorithm::None;
+        uint32_t block_size = 0;
+        uint64_t raw_size = 0;
+        uint32_t block_count = 0;
+
+        void write(uint8_t* out) const
+        {
+            out[0] = static_cast<uint8_t>(COMPRESSION_MAGIC[0]);
+            out[1] = static_cast<uint8_t>(COMPRESSION_MAGIC[1]);
+            out[2] = COMPRESSION_VERSION;
+            out[3] = static_cast<uint8_t>(algorithm);
+            std::memcpy(out + 4, &block_size, sizeof(uint32_t));
+            std::memcpy(out + 8, &raw_size, sizeof(uint64_t));
+            std::memcpy(out + 16, &block_count, sizeof(uint32_t));
+        }
+
+        static std::optional<ContainerHeader> read(const Buffer& input)
+        {
+            if (input.size < HEADER_SIZE)
+                return std::nullopt;
+
+            const auto* in = input.as<const uint8_t*>();
+            if (in[0] != static_cast<uint8_t>(COMPRESSION_MAGIC[0]) || in[1] != static_cast<uint8_t>(COMPRESSION_MAGIC[1]))
+                return std::nullopt;
+
+            if (in[2] != COMPRESSION_VERSION)
+            {
+                LOG_ERROR_TAG("Compression", "Unsupported compressed container version: {}", in[2]);
+                return std::nullopt;
+            }
+
+            ContainerHeader header{.algorithm = static_cast<CompressionAlgorithm>(in[3])};
+            std::memcpy(&header.block_size, in + 4, sizeof(uint32_t));
+            std::memcpy(&header.raw_size, in + 8, sizeof(uint64_t));
+            std::memcpy(&header.block_count, in + 16, sizeof(uint32_t));
+            return header;
+        }
+    };
+
+    size_t compress_bound(const CompressionAlgorithm algorithm, const size_t size)
+    {
+        switch (algorithm)
+        {
+        case CompressionAlgorithm::Lz4:
+            return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+        case CompressionAlgorithm::Zstd:
+            return ZSTD_compressBound(size);
+        case CompressionAlgorithm::None:
+            break;
+        }
+        return size;
+    }
+
+    /**
+     * Encodes a single block, falling back to storing it raw when the codec does not shrink it.
+     * `output` must be at least `compress_bound(algorithm, size)` bytes.
+     */
+    uint32_t compress_block(const CompressionParams& params, const uint8_t* input, const size_t size, uint8_t* output)
+    {
+        size_t compressed_size = 0;
+        switch (params.algorithm)
+        {
+        case CompressionAlgorithm::Lz4:
+        {
+            const auto result = LZ4_compress_fast(
+                reinterpret_cast<const char*>(input),
+                reinterpret_cast<char*>(output),
+                static_cast<int>(size),
+                LZ4_compressBound(static_cast<int>(size)),
+                (std::max)(params.level, 1)
+            );
+            compressed_size = result > 0 ? static_cast<size_t>(result) : 0;
+            break;
+        }
+        case CompressionAlgorithm::Zstd:
+        {
+            const auto result = ZSTD_compress(output, ZSTD_compressBound(size), input, size, params.level);
+            compressed_size = ZSTD_isError(result) ? 0 : result;
+            break;
+        }
+        case CompressionAlgorithm::None:
+            break;
+        }
+
+        if (compressed_size == 0 || compressed_size >= size)
+        {
+            std::memcpy(output, input, size);
+            return static_cast<uint32_t>(size);
+        }
+        return static_cast<uint32_t>(compressed_size);
+    }
+
+    bool decompress_block(const CompressionAlgorithm algorithm, const BlockEntry& entry, const uint8_t* input, uint8_t* output)
+    {
+        if (entry.stored_size == entry.raw_size)
+        {
+            std::memcpy(output, input, entry.raw_size);
+            return true;
+        }
+
+        switch (algorithm)
+        {
+        case CompressionAlgorithm::Lz4:
+        {
+            const auto result = LZ4_decompress_safe(
+                reinterpret_cast<const char*>(input),
+                reinterpret_cast<char*>(output),
+                static_cast<int>(entry.stored_size),
+                static_cast<int>(entry.raw_size)
+            );
+            return result == static_cast<int>(entry.raw_size);
+        }
+        case CompressionAlgorithm::Zstd:
+        {
+            const auto result = ZSTD_decompress(output, entry.raw_size, input, entry.stored_size);
+            return !ZSTD_isError(result) && result == entry.raw_size;
+        }
+        case CompressionAlgorithm::None:
+            break;
+        }
+        return false;
+    }
+
+    Buffer read_stream(std::istream& input)
+    {
+        const auto size = static_cast<size_t>(input.seekg(0, std::ios::end).tellg());
+        input.seekg(0, std::ios::beg);
+
+        Buffer data = Buffer::allocate(size);
+        input.read(data.as<char*>(), static_cast<std::streamsize>(size));
+        return data;
+    }
+
+    Job<> compress_block_job(const CompressionParams params, const uint8_t* input, const size_t size, uint8_t* output, uint32_t& stored_size)
+    {
+        PORTAL_PROF_ZONE();
+        stored_size = compress_block(params, input, size, output);
+        co_return;
+    }
+
+    Job<> decompress_block_job(const CompressionAlgorithm algorithm, const BlockEntry entry, const uint8_t* input, uint8_t* output, uint8_t& success)
+    {
+        PORTAL_PROF_ZONE();
+        success = decompress_block(algorithm, entry, input, output);
+        co_return;
+    }
+}
+
+Buffer compress(const Buffer& input, const CompressionParams& params, jobs::Scheduler* scheduler)
+{
+    PORTAL_PROF_ZONE();
+    PORTAL_ASSERT(params.block_size > 0, "Compression block size must be positive");
+
+    const auto* raw = input.as<const uint8_t*>();
+    const size_t block_count = (input.size + params.block_size - 1) / params.block_size;
+    const size_t block_bound = compress_bound(params.algorithm, params.block_size);
+
+    // Each block is encoded into its own fixed size slot so blocks can be written concurrently, slots are compacted afterward
+    Buffer scratch = Buffer::allocate(block_count * block_bound);
+    std::vector<uint32_t> stored_sizes(block_count);
+
+    auto raw_block_size = [&](const size_t index)
+    {
+        return (std::min)(static_cast<size_t>(params.block_size), input.size - index * params.block_size);
+    };
+
+    if (scheduler && block_count > 1)
+    {
+        llvm::SmallVector<Job<>> block_jobs;
+        block_jobs.reserve(block_count);
+        for (size_t i = 0; i < block_count; ++i)
+        {
+            block_jobs.emplace_back(
+                compress_block_job(
+                    params,
+                    raw + i * params.block_size,
+                    raw_block_size(i),
+                    scratch.as<uint8_t*>() + i * block_bound,
+                    stored_sizes[i]
+                )
+            );
+        }
+        scheduler->wait_for_jobs(std::span<Job<>>{block_jobs});
+    }
+    else
+    {
+        for (size_t i = 0; i < block_count; ++i)
+            stored_sizes[i] = compress_block(params, raw + i * params.block_size, raw_block_size(i), scratch.as<uint8_t*>() + i * block_bound);
+    }
+
+    size_t total_size = HEADER_SIZE + block_count * BLOCK_ENTRY_SIZE;
+    for (const auto stored_size : stored_sizes)
+        total_size += stored_size;
+
+    Buffer output = Buffer::allocate(total_size);
+    auto* out = output.as<uint8_t*>();
+
+    const ContainerHeader header{
+        .algorithm = params.algorithm,
+        .block_size = params.block_size,
+        .raw_size = input.size,
+        .block_count = static_cast<uint32_t>(block_count)
+    };
+    header.write(out);
+
+    auto* table = out + HEADER_SIZE;
+    auto* data = table + block_count * BLOCK_ENTRY_SIZE;
+    for (size_t i = 0; i < block_count; ++i)
+    {
+        const BlockEntry entry{static_cast<uint32_t>(raw_block_size(i)), stored_sizes[i]};
+        std::memcpy(table + i * BLOCK_ENTRY_SIZE, &entry.raw_size, sizeof(uint32_t));
+        std::memcpy(table + i * BLOCK_ENTRY_SIZE + sizeof(uint32_t), &entry.stored_size, sizeof(uint32_t));
+
+        std::memcpy(data, scratch.as<const uint8_t*>() + i * block_bound, entry.stored_size);
+        data += entry.stored_size;
+    }
+
+    return output;
+}
+
+Buffer decompress(const Buffer& input, jobs::Scheduler* scheduler)
+{
+    PORTAL_PROF_ZONE();
+    const auto header = ContainerHeader::read(input);
+    if (!header)
+    {
+        LOG_ERROR_TAG("Compression", "Invalid compressed container header");
+        return {};
+    }
+
+    const size_t table_size = header->block_count * BLOCK_ENTRY_SIZE;
+    if (input.size < HEADER_SIZE + table_size)
+    {
+        LOG_ERROR_TAG("Compression", "Truncated compressed container block table");
+        return {};
+    }
+
+    const auto* table = input.as<const uint8_t*>() + HEADER_SIZE;
+    std::vector<BlockEntry> entries(header->block_count);
+    std::vector<size_t> input_offsets(header->block_count);
+    std::vector<size_t> output_offsets(header->block_count);
+
+    size_t input_offset = HEADER_SIZE + table_size;
+    size_t output_offset = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        std::memcpy(&entries[i].raw_size, table + i * BLOCK_ENTRY_SIZE, sizeof(uint32_t));
+        std::memcpy(&entries[i].stored_size, table + i * BLOCK_ENTRY_SIZE + sizeof(uint32_t), sizeof(uint32_t));
+
+        input_offsets[i] = input_offset;
+        output_offsets[i] = output_offset;
+        input_offset += entries[i].stored_size;
+        output_offset += entries[i].raw_size;
+    }
+
+    if (input_offset > input.size || output_offset != header->raw_size)
+    {
+        LOG_ERROR_TAG("Compression", "Compressed container block table does not match its payload");
+        return {};
+    }
+
+    Buffer output = Buffer::allocate(header->raw_size);
+    const auto* in = input.as<const uint8_t*>();
+    auto* out = output.as<uint8_t*>();
+
+    // Not std::vector<bool>, each job needs its own addressable flag
+    std::vector<uint8_t> results(entries.size(), 0);
+    if (scheduler && entries.size() > 1)
+    {
+        llvm::SmallVector<Job<>> block_jobs;
+        block_jobs.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            block_jobs.emplace_back(
+                decompress_block_job(
+                    header->algorithm,
+                    entries[i],
+                    in + input_offsets[i],
+                    out + output_offsets[i],
+                    results[i]
+                )
+            );
+        }
+        scheduler->wait_for_jobs(std::span<Job<>>{block_jobs});
+    }
+    else
+    {
+        for (size_t i = 0; i < entries.size(); ++i)
+            results[i] = decompress_block(header->algorithm, entries[i], in + input_offsets[i], out + output_offsets[i]);
+    }
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i])
+        {
+            LOG_ERROR_TAG("Compression", "Failed to decompress block {} of {}", i, results.size());
+            return {};
+        }
+    }
+
+    return output;
+}
+
+bool is_compressed(const Buffer& input)
+{
+    if (input.size < HEADER_SIZE)
+        return false;
+
+    const auto* in = input.as<const uint8_t*>();
+    return in[0] == static_cast<uint8_t>(COMPRESSION_MAGIC[0]) && in[1] == static_cast<uint8_t>(COMPRESSION_MAGIC[1]);
+}
+
+CompressedStreamWriter::CompressedStreamWriter(const CompressionParams& params, jobs::Scheduler* scheduler) :
+    params(params),
+    scheduler(scheduler),
+    writer(buffer)
+{}
+
+Buffer CompressedStreamWriter::finish()
+{
+    writer.flush();
+    return compress(Buffer{buffer.data, writer.size()}, params, scheduler);
+}
+
+void CompressedStreamWriter::finish(std::ostream& output)
+{
+    const auto compressed = finish();
+    output.write(compressed.as<const char*>(), static_cast<std::streamsize>(compressed.size));
+}
+
+CompressedStreamReader::CompressedStreamReader(const Buffer& compressed, jobs::Scheduler* scheduler) :
+    buffer(decompress(compressed, scheduler)),
+    reader(buffer)
+{}
+
+CompressedStreamReader::CompressedStreamReader(std::istream& input, jobs::Scheduler* scheduler) :
+    buffer(decompress(read_stream(input), scheduler)),
+    reader(buffer)
+{}
+} // portal
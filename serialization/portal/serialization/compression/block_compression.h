@@ -0,0 +1,170 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#pragma once
+
+#include <array>
+#include <istream>
+#include <ostream>
+
+#include "portal/core/buffer.h"
+#include "portal/core/buffer_stream.h"
+
+namespace portal
+{
+namespace jobs
+{
+    class Scheduler;
+}
+
+/** @brief Magic bytes identifying a Portal compressed container ("PZ") */
+constexpr std::array COMPRESSION_MAGIC = {'P', 'Z'};
+
+/** @brief Compressed container format version */
+constexpr uint8_t COMPRESSION_VERSION = 1;
+
+/**
+ * @brief Codec used to encode each block of a compressed container.
+ */
+enum class CompressionAlgorithm : uint8_t
+{
+    /** @brief Blocks are stored as-is, useful for debugging the container format */
+    None = 0,
+    /** @brief LZ4, optimized for speed (default) */
+    Lz4 = 1,
+    /** @brief Zstandard, optimized for ratio */
+    Zstd = 2,
+};
+
+/**
+ * @brief Configuration parameters for block compression.
+ */
+struct CompressionParams
+{
+    CompressionAlgorithm algorithm = CompressionAlgorithm::Lz4;
+
+    /**
+     * @brief Codec specific level.
+     *
+     * For LZ4 this is the acceleration factor (1 = default, higher is faster with worse ratio),
+     * for Zstd this is the compression level (1-22, 3 is the zstd default).
+     */
+    int level = 1;
+
+    /** @brief Size of each independently decodable block in bytes. Default: 256 KiB */
+    uint32_t block_size = 256 * 1024;
+};
+
+/**
+ * @brief Compresses a buffer into a self describing container of independently decodable blocks.
+ *
+ * ## Container Format
+ *
+ * **Header** (20 bytes):
+ * - Magic bytes: "PZ" (0x50, 0x5A)
+ * - Version: 1 byte
+ * - Algorithm: 1 byte (CompressionAlgorithm)
+ * - Block size: uint32_t
+ * - Raw size: uint64_t (total uncompressed size)
+ * - Block count: uint32_t
+ *
+ * **Block table** (8 bytes per block):
+ * - Raw size: uint32_t
+ * - Stored size: uint32_t (equal to raw size when the block did not compress and is stored as-is)
+ *
+ * **Block data**: the stored bytes of every block, back to back in table order.
+ *
+ * Because every block is encoded on its own, blocks can be compressed and decompressed in parallel.
+ * When a scheduler is given and the input spans more than one block, each block is encoded as a separate job.
+ *
+ * @param input The raw data to compress
+ * @param params Compression parameters
+ * @param scheduler Optional scheduler used to compress blocks in parallel
+ * @return An owning buffer containing the compressed container
+ */
+[[nodiscard]] Buffer compress(const Buffer& input, const CompressionParams& params = {}, jobs::Scheduler* scheduler = nullptr);
+
+/**
+ * @brief Decompresses a container produced by `compress`.
+ *
+ * @param input The compressed container
+ * @param scheduler Optional scheduler used to decompress blocks in parallel
+ * @return An owning buffer with the original data, or an empty buffer if the container is malformed
+ */
+[[nodiscard]] Buffer decompress(const Buffer& input, jobs::Scheduler* scheduler = nullptr);
+
+/**
+ * @brief Checks whether a buffer starts with a compressed container header.
+ */
+[[nodiscard]] bool is_compressed(const Buffer& input);
+
+/**
+ * @brief Adapts a Serializer output stream so that everything written to it is block compressed.
+ *
+ * The written data is staged in memory (so `Serializer::reserve` keeps working) and is compressed once `finish` is called.
+ *
+ * @code
+ * CompressedStreamWriter writer({.algorithm = CompressionAlgorithm::Zstd, .level = 3}, &scheduler);
+ * BinarySerializer serializer(writer.stream());
+ * serializer.add_value(42);
+ * Buffer compressed = writer.finish();
+ * @endcode
+ */
+class CompressedStreamWriter
+{
+public:
+    explicit CompressedStreamWriter(const CompressionParams& params = {}, jobs::Scheduler* scheduler = nullptr);
+
+    [[nodiscard]] std::ostream& stream() { return writer; }
+
+    /** @brief Number of uncompressed bytes written so far */
+    [[nodiscard]] size_t size() const { return writer.size(); }
+
+    /**
+     * @brief Compresses the staged data and returns the compressed container.
+     */
+    [[nodiscard]] Buffer finish();
+
+    /**
+     * @brief Compresses the staged data and writes the compressed container to `output`.
+     */
+    void finish(std::ostream& output);
+
+private:
+    CompressionParams params;
+    jobs::Scheduler* scheduler;
+
+    Buffer buffer;
+    BufferStreamWriter writer;
+};
+
+/**
+ * @brief Adapts a compressed container so it can be consumed by a Deserializer.
+ *
+ * The container is decompressed up front (in parallel when a scheduler is given) and exposed as a seekable input stream.
+ *
+ * @code
+ * CompressedStreamReader reader(compressed, &scheduler);
+ * BinaryDeserializer deserializer(reader.stream());
+ * int value;
+ * deserializer.get_value(value);
+ * @endcode
+ */
+class CompressedStreamReader
+{
+public:
+    explicit CompressedStreamReader(const Buffer& compressed, jobs::Scheduler* scheduler = nullptr);
+    explicit CompressedStreamReader(std::istream& input, jobs::Scheduler* scheduler = nullptr);
+
+    [[nodiscard]] std::istream& stream() { return reader; }
+
+    /** @brief Size of the decompressed data */
+    [[nodiscard]] size_t size() const { return buffer.size; }
+
+private:
+    Buffer buffer;
+    BufferStreamReader reader;
+};
+} // portal
@@ -774,4 +774,107 @@ SCENARIO("Non-intrusive archiving concepts are correctly detected")
         STATIC_REQUIRE_FALSE(ArchiveableConcept<ExternalPoint>);
         STATIC_REQUIRE_FALSE(ArchiveableConcept<ExternalConfig>);
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Archive objects can be merged and diffed")
+{
+    GIVEN("A base archive with a nested object")
+    {
+        ArchiveObject base;
+        base.add_property("name", std::string("base"));
+        base.add_property("count", 1);
+        auto* child = base.create_child("window");
+        child->add_property("width", 800);
+        child->add_property("height", 600);
+
+        WHEN("The archive is copied")
+        {
+            ArchiveObject copy = base;
+
+            THEN("Nested objects are independent of the original")
+            {
+                REQUIRE(copy == base);
+
+                copy.get_object("window")->add_property("width", 1920);
+
+                int width = 0;
+                REQUIRE(base.get_object("window")->get_property("width", width));
+                REQUIRE(width == 800);
+                REQUIRE_FALSE(copy == base);
+            }
+        }
+
+        WHEN("The archive is diffed against a modified copy")
+        {
+            ArchiveObject modified = base;
+            modified.add_property("count", 2);
+            modified.get_object("window")->add_property("height", 1080);
+            modified.add_property("title", std::string("portal"));
+
+            const auto changes = ArchiveObject::diff(base, modified);
+
+            THEN("Only the changed paths are part of the diff")
+            {
+                ArchiveObject diff_copy = changes;
+
+                int count = 0;
+                std::string title;
+                std::string name;
+                REQUIRE(diff_copy.get_property("count", count));
+                REQUIRE(count == 2);
+                REQUIRE(diff_copy.get_property("title", title));
+                REQUIRE(title == "portal");
+                REQUIRE_FALSE(diff_copy.get_property("name", name));
+
+                auto* window = diff_copy.get_object("window");
+                REQUIRE(window != nullptr);
+
+                int width = 0;
+                int height = 0;
+                REQUIRE(window->get_property("height", height));
+                REQUIRE(height == 1080);
+                REQUIRE_FALSE(window->get_property("width", width));
+            }
+
+            THEN("Applying the diff to the base results in the modified archive")
+            {
+                base.update(changes);
+                REQUIRE(base == modified);
+            }
+
+            THEN("Diffing identical archives results in an empty diff")
+            {
+                const auto empty = ArchiveObject::diff(modified, modified);
+                REQUIRE(empty == ArchiveObject{});
+            }
+        }
+
+        WHEN("A patch is moved into the archive")
+        {
+            ArchiveObject patch;
+            patch.add_property("count", 3);
+            patch.create_child("window")->add_property("width", 1024);
+            patch.create_child("audio")->add_property("volume", 0.5f);
+
+            base.update(std::move(patch));
+
+            THEN("The patch is merged into the archive and left empty")
+            {
+                int count = 0;
+                int width = 0;
+                int height = 0;
+                float volume = 0;
+                REQUIRE(base.get_property("count", count));
+                REQUIRE(count == 3);
+                REQUIRE(base.get_object("window")->get_property("width", width));
+                REQUIRE(width == 1024);
+                REQUIRE(base.get_object("window")->get_property("height", height));
+                REQUIRE(height == 600);
+                REQUIRE(base.get_object("audio")->get_property("volume", volume));
+                REQUIRE(volume == 0.5f);
+
+                REQUIRE(patch == ArchiveObject{});
+            }
+        }
+    }
+}
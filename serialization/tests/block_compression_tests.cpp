@@ -0,0 +1,184 @@
+//
+// Copyright © 2026 Jonatan Nevo.
+// Distributed under the MIT license (see LICENSE file).
+//
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "portal/core/buffer.h"
+#include "portal/core/jobs/scheduler.h"
+#include "portal/serialization/compression/block_compression.h"
+#include "portal/serialization/serialize/binary_serialization.h"
+
+using namespace portal;
+
+namespace
+{
+std::vector<uint8_t> make_compressible_data(const size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>((i / 64) % 17);
+    return data;
+}
+
+std::vector<uint8_t> make_noise(const size_t size)
+{
+    std::vector<uint8_t> data(size);
+    uint32_t state = 0x12345678;
+    for (auto& byte : data)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        byte = static_cast<uint8_t>(state);
+    }
+    return data;
+}
+
+bool equals(const Buffer& buffer, const std::vector<uint8_t>& data)
+{
+    return buffer.size == data.size() && std::memcmp(buffer.data, data.data(), data.size()) == 0;
+}
+}
+
+SCENARIO("Block compression round-trips data")
+{
+    const auto algorithm = GENERATE(CompressionAlgorithm::None, CompressionAlgorithm::Lz4, CompressionAlgorithm::Zstd);
+    const CompressionParams params{.algorithm = algorithm, .level = algorithm == CompressionAlgorithm::Zstd ? 3 : 1, .block_size = 4096};
+
+    GIVEN("Compressible data spanning multiple blocks")
+    {
+        const auto data = make_compressible_data(params.block_size * 5 + 123);
+
+        WHEN("The data is compressed")
+        {
+            const auto compressed = compress(Buffer{data.data(), data.size()}, params);
+
+            THEN("The container is recognized and decompresses to the original data")
+            {
+                REQUIRE(is_compressed(compressed));
+                REQUIRE(equals(decompress(compressed), data));
+            }
+
+            THEN("The container is smaller than the input when a codec is used")
+            {
+                if (algorithm != CompressionAlgorithm::None)
+                    REQUIRE(compressed.size < data.size());
+            }
+        }
+    }
+
+    GIVEN("Incompressible data")
+    {
+        const auto data = make_noise(params.block_size * 2);
+
+        THEN("Blocks are stored raw and still round-trip")
+        {
+            const auto compressed = compress(Buffer{data.data(), data.size()}, params);
+            REQUIRE(compressed.size <= data.size() + 64);
+            REQUIRE(equals(decompress(compressed), data));
+        }
+    }
+
+    GIVEN("An empty buffer")
+    {
+        THEN("It round-trips to an empty buffer")
+        {
+            const auto compressed = compress(Buffer{}, params);
+            REQUIRE(is_compressed(compressed));
+            REQUIRE(decompress(compressed).size == 0);
+        }
+    }
+}
+
+SCENARIO("Block compression runs in parallel on the scheduler")
+{
+    GIVEN("A scheduler and a large blob")
+    {
+        jobs::Scheduler scheduler{2};
+        const auto data = make_compressible_data(1024 * 1024 + 7);
+        const CompressionParams params{.block_size = 64 * 1024};
+
+        THEN("Parallel and serial compression produce identical containers")
+        {
+            const auto parallel = compress(Buffer{data.data(), data.size()}, params, &scheduler);
+            const auto serial = compress(Buffer{data.data(), data.size()}, params);
+
+            REQUIRE(parallel.size == serial.size);
+            REQUIRE(std::memcmp(parallel.data, serial.data, serial.size) == 0);
+            REQUIRE(equals(decompress(parallel, &scheduler), data));
+        }
+    }
+}
+
+SCENARIO("Block compression rejects malformed containers")
+{
+    GIVEN("A buffer without a container header")
+    {
+        const std::string text = "definitely not compressed data";
+        const Buffer buffer{text.data(), text.size()};
+
+        THEN("It is not recognized and decompression fails")
+        {
+            REQUIRE_FALSE(is_compressed(buffer));
+            REQUIRE(decompress(buffer) == nullptr);
+        }
+    }
+
+    GIVEN("A truncated container")
+    {
+        const auto data = make_compressible_data(10000);
+        const auto compressed = compress(Buffer{data.data(), data.size()}, {.block_size = 1024});
+
+        THEN("Decompression fails")
+        {
+            REQUIRE(decompress(Buffer{compressed, compressed.size / 2}) == nullptr);
+        }
+    }
+}
+
+SCENARIO("Compressed streams wrap binary serialization")
+{
+    GIVEN("A compressed stream writer")
+    {
+        CompressedStreamWriter writer({.algorithm = CompressionAlgorithm::Zstd, .level = 3, .block_size = 1024});
+        BinarySerializer serializer(writer.stream());
+
+        std::vector<float> values(4096);
+        std::iota(values.begin(), values.end(), 0.f);
+
+        auto count_slot = serializer.reserve<size_t>();
+        serializer.add_value(std::string{"compressed"});
+        serializer.add_value(values);
+        count_slot.write(values.size());
+
+        WHEN("The stream is finished and read back")
+        {
+            const auto compressed = writer.finish();
+            REQUIRE(compressed.size < writer.size());
+
+            CompressedStreamReader reader(compressed);
+            BinaryDeserializer deserializer(reader.stream());
+
+            size_t count;
+            std::string name;
+            std::vector<float> read_values;
+            deserializer.get_value(count);
+            deserializer.get_value(name);
+            deserializer.get_value(read_values);
+
+            THEN("The values match the ones written")
+            {
+                REQUIRE(count == values.size());
+                REQUIRE(name == "compressed");
+                REQUIRE(read_values == values);
+            }
+        }
+    }
+}